@@ -5,6 +5,17 @@
 import meshio
 import os
 
+from DataAsst.MeshConverters.OasisMesh import DEFAULT_FILE_NAME, write_oasis_mesh
+
+# 各类单元的面(以单元节点序号表示)
+CELL_FACES = {
+    "triangle": [[0, 1], [1, 2], [2, 0]],
+    "quad": [[0, 1], [1, 2], [2, 3], [3, 0]],
+    "tetra": [[0, 2, 1], [0, 1, 3], [1, 2, 3], [0, 3, 2]],
+    "hexahedron": [[0, 3, 2, 1], [4, 5, 6, 7], [0, 1, 5, 4],
+                   [1, 2, 6, 5], [2, 3, 7, 6], [3, 0, 4, 7]],
+}
+
 
 class FromGmsh:
     """
@@ -47,6 +58,41 @@ class FromGmsh:
         vtk_file = os.path.join(output_dir, name + ".vtk")
         meshio.write(vtk_file, self.mesh, file_format="vtk")
 
+    def read_faces_of_cells(self):
+        """
+        由单元节点生成面, 共用的面只保留一个。
+
+        Returns:
+            (faces, cells), 面的节点索引列表和单元的面索引列表。
+        """
+        faces, cells, face_ids = [], [], {}
+        for block in self.mesh.cells:
+            if block.type not in CELL_FACES:
+                continue
+
+            for nodes in block.data:
+                cell = []
+                for local in CELL_FACES[block.type]:
+                    face = [int(nodes[i]) for i in local]
+                    key = tuple(sorted(face))
+                    if key not in face_ids:
+                        face_ids[key] = len(faces)
+                        faces.append(face)
+                    cell.append(face_ids[key])
+                cells.append(cell)
+
+        return faces, cells
+
+    def to_oasis_binary(self, output_file: str = DEFAULT_FILE_NAME):
+        """
+        将 Gmsh4 的 MESH 格式网格文件转换为 OpenOasis 的二进制网格文件。
+
+        Parameters:
+            output_file: 输出文件路径。
+        """
+        faces, cells = self.read_faces_of_cells()
+        write_oasis_mesh(output_file, self.read_nodes(), faces, cells)
+
     def to_oasis(self, output_dir: str = "."):
         """
         将 Gmsh4 的 MESH 格式网格文件转换为 OpenOasis 的网格格式。
@@ -0,0 +1,197 @@
+# -*- encoding: utf-8 -*-
+"""
+OpenOasis 二进制网格文件(mesh.omsh)的读写, 格式与 Models/CommImp/IO/MeshFile.h 一致。
+
+文件布局(小端, 各段按 8 字节对齐):
+    文件头(含转换自的 csv 文件的大小与修改时间) | 节点坐标 | 面坐标 | 单元坐标
+    | 面节点(CSR) | 单元面(CSR) | 边界面(CSR) | 区域面(CSR) | 边界与区域名称
+"""
+import csv
+import os
+import struct
+import threading
+from array import array
+
+MAGIC = b"OASISMSH"
+VERSION = 2
+HEADER = struct.Struct("<8sII10Q5Q5q")
+DEFAULT_FILE_NAME = "mesh.omsh"
+SOURCE_FILES = ("nodes.csv", "faces.csv", "cells.csv", "patches.csv", "zones.csv")
+
+
+def _align(offset: int) -> int:
+    return (offset + 7) // 8 * 8
+
+
+def _to_csr(rows):
+    offsets, indexes = [0], []
+    for row in rows:
+        indexes.extend(int(i) for i in row)
+        offsets.append(len(indexes))
+    return offsets, indexes
+
+
+def _stamp_sources(mesh_dir: str):
+    """返回各 csv 文件的大小与修改时间(ns), 文件不存在时为 0。"""
+    sizes, times = [], []
+    for name in SOURCE_FILES:
+        file = os.path.join(mesh_dir, name)
+        stat = os.stat(file) if os.path.exists(file) else None
+        sizes.append(stat.st_size if stat else 0)
+        times.append(stat.st_mtime_ns if stat else 0)
+    return sizes, times
+
+
+def _centroids(coords, rows):
+    centroids = []
+    for row in rows:
+        n = len(row)
+        centroids.append(tuple(sum(coords[i][k] for i in row) / n for k in range(3)))
+    return centroids
+
+
+def write_oasis_mesh(path: str, nodes, faces, cells, patches=None, zones=None,
+                     real_size: int = 8, mesh_dir: str = None):
+    """
+    写出 OpenOasis 二进制网格文件。
+
+    Parameters:
+        path: 输出文件路径。
+        nodes: 节点坐标列表, 每项为 (x, y, z)。
+        faces: 面的节点索引列表。
+        cells: 单元的面索引列表。
+        patches: 边界名称到面索引列表的字典。
+        zones: 区域名称到面索引列表的字典。
+        real_size: 浮点数字节数, 8 为双精度, 4 为单精度(USE_SP)。
+        mesh_dir: 转换自的 csv 网格目录, 记录其中 csv 文件的大小与修改时间。
+    """
+    real = {8: "d", 4: "f"}[real_size]
+    nodes = [tuple(float(v) for v in node) for node in nodes]
+    face_coords = _centroids(nodes, faces)
+    cell_coords = _centroids(face_coords, cells)
+
+    patches = sorted((patches or {}).items())
+    zones = sorted((zones or {}).items())
+
+    face_offsets, face_nodes = _to_csr(faces)
+    cell_offsets, cell_faces = _to_csr(cells)
+    patch_offsets, patch_faces = _to_csr(faces for _, faces in patches)
+    zone_offsets, zone_faces = _to_csr(faces for _, faces in zones)
+
+    names = b""
+    name_offsets = [0]
+    for name, _ in patches + zones:
+        names += name.encode("utf-8")
+        name_offsets.append(len(names))
+
+    # 不是由 csv 文件转换时, 视为各文件都不存在
+    sizes, times = [0] * len(SOURCE_FILES), [0] * len(SOURCE_FILES)
+    if mesh_dir:
+        sizes, times = _stamp_sources(mesh_dir)
+
+    header = HEADER.pack(
+        MAGIC, VERSION, real_size,
+        len(nodes), len(faces), len(cells), len(face_nodes), len(cell_faces),
+        len(patches), len(patch_faces), len(zones), len(zone_faces), len(names),
+        *sizes, *times)
+
+    sections = [
+        array(real, [v for coor in nodes for v in coor]).tobytes(),
+        array(real, [v for coor in face_coords for v in coor]).tobytes(),
+        array(real, [v for coor in cell_coords for v in coor]).tobytes(),
+    ]
+    for values in (face_offsets, face_nodes, cell_offsets, cell_faces,
+                   patch_offsets, patch_faces, zone_offsets, zone_faces, name_offsets):
+        sections.append(array("Q", values).tobytes())
+    sections.append(names)
+
+    # 先写临时文件再重命名, 避免读到未写完的文件;
+    # 临时文件以进程与线程命名, 同时写同一文件时互不覆盖
+    temp = f"{path}.{os.getpid()}.{threading.get_ident()}.tmp"
+    with open(temp, "wb") as f:
+        f.write(header)
+        for data in sections:
+            f.write(b"\0" * (_align(f.tell()) - f.tell()))
+            f.write(data)
+    os.replace(temp, path)
+
+
+def read_oasis_mesh(path: str):
+    """
+    读取 OpenOasis 二进制网格文件。
+
+    Returns:
+        (nodes, faces, cells, patches, zones), 含义同 write_oasis_mesh 的参数。
+    """
+    with open(path, "rb") as f:
+        data = f.read()
+
+    magic, version, real_size, *fields = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION or real_size not in (4, 8):
+        raise ValueError(f"Unsupported mesh file [{path}].")
+
+    real = {8: "d", 4: "f"}[real_size]
+
+    (n_nodes, n_faces, n_cells, n_face_nodes, n_cell_faces,
+     n_patches, n_patch_faces, n_zones, n_zone_faces, n_names) = fields[:10]
+
+    offset = HEADER.size
+
+    def read(code, count):
+        nonlocal offset
+        offset = _align(offset)
+        values = array(code)
+        values.frombytes(data[offset:offset + count * values.itemsize])
+        offset += count * values.itemsize
+        return values.tolist()
+
+    def split(offsets, indexes):
+        return [indexes[offsets[i]:offsets[i + 1]] for i in range(len(offsets) - 1)]
+
+    coords = read(real, 3 * n_nodes)
+    nodes = [tuple(coords[3 * i:3 * i + 3]) for i in range(n_nodes)]
+    read(real, 3 * n_faces)
+    read(real, 3 * n_cells)
+
+    faces = split(read("Q", n_faces + 1), read("Q", n_face_nodes))
+    cells = split(read("Q", n_cells + 1), read("Q", n_cell_faces))
+    patch_faces = split(read("Q", n_patches + 1), read("Q", n_patch_faces))
+    zone_faces = split(read("Q", n_zones + 1), read("Q", n_zone_faces))
+
+    name_offsets = read("Q", n_patches + n_zones + 1)
+    names = data[offset:offset + n_names].decode("utf-8")
+    names = [names[name_offsets[i]:name_offsets[i + 1]]
+             for i in range(len(name_offsets) - 1)]
+
+    patches = dict(zip(names[:n_patches], patch_faces))
+    zones = dict(zip(names[n_patches:], zone_faces))
+    return nodes, faces, cells, patches, zones
+
+
+def convert_from_csv(mesh_dir: str, path: str = None):
+    """
+    将网格目录下的 csv 文件(nodes/faces/cells/patches/zones.csv)转换为二进制网格文件。
+
+    Parameters:
+        mesh_dir: csv 网格目录。
+        path: 输出文件路径, 默认为网格目录下的 mesh.omsh。
+    """
+    def read_rows(name, header=True):
+        file = os.path.join(mesh_dir, name)
+        if not os.path.exists(file):
+            return []
+        with open(file, newline="") as f:
+            rows = [row for row in csv.reader(f) if row]
+        return rows[1:] if header else rows
+
+    nodes = [[float(v) for v in row[1:4]] for row in read_rows("nodes.csv")]
+    faces = [[int(v) for v in row[1:] if v.strip()] for row in read_rows("faces.csv")]
+    cells = [[int(v) for v in row[1:] if v.strip()] for row in read_rows("cells.csv")]
+
+    def read_table(name):
+        return {row[0]: [int(v) for v in row[1:] if v.strip()]
+                for row in read_rows(name, header=False)}
+
+    write_oasis_mesh(
+        path or os.path.join(mesh_dir, DEFAULT_FILE_NAME), nodes, faces, cells,
+        read_table("patches.csv"), read_table("zones.csv"), mesh_dir=mesh_dir)
@@ -0,0 +1,211 @@
+/** ***********************************************************************************
+ *    @File      :  AsyncOutput.cpp
+ *    @Brief     :  To provide an output delivering values asynchronously.
+ *
+ ** ***********************************************************************************/
+#include "AsyncOutput.h"
+#include "TimeSet.h"
+#include "Time.h"
+#include "ValueSetDense.h"
+#include "DevSupports/ExchangeItemHelper.h"
+#include "DevSupports/ExtensionMethods.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
+#include <limits>
+
+
+namespace OpenOasis::CommImp
+{
+using namespace DevSupports;
+using namespace Utils;
+using namespace std;
+
+
+AsyncOutput::AsyncOutput(
+    const string &id, const shared_ptr<IOutput> &adaptee, int capacity) :
+    Output(id, adaptee->GetComponent().lock()),
+    mAdaptee(adaptee), mRing(capacity > 0 ? capacity : 1)
+{
+    auto valueDef = dynamic_pointer_cast<IQuantity>(adaptee->GetValueDefinition());
+    if (!valueDef)
+    {
+        throw IllegalArgumentException(StringHelper::FormatSimple(
+            "Output [{}] without quantity can't be exchanged asynchronously.",
+            adaptee->GetId()));
+    }
+
+    mElementSet = adaptee->GetElementSet();
+    mTimeSet    = make_shared<TimeSet>();
+    mValues     = make_shared<ValueSetDense<real>>(valueDef);
+}
+
+AsyncOutput::~AsyncOutput()
+{
+    Stop();
+}
+
+shared_ptr<IOutput> AsyncOutput::GetAdaptee() const
+{
+    return mAdaptee;
+}
+
+void AsyncOutput::Start()
+{
+    if (IsStarted())
+    {
+        return;
+    }
+
+    mStopped      = false;
+    mProducerDone = false;
+    mProducer     = thread(&AsyncOutput::ProduceLoop, this);
+}
+
+void AsyncOutput::Stop()
+{
+    mStopped = true;
+    Notify(mPopped);
+
+    if (mProducer.joinable())
+    {
+        mProducer.join();
+    }
+}
+
+bool AsyncOutput::IsStarted() const
+{
+    return mProducer.joinable();
+}
+
+void AsyncOutput::Reset()
+{
+    Stop();
+
+    Output::Reset();
+    mAdaptee.reset();
+}
+
+void AsyncOutput::ProduceLoop()
+{
+    try
+    {
+        const auto &comp = mAdaptee->GetComponent().lock();
+        while (!mStopped && comp && !IsProducerFinished())
+        {
+            comp->Update();
+
+            // The adaptee has no consumers, only the latest values are kept.
+            const auto &values = mAdaptee->GetValues();
+            const auto &times  = mAdaptee->GetTimeSet()->GetTimes();
+            if (times.empty() || values->GetIndexCount({0}) == 0)
+            {
+                continue;
+            }
+
+            int lastIdx = values->GetIndexCount({0}) - 1;
+
+            Frame frame;
+            frame.time   = make_shared<Time>(times.back());
+            frame.values =
+                ExtensionMethods::GetElementValuesForTime<real>(values, lastIdx);
+
+            // Waits for the consumer when the ring is full.
+            {
+                unique_lock<mutex> lock(mWaitMutex);
+                mPopped.wait(lock, [this, &frame] {
+                    return mStopped || mRing.TryPush(std::move(frame));
+                });
+            }
+            mPushed.notify_one();
+        }
+    }
+    catch (...)
+    {
+        mProducerError = current_exception();
+    }
+
+    mProducerDone = true;
+    Notify(mPushed);
+}
+
+void AsyncOutput::Update()
+{
+    const auto &latestTime = ExchangeItemHelper::GetLatestConsumerTime(GetInstance());
+    if (!latestTime)
+    {
+        RefreshAdaptedOutputs();
+        return;
+    }
+
+    double queryTimestamp = latestTime->GetTimeStamp();
+    auto   available      = [this]() {
+        const auto &times = mTimeSet->GetTimes();
+        if (times.empty())
+        {
+            return numeric_limits<double>::lowest();
+        }
+        return ExtensionMethods::EndTimeStamp(times.back());
+    };
+
+    // Pops the produced steps until the query is covered or the producer stops.
+    Frame frame;
+    while (available() < queryTimestamp)
+    {
+        if (mRing.TryPop(frame))
+        {
+            AppendFrame(frame);
+            Notify(mPopped);
+            continue;
+        }
+
+        if (!IsStarted())
+        {
+            break;
+        }
+
+        // The producer sets done after its last push, so an empty ring is final.
+        unique_lock<mutex> lock(mWaitMutex);
+        if (mProducerDone && mRing.IsEmpty())
+        {
+            break;
+        }
+        mPushed.wait(lock, [this] { return mProducerDone || !mRing.IsEmpty(); });
+    }
+
+    if (mProducerDone && mProducerError)
+    {
+        rethrow_exception(mProducerError);
+    }
+
+    RefreshAdaptedOutputs();
+}
+
+bool AsyncOutput::IsProducerFinished() const
+{
+    auto status = mAdaptee->GetComponent().lock()->GetStatus();
+
+    return status == LinkableComponentStatus::Done
+           || status == LinkableComponentStatus::Failed
+           || status == LinkableComponentStatus::Finished;
+}
+
+void AsyncOutput::AppendFrame(Frame &frame)
+{
+    dynamic_pointer_cast<ValueSetDense<real>>(mValues)->AddElementValuesForTime(
+        frame.values);
+
+    mTimeSet->AddTime(frame.time);
+
+    BroadcastEventWithMsg("Values received asynchronously");
+}
+
+void AsyncOutput::Notify(condition_variable &condition)
+{
+    // Locking orders the notification after the waiter checked its condition.
+    {
+        lock_guard<mutex> lock(mWaitMutex);
+    }
+    condition.notify_one();
+}
+
+}  // namespace OpenOasis::CommImp
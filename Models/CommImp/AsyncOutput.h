@@ -0,0 +1,107 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  AsyncOutput.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To provide an output delivering values asynchronously.
+ *
+ *    The asynchronous output wraps an output (the adaptee) of a producer component.
+ *    Once started, the producer is updated by a dedicated thread, which pushes the
+ *    values of each new time step into a bounded single-producer/single-consumer
+ *    ring, while the consumer is still working on the previous steps.
+ *
+ *    The consumer pops the buffered steps when requesting values, and waits only if
+ *    the required time is not produced yet. Thus, with a ring of capacity 2, the
+ *    producer computes the step t+1 while the consumer computes the step t.
+ *
+ *    The producer component is driven exclusively by the asynchronous output after
+ *    started, it must not be updated by others (e.g. a scheduler) simultaneously.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Output.h"
+#include "Models/Utils/CommConstants.h"
+#include "Models/Utils/SpscRing.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+/// @brief Output item delivering the values of its adaptee through a bounded ring.
+class AsyncOutput : public Output
+{
+private:
+    // Values of all elements at a time step.
+    struct Frame
+    {
+        std::shared_ptr<ITime> time;
+        std::vector<real>      values;
+    };
+
+    std::shared_ptr<IOutput> mAdaptee;
+
+    Utils::SpscRing<Frame> mRing;
+
+    std::thread        mProducer;
+    std::atomic<bool>  mStopped{false};
+    std::atomic<bool>  mProducerDone{false};
+    std::exception_ptr mProducerError = nullptr;
+
+    // Pushes are made under the mutex, so the consumer waiting on `mPushed` and the
+    // producer waiting on `mPopped` don't miss a notification.
+    std::mutex              mWaitMutex;
+    std::condition_variable mPushed;
+    std::condition_variable mPopped;
+
+public:
+    virtual ~AsyncOutput();
+
+    /// @brief Creates the asynchronous output.
+    ///
+    /// @param id Id of the output.
+    /// @param adaptee Output of the producer component.
+    /// @param capacity Maximum number of time steps buffered ahead of the consumer.
+    AsyncOutput(
+        const std::string &id, const std::shared_ptr<IOutput> &adaptee,
+        int capacity = 2);
+
+    std::shared_ptr<IOutput> GetAdaptee() const;
+
+    /// @brief Starts updating the producer component on a dedicated thread.
+    void Start();
+
+    /// @brief Stops the producer thread, the buffered values are kept.
+    void Stop();
+
+    bool IsStarted() const;
+
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Override methods inherited from `Output`.
+    //
+
+    virtual void Reset() override;
+
+protected:
+    /// @brief Pops the buffered time steps until the latest consumer time is covered,
+    /// instead of updating the producer component.
+    virtual void Update() override;
+
+private:
+    void ProduceLoop();
+
+    bool IsProducerFinished() const;
+
+    void AppendFrame(Frame &frame);
+
+    void Notify(std::condition_variable &condition);
+};
+
+}  // namespace CommImp
+}  // namespace OpenOasis
@@ -0,0 +1,362 @@
+/** ***********************************************************************************
+ *    @File      :  ComponentHost.cpp
+ *    @Brief     :  To host a linkable component in a child process.
+ *
+ ** ***********************************************************************************/
+#include "ComponentHost.h"
+#include "Models/CommImp/LinkableComponent.h"
+#include "Models/CommImp/Quantity.h"
+#include "Models/CommImp/Time.h"
+#include "Models/CommImp/TimeSet.h"
+#include "Models/CommImp/ValueSetDense.h"
+#include "Models/Utils/CommConstants.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
+#include <algorithm>
+#include <cctype>
+#include <thread>
+#include <type_traits>
+
+#ifdef LINUX
+#include <unistd.h>
+#endif
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Utils;
+using namespace std;
+
+
+namespace
+{
+double ToDouble(const any &value)
+{
+    if (value.type() == typeid(double))
+        return any_cast<double>(value);
+    if (value.type() == typeid(float))
+        return any_cast<float>(value);
+    if (value.type() == typeid(int))
+        return any_cast<int>(value);
+
+    throw NotSupportedException("Only numeric values can be shared by processes.");
+}
+
+int GetProcessId()
+{
+#ifdef LINUX
+    return (int)getpid();
+#else
+    return 0;
+#endif
+}
+}  // namespace
+
+
+ComponentHost::ComponentHost(ILinkableComponent *component, UnixSocket channel) :
+    mComponent(component),
+    mChannel(std::move(channel)),
+    mComponentRef(component, [](ILinkableComponent *) {})
+{}
+
+string ComponentHost::GetSegmentName(
+    int processId, const string &compId, const string &itemId, bool isInput)
+{
+    string name = StringHelper::FormatSimple(
+        "oasis_{}_{}_{}_{}", processId, compId, isInput ? "in" : "out", itemId);
+    replace_if(
+        name.begin(),
+        name.end(),
+        [](char c) { return !isalnum((unsigned char)c); },
+        '_');
+
+    return "/" + name;
+}
+
+shared_ptr<SharedMemory>
+ComponentHost::CreateSegment(const string &name, size_t capacity)
+{
+    size_t size   = sizeof(SharedValuesHeader) + capacity * sizeof(double);
+    auto   memory = SharedMemory::Create(name, size);
+
+    auto header = new (memory->GetData()) SharedValuesHeader();
+    header->sequence.store(0);
+    header->time     = 0;
+    header->count    = 0;
+    header->capacity = capacity;
+
+    return memory;
+}
+
+void ComponentHost::CheckCapacity(
+    const SharedValuesHeader &header, size_t count, const string &name)
+{
+    if (count > header.capacity)
+    {
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "{} values exceed the capacity {} of shared buffer [{}].",
+            count,
+            header.capacity,
+            name));
+    }
+}
+
+double ComponentHost::ReadValues(const SharedMemory &memory, Span<const double> &values)
+{
+    auto header = static_cast<const SharedValuesHeader *>(memory.GetData());
+    auto data   = reinterpret_cast<const double *>(header + 1);
+
+    // Seqlock: waits while the values are being written. The segments are written
+    // and read in turn by the command protocol, so the wait is short or none.
+    while (true)
+    {
+        uint64_t sequence = header->sequence.load(memory_order_acquire);
+        if (sequence % 2 == 1)
+        {
+            this_thread::yield();
+            continue;
+        }
+
+        double time = header->time;
+        values      = Span<const double>(data, min(header->count, header->capacity));
+
+        atomic_thread_fence(memory_order_acquire);
+        if (header->sequence.load(memory_order_relaxed) == sequence)
+        {
+            return time;
+        }
+    }
+}
+
+int ComponentHost::Run()
+{
+    string command;
+    while (mChannel.Receive(command))
+    {
+        string reply;
+        try
+        {
+            reply = Execute(command);
+        }
+        catch (const exception &e)
+        {
+            reply = StringHelper::FormatSimple("ERR|{}", e.what());
+        }
+
+        if (!mChannel.Send(reply))
+        {
+            return 1;
+        }
+
+        if (command == "EXIT")
+        {
+            return 0;
+        }
+    }
+
+    // The launcher is gone.
+    return 1;
+}
+
+string ComponentHost::Execute(const string &command)
+{
+    string payload;
+    if (command == "INITIALIZE")
+    {
+        mComponent->Initialize();
+    }
+    else if (command == "VALIDATE")
+    {
+        for (const auto &error : mComponent->Validate())
+        {
+            payload += payload.empty() ? error : "\n" + error;
+        }
+    }
+    else if (command.rfind("PREPARE", 0) == 0)
+    {
+        // The inputs are linked before preparing, as by the launcher.
+        auto inputs = command.size() > 8 ? command.substr(8) : string();
+        auto links  = CreateInputBuffers(inputs);
+
+        mComponent->Prepare();
+        payload = CreateBuffers() + "|" + links;
+        PublishOutputs();
+        RequestInputs();
+    }
+    else if (command == "UPDATE")
+    {
+        ApplyInputs();
+        mComponent->Update();
+        PublishOutputs();
+        RequestInputs();
+    }
+    else if (command == "FINISH")
+    {
+        mComponent->Finish();
+    }
+    else if (command != "EXIT")
+    {
+        throw NotSupportedException(
+            StringHelper::FormatSimple("Unknown command [{}].", command));
+    }
+
+    return StringHelper::FormatSimple(
+        "OK|{}|{}|{}", (int)mComponent->GetStatus(), GetNowTime(), payload);
+}
+
+string ComponentHost::CreateBuffers()
+{
+    mBuffers.clear();
+
+    string payload;
+    for (const auto &output : mComponent->GetOutputs())
+    {
+        const auto &elementSet = output->GetElementSet();
+        size_t      capacity   = elementSet ? max(elementSet->GetElementCount(), 1) : 1;
+
+        string name =
+            GetSegmentName(GetProcessId(), mComponent->GetId(), output->GetId());
+        mBuffers.push_back({output, CreateSegment(name, capacity)});
+        payload += StringHelper::FormatSimple("{}={};", output->GetId(), name);
+    }
+
+    return payload;
+}
+
+string ComponentHost::CreateInputBuffers(const string &inputIds)
+{
+    mInputBuffers.clear();
+
+    string payload;
+    for (const auto &id : StringHelper::Split(inputIds, ';'))
+    {
+        if (id.empty())
+        {
+            continue;
+        }
+
+        const auto &inputs = mComponent->GetInputs();
+        auto        iter   = find_if(inputs.begin(), inputs.end(), [&](const auto &in) {
+            return in->GetId() == id;
+        });
+        if (iter == inputs.end())
+        {
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "Component [{}] has no input [{}].", mComponent->GetId(), id));
+        }
+
+        const auto &input    = *iter;
+        const auto &valueDef = input->GetValueDefinition();
+        auto        quantity = dynamic_pointer_cast<IQuantity>(valueDef);
+        if (!quantity)
+        {
+            throw NotSupportedException(StringHelper::FormatSimple(
+                "Input [{}] without a quantity can't be linked remotely.", id));
+        }
+
+        // The provider is driven by the launcher, it only holds the values written.
+        auto provider = make_shared<Output>(id, mComponentRef);
+        provider->SetValues(make_shared<ValueSetDense<real>>(quantity));
+        provider->SetTimeSet(make_shared<TimeSet>());
+        provider->SetElementSet(input->GetElementSet());
+        provider->SetComponentUpdateDisabled(true);
+        provider->AddConsumer(input);
+
+        const auto &elementSet = input->GetElementSet();
+        size_t      capacity   = elementSet ? max(elementSet->GetElementCount(), 1) : 1;
+
+        string name = GetSegmentName(GetProcessId(), mComponent->GetId(), id, true);
+        mInputBuffers.push_back({input, provider, CreateSegment(name, capacity)});
+        payload += StringHelper::FormatSimple("{}={};", id, name);
+    }
+
+    return payload;
+}
+
+void ComponentHost::PublishOutputs()
+{
+    vector<double> converted;
+    for (const auto &buffer : mBuffers)
+    {
+        const auto &values = buffer.output->GetValues();
+        int         times  = values ? values->GetIndexCount({0}) : 0;
+        if (times == 0)
+        {
+            continue;
+        }
+
+        // Rows of dense value sets are copied into the segment directly, others are
+        // converted from their boxed values.
+        if (auto dense = dynamic_pointer_cast<ValueSetDense<real>>(values))
+        {
+            auto row = dense->GetElementValuesForTimeSpan(times - 1);
+            WriteValues<real>(*buffer.memory, GetNowTime(), row);
+            continue;
+        }
+
+        const auto &boxed = values->GetElementValuesForTime(times - 1);
+        converted.resize(boxed.size());
+        transform(boxed.begin(), boxed.end(), converted.begin(), ToDouble);
+        WriteValues(*buffer.memory, GetNowTime(), Span<const double>(converted));
+    }
+}
+
+void ComponentHost::RequestInputs()
+{
+    for (const auto &buffer : mInputBuffers)
+    {
+        // The input requests the values at the end of its time set.
+        double      time  = GetNowTime();
+        const auto &times = buffer.input->GetTimeSet();
+        if (times && !times->GetTimes().empty())
+        {
+            time = times->GetTimes().back()->GetTimeStamp();
+        }
+
+        WriteValues(*buffer.memory, time, Span<const double>());
+    }
+}
+
+void ComponentHost::ApplyInputs()
+{
+    for (const auto &buffer : mInputBuffers)
+    {
+        Span<const double> values;
+        double             time = ReadValues(*buffer.memory, values);
+
+        // The values replace those of the last update, and none are provided if
+        // the launcher has none.
+        auto dense =
+            dynamic_pointer_cast<ValueSetDense<real>>(buffer.provider->GetValues());
+        auto times = dynamic_pointer_cast<TimeSet>(buffer.provider->GetTimeSet());
+        dense->RemoveTimesFrom(0);
+        times->RemoveTimeRange(0, times->GetCount());
+        if (values.empty())
+        {
+            continue;
+        }
+
+        if constexpr (is_same_v<real, double>)
+        {
+            dense->AddElementValuesForTime(values);
+        }
+        else
+        {
+            dense->AddElementValuesForTime(vector<real>(values.begin(), values.end()));
+        }
+        times->AddTime(make_shared<Time>(time));
+    }
+}
+
+double ComponentHost::GetNowTime() const
+{
+    auto comp = dynamic_cast<LinkableComponent *>(mComponent);
+    if (!comp || !comp->GetNowTime())
+    {
+        return 0;
+    }
+
+    return comp->GetNowTime()->GetTimeStamp();
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
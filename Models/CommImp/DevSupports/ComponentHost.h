@@ -0,0 +1,159 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  ComponentHost.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To host a linkable component in a child process.
+ *
+ *    The host serves the commands from the launcher (see `RemoteComponent`) over a
+ *    Unix socket, one command per message:
+ *
+ *        INITIALIZE | VALIDATE | PREPARE|{input ids} | UPDATE | FINISH | EXIT
+ *
+ *    and replies "OK|{status}|{now time}|{payload}" or "ERR|{message}".
+ *
+ *    After preparing, the values of each output are published into a POSIX shared
+ *    memory segment after every update, laid out as `SharedValuesHeader` followed
+ *    by `capacity` doubles. The inputs listed by PREPARE, as "{input id};...", are
+ *    linked to the launcher the same way: after each command the host writes the
+ *    time requested by the input into its segment, the launcher writes the values
+ *    at that time before UPDATE, and the host provides them to the input before
+ *    updating. The payload
+ *    of PREPARE lists the segments as "{output id}={segment name};...|{input id}=
+ *    {segment name};...". Both sides map the segments and access the values in
+ *    place, without passing them through the socket.
+ *
+ *    The segments are only written while serving a command (by the host) or between
+ *    commands (by the launcher), so a reader never races a writer.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Models/CommImp/Output.h"
+#include "Models/Inc/ILinkableComponent.h"
+#include "Models/Utils/SharedMemory.h"
+#include "Models/Utils/Span.h"
+#include "Models/Utils/UnixSocket.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+namespace DevSupports
+{
+/// @brief Header of the values of an exchange item in a shared memory segment.
+struct SharedValuesHeader
+{
+    std::atomic<std::uint64_t> sequence;  // Odd while the values are being written.
+    double                     time;      // Time stamp of the values.
+    std::uint64_t              count;     // Number of values.
+    std::uint64_t              capacity;  // Maximum number of values.
+};
+
+static_assert(
+    std::atomic<std::uint64_t>::is_always_lock_free,
+    "Lock-free atomics are required for sharing between processes.");
+
+
+/// @brief Host serving a linkable component in a child process.
+class ComponentHost
+{
+private:
+    struct OutputBuffer
+    {
+        std::shared_ptr<IOutput>             output;
+        std::shared_ptr<Utils::SharedMemory> memory;
+    };
+
+    // Values of an input written by the launcher, provided to the input by an
+    // output standing in for the providers in the launcher.
+    struct InputBuffer
+    {
+        std::shared_ptr<IInput>              input;
+        std::shared_ptr<Output>              provider;
+        std::shared_ptr<Utils::SharedMemory> memory;
+    };
+
+    ILinkableComponent       *mComponent;
+    Utils::UnixSocket         mChannel;
+    std::vector<OutputBuffer> mBuffers;
+    std::vector<InputBuffer>  mInputBuffers;
+
+    // Non-owning reference to the component, required by the exchange items.
+    std::shared_ptr<ILinkableComponent> mComponentRef;
+
+public:
+    ComponentHost(ILinkableComponent *component, Utils::UnixSocket channel);
+
+    /// @brief Serves commands until "EXIT" received or the channel closed.
+    /// @return The exit code of the process.
+    int Run();
+
+    /// @brief Gets the name of the segment holding the values of an exchange item.
+    ///
+    /// @param processId Id of the hosting process.
+    /// @param compId Component id.
+    /// @param itemId Id of the output, or of the input if @p isInput.
+    static std::string GetSegmentName(
+        int processId, const std::string &compId, const std::string &itemId,
+        bool isInput = false);
+
+    /// @brief Creates a segment holding @p capacity values.
+    static std::shared_ptr<Utils::SharedMemory>
+    CreateSegment(const std::string &name, std::size_t capacity);
+
+    /// @brief Writes the values at the time stamp into the segment.
+    /// @throw IllegalStateException If the values exceed the segment.
+    template <typename T>
+    static void
+    WriteValues(Utils::SharedMemory &memory, double time, Utils::Span<const T> values)
+    {
+        auto header = static_cast<SharedValuesHeader *>(memory.GetData());
+        CheckCapacity(*header, values.size(), memory.GetName());
+
+        // Seqlock: the sequence is odd while the values are being written.
+        header->sequence.fetch_add(1, std::memory_order_acq_rel);
+        std::copy(values.begin(), values.end(), reinterpret_cast<double *>(header + 1));
+        header->count = values.size();
+        header->time  = time;
+        header->sequence.fetch_add(1, std::memory_order_release);
+    }
+
+    /// @brief Views the values in the segment, valid until the writer writes again.
+    ///
+    /// @param memory Segment of the values.
+    /// @param values View of the values, empty if never written.
+    /// @return The time stamp of the values.
+    /// @throw IllegalStateException If the writer stopped while writing.
+    static double
+    ReadValues(const Utils::SharedMemory &memory, Utils::Span<const double> &values);
+
+private:
+    std::string Execute(const std::string &command);
+
+    std::string CreateBuffers();
+
+    /// @brief Links the inputs to the values written by the launcher.
+    std::string CreateInputBuffers(const std::string &inputIds);
+
+    void PublishOutputs();
+
+    /// @brief Writes the times requested by the inputs, with no values.
+    void RequestInputs();
+
+    /// @brief Provides the values written by the launcher to the inputs.
+    void ApplyInputs();
+
+    static void CheckCapacity(
+        const SharedValuesHeader &header, std::size_t count, const std::string &name);
+
+    double GetNowTime() const;
+};
+
+}  // namespace DevSupports
+}  // namespace CommImp
+}  // namespace OpenOasis
@@ -0,0 +1,461 @@
+/** ***********************************************************************************
+ *    @File      :  ComponentScheduler.cpp
+ *    @Brief     :  To schedule linked components by their dependencies.
+ *
+ ** ***********************************************************************************/
+#include "ComponentScheduler.h"
+#include "ExtensionMethods.h"
+#include "RemoteComponent.h"
+#include "Models/CommImp/LinkableComponent.h"
+#include "Models/Utils/ThreadPool.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
+#include <algorithm>
+#include <exception>
+#include <limits>
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Utils;
+using namespace std;
+
+
+ComponentScheduler::ComponentScheduler(int numThreads) : mNumThreads(numThreads)
+{}
+
+void ComponentScheduler::AddComponent(const string &compId, ILinkableComponent *comp)
+{
+    if (!comp)
+    {
+        throw IllegalArgumentException(
+            StringHelper::FormatSimple("Component [{}] is null.", compId));
+    }
+
+    if (mComps.count(compId) == 0)
+    {
+        mCompIds.push_back(compId);
+    }
+    mComps[compId] = comp;
+}
+
+void ComponentScheduler::AddDependency(const string &consumer, const string &provider)
+{
+    if (consumer == provider)
+    {
+        return;
+    }
+
+    mProviders[consumer].insert(provider);
+}
+
+void ComponentScheduler::BuildUnits()
+{
+    mUnits.clear();
+
+    const int                  compNum = (int)mCompIds.size();
+    unordered_map<string, int> compIdx;
+    vector<vector<int>>        consumers(compNum);
+    for (int i = 0; i < compNum; i++)
+    {
+        compIdx[mCompIds[i]] = i;
+    }
+
+    for (const auto &pair : mProviders)
+    {
+        if (compIdx.count(pair.first) == 0)
+        {
+            continue;
+        }
+
+        for (const auto &provider : pair.second)
+        {
+            if (compIdx.count(provider) == 0)
+            {
+                continue;
+            }
+            consumers[compIdx[provider]].push_back(compIdx[pair.first]);
+        }
+    }
+
+    // Components reachable from each other are coupled in a loop.
+    vector<vector<bool>> reachable(compNum, vector<bool>(compNum, false));
+    for (int i = 0; i < compNum; i++)
+    {
+        vector<int> stack = {i};
+        while (!stack.empty())
+        {
+            int curr = stack.back();
+            stack.pop_back();
+
+            for (int next : consumers[curr])
+            {
+                if (!reachable[i][next])
+                {
+                    reachable[i][next] = true;
+                    stack.push_back(next);
+                }
+            }
+        }
+    }
+
+    vector<int> compUnit(compNum, -1);
+    for (int i = 0; i < compNum; i++)
+    {
+        if (compUnit[i] >= 0)
+        {
+            continue;
+        }
+
+        Unit unit;
+        for (int j = i; j < compNum; j++)
+        {
+            if (j == i || (reachable[i][j] && reachable[j][i]))
+            {
+                compUnit[j] = (int)mUnits.size();
+                unit.compIds.push_back(mCompIds[j]);
+            }
+        }
+        mUnits.push_back(unit);
+    }
+
+    for (int i = 0; i < compNum; i++)
+    {
+        for (int j : consumers[i])
+        {
+            int src = compUnit[i], tar = compUnit[j];
+            if (src != tar)
+            {
+                mUnits[src].consumers.insert(tar);
+                mUnits[tar].providers.insert(src);
+            }
+        }
+    }
+}
+
+vector<vector<string>> ComponentScheduler::GetStages()
+{
+    vector<vector<string>> stages;
+    for (const auto &unitStage : GetUnitStages())
+    {
+        vector<string> stage;
+        for (const auto &unit : unitStage)
+        {
+            stage.insert(stage.end(), unit.begin(), unit.end());
+        }
+        stages.push_back(stage);
+    }
+
+    return stages;
+}
+
+vector<vector<vector<string>>> ComponentScheduler::GetUnitStages()
+{
+    BuildUnits();
+
+    const int   unitNum = (int)mUnits.size();
+    vector<int> levels(unitNum, -1);
+
+    int maxLevel = -1;
+    for (int count = 0; count < unitNum;)
+    {
+        for (int i = 0; i < unitNum; i++)
+        {
+            if (levels[i] >= 0)
+            {
+                continue;
+            }
+
+            int  level = 0;
+            bool ready = all_of(
+                mUnits[i].providers.begin(),
+                mUnits[i].providers.end(),
+                [&](int p) {
+                    level = max(level, levels[p] + 1);
+                    return levels[p] >= 0;
+                });
+
+            if (ready)
+            {
+                levels[i] = level;
+                maxLevel  = max(maxLevel, level);
+                count++;
+            }
+        }
+    }
+
+    vector<vector<vector<string>>> stages(maxLevel + 1);
+    for (int i = 0; i < unitNum; i++)
+    {
+        stages[levels[i]].push_back(mUnits[i].compIds);
+    }
+
+    return stages;
+}
+
+unordered_map<string, int> ComponentScheduler::Run()
+{
+    BuildUnits();
+
+    for (int i = 0; i < (int)mUnits.size(); i++)
+    {
+        auto &unit    = mUnits[i];
+        unit.finished = all_of(unit.compIds.begin(), unit.compIds.end(), [&](auto &id) {
+            return IsComponentFinished(id);
+        });
+
+        // Components compared by steps advance one per step, the others advance by
+        // the time steps known after their first steps.
+        unit.lastStep = GetComponentTime(unit.compIds.front(), 1)
+                        - GetComponentTime(unit.compIds.front(), 0);
+    }
+
+    mutex              mtx;
+    condition_variable cond;
+    exception_ptr      error  = nullptr;
+    int                active = 0;
+
+    // The pool must be destroyed before the synchronization objects it refers to.
+    ThreadPool pool(mNumThreads);
+
+    unique_lock<mutex> lock(mtx);
+    while (true)
+    {
+        for (int i = 0; i < (int)mUnits.size() && !error; i++)
+        {
+            set<int> writes, reads;
+            if (!IsUnitReady(i, writes, reads))
+            {
+                continue;
+            }
+
+            auto &unit     = mUnits[i];
+            unit.writes    = move(writes);
+            unit.reads     = move(reads);
+            unit.required  = GetRequiredTime(i);
+            unit.startTime = GetUnitTime(i);
+            unit.running   = true;
+            active++;
+
+            pool.Submit([&, i] {
+                exception_ptr ex = nullptr;
+                try
+                {
+                    UpdateUnit(i);
+                }
+                catch (...)
+                {
+                    ex = current_exception();
+                }
+
+                lock_guard<mutex> guard(mtx);
+                auto             &unit = mUnits[i];
+
+                unit.running = false;
+                unit.steps++;
+                unit.finished =
+                    all_of(unit.compIds.begin(), unit.compIds.end(), [&](auto &id) {
+                        return IsComponentFinished(id);
+                    });
+
+                double time = GetUnitTime(i);
+                if (time > unit.startTime)
+                {
+                    unit.lastStep = time - unit.startTime;
+                }
+
+                if (ex && !error)
+                {
+                    error = ex;
+                }
+
+                active--;
+                cond.notify_all();
+            });
+        }
+
+        if (active == 0)
+        {
+            bool finished = all_of(mUnits.begin(), mUnits.end(), [](const Unit &unit) {
+                return unit.finished;
+            });
+
+            if (error || finished)
+            {
+                break;
+            }
+
+            throw IllegalStateException(
+                "Component scheduler stalled, no component is ready to update.");
+        }
+
+        cond.wait(lock);
+    }
+
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+
+    unordered_map<string, int> steps;
+    for (const auto &unit : mUnits)
+    {
+        for (const auto &compId : unit.compIds)
+        {
+            steps[compId] = unit.steps;
+        }
+    }
+
+    return steps;
+}
+
+bool ComponentScheduler::IsUnitReady(
+    int unitIdx, set<int> &writes, set<int> &reads) const
+{
+    const auto &unit = mUnits[unitIdx];
+    if (unit.running || unit.finished)
+    {
+        return false;
+    }
+
+    // Waits for the providers reaching the end of the next step, which are read and
+    // not running.
+    double required = GetRequiredTime(unitIdx);
+    for (int idx : unit.providers)
+    {
+        const auto &provider = mUnits[idx];
+        if (provider.running || (!provider.finished && GetUnitTime(idx) < required))
+        {
+            return false;
+        }
+    }
+
+    // Units updating the same components, or reading the components updated by the
+    // other, can not be updated simultaneously.
+    CollectTouchedUnits(unitIdx, writes, reads);
+
+    auto intersects = [](const set<int> &a, const set<int> &b) {
+        return any_of(a.begin(), a.end(), [&](int idx) { return b.count(idx) > 0; });
+    };
+
+    for (const auto &other : mUnits)
+    {
+        if (other.running
+            && (intersects(writes, other.writes) || intersects(writes, other.reads)
+                || intersects(reads, other.writes)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ComponentScheduler::CollectTouchedUnits(
+    int unitIdx, set<int> &writes, set<int> &reads) const
+{
+    writes.insert(unitIdx);
+    for (int idx : mUnits[unitIdx].providers)
+    {
+        reads.insert(idx);
+
+        // Pulling a provider behind the latest time requested by its consumers updates
+        // it, which pulls its own providers. So may the provider not stepped yet, whose
+        // outputs may not cover its start time. A running one conflicts anyway.
+        const auto &provider = mUnits[idx];
+        if (!provider.finished && !provider.running && writes.count(idx) == 0
+            && (provider.steps == 0 || GetUnitTime(idx) < GetDemandedTime(idx)))
+        {
+            CollectTouchedUnits(idx, writes, reads);
+        }
+    }
+}
+
+double ComponentScheduler::GetRequiredTime(int unitIdx) const
+{
+    const auto &unit     = mUnits[unitIdx];
+    double      required = GetUnitTime(unitIdx) + unit.lastStep;
+
+    // The times requested by the inputs, which are pulled as they are.
+    for (const auto &compId : unit.compIds)
+    {
+        for (const auto &input : mComps.at(compId)->GetInputs())
+        {
+            if (input->GetProviders().empty() || !input->GetTimeSet())
+            {
+                continue;
+            }
+
+            for (const auto &time : input->GetTimeSet()->GetTimes())
+            {
+                required = max(required, ExtensionMethods::EndTimeStamp(time));
+            }
+        }
+    }
+
+    return required;
+}
+
+double ComponentScheduler::GetDemandedTime(int unitIdx) const
+{
+    double demanded = numeric_limits<double>::lowest();
+    for (int idx : mUnits[unitIdx].consumers)
+    {
+        const auto &consumer = mUnits[idx];
+        if (!consumer.finished)
+        {
+            // The running consumers may change their requests, the ones when started
+            // are taken.
+            double required =
+                consumer.running ? consumer.required : GetRequiredTime(idx);
+            demanded = max(demanded, required);
+        }
+    }
+
+    return demanded;
+}
+
+double ComponentScheduler::GetUnitTime(int unitIdx) const
+{
+    const auto &unit = mUnits[unitIdx];
+    return GetComponentTime(unit.compIds.front(), unit.steps);
+}
+
+bool ComponentScheduler::IsComponentFinished(const string &compId) const
+{
+    auto status = mComps.at(compId)->GetStatus();
+
+    return status == LinkableComponentStatus::Done
+           || status == LinkableComponentStatus::Failed
+           || status == LinkableComponentStatus::Finished;
+}
+
+double ComponentScheduler::GetComponentTime(const string &compId, int steps) const
+{
+    if (auto remote = dynamic_cast<RemoteComponent *>(mComps.at(compId)))
+    {
+        return remote->GetNowTime();
+    }
+
+    // Other components not derived from `LinkableComponent` are compared by steps.
+    auto comp = dynamic_cast<LinkableComponent *>(mComps.at(compId));
+    if (!comp || !comp->GetNowTime())
+    {
+        return steps;
+    }
+
+    return comp->GetNowTime()->GetTimeStamp();
+}
+
+void ComponentScheduler::UpdateUnit(int unitIdx)
+{
+    for (const auto &compId : mUnits[unitIdx].compIds)
+    {
+        if (!IsComponentFinished(compId))
+        {
+            mComps.at(compId)->Update();
+        }
+    }
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
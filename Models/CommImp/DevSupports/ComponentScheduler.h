@@ -0,0 +1,121 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  ComponentScheduler.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To schedule linked components by their dependencies.
+ *
+ *    Components and their provider-consumer relations (from the `links/pipelines`
+ *    configuration) form a directed graph. Components coupled in a loop are merged
+ *    into one scheduling unit, which makes the graph a DAG of units.
+ *
+ *    A unit is updated one time step per task. Units only wait at exchange-item
+ *    boundaries: a consumer waits until its providers have reached the end of its
+ *    next step, i.e., the latest time requested by its inputs, or its time advanced
+ *    by its last step, so that pulling the inputs reads the data available without
+ *    updating the providers. A provider not caught up by all its consumers may still
+ *    be updated by a pull, cascading upstream, thus the unit pulling it is not run
+ *    while any unit updating or reading the same components is running. Consumers
+ *    of the providers caught up, and independent units, run concurrently.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Models/Inc/ILinkableComponent.h"
+#include <unordered_map>
+#include <set>
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+namespace DevSupports
+{
+/// @brief Dependency-aware scheduler running linked components concurrently.
+class ComponentScheduler
+{
+private:
+    // Scheduling unit, i.e., a single component or a loop-coupled component group.
+    struct Unit
+    {
+        std::vector<std::string> compIds;
+        std::set<int>            providers;
+        std::set<int>            consumers;
+
+        // Units updated and read by the running task, including the providers it may
+        // update by pulling, and the time required of its providers.
+        std::set<int> writes;
+        std::set<int> reads;
+        double        required = 0;
+
+        double startTime = 0;
+        double lastStep  = 0;
+
+        bool running  = false;
+        bool finished = false;
+        int  steps    = 0;
+    };
+
+    int mNumThreads = 0;
+
+    std::vector<std::string>                                mCompIds;
+    std::unordered_map<std::string, ILinkableComponent *>   mComps;
+    std::unordered_map<std::string, std::set<std::string>> mProviders;
+
+    std::vector<Unit> mUnits;
+
+public:
+    /// @brief Creates the scheduler.
+    ///
+    /// @param numThreads Number of worker threads, the number of hardware threads
+    /// is used if not positive.
+    ComponentScheduler(int numThreads = 0);
+
+    void AddComponent(const std::string &compId, ILinkableComponent *comp);
+
+    /// @brief Declares that `consumer` takes inputs from `provider`.
+    void AddDependency(const std::string &consumer, const std::string &provider);
+
+    /// @brief Gets the scheduling stages in topological order, components in the
+    /// same stage are independent with each other.
+    std::vector<std::vector<std::string>> GetStages();
+
+    /// @brief Gets the scheduling stages in topological order, where each stage
+    /// consists of scheduling units, and each unit consists of components coupled
+    /// in a loop (or a single component).
+    std::vector<std::vector<std::vector<std::string>>> GetUnitStages();
+
+    /// @brief Updates all prepared components until they are done or failed.
+    ///
+    /// @return The number of time steps updated of each component.
+    std::unordered_map<std::string, int> Run();
+
+private:
+    void BuildUnits();
+
+    bool IsUnitReady(int unitIdx, std::set<int> &writes, std::set<int> &reads) const;
+
+    /// @brief Collects the units updated and read by updating the unit, including
+    /// the providers not caught up with their consumers, which its pulls update.
+    void
+    CollectTouchedUnits(int unitIdx, std::set<int> &writes, std::set<int> &reads) const;
+
+    /// @brief Gets the time the providers of the unit must reach before it's updated.
+    double GetRequiredTime(int unitIdx) const;
+
+    /// @brief Gets the latest time required of the unit by its consumers.
+    double GetDemandedTime(int unitIdx) const;
+
+    double GetUnitTime(int unitIdx) const;
+
+    bool IsComponentFinished(const std::string &compId) const;
+
+    double GetComponentTime(const std::string &compId, int steps) const;
+
+    void UpdateUnit(int unitIdx);
+};
+
+}  // namespace DevSupports
+}  // namespace CommImp
+}  // namespace OpenOasis
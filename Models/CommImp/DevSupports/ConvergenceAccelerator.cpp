@@ -0,0 +1,246 @@
+/** ***********************************************************************************
+ *    @File      :  ConvergenceAccelerator.cpp
+ *    @Brief     :  To accelerate the convergence of fixed-point coupling iterations.
+ *
+ ** ***********************************************************************************/
+#include "ConvergenceAccelerator.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
+#include <cmath>
+#include <numeric>
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Utils;
+using namespace std;
+
+
+ConvergenceAccelerator::ConvergenceAccelerator(
+    Method method, double relaxation, int historyDepth) :
+    mMethod(method),
+    mInitRelaxation(relaxation), mRelaxation(relaxation), mHistoryDepth(historyDepth)
+{
+    if (relaxation <= 0)
+    {
+        throw ArgumentOutOfRangeException(StringHelper::FormatSimple(
+            "Relaxation [{}] of convergence accelerator must be positive.",
+            relaxation));
+    }
+
+    if (historyDepth < 1)
+    {
+        throw ArgumentOutOfRangeException(StringHelper::FormatSimple(
+            "History depth [{}] of convergence accelerator must be at least 1.",
+            historyDepth));
+    }
+}
+
+ConvergenceAccelerator::Method ConvergenceAccelerator::ParseMethod(const string &method)
+{
+    string name = StringHelper::ToLower(method);
+    if (name == "constant")
+    {
+        return Method::Constant;
+    }
+    else if (name == "aitken")
+    {
+        return Method::Aitken;
+    }
+    else if (name == "anderson")
+    {
+        return Method::Anderson;
+    }
+
+    throw NotSupportedException(StringHelper::FormatSimple(
+        "Convergence acceleration method [{}] is not supported.", method));
+}
+
+ConvergenceAccelerator::Method ConvergenceAccelerator::GetMethod() const
+{
+    return mMethod;
+}
+
+double ConvergenceAccelerator::GetRelaxation() const
+{
+    return mRelaxation;
+}
+
+void ConvergenceAccelerator::Reset()
+{
+    mRelaxation = mInitRelaxation;
+
+    mLastIterate.clear();
+    mLastResidual.clear();
+    mIterateDiffs.clear();
+    mResidualDiffs.clear();
+}
+
+vector<real> ConvergenceAccelerator::Accelerate(
+    const vector<real> &iterate, const vector<real> &result)
+{
+    if (iterate.size() != result.size())
+    {
+        throw IllegalArgumentException(StringHelper::FormatSimple(
+            "Iterate size [{}] mismatches the result size [{}].",
+            iterate.size(),
+            result.size()));
+    }
+
+    if (!mLastIterate.empty() && mLastIterate.size() != iterate.size())
+    {
+        Reset();
+    }
+
+    size_t         n = iterate.size();
+    vector<double> x(iterate.begin(), iterate.end());
+    vector<double> r(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        r[i] = (double)result[i] - x[i];
+    }
+
+    vector<double> next(n);
+    switch (mMethod)
+    {
+    case Method::Aitken:
+        UpdateAitkenRelaxation(r);
+        [[fallthrough]];
+    case Method::Constant:
+        for (size_t i = 0; i < n; i++)
+        {
+            next[i] = x[i] + mRelaxation * r[i];
+        }
+        break;
+    case Method::Anderson:
+        if (!mLastIterate.empty())
+        {
+            vector<double> dx(n), dr(n);
+            for (size_t i = 0; i < n; i++)
+            {
+                dx[i] = x[i] - mLastIterate[i];
+                dr[i] = r[i] - mLastResidual[i];
+            }
+
+            mIterateDiffs.push_back(std::move(dx));
+            mResidualDiffs.push_back(std::move(dr));
+            if ((int)mResidualDiffs.size() > mHistoryDepth)
+            {
+                mIterateDiffs.pop_front();
+                mResidualDiffs.pop_front();
+            }
+        }
+        next = MixAnderson(x, r);
+        break;
+    }
+
+    mLastIterate  = std::move(x);
+    mLastResidual = std::move(r);
+
+    return vector<real>(next.begin(), next.end());
+}
+
+void ConvergenceAccelerator::UpdateAitkenRelaxation(const vector<double> &residual)
+{
+    if (mLastResidual.empty())
+    {
+        return;
+    }
+
+    double numerator = 0, denominator = 0;
+    for (size_t i = 0; i < residual.size(); i++)
+    {
+        double diff  = residual[i] - mLastResidual[i];
+        numerator   += mLastResidual[i] * diff;
+        denominator += diff * diff;
+    }
+
+    // Keeps the last coefficient if residuals stagnate.
+    double relaxation = -mRelaxation * numerator / denominator;
+    if (denominator > 0 && isfinite(relaxation) && relaxation != 0)
+    {
+        mRelaxation = relaxation;
+    }
+}
+
+vector<double> ConvergenceAccelerator::MixAnderson(
+    const vector<double> &iterate, const vector<double> &residual) const
+{
+    size_t n = iterate.size();
+    size_t m = mResidualDiffs.size();
+
+    vector<double> next(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        next[i] = iterate[i] + mInitRelaxation * residual[i];
+    }
+
+    if (m == 0)
+    {
+        return next;
+    }
+
+    // Least squares by the QR decomposition of dR (modified Gram-Schmidt), where
+    // nearly dependent columns are dropped, newest columns first kept.
+    vector<vector<double>> q;
+    vector<vector<double>> r;  // Upper triangle, stored by column.
+    vector<size_t>         cols;
+    for (size_t j = m; j-- > 0;)
+    {
+        vector<double> v     = mResidualDiffs[j];
+        double         vNorm = sqrt(inner_product(v.begin(), v.end(), v.begin(), 0.));
+
+        vector<double> rj(q.size() + 1);
+        for (size_t k = 0; k < q.size(); k++)
+        {
+            rj[k] = inner_product(q[k].begin(), q[k].end(), v.begin(), 0.);
+            for (size_t i = 0; i < n; i++)
+            {
+                v[i] -= rj[k] * q[k][i];
+            }
+        }
+
+        double norm = sqrt(inner_product(v.begin(), v.end(), v.begin(), 0.));
+        if (norm <= 1.e-10 * vNorm || norm == 0)
+        {
+            continue;
+        }
+
+        for (auto &vi : v)
+        {
+            vi /= norm;
+        }
+        rj.back() = norm;
+
+        q.push_back(std::move(v));
+        r.push_back(std::move(rj));
+        cols.push_back(j);
+    }
+
+    // Solves R * g = Q^T * r by back substitution.
+    size_t         k = q.size();
+    vector<double> gamma(k);
+    for (size_t j = k; j-- > 0;)
+    {
+        double sum = inner_product(q[j].begin(), q[j].end(), residual.begin(), 0.);
+        for (size_t l = j + 1; l < k; l++)
+        {
+            sum -= r[l][j] * gamma[l];
+        }
+        gamma[j] = sum / r[j][j];
+    }
+
+    for (size_t j = 0; j < k; j++)
+    {
+        const auto &dx = mIterateDiffs[cols[j]];
+        const auto &dr = mResidualDiffs[cols[j]];
+        for (size_t i = 0; i < n; i++)
+        {
+            next[i] -= gamma[j] * (dx[i] + mInitRelaxation * dr[i]);
+        }
+    }
+
+    return next;
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
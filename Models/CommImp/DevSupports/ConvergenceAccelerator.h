@@ -0,0 +1,97 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  ConvergenceAccelerator.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To accelerate the convergence of fixed-point coupling iterations.
+ *
+ *    An iterative coupling loop solves x = G(x), where x is the vector of exchanged
+ *    values and G is one sweep of the coupled components. Given the current iterate
+ *    x_k and the sweep result G(x_k), the accelerator proposes the next iterate:
+ *
+ *    - constant: x_k+1 = x_k + w * r_k, with the residual r_k = G(x_k) - x_k.
+ *    - aitken:   as constant, but w is updated dynamically (Irons-Tuck) by
+ *                w_k = -w_k-1 * r_k-1 . (r_k - r_k-1) / |r_k - r_k-1|^2.
+ *    - anderson: quasi-Newton mixing of the last m residuals (Walker-Ni form),
+ *                x_k+1 = x_k - dX * g + w * (r_k - dR * g), where g minimizes
+ *                |r_k - dR * g| and dX, dR are differences of past iterates and
+ *                residuals.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Models/Utils/CommConstants.h"
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+namespace DevSupports
+{
+using Utils::real;
+
+/// @brief Convergence accelerator for fixed-point iterations on exchanged values.
+class ConvergenceAccelerator
+{
+public:
+    enum class Method
+    {
+        Constant,
+        Aitken,
+        Anderson
+    };
+
+private:
+    Method mMethod;
+    double mInitRelaxation;  // Initial (or constant) relaxation coefficient.
+    double mRelaxation;      // Relaxation coefficient of the last step.
+    int    mHistoryDepth;    // Maximum residuals kept by the Anderson mixing.
+
+    std::vector<double> mLastIterate;
+    std::vector<double> mLastResidual;
+
+    std::deque<std::vector<double>> mIterateDiffs;
+    std::deque<std::vector<double>> mResidualDiffs;
+
+public:
+    /// @brief Creates the accelerator.
+    ///
+    /// @param method Acceleration method.
+    /// @param relaxation Relaxation coefficient of the first step (Aitken), of all
+    /// steps (constant), or the mixing parameter (Anderson).
+    /// @param historyDepth Number of past residuals used by the Anderson mixing.
+    ConvergenceAccelerator(
+        Method method = Method::Aitken, double relaxation = 0.25, int historyDepth = 5);
+
+    /// @brief Parses the method name, i.e., "constant", "aitken" or "anderson".
+    static Method ParseMethod(const std::string &method);
+
+    Method GetMethod() const;
+
+    double GetRelaxation() const;
+
+    /// @brief Forgets the history, to be called at the start of every coupling step.
+    void Reset();
+
+    /// @brief Proposes the next iterate.
+    ///
+    /// @param iterate The current iterate x_k.
+    /// @param result The sweep result G(x_k).
+    /// @return The next iterate x_k+1.
+    std::vector<real>
+    Accelerate(const std::vector<real> &iterate, const std::vector<real> &result);
+
+private:
+    void UpdateAitkenRelaxation(const std::vector<double> &residual);
+
+    std::vector<double> MixAnderson(
+        const std::vector<double> &iterate, const std::vector<double> &residual) const;
+};
+
+}  // namespace DevSupports
+}  // namespace CommImp
+}  // namespace OpenOasis
@@ -0,0 +1,199 @@
+/** ***********************************************************************************
+ *    @File      :  CouplingStepController.cpp
+ *    @Brief     :  To adapt the coupling interval by the change of exchanged values.
+ *
+ ** ***********************************************************************************/
+#include "CouplingStepController.h"
+#include "Models/CommImp/ValueSetDense.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Utils;
+using namespace std;
+
+
+namespace
+{
+// Tolerance of time stamps (in days) to tell whether an exchange is due.
+const double TIME_EPSILON = 1.e-10;
+
+bool ToDouble(const any &value, double &result)
+{
+    if (value.type() == typeid(double))
+    {
+        result = any_cast<double>(value);
+    }
+    else if (value.type() == typeid(float))
+    {
+        result = any_cast<float>(value);
+    }
+    else if (value.type() == typeid(int))
+    {
+        result = any_cast<int>(value);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+}  // namespace
+
+
+CouplingStepController::CouplingStepController(
+    double minInterval, double maxInterval, double tolerance, double growFactor,
+    double shrinkFactor) :
+    mMinInterval(minInterval),
+    mMaxInterval(maxInterval), mTolerance(tolerance), mGrowFactor(growFactor),
+    mShrinkFactor(shrinkFactor)
+{
+    if (minInterval <= 0 || maxInterval < minInterval)
+    {
+        throw ArgumentOutOfRangeException(StringHelper::FormatSimple(
+            "Invalid coupling interval bounds [{}, {}].", minInterval, maxInterval));
+    }
+
+    if (tolerance <= 0)
+    {
+        throw ArgumentOutOfRangeException(StringHelper::FormatSimple(
+            "Coupling tolerance [{}] must be positive.", tolerance));
+    }
+
+    if (growFactor < 1 || shrinkFactor <= 0 || shrinkFactor > 1)
+    {
+        throw ArgumentOutOfRangeException(StringHelper::FormatSimple(
+            "Invalid coupling interval factors, grow [{}] and shrink [{}].",
+            growFactor,
+            shrinkFactor));
+    }
+
+    Reset();
+}
+
+bool CouplingStepController::IsExchangeDue(double time)
+{
+    if (time + TIME_EPSILON >= mNextExchangeTime)
+    {
+        return true;
+    }
+
+    mSkippedCount++;
+    return false;
+}
+
+void CouplingStepController::Observe(
+    const string &inputId, const shared_ptr<IValueSet> &values)
+{
+    vector<double> received;
+
+    // Dense values are read from their rows, without unboxing each element.
+    auto dense = dynamic_pointer_cast<ValueSetDense<real>>(values);
+
+    int timeCount = values ? values->GetIndexCount({0}) : 0;
+    for (int t = 0; t < timeCount; t++)
+    {
+        if (dense)
+        {
+            auto row = dense->GetElementValuesForTimeSpan(t);
+            received.insert(received.end(), row.begin(), row.end());
+            continue;
+        }
+
+        for (const auto &value : values->GetElementValuesForTime(t))
+        {
+            double v;
+            if (!ToDouble(value, v))
+            {
+                // Non-numeric values can't be measured, never skip exchanges.
+                mComparable = false;
+                return;
+            }
+            received.push_back(v);
+        }
+    }
+
+    auto &last = mLastValues[inputId];
+    if (last.size() != received.size())
+    {
+        mComparable = false;
+    }
+    else
+    {
+        for (size_t i = 0; i < received.size(); i++)
+        {
+            double diff  = received[i] - last[i];
+            mDiffNorm   += diff * diff;
+            mValueNorm  += received[i] * received[i];
+        }
+    }
+
+    last = std::move(received);
+}
+
+void CouplingStepController::CompleteExchange(double time)
+{
+    mExchangeCount++;
+
+    if (mComparable && mExchangeCount > 1)
+    {
+        double valueNorm = max(sqrt(mValueNorm), numeric_limits<double>::min());
+        mLastChange      = sqrt(mDiffNorm) / valueNorm;
+
+        double factor = mLastChange > 0 ? 0.9 * mTolerance / mLastChange : mGrowFactor;
+        factor        = clamp(factor, mShrinkFactor, mGrowFactor);
+        mInterval     = clamp(mInterval * factor, mMinInterval, mMaxInterval);
+    }
+    else
+    {
+        mInterval = mMinInterval;
+    }
+
+    mNextExchangeTime = time + mInterval;
+
+    mDiffNorm   = 0;
+    mValueNorm  = 0;
+    mComparable = true;
+}
+
+void CouplingStepController::Reset()
+{
+    mInterval         = mMinInterval;
+    mNextExchangeTime = numeric_limits<double>::lowest();
+    mLastChange       = 0;
+    mExchangeCount    = 0;
+    mSkippedCount     = 0;
+
+    mLastValues.clear();
+    mDiffNorm   = 0;
+    mValueNorm  = 0;
+    mComparable = true;
+}
+
+double CouplingStepController::GetInterval() const
+{
+    return mInterval;
+}
+
+double CouplingStepController::GetLastChange() const
+{
+    return mLastChange;
+}
+
+int CouplingStepController::GetExchangeCount() const
+{
+    return mExchangeCount;
+}
+
+int CouplingStepController::GetSkippedCount() const
+{
+    return mSkippedCount;
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
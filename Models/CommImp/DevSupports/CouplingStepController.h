@@ -0,0 +1,101 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  CouplingStepController.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To adapt the coupling interval by the change of exchanged values.
+ *
+ *    A consumer component owning the controller pulls its inputs only when the
+ *    coupling interval has elapsed, and keeps using the last received values in the
+ *    steps between. At each exchange, the relative change of all received values
+ *    since the last exchange is measured by the L2 norm:
+ *
+ *        change = |v_new - v_old| / |v_new|
+ *
+ *    and the interval is scaled towards the change tolerance, assuming the change
+ *    grows linearly with the interval:
+ *
+ *        interval = interval * clamp(0.9 * tolerance / change, shrink, grow)
+ *
+ *    bounded by the configured minimum and maximum intervals. Identical values (e.g.
+ *    during dry periods) widen the interval by the grow factor at each exchange.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Models/Inc/IValueSet.h"
+#include "Models/Utils/CommConstants.h"
+#include <unordered_map>
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+namespace DevSupports
+{
+using Utils::real;
+
+/// @brief Controller widening or shrinking the coupling interval of a consumer.
+class CouplingStepController
+{
+private:
+    double mMinInterval;   // Minimum coupling interval, in days.
+    double mMaxInterval;   // Maximum coupling interval, in days.
+    double mTolerance;     // Tolerance of the relative change per exchange.
+    double mGrowFactor;    // Maximum widening factor per exchange.
+    double mShrinkFactor;  // Maximum shrinking factor per exchange.
+
+    double mInterval;
+    double mNextExchangeTime;
+    double mLastChange = 0;
+
+    int mExchangeCount = 0;
+    int mSkippedCount  = 0;
+
+    // Values received in the last exchange, by input id.
+    std::unordered_map<std::string, std::vector<double>> mLastValues;
+
+    // Accumulated norms of the current exchange.
+    double mDiffNorm   = 0;
+    double mValueNorm  = 0;
+    bool   mComparable = true;
+
+public:
+    /// @brief Creates the controller.
+    ///
+    /// @param minInterval Minimum coupling interval, in days.
+    /// @param maxInterval Maximum coupling interval, in days.
+    /// @param tolerance Tolerance of the relative change of values per exchange.
+    /// @param growFactor Maximum widening factor per exchange.
+    /// @param shrinkFactor Maximum shrinking factor per exchange.
+    CouplingStepController(
+        double minInterval, double maxInterval, double tolerance,
+        double growFactor = 2., double shrinkFactor = 0.5);
+
+    /// @brief Checks whether inputs should be pulled at the time, the skipped
+    /// exchanges are counted.
+    bool IsExchangeDue(double time);
+
+    /// @brief Records the values received by the input in the current exchange.
+    void Observe(const std::string &inputId, const std::shared_ptr<IValueSet> &values);
+
+    /// @brief Completes the current exchange at the time and adapts the interval.
+    void CompleteExchange(double time);
+
+    /// @brief Forgets the received values and restarts from the minimum interval.
+    void Reset();
+
+    double GetInterval() const;
+
+    /// @brief Relative change of values measured in the last exchange.
+    double GetLastChange() const;
+
+    int GetExchangeCount() const;
+
+    int GetSkippedCount() const;
+};
+
+}  // namespace DevSupports
+}  // namespace CommImp
+}  // namespace OpenOasis
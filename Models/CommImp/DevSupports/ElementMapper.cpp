@@ -9,11 +9,18 @@
 #include "ExtensionMethods.h"
 #include "ElementSetChecker.h"
 #include "ElementSearchTree.h"
+#include "MappingMatrixCache.h"
 #include "Models/CommImp/Spatial/GeomCalculator.h"
-#include "Models/CommImp/ValueSet2D.h"
+#include "Models/CommImp/ValueSetDense.h"
 #include "Models/CommImp/SpaceAdaptedOutputFactory.h"
 #include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
 #include <numeric>
+#include <sstream>
 
 
 namespace OpenOasis::CommImp::DevSupports
@@ -23,6 +30,22 @@ using namespace Utils;
 using namespace std;
 
 
+namespace
+{
+GeomExtent ExpandExtent(GeomExtent extent, real adjacent)
+{
+    extent.xMin -= adjacent;
+    extent.xMax += adjacent;
+    extent.yMin -= adjacent;
+    extent.yMax += adjacent;
+    return extent;
+}
+}  // namespace
+
+
+string ElementMapper::mCacheDirectory;
+
+
 ElementMapper::ElementMapper()
 {
     mNumberOfToRows      = 0;
@@ -50,6 +73,64 @@ void ElementMapper::SetUseSearchTree(bool value)
     mUseSearchTree = value;
 }
 
+int ElementMapper::GetInverseNeighbours() const
+{
+    return mInverseNeighbours;
+}
+
+void ElementMapper::SetInverseNeighbours(int count)
+{
+    if (count < 0)
+    {
+        throw IllegalArgumentException(
+            StringHelper::FormatSimple("Invalid inverse neighbours count {}.", count));
+    }
+
+    mInverseNeighbours = count;
+}
+
+real ElementMapper::GetInverseRadius() const
+{
+    return mInverseRadius;
+}
+
+void ElementMapper::SetInverseRadius(real radius)
+{
+    if (radius < 0)
+    {
+        throw IllegalArgumentException(
+            StringHelper::FormatSimple("Invalid inverse radius {}.", radius));
+    }
+
+    mInverseRadius = radius;
+}
+
+void ElementMapper::SetCacheDirectory(const string &directory)
+{
+    mCacheDirectory = directory;
+}
+
+const string &ElementMapper::GetCacheDirectory()
+{
+    return mCacheDirectory;
+}
+
+real ElementMapper::GetInversePower() const
+{
+    return mInversePower;
+}
+
+void ElementMapper::SetInversePower(real power)
+{
+    if (power <= 0)
+    {
+        throw IllegalArgumentException(
+            StringHelper::FormatSimple("Invalid inverse power {}.", power));
+    }
+
+    mInversePower = power;
+}
+
 void ElementMapper::Initialise(
     const shared_ptr<IIdentifiable> &method,
     const shared_ptr<IElementSet>   &fromElements,
@@ -83,31 +164,75 @@ shared_ptr<IValueSet> ElementMapper::MapValues(const shared_ptr<IValueSet> &inpu
 
 shared_ptr<IValueSet> ElementMapper::CreateResultValueSet(int numtimes, int numElements)
 {
-    vector<vector<real>> outValues;
-    for (int i = 0; i < numtimes; i++)
-    {
-        outValues.push_back(vector<real>(numElements));
-    }
-
-    return make_shared<ValueSetFP>(outValues, nullptr);
+    return make_shared<ValueSetDense<real>>(
+        shared_ptr<IValueDefinition>(), numtimes, numElements);
 }
 
 void ElementMapper::MapValues(
     const shared_ptr<IValueSet> &outputValues, const shared_ptr<IValueSet> &inputValues)
 {
+    auto denseOutputs = dynamic_pointer_cast<ValueSetDense<real>>(outputValues);
+    auto denseInputs  = dynamic_pointer_cast<ValueSetDense<real>>(inputValues);
+
+    // Maps the rows of all times in one pass over the mapping matrix.
+    if (denseOutputs && denseInputs
+        && denseOutputs->GetTimesCount() >= denseInputs->GetTimesCount()
+        && denseOutputs->GetElementsCount() == mNumberOfToRows
+        && denseInputs->GetElementsCount() == mNumberOfFromColumns)
+    {
+        vector<real *>       outputRows(denseInputs->GetTimesCount());
+        vector<const real *> inputRows(denseInputs->GetTimesCount());
+        for (int i = 0; i < (int)inputRows.size(); i++)
+        {
+            auto outputRow = denseOutputs->GetElementValuesForTimeSpan(i);
+            fill(outputRow.begin(), outputRow.end(), 0.0);
+
+            outputRows[i] = outputRow.data();
+            inputRows[i]  = denseInputs->GetElementValuesForTimeSpan(i).data();
+        }
+
+        mMappingMatrix->Product(outputRows, inputRows);
+        return;
+    }
+
     for (int i = 0; i < ExtensionMethods::TimesCount(inputValues); i++)
     {
-        int          elemCount = outputValues->GetIndexCount({i});
+        int          elemCount = outputValues->GetIndexCount({i, 0});
         vector<real> resultDbl(elemCount);
 
         mMappingMatrix->Product(
             resultDbl, ExtensionMethods::GetElementValuesForTime<real>(inputValues, i));
 
+        if (denseOutputs)
+        {
+            denseOutputs->SetElementValuesForTime(i, resultDbl);
+            continue;
+        }
+
         vector<any> result(resultDbl.begin(), resultDbl.end());
         outputValues->SetElementValuesForTime(i, result);
     }
 }
 
+void ElementMapper::MapValues(
+    Span<real> outputValues, Span<const real> inputValues) const
+{
+    if (!mIsInitialised)
+    {
+        throw runtime_error(
+            "ElementMapper needs to be initialised before the MapValue() can be used");
+    }
+
+    if ((int)inputValues.size() != mNumberOfFromColumns
+        || (int)outputValues.size() != mNumberOfToRows)
+    {
+        throw runtime_error("Dimension mismatch between values and mapping matrix");
+    }
+
+    fill(outputValues.begin(), outputValues.end(), 0.0);
+    mMappingMatrix->Product(outputValues.data(), inputValues.data());
+}
+
 void ElementMapper::UpdateMappingMatrix(
     const shared_ptr<IIdentifiable> &methodIdentifier,
     const shared_ptr<IElementSet>   &fromElements,
@@ -125,6 +250,23 @@ void ElementMapper::UpdateMappingMatrix(
         mMappingMatrix =
             make_shared<DoubleSparseMatrix>(mNumberOfToRows, mNumberOfFromColumns);
 
+        // Loads the matrix cached for the same mapping, or else saves it at last.
+        uint64_t cacheKey = 0;
+        if (!mCacheDirectory.empty())
+        {
+            ostringstream options;
+            options.precision(17);
+            options << mInverseNeighbours << ',' << mInverseRadius << ','
+                    << mInversePower;
+
+            cacheKey = MappingMatrixCache::ComputeKey(
+                methodIdentifier->GetId(), fromElements, toElements, options.str());
+            if (MappingMatrixCache::Load(mCacheDirectory, cacheKey, *mMappingMatrix))
+            {
+                return;
+            }
+        }
+
         if (fromElements->GetElementType() == ElementType::Point
             && toElements->GetElementType() == ElementType::Point)
         {
@@ -183,6 +325,11 @@ void ElementMapper::UpdateMappingMatrix(
             throw runtime_error(
                 "Mapping of specified ElementTypes not included in ElementMapper");
         }
+
+        if (!mCacheDirectory.empty())
+        {
+            MappingMatrixCache::Save(mCacheDirectory, cacheKey, *mMappingMatrix);
+        }
     }
     catch (const runtime_error &e)
     {
@@ -196,107 +343,25 @@ void ElementMapper::MapFromPointToPoint(
 {
     try
     {
-        for (int i = 0; i < mNumberOfToRows; i++)
+        if (mMethod != ElementMapperMethod::Nearest
+            && mMethod != ElementMapperMethod::Inverse)
         {
-            Point toPoint = CreateXYPoint(toElements, i);
-            for (int j = 0; j < mNumberOfFromColumns; j++)
-            {
-                Point fromPoint = CreateXYPoint(fromElements, j);
-                mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                    GeomCalculator::CalculatePointsDistance(toPoint, fromPoint);
-            }
+            throw runtime_error("methodDescription unknown for point point mapping");
         }
 
-        if (mMethod == ElementMapperMethod::Nearest)
-        {
-            for (int i = 0; i < mNumberOfToRows; i++)
-            {
-                double minDist = mMappingMatrix->At(i, 0);
-                for (int j = 1; j < mNumberOfFromColumns; j++)
-                {
-                    if (mMappingMatrix->At(i, j) < minDist)
-                    {
-                        minDist = mMappingMatrix->At(i, j);
-                    }
-                }
-
-                int denominator = 0;
-                for (int j = 0; j < mNumberOfFromColumns; j++)
-                {
-                    if (mMappingMatrix->At(i, j) == minDist)
-                    {
-                        mMappingMatrix->SetValue(i, j, 1);
-                        denominator++;
-                    }
-                    else
-                    {
-                        mMappingMatrix->SetValue(i, j, 0);
-                    }
-                }
+        const auto fromPoints = CreateXYShapes(fromElements);
+        const auto toPoints   = CreateXYShapes(toElements);
 
-                for (int j = 0; j < mNumberOfFromColumns; j++)
-                {
-                    mMappingMatrix->SetValue(
-                        i, j, mMappingMatrix->At(i, j) / denominator);
-                }
-            }
-        }
-        else if (mMethod == ElementMapperMethod::Inverse)
+        vector<GeomExtent> toExtents(mNumberOfToRows);
+        for (int i = 0; i < mNumberOfToRows; i++)
         {
-            for (int i = 0; i < mNumberOfToRows; i++)
-            {
-                double minDist = mMappingMatrix->At(i, 0);
-                for (int j = 1; j < mNumberOfFromColumns; j++)
-                {
-                    if (mMappingMatrix->At(i, j) < minDist)
-                    {
-                        minDist = mMappingMatrix->At(i, j);
-                    }
-                }
-
-                if (minDist == 0)
-                {
-                    int denominator = 0;
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        if (mMappingMatrix->At(i, j) == minDist)
-                        {
-                            mMappingMatrix->SetValue(i, j, 1);
-                            denominator++;
-                        }
-                        else
-                        {
-                            mMappingMatrix->SetValue(i, j, 0);
-                        }
-                    }
-
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        mMappingMatrix->SetValue(
-                            i, j, mMappingMatrix->At(i, j) / denominator);
-                    }
-                }
-                else
-                {
-                    double denominator = 0;
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        mMappingMatrix->SetValue(i, j, 1 / mMappingMatrix->At(i, j));
-                        denominator = denominator + mMappingMatrix->At(i, j);
-                    }
-
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        mMappingMatrix->SetValue(
-                            i, j, mMappingMatrix->At(i, j) / denominator);
-                    }
-                }
-            }
-        }
-        else
-        {
-            throw runtime_error("methodDescription unknown for point point mapping");
+            toExtents[i] = GenerateExtent(toPoints[i].front());
         }
+
+        MapByDistance(fromElements, toExtents, [&](int i, int j) {
+            return GeomCalculator::CalculatePointsDistance(
+                toPoints[i].front(), fromPoints[j].front());
+        });
     }
     catch (const runtime_error &e)
     {
@@ -310,112 +375,26 @@ void ElementMapper::MapFromPointToPolyline(
 {
     try
     {
-        for (int i = 0; i < mNumberOfToRows; i++)
+        if (mMethod != ElementMapperMethod::Nearest
+            && mMethod != ElementMapperMethod::Inverse)
         {
-            Polyline toPolyline = CreateXYPolyline(toElements, i);
-            for (int j = 0; j < mNumberOfFromColumns; j++)
-            {
-                Point fromPoint = CreateXYPoint(fromElements, j);
-                mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                    GeomCalculator::CalculatePointToPolylineDistance(
-                        toPolyline, fromPoint);
-            }
+            throw runtime_error(
+                "methodDescription unknown for point to Polyline mapping");
         }
 
-        if (mMethod == ElementMapperMethod::Nearest)
-        {
-            for (int i = 0; i < mNumberOfToRows; i++)
-            {
-                double minDist = (*mMappingMatrix)(i, 0);
-                for (int j = 1; j < mNumberOfFromColumns; j++)
-                {
-                    if (mMappingMatrix->At(i, j) < minDist)
-                    {
-                        minDist = mMappingMatrix->At(i, j);
-                    }
-                }
-
-                int denominator = 0;
-                for (int j = 0; j < mNumberOfFromColumns; j++)
-                {
-                    if (mMappingMatrix->At(i, j) == minDist)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] = 1;
-                        denominator++;
-                    }
-                    else
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] = 0;
-                    }
-                }
-
-                for (int j = 0; j < mNumberOfFromColumns; j++)
-                {
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                        mMappingMatrix->At(i, j) / denominator;
-                }
-            }
-        }
-        else if (mMethod == ElementMapperMethod::Inverse)
-        {
-            for (int i = 0; i < mNumberOfToRows; i++)
-            {
-                double minDist = (*mMappingMatrix)(i, 0);
-                for (int j = 1; j < mNumberOfFromColumns; j++)
-                {
-                    if (mMappingMatrix->At(i, j) < minDist)
-                    {
-                        minDist = mMappingMatrix->At(i, j);
-                    }
-                }
+        const auto fromPoints  = CreateXYShapes(fromElements);
+        const auto toPolylines = CreateXYShapes(toElements);
 
-                if (minDist == 0)
-                {
-                    int denominator = 0;
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        if (mMappingMatrix->At(i, j) == minDist)
-                        {
-                            mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                                1;
-                            denominator++;
-                        }
-                        else
-                        {
-                            mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                                0;
-                        }
-                    }
-
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                            mMappingMatrix->At(i, j) / denominator;
-                    }
-                }
-                else
-                {
-                    double denominator = 0;
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                            1 / mMappingMatrix->At(i, j);
-                        denominator = denominator + mMappingMatrix->At(i, j);
-                    }
-
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                            mMappingMatrix->At(i, j) / denominator;
-                    }
-                }
-            }
-        }
-        else
+        vector<GeomExtent> toExtents(mNumberOfToRows);
+        for (int i = 0; i < mNumberOfToRows; i++)
         {
-            throw runtime_error(
-                "methodDescription unknown for point to Polyline mapping");
+            toExtents[i] = GenerateExtent(toPolylines[i]);
         }
+
+        MapByDistance(fromElements, toExtents, [&](int i, int j) {
+            return GeomCalculator::CalculatePointToPolylineDistance(
+                toPolylines[i], fromPoints[j].front());
+        });
     }
     catch (const runtime_error &e)
     {
@@ -429,42 +408,34 @@ void ElementMapper::MapFromPointToPolygon(
 {
     try
     {
-        for (int i = 0; i < mNumberOfToRows; i++)
+        if (mMethod != ElementMapperMethod::Mean && mMethod != ElementMapperMethod::Sum)
         {
-            Polygon polygon = CreateXYPolygon(toElements, i);
-            int     count   = 0;
-            Point   point;
-            for (int n = 0; n < mNumberOfFromColumns; n++)
+            throw runtime_error(
+                "methodDescription unknown for point to polygon mapping");
+        }
+
+        const auto fromPoints = CreateXYShapes(fromElements);
+        const auto toPolygons = CreateXYShapes(toElements);
+        const auto tree       = CreateSearchTree(fromElements);
+
+        UpdateMappingRows([&](int i, MatrixRow &row) {
+            const auto &polygon = toPolygons[i];
+            for (int n : FindCandidates(tree.get(), GenerateExtent(polygon)))
             {
-                point = CreateXYPoint(fromElements, n);
-                if (GeomCalculator::IsPointInPolygon(point, polygon))
+                if (GeomCalculator::IsPointInPolygon(fromPoints[n].front(), polygon))
                 {
-                    if (mMethod == ElementMapperMethod::Mean)
-                    {
-                        count = count + 1;
-                    }
-                    else if (mMethod == ElementMapperMethod::Sum)
-                    {
-                        count = 1;
-                    }
-                    else
-                    {
-                        throw runtime_error(
-                            "methodDescription unknown for point to polygon mapping");
-                    }
+                    row.emplace_back(n, 1.0);
                 }
             }
 
-            for (int n = 0; n < mNumberOfFromColumns; n++)
+            if (mMethod == ElementMapperMethod::Mean)
             {
-                point = CreateXYPoint(fromElements, n);
-                if (GeomCalculator::IsPointInPolygon(point, polygon))
+                for (auto &entry : row)
                 {
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, n)] =
-                        1.0 / count;
+                    entry.second = 1.0 / row.size();
                 }
             }
-        }
+        });
     }
     catch (const runtime_error &e)
     {
@@ -478,107 +449,26 @@ void ElementMapper::MapFromPolylineToPoint(
 {
     try
     {
-        for (int i = 0; i < mNumberOfToRows; i++)
+        if (mMethod != ElementMapperMethod::Nearest
+            && mMethod != ElementMapperMethod::Inverse)
         {
-            Point toPoint = CreateXYPoint(toElements, i);
-            for (int j = 0; j < mNumberOfFromColumns; j++)
-            {
-                Polyline fromPolyline = CreateXYPolyline(fromElements, j);
-                mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                    GeomCalculator::CalculatePointToPolylineDistance(
-                        fromPolyline, toPoint);
-            }
+            throw runtime_error(
+                "methodDescription unknown for Polyline to point mapping");
         }
 
-        if (mMethod == ElementMapperMethod::Nearest)
-        {
-            for (int i = 0; i < mNumberOfToRows; i++)
-            {
-                double minDist = (*mMappingMatrix)(i, 0);
-                for (int j = 1; j < mNumberOfFromColumns; j++)
-                {
-                    if (mMappingMatrix->At(i, j) < minDist)
-                    {
-                        minDist = mMappingMatrix->At(i, j);
-                    }
-                }
-                int denominator = 0;
-                for (int j = 0; j < mNumberOfFromColumns; j++)
-                {
-                    if (mMappingMatrix->At(i, j) == minDist)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] = 1;
-                        denominator++;
-                    }
-                    else
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] = 0;
-                    }
-                }
-                for (int j = 0; j < mNumberOfFromColumns; j++)
-                {
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                        mMappingMatrix->At(i, j) / denominator;
-                }
-            }
-        }
-        else if (mMethod == ElementMapperMethod::Inverse)
-        {
-            for (int i = 0; i < mNumberOfToRows; i++)
-            {
-                double minDist = (*mMappingMatrix)(i, 0);
-                for (int j = 1; j < mNumberOfFromColumns; j++)
-                {
-                    if (mMappingMatrix->At(i, j) < minDist)
-                    {
-                        minDist = mMappingMatrix->At(i, j);
-                    }
-                }
-                if (minDist == 0)
-                {
-                    int denominator = 0;
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        if (mMappingMatrix->At(i, j) == minDist)
-                        {
-                            mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                                1;
-                            denominator++;
-                        }
-                        else
-                        {
-                            mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                                0;
-                        }
-                    }
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                            mMappingMatrix->At(i, j) / denominator;
-                    }
-                }
-                else
-                {
-                    double denominator = 0;
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                            1 / mMappingMatrix->At(i, j);
-                        denominator = denominator + mMappingMatrix->At(i, j);
-                    }
-                    for (int j = 0; j < mNumberOfFromColumns; j++)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                            mMappingMatrix->At(i, j) / denominator;
-                    }
-                }
-            }
-        }
-        else
+        const auto fromPolylines = CreateXYShapes(fromElements);
+        const auto toPoints      = CreateXYShapes(toElements);
+
+        vector<GeomExtent> toExtents(mNumberOfToRows);
+        for (int i = 0; i < mNumberOfToRows; i++)
         {
-            throw runtime_error(
-                "methodDescription unknown for Polyline to point mapping");
+            toExtents[i] = GenerateExtent(toPoints[i].front());
         }
+
+        MapByDistance(fromElements, toExtents, [&](int i, int j) {
+            return GeomCalculator::CalculatePointToPolylineDistance(
+                fromPolylines[j], toPoints[i].front());
+        });
     }
     catch (const runtime_error &e)  // For all of the Point to Polyline part
     {
@@ -600,50 +490,47 @@ void ElementMapper::MapFromPolylineToPolygon(
 {
     try
     {
-        // For each polygon in target.
-        for (int i = 0; i < mNumberOfToRows; i++)
+        if (mMethod != ElementMapperMethod::WeightedMean
+            && mMethod != ElementMapperMethod::WeightedSum)
         {
-            Polygon polygon = CreateXYPolygon(toElements, i);
+            throw runtime_error(
+                "methodDescription unknown for Polyline to polygon mapping");
+        }
+
+        const auto fromPolylines = CreateXYShapes(fromElements);
+        const auto toPolygons    = CreateXYShapes(toElements);
+        const auto tree          = CreateSearchTree(fromElements);
+
+        // For each polygon in target.
+        UpdateMappingRows([&](int i, MatrixRow &row) {
+            const auto &polygon = toPolygons[i];
 
-            if (mMethod == ElementMapperMethod::WeightedMean)
+            double totalLineLengthInPolygon = 0;
+            for (int n : FindCandidates(tree.get(), GenerateExtent(polygon)))
             {
-                double totalLineLengthInPolygon = 0;
-                for (int n = 0; n < mNumberOfFromColumns; n++)
-                {
-                    Polyline Polyline = CreateXYPolyline(fromElements, n);
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, n)] =
-                        GeomCalculator::CalculateLengthOfPolylineInsidePolygon(
-                            Polyline, polygon);
-                    totalLineLengthInPolygon += (*mMappingMatrix)(i, n);
-                }
+                const auto &polyline = fromPolylines[n];
+                double      length =
+                    GeomCalculator::CalculateLengthOfPolylineInsidePolygon(
+                        polyline, polygon);
 
-                if (totalLineLengthInPolygon > 0)
+                if (mMethod == ElementMapperMethod::WeightedSum)
                 {
-                    for (int n = 0; n < mNumberOfFromColumns; n++)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, n)] =
-                            (*mMappingMatrix)(i, n) / totalLineLengthInPolygon;
-                    }
+                    length /= GeomCalculator::CalculateLengthOfPolyline(polyline);
                 }
+
+                row.emplace_back(n, length);
+                totalLineLengthInPolygon += length;
             }
-            else if (mMethod == ElementMapperMethod::WeightedSum)
+
+            if (mMethod == ElementMapperMethod::WeightedMean
+                && totalLineLengthInPolygon > 0)
             {
-                // For each line segment in Polyline
-                for (int n = 0; n < mNumberOfFromColumns; n++)
+                for (auto &entry : row)
                 {
-                    Polyline Polyline = CreateXYPolyline(fromElements, n);
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, n)] =
-                        GeomCalculator::CalculateLengthOfPolylineInsidePolygon(
-                            Polyline, polygon)
-                        / GeomCalculator::CalculateLengthOfPolyline(Polyline);
+                    entry.second /= totalLineLengthInPolygon;
                 }
             }
-            else
-            {
-                throw runtime_error(
-                    "methodDescription unknown for Polyline to polygon mapping");
-            }
-        }
+        });
     }
     catch (const runtime_error &e)
     {
@@ -663,69 +550,26 @@ void ElementMapper::MapFromPolygonToPoint(
                 "methodDescription unknown for polygon to point mapping");
         }
 
-        // Only create search tree if number of cols/rows is larger than 10/10.
-        bool useSearchTree = mNumberOfFromColumns > 10 && mNumberOfToRows > 10;
-        ElementSearchTree<int> fromSearchTree({});
-        vector<int>            fromCandidateElmts;
-        if (useSearchTree)
-        {
-            fromSearchTree = ElementSearchTree<int>::BuildSearchTree(fromElements);
-        }
-        else
-        {
-            fromCandidateElmts = vector<int>(mNumberOfFromColumns);
-            iota(begin(fromCandidateElmts), end(fromCandidateElmts), 0);
-        }
-
-        for (int n = 0; n < mNumberOfToRows; n++)
-        {
-            Point point = CreateXYPoint(toElements, n);
-            if (useSearchTree)
-            {
-                GeomExtent toExtent = GenerateExtent(point);
-                fromCandidateElmts  = fromSearchTree.FindElements(toExtent);
-            }
-
-            int count = 0;
-
-            // Check first for strict inclusion.
-            for (auto i : fromCandidateElmts)
-            {
-                Polygon polygon = CreateXYPolygon(fromElements, i);
-                if (GeomCalculator::IsPointInPolygon(point, polygon))
-                {
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(n, i)] = 1.0;
-                    count++;
-                }
-            }
+        const auto fromPolygons = CreateXYShapes(fromElements);
+        const auto toPoints     = CreateXYShapes(toElements);
+        const auto tree         = CreateSearchTree(fromElements);
 
-            if (count == 0)
+        UpdateMappingRows([&](int n, MatrixRow &row) {
+            const auto &point = toPoints[n].front();
+            for (int i : FindCandidates(tree.get(), GenerateExtent(point)))
             {
-                // Not strictly inside any polygon, check also edges.
-                for (auto i : fromCandidateElmts)
+                if (GeomCalculator::IsPointInPolygon(point, fromPolygons[i]))
                 {
-                    Polygon polygon = CreateXYPolygon(fromElements, i);
-                    if (GeomCalculator::IsPointInPolygon(point, polygon))
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(n, i)] = 1.0;
-                        count++;
-                    }
+                    row.emplace_back(i, 1.0);
                 }
             }
 
-            if (count > 1)
+            // In case of more than one hit, use average.
+            for (auto &entry : row)
             {
-                // In case of more than one hit, use average.
-                for (auto i : fromCandidateElmts)
-                {
-                    if ((*mMappingMatrix)(n, i) != 0.0)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(n, i)] =
-                            1.0 / count;
-                    }
-                }
+                entry.second = 1.0 / row.size();
             }
-        }
+        });
     }
     catch (const runtime_error &e)
     {
@@ -740,50 +584,40 @@ void ElementMapper::MapFromPolygonToPolyline(
     // Polygon to Polyline
     try
     {
-        for (int i = 0; i < mNumberOfToRows; i++)
+        if (mMethod != ElementMapperMethod::WeightedMean
+            && mMethod != ElementMapperMethod::WeightedSum)
         {
-            Polyline Polyline = CreateXYPolyline(toElements, i);
+            throw runtime_error(
+                "methodDescription unknown for polygon to Polyline mapping");
+        }
 
-            if (mMethod == ElementMapperMethod::WeightedMean)
-            {
-                for (int n = 0; n < mNumberOfFromColumns; n++)
-                {
-                    Polygon polygon = CreateXYPolygon(fromElements, n);
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, n)] =
-                        GeomCalculator::CalculateLengthOfPolylineInsidePolygon(
-                            Polyline, polygon)
-                        / GeomCalculator::CalculateLengthOfPolyline(Polyline);
-                }
+        const auto fromPolygons = CreateXYShapes(fromElements);
+        const auto toPolylines  = CreateXYShapes(toElements);
+        const auto tree         = CreateSearchTree(fromElements);
 
-                double sum = 0;
-                for (int n = 0; n < mNumberOfFromColumns; n++)
-                {
-                    sum += (*mMappingMatrix)(i, n);
-                }
+        UpdateMappingRows([&](int i, MatrixRow &row) {
+            const auto &polyline = toPolylines[i];
+            double      length   = GeomCalculator::CalculateLengthOfPolyline(polyline);
 
-                for (int n = 0; n < mNumberOfFromColumns; n++)
-                {
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, n)] =
-                        (*mMappingMatrix)(i, n) / sum;
-                }
+            double sum = 0;
+            for (int n : FindCandidates(tree.get(), GenerateExtent(polyline)))
+            {
+                double ratio = GeomCalculator::CalculateLengthOfPolylineInsidePolygon(
+                                   polyline, fromPolygons[n])
+                               / length;
+
+                row.emplace_back(n, ratio);
+                sum += ratio;
             }
-            else if (mMethod == ElementMapperMethod::WeightedSum)
+
+            if (mMethod == ElementMapperMethod::WeightedMean && sum != 0)
             {
-                for (int n = 0; n < mNumberOfFromColumns; n++)
+                for (auto &entry : row)
                 {
-                    Polygon polygon = CreateXYPolygon(fromElements, n);
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, n)] =
-                        GeomCalculator::CalculateLengthOfPolylineInsidePolygon(
-                            Polyline, polygon)
-                        / GeomCalculator::CalculateLengthOfPolyline(Polyline);
+                    entry.second /= sum;
                 }
             }
-            else
-            {
-                throw runtime_error(
-                    "methodDescription unknown for polygon to Polyline mapping");
-            }
-        }
+        });
     }
     catch (const runtime_error &e)  // catch for all of Polygon to Polyline
     {
@@ -798,78 +632,246 @@ void ElementMapper::MapFromPolygonToPolygon(
     // Polygon to Polygon
     try
     {
-        // Only create search tree if number of cols/rows is larger than 100/10.
-        bool useSearchTree = mNumberOfFromColumns > 10 && mNumberOfToRows > 10;
-        ElementSearchTree<int> fromSearchTree({});
-        vector<int>            fromCandidateElmts;
-        if (useSearchTree)
+        if (mMethod != ElementMapperMethod::WeightedMean
+            && mMethod != ElementMapperMethod::WeightedSum
+            && mMethod != ElementMapperMethod::Distribute)
         {
-            fromSearchTree = ElementSearchTree<int>::BuildSearchTree(fromElements);
-        }
-        else
-        {
-            fromCandidateElmts = vector<int>(mNumberOfFromColumns);
-            iota(begin(fromCandidateElmts), end(fromCandidateElmts), 0);
+            throw runtime_error(
+                "methodDescription unknown for polygon to polygon mapping");
         }
 
-        for (int i = 0; i < mNumberOfToRows; i++)
-        {
-            Polygon toPolygon = CreateXYPolygon(toElements, i);
-            if (useSearchTree)
-            {
-                GeomExtent toExtent = GenerateExtent(toPolygon);
-                fromCandidateElmts  = fromSearchTree.FindElements(toExtent);
-            }
+        const auto fromPolygons = CreateXYShapes(fromElements);
+        const auto toPolygons   = CreateXYShapes(toElements);
+        const auto tree         = CreateSearchTree(fromElements);
+
+        UpdateMappingRows([&](int i, MatrixRow &row) {
+            const auto &toPolygon = toPolygons[i];
 
-            for (auto j : fromCandidateElmts)
+            // The target is split into convex parts once, which clip the candidates.
+            const auto toParts = GeomCalculator::SplitPolygonToConvexParts(toPolygon);
+
+            double denominator = 0;
+            for (int j : FindCandidates(tree.get(), GenerateExtent(toPolygon)))
             {
-                Polygon fromPolygon = CreateXYPolygon(fromElements, j);
-                mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                    GeomCalculator::CalculatePolygonSharedArea(toPolygon, fromPolygon);
+                const auto &fromPolygon = fromPolygons[j];
+                double      sharedArea =
+                    GeomCalculator::CalculatePolygonSharedArea(fromPolygon, toParts);
+                if (sharedArea == 0)
+                {
+                    continue;
+                }
+
                 if (mMethod == ElementMapperMethod::Distribute)
                 {
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] /=
-                        GeomCalculator::CalculateAreaOfPolygon(fromPolygon);
+                    sharedArea /= GeomCalculator::CalculateAreaOfPolygon(fromPolygon);
                 }
+
+                row.emplace_back(j, sharedArea);
+                denominator += sharedArea;
             }
 
-            if (mMethod == ElementMapperMethod::WeightedMean)
+            if (mMethod == ElementMapperMethod::WeightedSum)
             {
-                double denominator = 0;
-                for (auto j : fromCandidateElmts)
-                {
-                    denominator = denominator + mMappingMatrix->At(i, j);
-                }
+                denominator = GeomCalculator::CalculateAreaOfPolygon(toPolygon);
+            }
 
-                for (auto j : fromCandidateElmts)
+            if (mMethod != ElementMapperMethod::Distribute && denominator != 0)
+            {
+                for (auto &entry : row)
                 {
-                    if (denominator != 0)
-                    {
-                        mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                            mMappingMatrix->At(i, j) / denominator;
-                    }
+                    entry.second /= denominator;
                 }
             }
-            else if (mMethod == ElementMapperMethod::WeightedSum)
+        });
+    }
+    catch (const runtime_error &e)  // catch for all of Polygon to Polygon.
+    {
+        throw runtime_error("Polygon to polygon mapping failed");
+    }
+}
+
+void ElementMapper::UpdateMappingRows(const function<void(int, MatrixRow &)> &evaluator)
+{
+    vector<MatrixRow> rows(mNumberOfToRows);
+    exception_ptr     error;
+
+    // Rows of target elements are independent, so they're evaluated in parallel.
+#pragma omp parallel for schedule(dynamic, 16)
+    for (int i = 0; i < mNumberOfToRows; i++)
+    {
+        try
+        {
+            evaluator(i, rows[i]);
+        }
+        catch (...)
+        {
+#pragma omp critical
+            error = current_exception();
+        }
+    }
+
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+
+    mMappingMatrix->SetRows(rows);
+}
+
+unique_ptr<ElementSearchTree<int>>
+ElementMapper::CreateSearchTree(const shared_ptr<IElementSet> &fromElements) const
+{
+    // Only create search tree if number of cols/rows is larger than 10/10.
+    if (!mUseSearchTree || mNumberOfFromColumns <= 10 || mNumberOfToRows <= 10)
+    {
+        return nullptr;
+    }
+
+    return make_unique<ElementSearchTree<int>>(
+        ElementSearchTree<int>::BuildSearchTree(fromElements));
+}
+
+vector<int> ElementMapper::FindCandidates(
+    const ElementSearchTree<int> *tree, const GeomExtent &extent) const
+{
+    if (tree)
+    {
+        return tree->FindElements(extent);
+    }
+
+    vector<int> candidates(mNumberOfFromColumns);
+    iota(begin(candidates), end(candidates), 0);
+    return candidates;
+}
+
+void ElementMapper::MapByDistance(
+    const shared_ptr<IElementSet> &fromElements, const vector<GeomExtent> &toExtents,
+    const function<real(int, int)> &distance)
+{
+    // Inverse weights all the source elements unless limited, where the tree doesn't
+    // help.
+    const bool isNearest = mMethod == ElementMapperMethod::Nearest;
+    const bool isLimited = mInverseNeighbours > 0 || mInverseRadius > 0;
+    const auto tree      = isNearest || isLimited
+                               ? CreateSearchTree(fromElements)
+                               : unique_ptr<ElementSearchTree<int>>();
+
+    UpdateMappingRows([&](int i, MatrixRow &row) {
+        auto sourceDistance = [&](int j) { return distance(i, j); };
+
+        vector<int> candidates;
+        if (!tree)
+        {
+            candidates = FindCandidates(nullptr, GeomExtent());
+        }
+        else if (isNearest)
+        {
+            // The nearest source is found by best-first search, then the ones not
+            // farther than it are the candidates of the nearest.
+            auto nearest = tree->FindNearest(toExtents[i], 1, sourceDistance);
+
+            candidates = tree->FindElements(
+                ExpandExtent(toExtents[i], distance(i, nearest.front())));
+        }
+        else if (mInverseNeighbours > 0)
+        {
+            // The ties of the farthest neighbour are found as well, and trimmed in
+            // order later.
+            auto nearest =
+                tree->FindNearest(toExtents[i], mInverseNeighbours, sourceDistance);
+
+            candidates = tree->FindElements(
+                ExpandExtent(toExtents[i], distance(i, nearest.back())));
+        }
+        else
+        {
+            candidates = tree->FindElements(ExpandExtent(toExtents[i], mInverseRadius));
+        }
+
+        vector<real> distances(candidates.size());
+        real         minDist = numeric_limits<real>::max();
+        for (size_t k = 0; k < candidates.size(); k++)
+        {
+            distances[k] = distance(i, candidates[k]);
+        }
+
+        if (!isNearest && isLimited)
+        {
+            LimitInverseSources(candidates, distances);
+        }
+
+        for (real dist : distances)
+        {
+            minDist = min(minDist, dist);
+        }
+
+        if (mMethod == ElementMapperMethod::Nearest || minDist == 0)
+        {
+            // Sources of the least distance are weighted equally.
+            for (size_t k = 0; k < candidates.size(); k++)
             {
-                for (auto j : fromCandidateElmts)
+                if (distances[k] == minDist)
                 {
-                    mMappingMatrix->mValues[DoubleSparseMatrix::Index(i, j)] =
-                        mMappingMatrix->At(i, j)
-                        / GeomCalculator::CalculateAreaOfPolygon(toPolygon);
+                    row.emplace_back(candidates[k], 1.0);
                 }
             }
-            else if (mMethod != ElementMapperMethod::Distribute)
+
+            for (auto &entry : row)
             {
-                throw runtime_error(
-                    "methodDescription unknown for polygon to polygon mapping");
+                entry.second = 1.0 / row.size();
             }
         }
+        else
+        {
+            real denominator = 0;
+            for (size_t k = 0; k < candidates.size(); k++)
+            {
+                real weight = pow(distances[k], -mInversePower);
+                row.emplace_back(candidates[k], weight);
+                denominator += weight;
+            }
+
+            for (auto &entry : row)
+            {
+                entry.second /= denominator;
+            }
+        }
+    });
+}
+
+void ElementMapper::LimitInverseSources(
+    vector<int> &candidates, vector<real> &distances) const
+{
+    // Orders the candidates by distance, ties by index, so the same sources are kept
+    // whether they are searched on the tree or not.
+    vector<size_t> order(candidates.size());
+    iota(begin(order), end(order), 0);
+    sort(begin(order), end(order), [&](size_t a, size_t b) {
+        return make_pair(distances[a], candidates[a])
+               < make_pair(distances[b], candidates[b]);
+    });
+
+    size_t count = order.size();
+    if (mInverseNeighbours > 0)
+    {
+        count = min(count, (size_t)mInverseNeighbours);
     }
-    catch (const runtime_error &e)  // catch for all of Polygon to Polygon.
+
+    vector<int>  limitedCandidates;
+    vector<real> limitedDistances;
+    for (size_t k = 0; k < count; k++)
     {
-        throw runtime_error("Polygon to polygon mapping failed");
+        if (mInverseRadius > 0 && distances[order[k]] > mInverseRadius)
+        {
+            break;
+        }
+
+        limitedCandidates.push_back(candidates[order[k]]);
+        limitedDistances.push_back(distances[order[k]]);
     }
+
+    candidates.swap(limitedCandidates);
+    distances.swap(limitedDistances);
 }
 
 double ElementMapper::GetValueFromMappingMatrix(int row, int column)
@@ -895,7 +897,7 @@ void ElementMapper::SetValueInMappingMatrix(double value, int row, int column)
     {
         throw runtime_error("SetValueInMappingMatrix failed.");
     }
-    mMappingMatrix->mValues[DoubleSparseMatrix::Index(row, column)] = value;
+    mMappingMatrix->SetValue(row, column, value);
 }
 
 void ElementMapper::ValidateIndicies(int row, int column)
@@ -939,7 +941,13 @@ GeomExtent ElementMapper::GenerateExtent(const Point &point, real adjacent)
 
 GeomExtent ElementMapper::GenerateExtent(const Polygon &polygon)
 {
-    GeomExtent extent;
+    if (polygon.empty())
+    {
+        return GeomExtent();
+    }
+
+    // Starts from the first point, or the origin would be included.
+    GeomExtent extent = GenerateExtent(polygon.front());
     for (auto point : polygon)
     {
         GeomCalculator::UpdateExtent(extent, point);
@@ -948,6 +956,23 @@ GeomExtent ElementMapper::GenerateExtent(const Polygon &polygon)
     return extent;
 }
 
+vector<Polyline>
+ElementMapper::CreateXYShapes(const shared_ptr<IElementSet> &elementSet)
+{
+    vector<Polyline> shapes(elementSet->GetElementCount());
+    for (int i = 0; i < (int)shapes.size(); i++)
+    {
+        for (int n = 0; n < elementSet->GetNodeCount(i); n++)
+        {
+            shapes[i].push_back(Point{
+                elementSet->GetNodeXCoordinate(i, n),
+                elementSet->GetNodeYCoordinate(i, n)});
+        }
+    }
+
+    return shapes;
+}
+
 Point ElementMapper::CreateXYPoint(const shared_ptr<IElementSet> &elementSet, int index)
 {
     if (elementSet->GetElementType() != ElementType::Point)
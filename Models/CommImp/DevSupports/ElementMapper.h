@@ -38,13 +38,18 @@
 #include "Models/Inc/IValueSet.h"
 #include "Models/CommImp/Numeric/Matrix.h"
 #include "Models/CommImp/Spatial/Geom.h"
+#include "Models/Utils/Span.h"
+#include <functional>
+#include <memory>
 #include <optional>
+#include <string>
 
 
 namespace OpenOasis::CommImp::DevSupports
 {
 using namespace Spatial;
 using namespace Numeric;
+using Utils::Span;
 
 
 /// @brief Predined element mapping methods.
@@ -62,6 +67,10 @@ enum class ElementMapperMethod
 };
 
 
+template <typename T>
+class ElementSearchTree;
+
+
 /// @brief ElementMapper class converts one ValueSet(inputValues) associated one
 /// ElementSet(fromElements) to a new ValueSet that corresponds to another
 /// ElementSet(toElements).
@@ -72,11 +81,19 @@ private:
     std::optional<ElementMapperMethod>  mMethod;
     std::shared_ptr<DoubleSparseMatrix> mMappingMatrix;
 
-    bool mUseSearchTree       = false;
+    bool mUseSearchTree       = true;
     bool mIsInitialised       = false;
     int  mNumberOfFromColumns = 0;
     int  mNumberOfToRows      = 0;
 
+    // Limits of the sources weighted by the Inverse method, 0 for no limit.
+    int  mInverseNeighbours = 0;
+    real mInverseRadius     = 0;
+    real mInversePower      = 1;
+
+    // Directory of the cached mapping matrices, empty if not cached.
+    static std::string mCacheDirectory;
+
 public:
     virtual ~ElementMapper()
     {}
@@ -91,6 +108,31 @@ public:
 
     bool GetUseSearchTree() const;
 
+    /// @brief Sets the number of the nearest sources weighted by the Inverse method,
+    /// 0 for all the sources.
+    void SetInverseNeighbours(int count);
+
+    int GetInverseNeighbours() const;
+
+    /// @brief Sets the distance within which the sources are weighted by the Inverse
+    /// method, 0 for no limit. Targets without any source within get no value.
+    void SetInverseRadius(real radius);
+
+    real GetInverseRadius() const;
+
+    /// @brief Sets the power of the distance in the Inverse weights, 1 by default.
+    void SetInversePower(real power);
+
+    real GetInversePower() const;
+
+    /// @brief Sets the directory to cache the mapping matrices for all the mappers,
+    /// empty to disable the cache, which is by default.
+    /// The matrix evaluated is saved, and loaded at the next time for mapping between
+    /// the same element sets with the same method and options.
+    static void SetCacheDirectory(const std::string &directory);
+
+    static const std::string &GetCacheDirectory();
+
     ElementType GetTargetElementType();
 
     /// @brief Calculates for each set of timestep data.
@@ -131,6 +173,14 @@ public:
         const std::shared_ptr<IValueSet> &outputValues,
         const std::shared_ptr<IValueSet> &inputValues);
 
+    /// @brief Maps the values of one time step, the outputs are overwritten.
+    /// It works on contiguous rows, e.g. rows of a `ValueSetDense` or a buffer, so no
+    /// intermediate valueset is created.
+    ///
+    /// @param outputValues Mapped values of the target elements.
+    /// @param inputValues Values of the source elements.
+    void MapValues(Span<real> outputValues, Span<const real> inputValues) const;
+
     /// @brief Extracts the (row, col) element from the MappingMatrix.
     ///
     /// @param row Zero based row index.
@@ -201,6 +251,42 @@ private:
         const std::shared_ptr<IElementSet> &fromElements,
         const std::shared_ptr<IElementSet> &toElements);
 
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Methods for evaluating the mapping matrix.
+    //
+
+    /// Nonzero entries of a mapping matrix row, pairs of column and value.
+    using MatrixRow = std::vector<std::pair<int, real>>;
+
+    /// @brief Evaluates the mapping matrix rows of the target elements in parallel.
+    /// @param evaluator Fills the nonzero entries of the row of the target element.
+    void UpdateMappingRows(const std::function<void(int, MatrixRow &)> &evaluator);
+
+    /// @brief Builds the search tree of the source elements, or null if the search
+    /// tree is disabled or there are too few elements.
+    std::unique_ptr<ElementSearchTree<int>>
+    CreateSearchTree(const std::shared_ptr<IElementSet> &fromElements) const;
+
+    /// @brief Finds the source elements whose extents overlap the extent, which are
+    /// all the source elements if there's no search tree.
+    std::vector<int>
+    FindCandidates(const ElementSearchTree<int> *tree, const GeomExtent &extent) const;
+
+    /// @brief Maps with the Nearest or Inverse method by the distances between the
+    /// target and source elements. The Inverse method weights the sources limited by
+    /// the neighbours and radius, which are searched on the tree if any.
+    ///
+    /// @param toExtents Extents of the target elements.
+    /// @param distance Distance between the target and source elements.
+    void MapByDistance(
+        const std::shared_ptr<IElementSet>  &fromElements,
+        const std::vector<GeomExtent>       &toExtents,
+        const std::function<real(int, int)> &distance);
+
+    /// @brief Keeps the nearest candidates within the limits of the Inverse method.
+    void LimitInverseSources(
+        std::vector<int> &candidates, std::vector<real> &distances) const;
+
 public:
     ///////////////////////////////////////////////////////////////////////////////////
     // Static methods.
@@ -212,6 +298,10 @@ public:
 
     static GeomExtent GenerateExtent(const Polygon &polygon);
 
+    /// @brief Creates the vertices of all elements, which is one for a point.
+    static std::vector<Polyline>
+    CreateXYShapes(const std::shared_ptr<IElementSet> &elementSet);
+
     static Point
     CreateXYPoint(const std::shared_ptr<IElementSet> &elementSet, int index);
 
@@ -6,6 +6,12 @@
  *
  *    @Desc      :  2D element search tree.
  *
+ *    The tree is a packed R-tree bulk loaded by Sort-Tile-Recursive(STR): elements are
+ *    sorted into vertical slices by x, then into leaves by y within each slice, and so
+ *    are the nodes of upper levels. All nodes live in one flat array, whose children
+ *    are contiguous, and the tree is read only after built, so queries are able to
+ *    run in parallel.
+ *
  ** ***********************************************************************************/
 #pragma once
 #include "Models/CommImp/Spatial/Geom.h"
@@ -13,296 +19,227 @@
 #include "Models/Inc/IElementSet.h"
 #include <memory>
 #include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
 #include <stdexcept>
+#include <tuple>
 
 
 namespace OpenOasis::CommImp::DevSupports
 {
 using namespace Spatial;
 
-/// @brief Leaf in the search tree.
+/// @brief 2D element search tree.
+/// The search tree is built up by adding elements with their extents, then calling
+/// `Build()` once before searching.
 template <typename T>
-class Leaf
+class ElementSearchTree
 {
 public:
-    T          mElement;  // Element in the search tree.
-    GeomExtent mExtent;   // Element extent.
-};
+    int MaxElementsPerNode = 16;  // Max number of elements or children in per node.
 
+private:
+    /// @brief Node in the search tree, whose entries are elements if it's a leaf,
+    /// or else nodes.
+    struct TreeNode
+    {
+        GeomExtent mExtent;
+        int        mFirst  = 0;  // Index of the first entry.
+        int        mCount  = 0;
+        bool       mIsLeaf = true;
+    };
 
-/// @brief Node in the search tree.
-template <typename T>
-class TreeNode
-{
-public:
-    int MaxPointsPerNode = 10;  // Max number of points in per node.
+    std::vector<T>          mElements;     // Elements in leaf order once built.
+    std::vector<GeomExtent> mElmtExtents;  // Extents of the elements.
 
-private:
-    GeomExtent            mExtent;    // Node extent.
-    std::vector<TreeNode> mChildren;  // Children node of current node.
-    std::vector<Point>    mPoints;    // Node points.
-    std::vector<Leaf<T>>  mElements;  // Node elements.
+    std::vector<TreeNode> mNodes;
+    int                   mRoot  = -1;
+    int                   mDepth = 0;
+    bool                  mBuilt = false;
 
 public:
-    TreeNode(const GeomExtent &extent) : mExtent(extent)
-    {}
+    ElementSearchTree() = default;
 
-    bool HasChildren() const
+    /// @brief Adds element to the search tree, which must be built again to search.
+    void AddElement(T element, const GeomExtent &extent)
     {
-        return !mChildren.empty();
+        mElements.push_back(element);
+        mElmtExtents.push_back(extent);
+        mBuilt = false;
     }
 
-    bool Add(const Point &point)
+    /// @brief Packs the added elements into the tree.
+    void Build()
     {
-        bool added = false;
+        mNodes.clear();
+        mRoot  = -1;
+        mDepth = 0;
+        mBuilt = true;
 
-        // Check if inside this domain.
-        if (!GeomCalculator::IsPointInExtent(point, mExtent))
+        if (mElements.empty())
         {
-            return false;
+            return;
         }
 
-        // If has children, add recursively.
-        if (HasChildren())
+        // Orders the elements, and packs them into leaves.
+        auto order = SortTileRecursive(mElmtExtents);
+
+        std::vector<T>          elements;
+        std::vector<GeomExtent> extents;
+        elements.reserve(order.size());
+        extents.reserve(order.size());
+        for (int k : order)
         {
-            for (auto &child : mChildren)
-            {
-                added = child.Add(point);
-            }
+            elements.push_back(mElements[k]);
+            extents.push_back(mElmtExtents[k]);
         }
-        else  // it does not have children, add it here.
-        {
-            // Check if it already exists.
-            for (auto &existPoint : mPoints)
-            {
-                if (point.x == existPoint.x && point.y == existPoint.y)
-                {
-                    return false;
-                }
-            }
-            // Add point.
-            mPoints.push_back(point);
-            added = true;
 
-            // Check if we should subdivide.
-            if ((int)mPoints.size() > MaxPointsPerNode)
-            {
-                SubDivide();
-            }
-        }
+        mElements.swap(elements);
+        mElmtExtents.swap(extents);
 
-        return added;
-    }
+        auto level = Pack(mElmtExtents, 0, true);
 
-    void Add(Leaf<T> elmtLeaf)
-    {
-        // If no overlap, do not add it here.
-        if (!GeomCalculator::IsExtentOverlap(mExtent, elmtLeaf.mExtent))
+        // Orders the nodes of each level, and packs them into upper levels.
+        while (true)
         {
-            return;
-        }
+            mDepth++;
 
-        if (HasChildren())
-        {
-            for (auto &child : mChildren)
+            std::vector<GeomExtent> levelExtents(level.size());
+            for (size_t i = 0; i < level.size(); i++)
             {
-                child.Add(elmtLeaf);
+                levelExtents[i] = level[i].mExtent;
             }
-        }
-        else
-        {
-            mElements.push_back(elmtLeaf);
-        }
-    }
 
-    void FindElements(const GeomExtent &extent, std::vector<T> &elmts)
-    {
-        // If no overlap, just return.
-        if (!GeomCalculator::IsExtentOverlap(mExtent, extent))
-        {
-            return;
-        }
-
-        // If has children, ask those.
-        if (HasChildren())
-        {
-            for (auto &child : mChildren)
+            int start = (int)mNodes.size();
+            for (int k : SortTileRecursive(levelExtents))
             {
-                child.FindElements(extent, elmts);
+                mNodes.push_back(level[k]);
+                levelExtents[mNodes.size() - 1 - start] = level[k].mExtent;
             }
-        }
-        else  // No children, search in elements of this node.
-        {
-            for (auto &elmtLeaf : mElements)
+
+            if (level.size() == 1)
             {
-                if (GeomCalculator::IsExtentOverlap(elmtLeaf.mExtent, extent))
-                {
-                    // Check if it is already there.
-                    if (std::find(begin(elmts), end(elmts), elmtLeaf.mElement)
-                        != elmts.end())
-                    {
-                        elmts.push_back(elmtLeaf.mElement);
-                    }
-                }
+                mRoot = start;
+                break;
             }
-        }
-    }
 
-    int Depth(int i)
-    {
-        int mydepth = i + 1;
-        if (!HasChildren())
-        {
-            return mydepth;
+            level = Pack(levelExtents, start, false);
         }
-
-        int depth = mydepth;
-        for (auto child : mChildren)
-        {
-            depth = std::max(depth, child.Depth(mydepth));
-        }
-        return depth;
     }
 
-    int Nodes()
+    /// @brief Finds elements with extends that overlaps the provided "extent".
+    ///
+    /// @param extent Extent to look for elements within.
+    /// @returns A list of elements with overlapping extents.
+    std::vector<T> FindElements(const GeomExtent &extent) const
     {
-        if (!HasChildren())
-        {
-            return 1;
-        }
-
-        int count = 1;
-        for (auto child : mChildren)
-        {
-            count += child.Nodes();
-        }
-        return count;
+        std::vector<T> elmts;
+        FindElements(extent, elmts);
+        return elmts;
     }
 
-    int MaxElementsInNode()
+    /// @brief Appends the elements overlapping the extent to the list.
+    void FindElements(const GeomExtent &extent, std::vector<T> &elmts) const
     {
-        if (!HasChildren())
+        CheckBuilt();
+        if (mRoot < 0)
         {
-            return mElements.size();
+            return;
         }
 
-        int count = 0;
-        for (auto child : mChildren)
+        std::vector<int> stack = {mRoot};
+        while (!stack.empty())
         {
-            count = std::max(count, child.MaxElementsInNode());
-        }
-        return count;
-    }
-
-private:
-    void SubDivide()
-    {
-        // Create children.
-        mChildren = std::vector<TreeNode>(4, GeomExtent());
-
-        double xMid = 0.5 * (mExtent.xMin + mExtent.xMax);
-        double yMid = 0.5 * (mExtent.yMin + mExtent.yMax);
+            const auto &node = mNodes[stack.back()];
+            stack.pop_back();
 
-        GeomExtent tempVar{xMid, mExtent.xMax, yMid, mExtent.yMax};
-        mChildren[0] = TreeNode(tempVar);
-
-        GeomExtent tempVar2{mExtent.xMin, xMid, yMid, mExtent.yMax};
-        mChildren[1] = TreeNode(tempVar2);
-
-        GeomExtent tempVar3{mExtent.xMin, xMid, mExtent.yMin, yMid};
-        mChildren[2] = TreeNode(tempVar3);
-
-        GeomExtent tempVar4{xMid, mExtent.xMax, mExtent.yMin, yMid};
-        mChildren[3] = TreeNode(tempVar4);
-
-        // Add points of this node to the new children.
-        for (auto &point : mPoints)
-        {
-            for (auto &child : mChildren)
+            for (int k = node.mFirst; k < node.mFirst + node.mCount; k++)
             {
-                child.Add(point);
+                if (node.mIsLeaf)
+                {
+                    if (GeomCalculator::IsExtentOverlap(mElmtExtents[k], extent))
+                    {
+                        elmts.push_back(mElements[k]);
+                    }
+                }
+                else if (GeomCalculator::IsExtentOverlap(mNodes[k].mExtent, extent))
+                {
+                    stack.push_back(k);
+                }
             }
         }
-
-        // Clear points of this node.
-        mPoints.clear();
     }
-};
-
-
-/// @brief 2D element search tree.
-/// The search tree structure is build up by adding a number of coordinates
-/// to the search tree, usually the coordinates of the nodes in the element.
-template <typename T>
-class ElementSearchTree
-{
-private:
-    /// @brief Head of the tree.
-    TreeNode<T> mHead;
-
-    /// Counts the number of unique nodes used for building up the tree.
-    int mNumNodes = 0;
 
-    /// Counts the number of elements added to the tree.
-    int mNumElmts = 0;
-
-public:
-    ElementSearchTree(const GeomExtent &extent) : mHead(extent)
-    {}
-
-    /// @brief Adds point to the search tree, thereby building the tree.
-    void Add(const Point &point)
+    /// @brief Finds elements overlapping each of the extents in parallel.
+    std::vector<std::vector<T>>
+    FindElements(const std::vector<GeomExtent> &extents) const
     {
-        if (HasElements())
-        {
-            throw std::runtime_error("Can not add nodes when tree has elements");
-        }
+        std::vector<std::vector<T>> elmts(extents.size());
 
-        bool added = mHead.Add(point);
-        if (added)
+#pragma omp parallel for schedule(dynamic, 64)
+        for (int i = 0; i < (int)extents.size(); i++)
         {
-            mNumNodes++;
+            FindElements(extents[i], elmts[i]);
         }
+
+        return elmts;
     }
 
-    /// @brief Adds element to the search tree.
-    void AddElement(T element, const GeomExtent &extent)
+    /// @brief Finds the elements nearest to the extent, ordered by the distance
+    /// between extents.
+    ///
+    /// @param count Max number of elements to find.
+    std::vector<T> FindNearest(const GeomExtent &extent, int count) const
     {
-        Leaf<T> leaf  = Leaf<T>();
-        leaf.mElement = element;
-        leaf.mExtent  = extent;
-
-        mHead.Add(leaf);
-        mNumElmts++;
+        return Nearest(extent, count, [&](int k) {
+            return ExtentDistance(extent, mElmtExtents[k]);
+        });
     }
 
-    /// @brief Finds elements with extends that overlaps the provided "extent".
+    /// @brief Finds the elements nearest to the extent, ordered by the distance.
     ///
-    /// @param extent Extent to look for elements within.
-    /// @returns A list of elements with overlapping extents.
-    std::vector<T> FindElements(const GeomExtent &extent)
+    /// @param count Max number of elements to find.
+    /// @param distance Exact distance from the extent to an element, which must not
+    /// be less than the distance between their extents.
+    template <typename Distance>
+    std::vector<T>
+    FindNearest(const GeomExtent &extent, int count, const Distance &distance) const
     {
-        std::vector<T> elmts;
-        mHead.FindElements(extent, elmts);
-        return elmts;
+        return Nearest(extent, count, [&](int k) { return distance(mElements[k]); });
+    }
+
+    /// @brief Returns the extent of all elements in the search tree.
+    GeomExtent GetExtent() const
+    {
+        CheckBuilt();
+        return mRoot < 0 ? GeomExtent() : mNodes[mRoot].mExtent;
     }
 
     /// @brief Returns the depth of the search tree.
     int Depth() const
     {
-        return mHead.Depth(0);
+        return mDepth;
     }
 
     /// @brief Returns the maximum number of elements in one search tree node.
     int MaxElementsInNode() const
     {
-        return mHead.MaxElementsInNode();
+        int count = 0;
+        for (const auto &node : mNodes)
+        {
+            if (node.mIsLeaf)
+            {
+                count = std::max(count, node.mCount);
+            }
+        }
+        return count;
     }
 
     /// @brief Returns the total number of nodes in the search tree.
     int TreeNodes() const
     {
-        return mHead.Nodes();
+        return (int)mNodes.size();
     }
 
     /// @brief Builds search tree based on an IElementSet, containing element
@@ -313,57 +250,150 @@ public:
     static ElementSearchTree<int>
     BuildSearchTree(const std::shared_ptr<IElementSet> &elmtSet)
     {
-        // Calculate start extent.
-        GeomExtent extent;
+        ElementSearchTree<int> tree;
 
         int elementCount = elmtSet->GetElementCount();
         for (int ielmt = 0; ielmt < elementCount; ielmt++)
         {
-            int vertixCount = elmtSet->GetNodeCount(ielmt);
-            for (int ivert = 0; ivert < vertixCount; ivert++)
-            {
-                double x = elmtSet->GetNodeXCoordinate(ielmt, ivert);
-                double y = elmtSet->GetNodeYCoordinate(ielmt, ivert);
-                GeomCalculator::UpdateExtent(extent, Point{x, y});
-            }
+            tree.AddElement(ielmt, NodeExtent(elmtSet, ielmt));
         }
 
-        // Create and build search tree, based on all vertex coordinates.
-        ElementSearchTree<int> tree(extent);
-        for (int ielmt = 0; ielmt < elementCount; ielmt++)
+        tree.Build();
+        return tree;
+    }
+
+private:
+    void CheckBuilt() const
+    {
+        if (!mBuilt)
+        {
+            throw std::runtime_error("Search tree must be built before searching");
+        }
+    }
+
+    /// @brief Returns the order of the extents tiled by their centers.
+    std::vector<int> SortTileRecursive(const std::vector<GeomExtent> &extents) const
+    {
+        int n      = (int)extents.size();
+        int leaves = (n + MaxElementsPerNode - 1) / MaxElementsPerNode;
+        int slices = (int)std::ceil(std::sqrt((double)leaves));
+        int size   = slices * MaxElementsPerNode;
+
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+
+        auto centerX = [&](int k) { return extents[k].xMin + extents[k].xMax; };
+        auto centerY = [&](int k) { return extents[k].yMin + extents[k].yMax; };
+
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return centerX(a) < centerX(b);
+        });
+
+        for (int first = 0; first < n; first += size)
         {
-            int vertixCount = elmtSet->GetNodeCount(ielmt);
-            for (int ivert = 0; ivert < vertixCount; ivert++)
+            auto last = order.begin() + std::min(n, first + size);
+            std::sort(order.begin() + first, last, [&](int a, int b) {
+                return centerY(a) < centerY(b);
+            });
+        }
+
+        return order;
+    }
+
+    /// @brief Groups the ordered entries into nodes.
+    /// @param start Index of the first entry.
+    std::vector<TreeNode>
+    Pack(const std::vector<GeomExtent> &extents, int start, bool isLeaf) const
+    {
+        std::vector<TreeNode> nodes;
+        for (int first = 0; first < (int)extents.size(); first += MaxElementsPerNode)
+        {
+            TreeNode node;
+            node.mFirst  = start + first;
+            node.mCount  = std::min(MaxElementsPerNode, (int)extents.size() - first);
+            node.mIsLeaf = isLeaf;
+            node.mExtent = extents[first];
+            for (int k = first + 1; k < first + node.mCount; k++)
             {
-                double x = elmtSet->GetNodeXCoordinate(ielmt, ivert);
-                double y = elmtSet->GetNodeYCoordinate(ielmt, ivert);
-                tree.Add(Point{x, y});
+                GeomCalculator::UpdateExtent(node.mExtent, extents[k]);
             }
+
+            nodes.push_back(node);
         }
 
-        // Add elements to the search tree.
-        for (int ielmt = 0; ielmt < elementCount; ielmt++)
+        return nodes;
+    }
+
+    /// @brief Finds the nearest elements in the order of the distance, visiting the
+    /// nodes by their least distance first.
+    template <typename Distance>
+    std::vector<T>
+    Nearest(const GeomExtent &extent, int count, const Distance &distance) const
+    {
+        CheckBuilt();
+
+        std::vector<T> elmts;
+        if (mRoot < 0 || count <= 0)
+        {
+            return elmts;
+        }
+
+        // Entries of (distance, is element, index), the nearest on the top.
+        using Entry = std::tuple<double, bool, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        queue.emplace(ExtentDistance(extent, mNodes[mRoot].mExtent), false, mRoot);
+
+        while (!queue.empty() && (int)elmts.size() < count)
         {
-            int        vertixCount = elmtSet->GetNodeCount(ielmt);
-            GeomExtent elmtExtent;
-            for (int ivert = 0; ivert < vertixCount; ivert++)
+            auto [dist, isElement, index] = queue.top();
+            queue.pop();
+
+            if (isElement)
             {
-                double x = elmtSet->GetNodeXCoordinate(ielmt, ivert);
-                double y = elmtSet->GetNodeYCoordinate(ielmt, ivert);
-                GeomCalculator::UpdateExtent(extent, Point{x, y});
+                elmts.push_back(mElements[index]);
+                continue;
             }
 
-            tree.AddElement(ielmt, elmtExtent);
+            const auto &node = mNodes[index];
+            for (int k = node.mFirst; k < node.mFirst + node.mCount; k++)
+            {
+                if (node.mIsLeaf)
+                    queue.emplace(distance(k), true, k);
+                else
+                    queue.emplace(ExtentDistance(extent, mNodes[k].mExtent), false, k);
+            }
         }
 
-        return tree;
+        return elmts;
     }
 
-private:
-    bool HasElements() const
+    /// @brief Returns the least distance between two extents in the xy plane.
+    static double ExtentDistance(const GeomExtent &e1, const GeomExtent &e2)
+    {
+        double dx = std::max({0.0, e1.xMin - e2.xMax, e2.xMin - e1.xMax});
+        double dy = std::max({0.0, e1.yMin - e2.yMax, e2.yMin - e1.yMax});
+        return std::hypot(dx, dy);
+    }
+
+    /// @brief Returns the extent of the nodes of the element.
+    static GeomExtent NodeExtent(const std::shared_ptr<IElementSet> &elmtSet, int ielmt)
     {
-        return mNumElmts > 0;
+        GeomExtent extent;
+        int        vertixCount = elmtSet->GetNodeCount(ielmt);
+        for (int ivert = 0; ivert < vertixCount; ivert++)
+        {
+            Point point{
+                elmtSet->GetNodeXCoordinate(ielmt, ivert),
+                elmtSet->GetNodeYCoordinate(ielmt, ivert)};
+
+            if (ivert == 0)
+                extent = GeomExtent{point.x, point.x, point.y, point.y};
+            else
+                GeomCalculator::UpdateExtent(extent, point);
+        }
+
+        return extent;
     }
 };
 
-}  // namespace OpenOasis::CommImp::DevSupports
\ No newline at end of file
+}  // namespace OpenOasis::CommImp::DevSupports
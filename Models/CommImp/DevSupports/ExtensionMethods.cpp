@@ -126,6 +126,42 @@ void ExtensionMethods::SetSingleTimeSpan(
         endTime->GetTimeStamp() + endTime->GetDurationInDays());
 }
 
+void ExtensionMethods::RemoveTimesBefore(
+    const shared_ptr<ITimeSet> &timeSet, const shared_ptr<IValueSet> &values,
+    double timestamp)
+{
+    // Counts the expired times, without copying the times of `TimeSet`.
+    int count = 0;
+    if (auto sortedTimes = dynamic_pointer_cast<TimeSet>(timeSet))
+    {
+        while (count < sortedTimes->GetCount()
+               && (*sortedTimes)[count]->GetTimeStamp() < timestamp)
+            count++;
+
+        sortedTimes->RemoveTimeRange(0, count);
+    }
+    else
+    {
+        const auto &times = timeSet->GetTimes();
+        while (count < (int)times.size() && times[count]->GetTimeStamp() < timestamp)
+            count++;
+
+        for (int i = 0; i < count; i++)
+            timeSet->RemoveTime(0);
+    }
+
+    if (auto dense = dynamic_pointer_cast<ValueSetDense<real>>(values))
+    {
+        dense->RemoveTimesBefore(count);
+        return;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        values->RemoveValue({0});
+    }
+}
+
 int ExtensionMethods::ElementCount(const shared_ptr<IValueSet> &values)
 {
     return values->GetIndexCount({0, 0});
@@ -19,6 +19,7 @@
 #include "Models/Inc/IInput.h"
 #include "Models/Inc/IOutput.h"
 #include "Models/Inc/ILinkableComponent.h"
+#include "Models/CommImp/ValueSetDense.h"
 #include "Models/Utils/DateTime.h"
 #include "Models/Utils/StringHelper.h"
 #include "Models/Utils/CommConstants.h"
@@ -149,6 +150,16 @@ public:
         const std::shared_ptr<ITimeSet> &timeSet,
         const std::shared_ptr<ITime> &startTime, const std::shared_ptr<ITime> &endTime);
 
+    /// @brief Removes the times earlier than the time stamp and their values
+    /// synchronously, the `TimeSet` and `ValueSetDense` expire them in O(1).
+    ///
+    /// @param timeSet Time set sorted from early to late.
+    /// @param values Value set whose times match the time set.
+    /// @param timestamp Earliest time stamp to keep.
+    static void RemoveTimesBefore(
+        const std::shared_ptr<ITimeSet>  &timeSet,
+        const std::shared_ptr<IValueSet> &values, double timestamp);
+
     ///////////////////////////////////////////////////////////////////////////////////
     // Methods related to value sets.
     //
@@ -170,6 +181,12 @@ public:
     static std::vector<T>
     GetElementValuesForTime(const std::shared_ptr<IValueSet> &values, int timeIndex)
     {
+        // Copy the contiguous values directly.
+        if (auto dense = std::dynamic_pointer_cast<ValueSetDense<T>>(values))
+        {
+            return dense->GetElementValuesForTimeSpan(timeIndex).ToVector();
+        }
+
         const auto &elmtValues = values->GetElementValuesForTime(timeIndex);
 
         // Check if it's already an array.
@@ -1,337 +1,620 @@
-// /**
-// ***********************************************************************************
-//  *    @File      :  IterationController.cpp
-//  *    @Brief     :  IterationController controls iterations among linkable
-//  components.
-//  *
-//  **
-//  ***********************************************************************************/
-// #include "IterationController.h"
-// #include "Models/CommImp/Arguments.h"
-// #include "Models/Utils/Exception.h"
-// #include "Models/Utils/StringHelper.h"
-// #include "Models/CommImp/Output.h"
-// #include "Models/CommImp/Time.h"
-// #include "Models/CommImp/TimeSet.h"
-
-
-// namespace OpenOasis::CommImp::DevSupports
-// {
-// using namespace std;
-// using namespace OpenOasis::Utils;
-
-// //
-// ------------------------------------------------------------------------------------
-
-// IterationController::IterationController(const string &id) : LinkableComponent(id)
-// {
-//     mCaption     = "Iteration Controller";
-//     mDescription = "IterationController controls iterations among linkable
-//     components";
-
-//     mRequiredArguments       = {"ID", "MaxIter", "Eps", "Relaxation"};
-//     mArguments["ID"]         = make_shared<ArgumentString>("ID", mId);
-//     mArguments["MaxIter"]    = make_shared<ArgumentInt>("MaxIter", mMaxIter);
-//     mArguments["Eps"]        = make_shared<ArgumentDouble>("Eps", mEps);
-//     mArguments["Relaxation"] = make_shared<ArgumentDouble>("Relaxation",
-//     mRelaxation);
-
-//     mTimeExtent  = nullptr;
-//     mCurrentTime = nullptr;
-// }
-
-// void IterationController::InitializeArguments()
-// {
-//     for (const auto &kid : mRequiredArguments)
-//     {
-//         any value = mArguments[kid]->GetValue();
-//         if (kid == "MaxIter")
-//         {
-//             mMaxIter = any_cast<int>(value);
-//         }
-//         else if (kid == "Eps")
-//         {
-//             mEps = any_cast<double>(value);
-//         }
-//         else if (kid == "Relaxation")
-//         {
-//             mRelaxation = any_cast<double>(value);
-//         }
-//     }
-// }
-
-// void IterationController::AddComponent(shared_ptr<ILinkableComponent> component)
-// {
-//     auto comp = dynamic_pointer_cast<LinkableComponent>(component);
-//     if (!comp)
-//     {
-//         return;
-//     }
-
-//     comp->SetCascadingUpdateCallsDisabled(true);
-
-//     mComponentSet[component->GetId()] = comp;
-// }
-
-// void IterationController::InitializeInputs()
-// {
-//     mInnerInputSet.clear();
-//     mInputs.clear();
-
-//     for (const auto &comPair : mComponentSet)
-//     {
-//         const auto &component = comPair.second;
-//         for (const auto &input : component->GetInputs())
-//         {
-//             if (input->GetProviders().empty())
-//                 continue;
-
-//             // Check if the input is outer. Note that the input is outer if it is not
-//             // provided by any of the components in the internal set.
-//             const auto &providers = input->GetProviders();
-//             bool        isOuter =
-//                 all_of(begin(providers), end(providers), [&](const auto &provider) {
-//                     string compId(provider.lock()->GetComponent().lock()->GetId());
-//                     return mComponentSet.count(compId) == 0;
-//                 });
-
-//             if (isOuter)
-//             {
-//                 mInputs.push_back(input);
-//             }
-//             else
-//             {
-//                 mInnerInputSet.push_back(input);
-//             }
-//         }
-//     }
-// }
-
-// void IterationController::InitializeOutputs()
-// {
-//     mInnerOutputSet.clear();
-//     mOutputs.clear();
-
-//     for (const auto &comPair : mComponentSet)
-//     {
-//         const auto &component = comPair.second;
-//         for (const auto &output : component->GetOutputs())
-//         {
-//             if (output->GetConsumers().empty())
-//                 continue;
-
-//             // Check if the output is outer.
-//             const auto &consumers = output->GetConsumers();
-//             bool        isOuter =
-//                 all_of(begin(consumers), end(consumers), [this](const auto &consumer)
-//                 {
-//                     string compId(consumer.lock()->GetComponent().lock()->GetId());
-//                     return mComponentSet.count(compId) == 0;
-//                 });
-
-//             if (isOuter)
-//             {
-//                 mOutputs.push_back(output);
-//             }
-//             else
-//             {
-//                 mInnerOutputSet.push_back(output);
-//             }
-//         }
-//     }
-// }
-
-// void IterationController::InitializeTime()
-// {
-//     mTimeExtent = make_shared<TimeSet>();
-
-//     auto currents = vector<shared_ptr<ITime>>();
-//     auto begins   = vector<shared_ptr<ITime>>();
-//     auto ends     = vector<shared_ptr<ITime>>();
-
-//     for (const auto &comp : mComponentSet)
-//     {
-//         currents.push_back(comp.second->GetNowTime());
-//         begins.push_back(comp.second->GetStartTime());
-//         ends.push_back(comp.second->GetEndTime());
-//     }
-
-//     // auto comp = [](shared_ptr<ITime> a, shared_ptr<ITime> b) {
-//     //     return a->GetTimeStamp() < b->GetTimeStamp();
-//     // };
-//     sort(begin(currents), end(currents));
-//     sort(begin(begins), end(begins));
-//     sort(begin(ends), end(ends));
-
-//     mCurrentTime = make_shared<Time>(currents.front()->GetTimeStamp());
-//     mTimeExtent->AddTime(make_shared<Time>(begins.front()->GetTimeStamp()));
-//     mTimeExtent->AddTime(make_shared<Time>(ends.back()->GetTimeStamp()));
-// }
-
-// vector<string> IterationController::OnValidate()
-// {
-//     vector<string> errors;
-
-//     for (const auto &comPair : mComponentSet)
-//     {
-//         const auto &innerInputIter =
-//             find_if(begin(mInnerInputSet), end(mInnerInputSet), [&](const auto
-//             &input) {
-//                 return input->GetComponent().lock()->GetId() == comPair.first;
-//             });
-//         if (innerInputIter == end(mInnerInputSet))
-//         {
-//             string msg = StringHelper::FormatSimple(
-//                 "LinkableComponent [{}] in InterationController [{}] has no inner
-//                 inputs.", comPair.first, mId);
-//             errors.push_back(msg);
-//         }
-
-//         const auto &innerOutputIter = find_if(
-//             begin(mInnerOutputSet), end(mInnerOutputSet), [&](const auto &output) {
-//                 return output->GetComponent().lock()->GetId() == comPair.first;
-//             });
-//         if (innerOutputIter == end(mInnerOutputSet))
-//         {
-//             string msg = StringHelper::FormatSimple(
-//                 "LinkableComponent [{}] in InterationController [{}] has no inner
-//                 outputs.", comPair.first, mId);
-//             errors.push_back(msg);
-//         }
-//     }
-
-//     if (mMaxIter < 1)
-//     {
-//         string msg = StringHelper::FormatSimple(
-//             "MaxIter for IterationController [{}] must be greater than 1.", mId);
-//         errors.push_back(msg);
-//     }
-//     if (mEps < 0)
-//     {
-//         string msg = StringHelper::FormatSimple(
-//             "Eps for IterationController [{}] must be greater than 0.", mId);
-//         errors.push_back(msg);
-//     }
-//     if (mRelaxation < 0 || mRelaxation > 1)
-//     {
-//         string msg = StringHelper::FormatSimple(
-//             "Relaxation for IterationController [{}] must be in [0, 1].", mId);
-//         errors.push_back(msg);
-//     }
-
-//     return errors;
-// }
-
-// void IterationController::PrepareOutputs()
-// {
-//     // To rebuild the output-linkages between components. To change the ownership
-//     // component saved in the output item, while retaining the ownership of the
-//     original
-//     // component to the output. This allows calls to the output item to be
-//     intercepted
-//     // and the original component is still responsible for updating the output.
-
-//     auto iterator = dynamic_pointer_cast<IterationController>(shared_from_this());
-//     for (auto &output : mOutputs)
-//     {
-//         auto item = dynamic_pointer_cast<Output>(output);
-//         if (!item)
-//         {
-//             throw NotSupportedException(StringHelper::FormatSimple(
-//                 "Unsupported output type in component [{}] in IterationController {},
-//                 \ only `OpenOasis::CommImp::Output` is supported.",
-//                 output->GetComponent().lock()->GetId(),
-//                 mId));
-//         }
-
-//         // This wouldn't erase the ownership of the original component to the output
-//         and
-//         // the linkages between the input items with the output item.
-//         item->SetComponent(iterator);
-//     }
-// }
-
-// void IterationController::PerformTimestep(
-//     const vector<shared_ptr<IOutput>> &requiredOutputs)
-// {
-//     // printf("\n --- iteration at time: %f :\n", mCurrentTime->GetTimeStamp());
-//     mIter = 0;
-//     while (true)
-//     {
-//         CollectStates();
-
-//         try
-//         {
-//             mComponentSet.begin()->second->Update();
-//         }
-//         catch (...)
-//         {}
-
-//         if (IsIterationConverged())
-//         {
-//             for (auto &comPair : mComponentSet)
-//             {
-//                 comPair.second->UpdateInputTimesAndValues();
-//                 comPair.second->SetStatus(
-//                     comPair.second->GetNowTime()->GetTimeStamp()
-//                             >= GetEndTime()->GetTimeStamp() ?
-//                         LinkableComponentStatus::Done :
-//                         LinkableComponentStatus::Updated);
-//             }
-//             break;
-//         }
-
-//         mIter++;
-//         ResetStates();
-//     }
-
-//     auto currents = vector<shared_ptr<ITime>>();
-//     for (const auto &comp : mComponentSet)
-//     {
-//         currents.push_back(comp.second->GetNowTime());
-//     }
-
-//     // auto comp = [](shared_ptr<ITime> a, shared_ptr<ITime> b) {
-//     //     return a->GetTimeStamp() < b->GetTimeStamp();
-//     // };
-//     sort(begin(currents), end(currents));
-//     mCurrentTime = make_shared<Time>(currents.front()->GetTimeStamp());
-// }
-
-// bool IterationController::IsIterationConverged() const
-// {
-//     bool isIterationDone = mIter > mMaxIter;
-
-//     bool isAllCompsConverged = true;
-//     for (const auto &comPair : mComponentSet)
-//     {
-//         // Leave the check of whether the iterations converge to each components.
-//         if (!comPair.second->IsIterationConverged())
-//         {
-//             isAllCompsConverged = false;
-//             break;
-//         }
-//     }
-
-//     return (isIterationDone) ? true : isAllCompsConverged;
-// }
-
-// void IterationController::CollectStates()
-// {
-//     mStates.clear();
-//     for (const auto &comPair : mComponentSet)
-//     {
-//         mStates[comPair.first] = comPair.second->KeepCurrentState();
-//     }
-// }
-
-// void IterationController::ResetStates()
-// {
-//     for (const auto &comPair : mComponentSet)
-//     {
-//         comPair.second->RestoreState(mStates[comPair.first]);
-//         comPair.second->ClearState(mStates[comPair.first]);
-//     }
-// }
-
-// }  // namespace OpenOasis::CommImp::DevSupports
\ No newline at end of file
+/** ***********************************************************************************
+ *    @File      :  IterationController.cpp
+ *    @Brief     :  IterationController controls iterations among linkable components.
+ *
+ ** ***********************************************************************************/
+#include "IterationController.h"
+#include "Models/CommImp/Arguments.h"
+#include "Models/CommImp/Output.h"
+#include "Models/CommImp/Time.h"
+#include "Models/CommImp/TimeSet.h"
+#include "Models/CommImp/DevSupports/ExtensionMethods.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/Logger.h"
+#include "Models/Utils/StringHelper.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace std;
+using namespace OpenOasis::Utils;
+
+
+IterationController::IterationController(const string &id) : LinkableComponent(id)
+{
+    mCaption     = "Iteration Controller";
+    mDescription = "IterationController controls iterations among linkable components";
+
+    mRequiredArguments = {
+        "ID",
+        "MaxIter",
+        "Eps",
+        "Relaxation",
+        "Acceleration",
+        "HistoryDepth",
+        "Threads"};
+
+    mArguments["ID"]         = make_shared<ArgumentString>("ID", mId);
+    mArguments["MaxIter"]    = make_shared<ArgumentInt>("MaxIter", mMaxIter);
+    mArguments["Eps"]        = make_shared<ArgumentDouble>("Eps", mEps);
+    mArguments["Relaxation"] = make_shared<ArgumentDouble>("Relaxation", mRelaxation);
+    mArguments["Acceleration"] =
+        make_shared<ArgumentString>("Acceleration", mAcceleration);
+    mArguments["HistoryDepth"] =
+        make_shared<ArgumentInt>("HistoryDepth", mHistoryDepth);
+    mArguments["Threads"] = make_shared<ArgumentInt>("Threads", mNumThreads);
+
+    mTimeExtent  = nullptr;
+    mCurrentTime = nullptr;
+}
+
+void IterationController::InitializeArguments()
+{
+    for (const auto &kid : mRequiredArguments)
+    {
+        any value = mArguments[kid]->GetValue();
+        if (kid == "MaxIter")
+        {
+            mMaxIter = any_cast<int>(value);
+        }
+        else if (kid == "Eps")
+        {
+            mEps = any_cast<double>(value);
+        }
+        else if (kid == "Relaxation")
+        {
+            mRelaxation = any_cast<double>(value);
+        }
+        else if (kid == "Acceleration")
+        {
+            mAcceleration = any_cast<string>(value);
+        }
+        else if (kid == "HistoryDepth")
+        {
+            mHistoryDepth = any_cast<int>(value);
+        }
+        else if (kid == "Threads")
+        {
+            mNumThreads = any_cast<int>(value);
+        }
+    }
+
+    mAccelerator = ConvergenceAccelerator(
+        ConvergenceAccelerator::ParseMethod(mAcceleration), mRelaxation, mHistoryDepth);
+}
+
+void IterationController::SetIterationConfigs(const multimap<string, string> &configs)
+{
+    // Several links may configure the same group, the strictest one is taken.
+    bool   hasMaxIter = false, hasEps = false, hasRelax = false;
+    int    maxIter    = mMaxIter;
+    double eps = mEps, relaxation = mRelaxation;
+
+    for (const auto &pair : configs)
+    {
+        if (pair.first == "max_iter_steps")
+        {
+            int value  = StringHelper::FromString<int>(pair.second);
+            maxIter    = hasMaxIter ? max(maxIter, value) : value;
+            hasMaxIter = true;
+        }
+        else if (pair.first == "tolerance")
+        {
+            double value = StringHelper::FromString<double>(pair.second);
+            eps          = hasEps ? min(eps, value) : value;
+            hasEps       = true;
+        }
+        else if (pair.first == "relaxation")
+        {
+            double value = StringHelper::FromString<double>(pair.second);
+            relaxation   = hasRelax ? min(relaxation, value) : value;
+            hasRelax     = true;
+        }
+        else if (pair.first == "acceleration")
+        {
+            mArguments["Acceleration"]->SetValue(pair.second);
+        }
+        else if (pair.first == "history_depth")
+        {
+            int value = StringHelper::FromString<int>(pair.second);
+            mArguments["HistoryDepth"]->SetValue(value);
+        }
+        else if (pair.first == "threads")
+        {
+            mArguments["Threads"]->SetValue(StringHelper::FromString<int>(pair.second));
+        }
+    }
+
+    mArguments["MaxIter"]->SetValue(maxIter);
+    mArguments["Eps"]->SetValue(eps);
+    mArguments["Relaxation"]->SetValue(relaxation);
+}
+
+void IterationController::AddComponent(shared_ptr<ILinkableComponent> component)
+{
+    auto comp = dynamic_pointer_cast<LinkableComponent>(component);
+    if (!comp)
+    {
+        throw NotSupportedException(StringHelper::FormatSimple(
+            "Component [{}] in IterationController [{}] is not a LinkableComponent.",
+            component->GetId(),
+            mId));
+    }
+
+    // States are restored before each sweep but the first one, so check the support
+    // here rather than in the middle of the first iteration.
+    try
+    {
+        comp->ClearState(comp->KeepCurrentState());
+    }
+    catch (const NotImplementedException &)
+    {
+        throw NotSupportedException(StringHelper::FormatSimple(
+            "Component [{}] in IterationController [{}] can't keep and restore its "
+            "states, which iterations require.",
+            component->GetId(),
+            mId));
+    }
+
+    // Time horizon of inputs is updated by the controller after convergence.
+    comp->SetCascadingUpdateCallsDisabled(true);
+
+    mComponentSet[component->GetId()] = comp;
+}
+
+vector<string> IterationController::GetComponentIds() const
+{
+    vector<string> ids;
+    for (const auto &comPair : mComponentSet)
+    {
+        ids.push_back(comPair.first);
+    }
+
+    return ids;
+}
+
+int IterationController::GetIterationCount() const
+{
+    return mIter;
+}
+
+double IterationController::GetResidual() const
+{
+    return mResidual;
+}
+
+void IterationController::InitializeInputs()
+{
+    mInnerInputSet.clear();
+    mInputs.clear();
+
+    for (const auto &comPair : mComponentSet)
+    {
+        const auto &component = comPair.second;
+        for (const auto &input : component->GetInputs())
+        {
+            if (input->GetProviders().empty())
+                continue;
+
+            // Check if the input is outer. Note that the input is outer if it is not
+            // provided by any of the components in the internal set.
+            const auto &providers = input->GetProviders();
+            bool        isOuter =
+                all_of(begin(providers), end(providers), [&](const auto &provider) {
+                    string compId(provider.lock()->GetComponent().lock()->GetId());
+                    return mComponentSet.count(compId) == 0;
+                });
+
+            if (isOuter)
+            {
+                mInputs.push_back(input);
+            }
+            else
+            {
+                mInnerInputSet.push_back(input);
+            }
+        }
+    }
+}
+
+void IterationController::InitializeOutputs()
+{
+    mInnerOutputSet.clear();
+    mOutputs.clear();
+
+    for (const auto &comPair : mComponentSet)
+    {
+        const auto &component = comPair.second;
+        for (const auto &output : component->GetOutputs())
+        {
+            if (output->GetConsumers().empty())
+                continue;
+
+            // Check if the output is outer.
+            const auto &consumers = output->GetConsumers();
+            bool        isOuter =
+                all_of(begin(consumers), end(consumers), [this](const auto &consumer) {
+                    string compId(consumer.lock()->GetComponent().lock()->GetId());
+                    return mComponentSet.count(compId) == 0;
+                });
+
+            if (isOuter)
+            {
+                mOutputs.push_back(output);
+            }
+            else
+            {
+                mInnerOutputSet.push_back(output);
+            }
+        }
+    }
+}
+
+void IterationController::InitializeTime()
+{
+    mTimeExtent = make_shared<TimeSet>();
+
+    double currTime  = numeric_limits<double>::max();
+    double beginTime = numeric_limits<double>::max();
+    double endTime   = numeric_limits<double>::lowest();
+
+    for (const auto &comPair : mComponentSet)
+    {
+        const auto &comp = comPair.second;
+
+        auto now  = comp->GetNowTime() ? comp->GetNowTime() : comp->GetStartTime();
+        currTime  = min(currTime, now->GetTimeStamp());
+        beginTime = min(beginTime, comp->GetStartTime()->GetTimeStamp());
+        endTime   = max(endTime, comp->GetEndTime()->GetTimeStamp());
+    }
+
+    mCurrentTime = make_shared<Time>(currTime);
+    mTimeExtent->AddTime(make_shared<Time>(beginTime, endTime - beginTime));
+}
+
+vector<string> IterationController::OnValidate()
+{
+    vector<string> errors;
+
+    if (mComponentSet.empty())
+    {
+        string msg = StringHelper::FormatSimple(
+            "IterationController [{}] has no components.", mId);
+        errors.push_back(msg);
+    }
+
+    for (const auto &comPair : mComponentSet)
+    {
+        const auto &innerInputIter =
+            find_if(begin(mInnerInputSet), end(mInnerInputSet), [&](const auto &input) {
+                return input->GetComponent().lock()->GetId() == comPair.first;
+            });
+        if (innerInputIter == end(mInnerInputSet))
+        {
+            string msg = StringHelper::FormatSimple(
+                "LinkableComponent [{}] in IterationController [{}] has no inner "
+                "inputs.",
+                comPair.first,
+                mId);
+            errors.push_back(msg);
+        }
+
+        const auto &innerOutputIter = find_if(
+            begin(mInnerOutputSet), end(mInnerOutputSet), [&](const auto &output) {
+                return output->GetComponent().lock()->GetId() == comPair.first;
+            });
+        if (innerOutputIter == end(mInnerOutputSet))
+        {
+            string msg = StringHelper::FormatSimple(
+                "LinkableComponent [{}] in IterationController [{}] has no inner "
+                "outputs.",
+                comPair.first,
+                mId);
+            errors.push_back(msg);
+        }
+    }
+
+    if (mMaxIter < 1)
+    {
+        string msg = StringHelper::FormatSimple(
+            "MaxIter for IterationController [{}] must be at least 1.", mId);
+        errors.push_back(msg);
+    }
+    if (mEps < 0)
+    {
+        string msg = StringHelper::FormatSimple(
+            "Eps for IterationController [{}] must be greater than 0.", mId);
+        errors.push_back(msg);
+    }
+    if (mRelaxation <= 0 || mRelaxation > 1)
+    {
+        string msg = StringHelper::FormatSimple(
+            "Relaxation for IterationController [{}] must be in (0, 1].", mId);
+        errors.push_back(msg);
+    }
+
+    return errors;
+}
+
+void IterationController::OnPrepare()
+{
+    LinkableComponent::OnPrepare();
+
+    // Components of the group are evaluated concurrently in each sweep.
+    int numComps   = max((int)mComponentSet.size(), 1);
+    int numThreads = mNumThreads > 0 ? mNumThreads : numComps;
+    mPool          = make_unique<ThreadPool>(min(numThreads, numComps));
+}
+
+void IterationController::PrepareOutputs()
+{
+    // To rebuild the output-linkages between components. To change the ownership
+    // component saved in the output item, while retaining the ownership of the
+    // original component to the output. This allows calls to the output item to be
+    // intercepted and the original component is still responsible for updating the
+    // output.
+
+    auto iterator = dynamic_pointer_cast<IterationController>(shared_from_this());
+    for (auto &output : mOutputs)
+    {
+        auto item = dynamic_pointer_cast<Output>(output);
+        if (!item)
+        {
+            throw NotSupportedException(StringHelper::FormatSimple(
+                "Unsupported output type in component [{}] in IterationController "
+                "[{}], only `OpenOasis::CommImp::Output` is supported.",
+                output->GetComponent().lock()->GetId(),
+                mId));
+        }
+
+        // This wouldn't erase the ownership of the original component to the output
+        // and the linkages between the input items with the output item.
+        item->SetComponent(iterator);
+    }
+
+    // Inner outputs are updated by sweeps only, never by requests of consumers.
+    for (auto &output : mInnerOutputSet)
+    {
+        auto item = dynamic_pointer_cast<Output>(output);
+        if (item)
+        {
+            item->SetComponentUpdateDisabled(true);
+        }
+    }
+}
+
+void IterationController::PerformTimestep(const vector<shared_ptr<IOutput>> &)
+{
+    CollectStates();
+    mLastIterate.clear();
+    mAccelerator.Reset();
+
+    bool converged = false;
+    for (mIter = 1;; mIter++)
+    {
+        Sweep();
+        if (mStatus == LinkableComponentStatus::Failed)
+        {
+            ClearStates();
+            return;
+        }
+
+        AccelerateInnerOutputs();
+
+        converged = IsIterationConverged();
+        if (converged || mIter >= mMaxIter)
+        {
+            break;
+        }
+
+        ResetStates();
+    }
+
+    ClearStates();
+
+    if (!converged)
+    {
+        Logger::Warn(StringHelper::FormatSimple(
+            "IterationController [{}] not converged in [{}] iterations, residual [{}].",
+            mId,
+            mIter,
+            mResidual));
+    }
+
+    // Accept the iterate and update the time horizon of inputs. The controller
+    // follows the slowest component not done yet.
+    double currTime = numeric_limits<double>::max();
+    double lastTime = numeric_limits<double>::lowest();
+    for (auto &comPair : mComponentSet)
+    {
+        const auto &comp = comPair.second;
+
+        double nowTime = comp->GetNowTime()->GetTimeStamp();
+        lastTime       = max(lastTime, nowTime);
+        if (comp->GetStatus() == LinkableComponentStatus::Done)
+        {
+            continue;
+        }
+
+        comp->UpdateInputs();
+        if (nowTime >= comp->GetEndTime()->GetTimeStamp())
+        {
+            comp->SetStatus(LinkableComponentStatus::Done);
+            continue;
+        }
+
+        comp->SetStatus(LinkableComponentStatus::Updated);
+        currTime = min(currTime, nowTime);
+    }
+
+    bool allDone = currTime == numeric_limits<double>::max();
+    mCurrentTime = make_shared<Time>(allDone ? lastTime : currTime);
+}
+
+void IterationController::Sweep()
+{
+    // Components reached the end time are no longer updated.
+    vector<shared_ptr<LinkableComponent>> comps;
+    for (const auto &comPair : mComponentSet)
+    {
+        if (comPair.second->GetStatus() != LinkableComponentStatus::Done)
+        {
+            comps.push_back(comPair.second);
+        }
+    }
+
+    if (comps.empty())
+    {
+        return;
+    }
+
+    // Inputs are pulled one by one, since outer providers may be updated on requests.
+    for (const auto &comp : comps)
+    {
+        comp->SetStatus(LinkableComponentStatus::WaitingForData);
+        comp->PullInputs();
+        comp->SetStatus(LinkableComponentStatus::Updating);
+    }
+
+    // Components only touch their own states and outputs, evaluated concurrently.
+    vector<future<void>> results;
+    for (const auto &comp : comps)
+    {
+        results.push_back(mPool->Submit([comp] {
+            const auto &outputs = comp->GetOutputs();
+            comp->PerformTimestep(outputs);
+            if (comp->GetStatus() != LinkableComponentStatus::Failed)
+            {
+                comp->UpdateOutputs(outputs);
+            }
+        }));
+    }
+
+    exception_ptr error = nullptr;
+    for (auto &result : results)
+    {
+        try
+        {
+            result.get();
+        }
+        catch (...)
+        {
+            error = error ? error : current_exception();
+        }
+    }
+
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+
+    for (const auto &comp : comps)
+    {
+        if (comp->GetStatus() == LinkableComponentStatus::Failed)
+        {
+            SetStatus(
+                LinkableComponentStatus::Failed,
+                StringHelper::FormatSimple("Component [{}] failed.", comp->GetId()));
+            return;
+        }
+    }
+}
+
+void IterationController::AccelerateInnerOutputs()
+{
+    // Gathers the latest values of all inner outputs into one vector, so that the
+    // accelerator sees the couplings between them.
+    vector<real>   result;
+    vector<size_t> offsets;
+    for (const auto &output : mInnerOutputSet)
+    {
+        offsets.push_back(result.size());
+
+        const auto &values = output->GetValues();
+        int         times  = values->GetIndexCount({0});
+        if (times > 0)
+        {
+            auto iterate =
+                ExtensionMethods::GetElementValuesForTime<real>(values, times - 1);
+            result.insert(result.end(), iterate.begin(), iterate.end());
+        }
+    }
+    offsets.push_back(result.size());
+
+    if (mIter == 1 || mLastIterate.size() != result.size())
+    {
+        mLastIterate = result;
+        mResidual    = numeric_limits<double>::max();
+        return;
+    }
+
+    // Relative residual norm, or absolute residual norm for tiny values.
+    double diffNorm = 0, valueNorm = 0;
+    for (size_t i = 0; i < result.size(); i++)
+    {
+        double diff  = result[i] - mLastIterate[i];
+        diffNorm    += diff * diff;
+        valueNorm   += (double)result[i] * result[i];
+    }
+    mResidual = sqrt(diffNorm) / max(sqrt(valueNorm), 1.);
+
+    mLastIterate = mAccelerator.Accelerate(mLastIterate, result);
+
+    for (size_t i = 0; i < mInnerOutputSet.size(); i++)
+    {
+        if (offsets[i + 1] == offsets[i])
+        {
+            continue;
+        }
+
+        vector<any> accelerated(
+            mLastIterate.begin() + offsets[i], mLastIterate.begin() + offsets[i + 1]);
+
+        const auto &values = mInnerOutputSet[i]->GetValues();
+        values->SetElementValuesForTime(values->GetIndexCount({0}) - 1, accelerated);
+    }
+}
+
+bool IterationController::IsIterationConverged() const
+{
+    if (mResidual > mEps)
+    {
+        return false;
+    }
+
+    // Leave the additional check of whether the iterations converge to components.
+    return all_of(begin(mComponentSet), end(mComponentSet), [](const auto &comPair) {
+        return comPair.second->IsIterationConverged();
+    });
+}
+
+void IterationController::CollectStates()
+{
+    mStates.clear();
+    for (const auto &comPair : mComponentSet)
+    {
+        mStates[comPair.first] = comPair.second->KeepCurrentState();
+    }
+}
+
+void IterationController::ResetStates()
+{
+    for (const auto &comPair : mComponentSet)
+    {
+        comPair.second->RestoreState(mStates[comPair.first]);
+    }
+}
+
+void IterationController::ClearStates()
+{
+    for (const auto &comPair : mComponentSet)
+    {
+        comPair.second->ClearState(mStates[comPair.first]);
+    }
+    mStates.clear();
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
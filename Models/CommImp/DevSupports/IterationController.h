@@ -1,97 +1,158 @@
-// /**
-// ***********************************************************************************
-//  *    Copyright (C) 2022, The OpenOasis Contributors. Join us in the Oasis!
-//  *
-//  *    @File      :  IterationController.h
-//  *    @License   :  Apache-2.0
-//  *
-//  *    @Desc      :  IterationController controls iterations among linkable
-//  components.
-//  *
-//  **
-//  ***********************************************************************************/
-// #pragma once
-// #include "Models/CommImp/LinkableComponent.h"
-// #include <unordered_map>
-// #include <set>
-// #include <map>
-
-
-// namespace OpenOasis
-// {
-// namespace CommImp
-// {
-// namespace DevSupports
-// {
-// /// @brief IterationController controls iterations between linkable components.
-// ///
-// /// @note IterationController encapsulates a set of bidirectional iteratively coupled
-// /// linkable components, takes over component updates and data exchange to
-// /// achieve loop-driven mode.
-// class IterationController : public LinkableComponent
-// {
-// public:
-//     int    mMaxIter    = 2;      // Maximum number of iteration.
-//     int    mIter       = 0;      // Current iteration step.
-//     double mEps        = 1.e-6;  // Accuracy of iterative convergence.
-//     double mRelaxation = 0.25;   // Relaxation coefficient.
-
-//     std::map<std::string, std::shared_ptr<IIdentifiable>>     mStates;
-//     std::map<std::string, std::shared_ptr<LinkableComponent>> mComponentSet;
-
-//     std::vector<std::shared_ptr<IInput>>  mInnerInputSet;
-//     std::vector<std::shared_ptr<IOutput>> mInnerOutputSet;
-
-// public:
-//     IterationController(const std::string &id);
-//     virtual ~IterationController() = default;
-
-//     void AddComponent(std::shared_ptr<ILinkableComponent> component);
-
-// protected:
-//     ///////////////////////////////////////////////////////////////////////////////////
-//     // Override methods inherited from `LinkableComponent` for iteration.
-//     //
-
-//     void InitializeArguments() override;
-
-//     void InitializeSpace() override
-//     {}
-
-//     void InitializeTime() override;
-
-//     void InitializeInputs() override;
-
-//     void InitializeOutputs() override;
-
-//     std::vector<std::string> OnValidate() override;
-
-//     void PrepareInputs() override
-//     {}
-
-//     void PrepareOutputs() override;
-
-//     void
-//     UpdateOutputs(const std::vector<std::shared_ptr<IOutput>> &requiredOutputs)
-//     override
-//     {}
-
-//     void PerformTimestep(
-//         const std::vector<std::shared_ptr<IOutput>> &requiredOutputs) override;
-
-//     void ApplyInputData(const std::shared_ptr<IValueSet> &values) override
-//     {}
-
-//     bool IsIterationConverged() const override;
-
-//     ///////////////////////////////////////////////////////////////////////////////////
-//     // Additional methods used for iteration.
-//     //
-
-//     void CollectStates();
-//     void ResetStates();
-// };
-
-// }  // namespace DevSupports
-// }  // namespace CommImp
-// }  // namespace OpenOasis
\ No newline at end of file
+/** ***********************************************************************************
+ *    Copyright (C) 2022, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  IterationController.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  IterationController controls iterations among linkable components.
+ *
+ *    The controller takes over a group of bidirectionally coupled components (a loop
+ *    group) and performs their time steps as a block fixed-point iteration:
+ *
+ *        1. Keeps the states of all components.
+ *        2. Sweeps: all components pull inputs, perform the time step and update
+ *           outputs, where components are evaluated concurrently within a sweep.
+ *        3. Accelerates the values of the inner outputs (consumed within the
+ *           group) by `ConvergenceAccelerator`, i.e., constant or dynamic Aitken
+ *           relaxation, or Anderson mixing, and computes the residual norm against
+ *           the last iterate.
+ *        4. Stops if the residual is below the tolerance or the maximum iteration
+ *           steps reached, otherwise restores the states and goes back to 2.
+ *
+ *    The components must implement `IManageState` to restore their states.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "ConvergenceAccelerator.h"
+#include "Models/CommImp/LinkableComponent.h"
+#include "Models/Utils/CommConstants.h"
+#include "Models/Utils/ThreadPool.h"
+#include <map>
+#include <memory>
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+namespace DevSupports
+{
+using Utils::real;
+
+/// @brief IterationController controls iterations between linkable components.
+///
+/// @note IterationController encapsulates a set of bidirectional iteratively coupled
+/// linkable components, takes over component updates and data exchange to
+/// achieve loop-driven mode.
+class IterationController : public LinkableComponent
+{
+protected:
+    int    mMaxIter    = 25;     // Maximum number of iteration.
+    int    mIter       = 0;      // Current iteration step.
+    double mEps        = 1.e-6;  // Accuracy of iterative convergence.
+    double mRelaxation = 0.25;   // (Initial) relaxation coefficient.
+    int    mNumThreads = 0;      // Number of threads to evaluate components.
+
+    std::string mAcceleration = "aitken";  // Convergence acceleration method.
+    int         mHistoryDepth = 5;         // History depth of Anderson mixing.
+
+    ConvergenceAccelerator mAccelerator;
+
+    double mResidual = 0;  // Residual norm of the last iteration.
+
+    std::map<std::string, std::shared_ptr<IIdentifiable>>     mStates;
+    std::map<std::string, std::shared_ptr<LinkableComponent>> mComponentSet;
+
+    std::vector<std::shared_ptr<IInput>>  mInnerInputSet;
+    std::vector<std::shared_ptr<IOutput>> mInnerOutputSet;
+
+    // Accelerated values of all inner outputs in the last iteration.
+    std::vector<real> mLastIterate;
+
+    // Workers evaluating the components in sweeps, created when prepared.
+    std::unique_ptr<Utils::ThreadPool> mPool;
+
+public:
+    IterationController(const std::string &id);
+    virtual ~IterationController() = default;
+
+    /// @brief Adds the initialized component to the group.
+    ///
+    /// @throw NotSupportedException If the component is not a `LinkableComponent`,
+    /// or it can't keep and restore its states.
+    void AddComponent(std::shared_ptr<ILinkableComponent> component);
+
+    std::vector<std::string> GetComponentIds() const;
+
+    /// @brief Sets the iteration parameters from the link configurations, i.e.,
+    /// "max_iter_steps", "tolerance", "relaxation", "acceleration" ("constant",
+    /// "aitken" or "anderson"), "history_depth" and "threads".
+    void SetIterationConfigs(const std::multimap<std::string, std::string> &configs);
+
+    /// @brief Iteration steps taken in the last time step.
+    int GetIterationCount() const;
+
+    /// @brief Residual norm of the last iteration.
+    double GetResidual() const;
+
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Override methods inherited from `LinkableComponent` for iteration.
+    //
+
+    bool IsIterationConverged() const override;
+
+protected:
+    void InitializeArguments() override;
+
+    void InitializeSpace() override
+    {}
+
+    void InitializeTime() override;
+
+    void InitializeInputs() override;
+
+    void InitializeOutputs() override;
+
+    std::vector<std::string> OnValidate() override;
+
+    void OnPrepare() override;
+
+    void PrepareInputs() override
+    {}
+
+    void PrepareOutputs() override;
+
+    void PullInputs() override
+    {}
+
+    void UpdateOutputs(const std::vector<std::shared_ptr<IOutput>> &) override
+    {}
+
+    void PerformTimestep(
+        const std::vector<std::shared_ptr<IOutput>> &requiredOutputs) override;
+
+    void ApplyInputData(const std::shared_ptr<IValueSet> &) override
+    {}
+
+    void UpdateInputs() override
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Additional methods used for iteration.
+    //
+
+    void CollectStates();
+    void ResetStates();
+    void ClearStates();
+
+    /// @brief Updates all components one time step concurrently, without updating
+    /// the time horizon of their inputs.
+    void Sweep();
+
+    /// @brief Accelerates the values of inner outputs and computes the residual.
+    void AccelerateInnerOutputs();
+};
+
+}  // namespace DevSupports
+}  // namespace CommImp
+}  // namespace OpenOasis
@@ -0,0 +1,263 @@
+/** ***********************************************************************************
+ *    @File      :  MappingMatrixCache.cpp
+ *    @Brief     :  On-disk cache of the element mapping matrices.
+ *
+ ** ***********************************************************************************/
+#include "MappingMatrixCache.h"
+#include "Models/Utils/FilePathHelper.h"
+#include "Models/Utils/MappedFile.h"
+#include "Models/Utils/StringHelper.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Utils;
+using namespace std;
+
+namespace
+{
+constexpr char     CacheMagic[8] = {'O', 'A', 'S', 'I', 'S', 'M', 'A', 'P'};
+constexpr uint32_t CacheVersion  = 1;
+
+struct CacheHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t realSize;
+    uint64_t key;
+    int64_t  rowCount;
+    int64_t  columnCount;
+    int64_t  nonZerosCount;
+};
+
+/// @brief FNV-1a hash, which is stable between runs and platforms.
+class Hasher
+{
+private:
+    uint64_t mHash = 14695981039346656037ull;
+
+public:
+    void Add(const void *data, size_t size)
+    {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            mHash = (mHash ^ bytes[i]) * 1099511628211ull;
+        }
+    }
+
+    template <typename T>
+    void Add(T value)
+    {
+        Add(&value, sizeof(T));
+    }
+
+    void Add(const string &value)
+    {
+        Add((uint64_t)value.size());
+        Add(value.data(), value.size());
+    }
+
+    uint64_t GetHash() const
+    {
+        return mHash;
+    }
+};
+
+void HashElementSet(Hasher &hasher, const shared_ptr<IElementSet> &elmtSet)
+{
+    int elementCount = elmtSet->GetElementCount();
+    hasher.Add((int)elmtSet->GetElementType());
+    hasher.Add(elementCount);
+
+    for (int i = 0; i < elementCount; i++)
+    {
+        int nodeCount = elmtSet->GetNodeCount(i);
+        hasher.Add(nodeCount);
+
+        for (int j = 0; j < nodeCount; j++)
+        {
+            hasher.Add(elmtSet->GetNodeXCoordinate(i, j));
+            hasher.Add(elmtSet->GetNodeYCoordinate(i, j));
+            hasher.Add(elmtSet->GetNodeZCoordinate(i, j));
+        }
+    }
+}
+
+size_t AlignOffset(size_t offset)
+{
+    return (offset + 7) / 8 * 8;
+}
+
+}  // namespace
+
+
+uint64_t MappingMatrixCache::ComputeKey(
+    const string &methodId, const shared_ptr<IElementSet> &fromElements,
+    const shared_ptr<IElementSet> &toElements, const string &options)
+{
+    Hasher hasher;
+    hasher.Add(methodId);
+    hasher.Add(options);
+    HashElementSet(hasher, fromElements);
+    HashElementSet(hasher, toElements);
+
+    return hasher.GetHash();
+}
+
+string MappingMatrixCache::GetFilePath(const string &directory, uint64_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.oasismap", (unsigned long long)key);
+    return FilePathHelper::Combine(directory, name);
+}
+
+bool MappingMatrixCache::Load(
+    const string &directory, uint64_t key, DoubleSparseMatrix &matrix)
+{
+    string path = GetFilePath(directory, key);
+    if (!FilePathHelper::FileExists(path))
+    {
+        return false;
+    }
+
+    shared_ptr<MappedFile> file;
+    try
+    {
+        file = MappedFile::Open(path);
+    }
+    catch (const exception &)
+    {
+        return false;
+    }
+
+    // Checks the header and the sizes before reading the arrays.
+    CacheHeader header;
+    if (file->GetSize() < sizeof(header))
+    {
+        return false;
+    }
+
+    const auto *data = static_cast<const char *>(file->GetData());
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) != 0
+        || header.version != CacheVersion || header.realSize != sizeof(real)
+        || header.key != key || header.rowCount != matrix.GetRowCount()
+        || header.columnCount != matrix.GetColumnCount() || header.nonZerosCount < 0)
+    {
+        return false;
+    }
+
+    size_t rows = (size_t)header.rowCount, nnz = (size_t)header.nonZerosCount;
+
+    size_t startsOffset  = AlignOffset(sizeof(header));
+    size_t columnsOffset = AlignOffset(startsOffset + (rows + 1) * sizeof(int));
+    size_t entriesOffset = AlignOffset(columnsOffset + nnz * sizeof(int));
+    if (file->GetSize() != entriesOffset + nnz * sizeof(real))
+    {
+        return false;
+    }
+
+    const auto *starts  = reinterpret_cast<const int *>(data + startsOffset);
+    const auto *columns = reinterpret_cast<const int *>(data + columnsOffset);
+    const auto *entries = reinterpret_cast<const real *>(data + entriesOffset);
+
+    try
+    {
+        matrix.SetCompressed(
+            vector<int>(starts, starts + rows + 1), vector<int>(columns, columns + nnz),
+            vector<real>(entries, entries + nnz));
+    }
+    catch (const runtime_error &)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool MappingMatrixCache::Save(
+    const string &directory, uint64_t key, const DoubleSparseMatrix &matrix)
+{
+    if (!matrix.IsCompressed())
+    {
+        return false;
+    }
+
+    const auto &starts  = matrix.GetRowStarts();
+    const auto &columns = matrix.GetColumns();
+    const auto &entries = matrix.GetEntries();
+
+    CacheHeader header;
+    memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.version       = CacheVersion;
+    header.realSize      = sizeof(real);
+    header.key           = key;
+    header.rowCount      = matrix.GetRowCount();
+    header.columnCount   = matrix.GetColumnCount();
+    header.nonZerosCount = (int64_t)entries.size();
+
+    size_t startsOffset  = AlignOffset(sizeof(header));
+    size_t columnsOffset = AlignOffset(startsOffset + starts.size() * sizeof(int));
+    size_t entriesOffset = AlignOffset(columnsOffset + columns.size() * sizeof(int));
+
+    // Writes a temporary file and renames it at last, so that the processes running
+    // at the same time never read a partly written one.
+    string path = GetFilePath(directory, key);
+    string temp = StringHelper::FormatSimple(
+        "{}.{}.tmp", path,
+        hash<thread::id>()(this_thread::get_id())
+            ^ (size_t)chrono::steady_clock::now().time_since_epoch().count());
+
+    try
+    {
+        filesystem::create_directories(filesystem::path(directory));
+
+        ofstream stream(temp, ios::binary | ios::trunc);
+        if (!stream)
+        {
+            return false;
+        }
+
+        const char padding[8] = {};
+
+        auto write = [&](const void *data, size_t size, size_t offset) {
+            if (!stream)
+                return;
+
+            stream.write(padding, offset - (size_t)stream.tellp());
+            stream.write(static_cast<const char *>(data), size);
+        };
+
+        write(&header, sizeof(header), 0);
+        write(starts.data(), starts.size() * sizeof(int), startsOffset);
+        write(columns.data(), columns.size() * sizeof(int), columnsOffset);
+        write(entries.data(), entries.size() * sizeof(real), entriesOffset);
+        stream.close();
+
+        if (!stream)
+        {
+            filesystem::remove(filesystem::path(temp));
+            return false;
+        }
+
+        filesystem::rename(filesystem::path(temp), filesystem::path(path));
+    }
+    catch (const exception &)
+    {
+        error_code code;
+        filesystem::remove(filesystem::path(temp), code);
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
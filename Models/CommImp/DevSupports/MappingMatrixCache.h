@@ -0,0 +1,57 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  MappingMatrixCache.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  On-disk cache of the element mapping matrices.
+ *
+ *    A mapping matrix is saved under the key hashed from the method, the element
+ *    types and the node coordinates of both element sets, so an unchanged mapping
+ *    is loaded instead of evaluated again at the next run.
+ *
+ *    The file is in the compressed sparse rows(CSR) of the matrix:
+ *      header | row starts(int, rows + 1) | columns(int, nnz) | entries(real, nnz)
+ *    where each array starts at 8 bytes alignment.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Models/CommImp/Numeric/Matrix.h"
+#include "Models/Inc/IElementSet.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Numeric;
+
+/// @brief Loads and saves the mapping matrices in a cache directory.
+class MappingMatrixCache final
+{
+public:
+    /// @brief Computes the cache key of a mapping.
+    ///
+    /// @param methodId Id of the mapping method.
+    /// @param options Mapping options affecting the matrix other than the method.
+    static std::uint64_t ComputeKey(
+        const std::string &methodId, const std::shared_ptr<IElementSet> &fromElements,
+        const std::shared_ptr<IElementSet> &toElements, const std::string &options);
+
+    /// @brief Returns the cache file path of the key in the directory.
+    static std::string GetFilePath(const std::string &directory, std::uint64_t key);
+
+    /// @brief Loads the cached matrix of the key into the matrix of the same size.
+    /// @returns False if not cached, or the cache file is invalid.
+    static bool
+    Load(const std::string &directory, std::uint64_t key, DoubleSparseMatrix &matrix);
+
+    /// @brief Saves the compressed matrix under the key, replacing the cached one.
+    /// @returns False if failed to write the cache file.
+    static bool Save(
+        const std::string &directory, std::uint64_t key,
+        const DoubleSparseMatrix &matrix);
+};
+
+}  // namespace OpenOasis::CommImp::DevSupports
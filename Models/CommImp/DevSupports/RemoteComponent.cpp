@@ -0,0 +1,516 @@
+/** ***********************************************************************************
+ *    @File      :  RemoteComponent.cpp
+ *    @Brief     :  To run a linkable component in a child process.
+ *
+ ** ***********************************************************************************/
+#include "RemoteComponent.h"
+#include "Models/CommImp/Dimension.h"
+#include "Models/CommImp/Quantity.h"
+#include "Models/CommImp/Unit.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/LibraryLoader.h"
+#include "Models/Utils/Logger.h"
+#include "Models/Utils/StringHelper.h"
+
+#ifdef LINUX
+#include <sched.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Utils;
+using namespace std;
+
+
+namespace
+{
+#ifdef LINUX
+// Creates the component in the child process and serves it.
+int RunChild(
+    UnixSocket channel, const string &id,
+    const RemoteComponent::ComponentFactory &factory, const vector<int> &cpus)
+{
+    try
+    {
+        if (!cpus.empty())
+        {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            for (int cpu : cpus)
+            {
+                CPU_SET(cpu, &cpuSet);
+            }
+
+            if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+            {
+                throw IllegalStateException(StringHelper::FormatSimple(
+                    "Failed to pin component [{}] to CPUs.", id));
+            }
+        }
+
+        auto comp = factory();
+        if (!comp)
+        {
+            throw IllegalStateException(
+                StringHelper::FormatSimple("Failed to create component [{}].", id));
+        }
+
+        channel.Send(StringHelper::FormatSimple("OK|{}|0|", (int)comp->GetStatus()));
+
+        return ComponentHost(comp.get(), std::move(channel)).Run();
+    }
+    catch (const exception &e)
+    {
+        channel.Send(StringHelper::FormatSimple("ERR|{}", e.what()));
+        return 1;
+    }
+}
+#endif
+}  // namespace
+
+
+RemoteComponent::RemoteComponent(
+    const string &id, const string &type, const string &taskFile,
+    const string &libraryPath, const vector<int> &cpus) :
+    RemoteComponent(
+        id,
+        [=, loader = make_shared<LibraryLoader>()]() -> shared_ptr<ILinkableComponent> {
+            if (!loader->Load(libraryPath))
+            {
+                throw FileLoadException(StringHelper::FormatSimple(
+                    "Failed to load dll/so from [{}].", libraryPath));
+            }
+
+            // The component is owned by the library.
+            auto rawComp =
+                loader->RunFunction<void *(const char *, const char *, const char *)>(
+                    "GetOasisComponent", id.c_str(), type.c_str(), taskFile.c_str());
+            auto comp = static_cast<ILinkableComponent *>(rawComp);
+            return shared_ptr<ILinkableComponent>(comp, [](ILinkableComponent *) {});
+        },
+        cpus)
+{}
+
+shared_ptr<IQuantity> RemoteComponent::CreateOpaqueQuantity(const string &caption)
+{
+    auto unit = make_shared<Unit>(make_shared<Dimension>(), "-", "Opaque unit", 1., 0.);
+    return make_shared<Quantity>(unit, caption, "Opaque quantity", (real)-9999);
+}
+
+
+// class RemoteComponent on Linux ----------------------------------------------------
+#ifdef LINUX
+
+RemoteComponent::RemoteComponent(
+    const string &id, const ComponentFactory &factory, const vector<int> &cpus) :
+    mId(id),
+    mCaption(id)
+{
+    auto channels = UnixSocket::CreatePair();
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Failed to start process for component [{}].", id));
+    }
+
+    if (pid == 0)
+    {
+        channels.first.Close();
+        auto &channel = channels.second;
+        _exit(RunChild(std::move(channel), id, factory, cpus));
+    }
+
+    channels.second.Close();
+    mChannel   = std::move(channels.first);
+    mProcessId = pid;
+
+    // Waits for the component being created.
+    try
+    {
+        Request("");
+    }
+    catch (...)
+    {
+        Terminate();
+        throw;
+    }
+}
+
+RemoteComponent::~RemoteComponent()
+{
+    Terminate();
+}
+
+void RemoteComponent::Terminate()
+{
+    if (mProcessId <= 0)
+    {
+        return;
+    }
+
+    string reply;
+    if (!mChannel.Send("EXIT") || !mChannel.Receive(reply))
+    {
+        kill(mProcessId, SIGKILL);
+    }
+
+    int status = 0;
+    waitpid(mProcessId, &status, 0);
+    mChannel.Close();
+    mProcessId = -1;
+
+    // Segments are left if the child was killed.
+    if (WIFSIGNALED(status))
+    {
+        RemoveSegments();
+    }
+}
+
+string RemoteComponent::Request(const string &command)
+{
+    if (mProcessId <= 0)
+    {
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Process of component [{}] is not running.", mId));
+    }
+
+    // An empty command only receives the reply.
+    string reply;
+    if ((!command.empty() && !mChannel.Send(command)) || !mChannel.Receive(reply))
+    {
+        int status = 0;
+        waitpid(mProcessId, &status, 0);
+        mChannel.Close();
+        mProcessId = -1;
+        mStatus    = LinkableComponentStatus::Failed;
+        RemoveSegments();
+
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Process of component [{}] exited unexpectedly ({}).",
+            mId,
+            WIFSIGNALED(status) ?
+                StringHelper::FormatSimple("signal {}", WTERMSIG(status)) :
+                StringHelper::FormatSimple("code {}", WEXITSTATUS(status))));
+    }
+
+    if (reply.rfind("ERR|", 0) == 0)
+    {
+        mStatus = LinkableComponentStatus::Failed;
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Component [{}] failed: {}", mId, reply.substr(4)));
+    }
+
+    // Parses "OK|{status}|{now time}|{payload}", a missing '|' gives a zero position.
+    size_t statusPos = reply.find('|') + 1;
+    size_t timePos   = reply.find('|', statusPos) + 1;
+    size_t dataPos   = reply.find('|', timePos) + 1;
+    if (reply.rfind("OK|", 0) != 0 || timePos == 0 || dataPos == 0)
+    {
+        throw InvalidDataException(StringHelper::FormatSimple(
+            "Invalid reply [{}] from component [{}].", reply, mId));
+    }
+
+    mStatus = static_cast<LinkableComponentStatus>(
+        stoi(reply.substr(statusPos, timePos - statusPos - 1)));
+    mNowTime = stod(reply.substr(timePos, dataPos - timePos - 1));
+
+    return reply.substr(dataPos);
+}
+
+
+// class RemoteComponent on other platforms ------------------------------------------
+#else
+
+RemoteComponent::RemoteComponent(
+    const string &id, const ComponentFactory &factory, const vector<int> &cpus) :
+    mId(id),
+    mCaption(id)
+{
+    throw NotSupportedException("Remote component is only supported on Linux.");
+}
+
+RemoteComponent::~RemoteComponent()
+{}
+
+void RemoteComponent::Terminate()
+{}
+
+string RemoteComponent::Request(const string &command)
+{
+    throw NotSupportedException("Remote component is only supported on Linux.");
+}
+
+#endif
+
+
+int RemoteComponent::GetProcessId() const
+{
+    return mProcessId;
+}
+
+double RemoteComponent::GetNowTime() const
+{
+    return mNowTime;
+}
+
+vector<string> RemoteComponent::GetOutputIds() const
+{
+    vector<string> ids;
+    for (const auto &buffer : mBuffers)
+    {
+        ids.push_back(buffer.first);
+    }
+
+    return ids;
+}
+
+void RemoteComponent::RemoveSegments()
+{
+    for (const auto &buffers : {mBuffers, mInputBuffers})
+    {
+        for (const auto &buffer : buffers)
+        {
+            SharedMemory::Remove(buffer.second->GetName());
+        }
+    }
+}
+
+double RemoteComponent::GetOutputValues(
+    const string &outputId, Span<const double> &values) const
+{
+    if (mBuffers.count(outputId) == 0)
+    {
+        throw IllegalArgumentException(StringHelper::FormatSimple(
+            "Component [{}] has no output [{}].", mId, outputId));
+    }
+
+    return ComponentHost::ReadValues(*mBuffers.at(outputId), values);
+}
+
+shared_ptr<IOutput> RemoteComponent::AddOutput(
+    const string &outputId, const shared_ptr<IQuantity> &quantity,
+    const shared_ptr<IElementSet> &elementSet)
+{
+    for (const auto &output : mOutputs)
+    {
+        if (output->GetId() == outputId)
+        {
+            return output;
+        }
+    }
+
+    mOutputs.push_back(
+        make_shared<RemoteOutput>(outputId, shared_from_this(), quantity, elementSet));
+
+    return mOutputs.back();
+}
+
+shared_ptr<IInput> RemoteComponent::AddInput(
+    const string &inputId, const shared_ptr<IQuantity> &quantity,
+    const shared_ptr<IElementSet> &elementSet)
+{
+    for (const auto &input : mInputs)
+    {
+        if (input->GetId() == inputId)
+        {
+            return input;
+        }
+    }
+
+    mInputs.push_back(
+        make_shared<RemoteInput>(inputId, shared_from_this(), quantity, elementSet));
+
+    return mInputs.back();
+}
+
+void RemoteComponent::PullOutputs()
+{
+    for (const auto &output : mOutputs)
+    {
+        // Outputs without values published are skipped. The values are copied from
+        // the segment into the output directly.
+        Span<const double> values;
+        double             time = GetOutputValues(output->GetId(), values);
+        if (!values.empty())
+        {
+            output->AppendValues(time, values);
+        }
+    }
+}
+
+void RemoteComponent::PushInputs()
+{
+    for (const auto &input : mInputs)
+    {
+        auto &memory = *mInputBuffers.at(input->GetId());
+
+        Span<const double> requested;
+        double             time = ComponentHost::ReadValues(memory, requested);
+        ComponentHost::WriteValues(memory, time, input->PullValues(time));
+    }
+}
+
+string RemoteComponent::GetId() const
+{
+    return mId;
+}
+
+string RemoteComponent::GetCaption() const
+{
+    return mCaption;
+}
+
+void RemoteComponent::SetCaption(const string &value)
+{
+    mCaption = value;
+}
+
+string RemoteComponent::GetDescription() const
+{
+    return mDescription;
+}
+
+void RemoteComponent::SetDescription(const string &value)
+{
+    mDescription = value;
+}
+
+vector<shared_ptr<IArgument>> RemoteComponent::GetArguments() const
+{
+    return {};
+}
+
+LinkableComponentStatus RemoteComponent::GetStatus() const
+{
+    return mStatus;
+}
+
+vector<shared_ptr<IInput>> RemoteComponent::GetInputs() const
+{
+    return vector<shared_ptr<IInput>>(mInputs.begin(), mInputs.end());
+}
+
+vector<shared_ptr<IOutput>> RemoteComponent::GetOutputs() const
+{
+    return vector<shared_ptr<IOutput>>(mOutputs.begin(), mOutputs.end());
+}
+
+vector<shared_ptr<IAdaptedOutputFactory>>
+RemoteComponent::GetAdaptedOutputFactories() const
+{
+    return {};
+}
+
+void RemoteComponent::Initialize()
+{
+    Request("INITIALIZE");
+}
+
+vector<string> RemoteComponent::Validate()
+{
+    auto payload = Request("VALIDATE");
+    if (payload.empty())
+    {
+        return {};
+    }
+
+    return StringHelper::Split(payload, '\n');
+}
+
+void RemoteComponent::Prepare()
+{
+    string command = "PREPARE|";
+    for (const auto &input : mInputs)
+    {
+        command += input->GetId() + ";";
+    }
+
+    // Parses "{output id}={segment};...|{input id}={segment};...".
+    auto payload = Request(command);
+    auto pos     = payload.find('|');
+
+    auto openSegments = [](const string &items) {
+        unordered_map<string, shared_ptr<SharedMemory>> buffers;
+        for (const auto &item : StringHelper::Split(items, ';'))
+        {
+            auto pos = item.find('=');
+            if (pos != string::npos)
+            {
+                buffers[item.substr(0, pos)] = SharedMemory::Open(item.substr(pos + 1));
+            }
+        }
+
+        return buffers;
+    };
+    mBuffers      = openSegments(payload.substr(0, pos));
+    mInputBuffers = openSegments(pos == string::npos ? "" : payload.substr(pos + 1));
+
+    for (const auto &output : mOutputs)
+    {
+        if (mBuffers.count(output->GetId()) == 0)
+        {
+            mStatus = LinkableComponentStatus::Failed;
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "Component [{}] has no output [{}].", mId, output->GetId()));
+        }
+    }
+
+    // The inputs are checked by the child.
+    if (mInputBuffers.size() != mInputs.size())
+    {
+        mStatus = LinkableComponentStatus::Failed;
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Inputs of component [{}] aren't linked to the child.", mId));
+    }
+
+    // The initial values are published on preparing.
+    PullOutputs();
+}
+
+void RemoteComponent::Update()
+{
+    if (mStatus == LinkableComponentStatus::Done
+        || mStatus == LinkableComponentStatus::Finished
+        || mStatus == LinkableComponentStatus::Failed)
+    {
+        return;
+    }
+
+    // Failures of the remote component don't stop others.
+    try
+    {
+        PushInputs();
+        Request("UPDATE");
+        PullOutputs();
+    }
+    catch (const exception &e)
+    {
+        mStatus = LinkableComponentStatus::Failed;
+        Logger::Error(e.what());
+    }
+}
+
+void RemoteComponent::Finish()
+{
+    if (mProcessId <= 0)
+    {
+        return;
+    }
+
+    try
+    {
+        Request("FINISH");
+    }
+    catch (const exception &e)
+    {
+        Logger::Error(e.what());
+    }
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
@@ -0,0 +1,190 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  RemoteComponent.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To run a linkable component in a child process.
+ *
+ *    The remote component forks a child process, which loads the component library,
+ *    creates the component and serves it by `ComponentHost`. The calls of the
+ *    `ILinkableComponent` interface are forwarded to the child over a Unix socket,
+ *    while the output values are read from shared memory, not through the socket.
+ *
+ *    A crash of the child process doesn't take down the launcher: the component
+ *    turns `Failed` and stops being updated. The child can be pinned to a set of
+ *    CPUs, e.g. those of one NUMA node, and the output buffers are first touched by
+ *    the child, i.e., allocated on its node.
+ *
+ *    The outputs consumed locally are added as `RemoteOutput`s, which take the
+ *    latest values from shared memory after each update. The inputs linked locally
+ *    are added as `RemoteInput`s: before each update, their values are pulled at
+ *    the time requested by the child and written into shared memory, where the
+ *    child provides them to the inputs of the component.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "ComponentHost.h"
+#include "Models/CommImp/RemoteInput.h"
+#include "Models/CommImp/RemoteOutput.h"
+#include <functional>
+#include <unordered_map>
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+namespace DevSupports
+{
+/// @brief Proxy of a linkable component running in a child process.
+class RemoteComponent : public ILinkableComponent,
+                        public std::enable_shared_from_this<RemoteComponent>
+{
+private:
+    std::string mId;
+    std::string mCaption;
+    std::string mDescription;
+
+    int               mProcessId = -1;
+    Utils::UnixSocket mChannel;
+
+    LinkableComponentStatus mStatus  = LinkableComponentStatus::Created;
+    double                  mNowTime = 0;
+
+    std::unordered_map<std::string, std::shared_ptr<Utils::SharedMemory>> mBuffers;
+    std::unordered_map<std::string, std::shared_ptr<Utils::SharedMemory>> mInputBuffers;
+    std::vector<std::shared_ptr<RemoteOutput>>                             mOutputs;
+    std::vector<std::shared_ptr<RemoteInput>>                              mInputs;
+
+public:
+    /// @brief Creates the component hosted in the child process.
+    using ComponentFactory = std::function<std::shared_ptr<ILinkableComponent>()>;
+
+    /// @brief Starts the child process hosting the component.
+    ///
+    /// @param id Component id.
+    /// @param type Component type.
+    /// @param taskFile Task file of the component.
+    /// @param libraryPath Library to create the component from.
+    /// @param cpus CPUs the child process is pinned to, not pinned if empty.
+    RemoteComponent(
+        const std::string &id, const std::string &type, const std::string &taskFile,
+        const std::string &libraryPath, const std::vector<int> &cpus = {});
+
+    /// @brief Starts the child process hosting the component created by the factory,
+    /// which is called in the child process.
+    RemoteComponent(
+        const std::string &id, const ComponentFactory &factory,
+        const std::vector<int> &cpus = {});
+
+    virtual ~RemoteComponent();
+
+    /// @brief Creates a quantity standing for an exchange item of a remote
+    /// component, whose value definition is only known in its child process.
+    static std::shared_ptr<IQuantity> CreateOpaqueQuantity(const std::string &caption);
+
+    int GetProcessId() const;
+
+    /// @brief The current time stamp of the remote component.
+    double GetNowTime() const;
+
+    std::vector<std::string> GetOutputIds() const;
+
+    /// @brief Views the latest values of the output in shared memory, which are
+    /// valid until the next update.
+    ///
+    /// @param outputId Output id.
+    /// @param values Values of the output.
+    /// @return The time stamp of the values.
+    double GetOutputValues(
+        const std::string &outputId, Utils::Span<const double> &values) const;
+
+    /// @brief Adds the output of the remote component to be consumed locally, or
+    /// gets it if added. The output is checked on `Prepare()`.
+    ///
+    /// @param outputId Output id.
+    /// @param quantity Value definition of the output.
+    /// @param elementSet Element set of the output.
+    /// @return The output, whose values are taken after each update.
+    std::shared_ptr<IOutput> AddOutput(
+        const std::string &outputId, const std::shared_ptr<IQuantity> &quantity,
+        const std::shared_ptr<IElementSet> &elementSet);
+
+    /// @brief Adds the input of the remote component to be linked locally, or gets
+    /// it if added. The input is checked on `Prepare()`.
+    ///
+    /// @param inputId Input id.
+    /// @param quantity Value definition of the input.
+    /// @param elementSet Element set of the input, or null if unknown.
+    /// @return The input, whose values are pulled before each update.
+    std::shared_ptr<IInput> AddInput(
+        const std::string &inputId, const std::shared_ptr<IQuantity> &quantity,
+        const std::shared_ptr<IElementSet> &elementSet);
+
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Implement methods inherited from `IIdentifiable` and `IDescribable`.
+    //
+
+    std::string GetId() const override;
+
+    std::string GetCaption() const override;
+
+    void SetCaption(const std::string &value) override;
+
+    std::string GetDescription() const override;
+
+    void SetDescription(const std::string &value) override;
+
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Implement methods inherited from `ILinkableComponent`.
+    //
+
+    std::vector<std::shared_ptr<IArgument>> GetArguments() const override;
+
+    LinkableComponentStatus GetStatus() const override;
+
+    std::vector<std::shared_ptr<IInput>> GetInputs() const override;
+
+    std::vector<std::shared_ptr<IOutput>> GetOutputs() const override;
+
+    std::vector<std::shared_ptr<IAdaptedOutputFactory>>
+    GetAdaptedOutputFactories() const override;
+
+    void Initialize() override;
+
+    std::vector<std::string> Validate() override;
+
+    void Prepare() override;
+
+    /// @brief Updates the remote component, turns `Failed` if the child crashed.
+    void Update() override;
+
+    void Finish() override;
+
+    void RemoveListener(const ListenFunc &) override
+    {}
+
+    void AddListener(const ListenFunc &) override
+    {}
+
+private:
+    /// @brief Sends the command and waits for the reply.
+    /// @return The payload of the reply.
+    std::string Request(const std::string &command);
+
+    /// @brief Appends the latest values from shared memory to the outputs.
+    void PullOutputs();
+
+    /// @brief Writes the values of the inputs at the times requested by the child.
+    void PushInputs();
+
+    /// @brief Removes the segments left by a child stopped abnormally.
+    void RemoveSegments();
+
+    void Terminate();
+};
+
+}  // namespace DevSupports
+}  // namespace CommImp
+}  // namespace OpenOasis
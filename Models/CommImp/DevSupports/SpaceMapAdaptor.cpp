@@ -6,7 +6,8 @@
 #include "SpaceMapAdaptor.h"
 #include "ExtensionMethods.h"
 #include "Models/CommImp/Input.h"
-#include "Models/CommImp/ValueSet2D.h"
+#include "Models/CommImp/SpaceAdaptedOutputFactory.h"
+#include "Models/CommImp/ValueSetDense.h"
 #include "Models/Utils/Exception.h"
 
 
@@ -31,8 +32,22 @@ SpaceMapAdaptor::SpaceMapAdaptor(
     mQuery->SetDescription(mDescription);
     mQuery->SetElementSet(adaptee->GetElementSet());
 
-    // Initialize the ElementMapper.
+    if (SpaceAdaptedOutputFactory::GetMethod(mMethodId) == ElementMapperMethod::Inverse)
+    {
+        for (const auto &argument : SpaceAdaptedOutputFactory::CreateInverseArguments())
+        {
+            mArguments.emplace(make_pair(argument->GetId(), argument));
+        }
+    }
+
+    Initialize();
+}
+
+void SpaceMapAdaptor::Initialize()
+{
+    // Initialize the ElementMapper, again if the arguments are changed.
     mElementMapper = make_shared<ElementMapper>();
+    SpaceAdaptedOutputFactory::SetInverseArguments(*mElementMapper, GetArguments());
     mElementMapper->Initialise(mMethodId, mOutput.lock()->GetElementSet(), mTarget);
 }
 
@@ -103,7 +118,7 @@ shared_ptr<IValueSet> SpaceMapAdaptor::GetValues()
         ExtensionMethods::TimesCount(incomingValues),
         GetSpatialDefinition()->GetElementCount());
 
-    auto result = dynamic_pointer_cast<ValueSet2D>(resultValues);
+    auto result = dynamic_pointer_cast<ValueSetDense<real>>(resultValues);
     result->SetValueDefinition(mOutput.lock()->GetValueDefinition());
 
     // Transform the values from the adaptee.
@@ -39,6 +39,9 @@ public:
         std::shared_ptr<IIdentifiable>  methodId,
         const std::shared_ptr<IOutput> &adaptee, std::shared_ptr<IElementSet> target);
 
+    /// @brief Initializes the element mapper with the arguments of the method.
+    void Initialize() override;
+
     ///////////////////////////////////////////////////////////////////////////////////
     // Override methods.
     //
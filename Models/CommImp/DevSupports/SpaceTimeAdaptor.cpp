@@ -0,0 +1,100 @@
+/** ***********************************************************************************
+ *    @File      :  SpaceTimeAdaptor.cpp
+ *    @Brief     :  AdaptedOutput that does temporal operation and element mapping.
+ *
+ ** ***********************************************************************************/
+#include "SpaceTimeAdaptor.h"
+#include "Models/CommImp/SpaceAdaptedOutputFactory.h"
+#include "Models/CommImp/ValueSetDense.h"
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Spatial;
+using namespace Utils;
+using namespace std;
+
+
+SpaceTimeAdaptor::SpaceTimeAdaptor(
+    shared_ptr<IIdentifiable> methodId, const shared_ptr<IOutput> &adaptee,
+    shared_ptr<IElementSet> target) :
+    TimeAdaptor(adaptee->GetId() + "->" + methodId->GetId(), adaptee)
+{
+    mMethodId = SpaceAdaptedOutputFactory::GetMappingMethod(methodId);
+    mTarget   = target;
+
+    if (SpaceAdaptedOutputFactory::GetMethod(mMethodId) == ElementMapperMethod::Inverse)
+    {
+        for (const auto &argument : SpaceAdaptedOutputFactory::CreateInverseArguments())
+        {
+            mArguments.emplace(make_pair(argument->GetId(), argument));
+        }
+    }
+
+    Initialize();
+}
+
+void SpaceTimeAdaptor::Initialize()
+{
+    // The mapping matrix is built at the first query, as the adaptor may be created
+    // only to list the available methods.
+    mElementMapper = make_shared<ElementMapper>();
+    SpaceAdaptedOutputFactory::SetInverseArguments(*mElementMapper, GetArguments());
+}
+
+shared_ptr<IValueSet> SpaceTimeAdaptor::GetValues()
+{
+    shared_ptr<IBaseExchangeItem> querier = mConsumers.back().lock();
+    UpdateBuffers(querier);
+
+    if (!mElementMapper->IsInitialized())
+    {
+        mElementMapper->Initialise(mMethodId, mOutput.lock()->GetElementSet(), mTarget);
+    }
+
+    // Interpolates the source values at each query time and maps them right away,
+    // the row stays in cache between the two stages.
+    const auto &queryTimes = querier->GetTimeSet()->GetTimes();
+    int         timesCount = (int)queryTimes.size();
+    if (!mResult || mResult->GetTimesCount() != timesCount
+        || mResult->GetElementsCount() != mTarget->GetElementCount())
+    {
+        mResult = make_shared<ValueSetDense<real>>(
+            GetValueDefinition(), timesCount, mTarget->GetElementCount());
+    }
+
+    mTemporalValues.resize(mBuffers.GetValuesCount());
+    for (int t = 0; t < timesCount; t++)
+    {
+        mBuffers.GetValues(queryTimes[t], Span<real>(mTemporalValues));
+        mElementMapper->MapValues(
+            mResult->GetElementValuesForTimeSpan(t), Span<const real>(mTemporalValues));
+    }
+
+    ClearBuffers();
+
+    return mResult;
+}
+
+void SpaceTimeAdaptor::Reset()
+{
+    TimeAdaptor::Reset();
+
+    mElementMapper.reset();
+    mMethodId.reset();
+    mTarget.reset();
+    mTemporalValues.clear();
+    mResult.reset();
+}
+
+shared_ptr<IElementSet> SpaceTimeAdaptor::GetElementSet() const
+{
+    return mTarget;
+}
+
+shared_ptr<ISpatialDefinition> SpaceTimeAdaptor::GetSpatialDefinition() const
+{
+    return dynamic_pointer_cast<ISpatialDefinition>(mTarget);
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
@@ -0,0 +1,69 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  SpaceTimeAdaptor.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  AdaptedOutput that does temporal operation and element mapping.
+ *
+ *    It works as a `TimeAdaptor` chained with a `SpaceMapAdaptor`, but for each query
+ *    time the buffered values are interpolated into one reused row, which is mapped
+ *    at once into the result. So no intermediate valueset is built between the two.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "TimeAdaptor.h"
+#include "ElementMapper.h"
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Spatial;
+
+/// @brief An adapted output item that interpolates the adaptee values in time and
+/// maps them to the target element set in one pass.
+class SpaceTimeAdaptor : public TimeAdaptor
+{
+protected:
+    std::shared_ptr<ElementMapper> mElementMapper;
+    std::shared_ptr<IIdentifiable> mMethodId;
+    std::shared_ptr<IElementSet>   mTarget;
+
+    /// Values of the source elements at the query time, reused between queries.
+    std::vector<real> mTemporalValues;
+
+    /// Values of the target elements at the query times, reused between queries of
+    /// the same times count.
+    std::shared_ptr<ValueSetDense<real>> mResult;
+
+public:
+    virtual ~SpaceTimeAdaptor()
+    {}
+
+    /// @param methodId The space-time method from `SpaceAdaptedOutputFactory`.
+    SpaceTimeAdaptor(
+        std::shared_ptr<IIdentifiable>  methodId,
+        const std::shared_ptr<IOutput> &adaptee, std::shared_ptr<IElementSet> target);
+
+    /// @brief Resets the element mapper with the arguments of the method, which is
+    /// initialized at the next query.
+    void Initialize() override;
+
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Override methods.
+    //
+
+    /// @brief Gets the values at the times of the latest consumer. The value set is
+    /// reused by the next query, so it's only valid until then.
+    virtual std::shared_ptr<IValueSet> GetValues() override;
+
+    virtual void Reset() override;
+
+    virtual std::shared_ptr<IElementSet> GetElementSet() const override;
+
+    /// The SpatialDefinition returned by this adapted output
+    /// is the target element set.
+    virtual std::shared_ptr<ISpatialDefinition> GetSpatialDefinition() const override;
+};
+
+}  // namespace OpenOasis::CommImp::DevSupports
@@ -54,10 +54,35 @@ void TimeAdaptor::SetValues(shared_ptr<IValueSet> value)
 
 shared_ptr<IValueSet> TimeAdaptor::GetValues()
 {
+    shared_ptr<IBaseExchangeItem> querier      = mConsumers.back().lock();
+    const auto                   &currentTimes = UpdateBuffers(querier);
+
     //------------------------------------------------------
-    // Check if we need to update the output component.
+    // Retrieve values from the buffer.
+
+    // Return the values for the required time(s).
+    vector<vector<real>> resultValues;
+    if (querier->GetTimeSet() != nullptr && !currentTimes.empty())
+    {
+        for (std::size_t t = 0; t < currentTimes.size(); t++)
+        {
+            const auto &queryTime         = querier->GetTimeSet()->GetTimeHorizon();
+            const auto &valuesForTimeStep = mBuffers.GetValues(queryTime);
+
+            resultValues.push_back(valuesForTimeStep);
+        }
+    }
+
+    ClearBuffers();
 
-    shared_ptr<IBaseExchangeItem> querier = mConsumers.back().lock();
+    return make_shared<ValueSetDense<real>>(resultValues, GetValueDefinition());
+}
+
+vector<shared_ptr<ITime>>
+TimeAdaptor::UpdateBuffers(const shared_ptr<IBaseExchangeItem> &querier)
+{
+    //------------------------------------------------------
+    // Check if we need to update the output component.
 
     // Time set of query must be defined and have at least 1 time.
     if (querier->GetTimeSet() == nullptr || querier->GetTimeSet()->GetTimes().empty())
@@ -93,41 +118,23 @@ shared_ptr<IValueSet> TimeAdaptor::GetValues()
     currentTimes       = mOutput.lock()->GetTimeSet()->GetTimes();
     for (std::size_t t = 0; t < currentTimes.size(); ++t)
     {
-        const auto  &data = currentValues->GetElementValuesForTime(t);
-        vector<real> dataInDbl;
-        for (const auto &val : data)
-        {
-            dataInDbl.push_back(any_cast<real>(val));
-        }
+        const auto &data =
+            ExtensionMethods::GetElementValuesForTime<real>(currentValues, (int)t);
 
-        mBuffers.AddValues(currentTimes[t], dataInDbl);
+        mBuffers.AddValues(currentTimes[t], data);
     }
 
-    //------------------------------------------------------
-    // Retrieve values from the buffer.
-
-    // Return the values for the required time(s).
-    vector<vector<real>> resultValues;
-    if (querier->GetTimeSet() != nullptr && !currentTimes.empty())
-    {
-        for (std::size_t t = 0; t < currentTimes.size(); t++)
-        {
-            const auto &queryTime         = querier->GetTimeSet()->GetTimeHorizon();
-            const auto &valuesForTimeStep = mBuffers.GetValues(queryTime);
-
-            resultValues.push_back(valuesForTimeStep);
-        }
-    }
+    return currentTimes;
+}
 
+void TimeAdaptor::ClearBuffers()
+{
     const auto &earliestConsumerTime =
         ExchangeItemHelper::GetEarliestConsumerTime(GetInstance());
     if (earliestConsumerTime != nullptr)
     {
         mBuffers.ClearBefore(earliestConsumerTime);
     }
-
-    return make_shared<ValueSetFP>(
-        resultValues, dynamic_pointer_cast<IQuantity>(GetValueDefinition()));
 }
 
 bool TimeAdaptor::Update(const shared_ptr<IBaseExchangeItem> &specifier)
@@ -199,11 +206,8 @@ void TimeAdaptor::Refresh()
 
     for (std::size_t t = 0; t < times.size(); ++t)
     {
-        vector<real> data;
-        for (const auto &val : values->GetTimeSeriesValuesForElement(t))
-        {
-            data.push_back(any_cast<real>(val));
-        }
+        const auto &data =
+            ExtensionMethods::GetElementValuesForTime<real>(values, (int)t);
 
         mBuffers.SetOrAddValues(times[t], data);
     }
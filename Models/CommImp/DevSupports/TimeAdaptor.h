@@ -69,6 +69,15 @@ protected:
 
     virtual bool Update(const std::shared_ptr<IBaseExchangeItem> &specifier);
 
+    /// @brief Updates the adaptee if it's behind the querier, and pulls its values
+    /// into the buffer.
+    /// @return The times of the adaptee.
+    std::vector<std::shared_ptr<ITime>>
+    UpdateBuffers(const std::shared_ptr<IBaseExchangeItem> &querier);
+
+    /// @brief Clears the buffered values earlier than all consumers would query.
+    void ClearBuffers();
+
     void RefreshAdaptedOutputs();
 };
 
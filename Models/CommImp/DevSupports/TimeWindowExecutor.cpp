@@ -0,0 +1,233 @@
+/** ***********************************************************************************
+ *    @File      :  TimeWindowExecutor.cpp
+ *    @Brief     :  To advance linked components in lock-step time windows.
+ *
+ ** ***********************************************************************************/
+#include "TimeWindowExecutor.h"
+#include "Models/CommImp/LinkableComponent.h"
+#include "Models/CommImp/Output.h"
+#include "Models/Utils/ThreadPool.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
+#include <algorithm>
+#include <exception>
+#include <limits>
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Utils;
+using namespace std;
+
+
+TimeWindowExecutor::TimeWindowExecutor(
+    double windowLength, int maxLookahead, int numThreads) :
+    mWindowLength(windowLength),
+    mMaxLookahead(maxLookahead), mNumThreads(numThreads), mScheduler(numThreads)
+{
+    if (windowLength <= 0)
+    {
+        throw ArgumentOutOfRangeException(StringHelper::FormatSimple(
+            "Invalid time window length [{}], must be positive.", windowLength));
+    }
+
+    if (maxLookahead < 1)
+    {
+        throw ArgumentOutOfRangeException(StringHelper::FormatSimple(
+            "Invalid lookahead steps [{}], must be at least 1.", maxLookahead));
+    }
+}
+
+void TimeWindowExecutor::AddComponent(const string &compId, ILinkableComponent *comp)
+{
+    if (!dynamic_cast<LinkableComponent *>(comp))
+    {
+        throw NotSupportedException(StringHelper::FormatSimple(
+            "Component [{}] is not a LinkableComponent, can't be time stepped.",
+            compId));
+    }
+
+    if (mComps.count(compId) == 0)
+    {
+        mCompIds.push_back(compId);
+    }
+    mComps[compId] = comp;
+
+    mScheduler.AddComponent(compId, comp);
+}
+
+void TimeWindowExecutor::AddDependency(const string &consumer, const string &provider)
+{
+    mScheduler.AddDependency(consumer, provider);
+}
+
+unordered_map<string, int> TimeWindowExecutor::Run()
+{
+    const auto stages = mScheduler.GetUnitStages();
+
+    // Steps are counted by each unit separately, so allocate all counters first.
+    unordered_map<string, int> steps;
+    for (const auto &compId : mCompIds)
+    {
+        steps[compId] = 0;
+    }
+
+    double windowStart = numeric_limits<double>::max();
+    double endTime     = numeric_limits<double>::lowest();
+    for (const auto &compId : mCompIds)
+    {
+        auto comp = dynamic_cast<LinkableComponent *>(mComps.at(compId));
+        auto now  = comp->GetNowTime() ? comp->GetNowTime() : comp->GetStartTime();
+
+        windowStart = min(windowStart, now->GetTimeStamp());
+        endTime     = max(endTime, comp->GetEndTime()->GetTimeStamp());
+    }
+
+    SetComponentUpdateDisabled(true);
+
+    ThreadPool pool(mNumThreads);
+    try
+    {
+        while (!all_of(mCompIds.begin(), mCompIds.end(), [this](const string &id) {
+            return IsComponentFinished(id);
+        }))
+        {
+            double windowEnd = windowStart + mWindowLength;
+            bool   advanced  = false;
+
+            for (const auto &stage : stages)
+            {
+                vector<future<bool>> results;
+                for (const auto &unit : stage)
+                {
+                    results.push_back(pool.Submit([&, windowEnd] {
+                        return AdvanceUnit(unit, windowEnd, steps);
+                    }));
+                }
+
+                // Barrier of the stage, exceptions are rethrown after all units stop.
+                exception_ptr error = nullptr;
+                for (auto &result : results)
+                {
+                    try
+                    {
+                        advanced = result.get() || advanced;
+                    }
+                    catch (...)
+                    {
+                        error = error ? error : current_exception();
+                    }
+                }
+
+                if (error)
+                {
+                    rethrow_exception(error);
+                }
+            }
+
+            if (!advanced && windowStart > endTime)
+            {
+                throw IllegalStateException(StringHelper::FormatSimple(
+                    "Components stalled after the end time [{}].", endTime));
+            }
+
+            windowStart = windowEnd;
+        }
+    }
+    catch (...)
+    {
+        SetComponentUpdateDisabled(false);
+        throw;
+    }
+
+    SetComponentUpdateDisabled(false);
+
+    return steps;
+}
+
+bool TimeWindowExecutor::AdvanceUnit(
+    const vector<string> &compIds, double windowEnd, unordered_map<string, int> &steps)
+{
+    // Steps of each component ending past the window end, components already past
+    // the window end have looked ahead in previous windows.
+    unordered_map<string, int> aheadSteps;
+    for (const auto &compId : compIds)
+    {
+        auto comp = dynamic_cast<LinkableComponent *>(mComps.at(compId));
+        bool ahead =
+            comp->GetNowTime() && comp->GetNowTime()->GetTimeStamp() >= windowEnd;
+
+        aheadSteps[compId] = ahead ? mMaxLookahead : 0;
+    }
+
+    // Components in a loop are updated alternately, one step each time.
+    bool advanced = false, progressing = true;
+    while (progressing)
+    {
+        progressing = false;
+        for (const auto &compId : compIds)
+        {
+            if (IsComponentFinished(compId) || aheadSteps.at(compId) >= mMaxLookahead)
+            {
+                continue;
+            }
+
+            auto   comp = dynamic_cast<LinkableComponent *>(mComps.at(compId));
+            double prevTime =
+                comp->GetNowTime() ? comp->GetNowTime()->GetTimeStamp()
+                                   : numeric_limits<double>::lowest();
+
+            comp->Update();
+            steps.at(compId)++;
+
+            progressing = true;
+            advanced    = true;
+
+            if (IsComponentFinished(compId))
+            {
+                continue;
+            }
+
+            // A component not advancing its time would never reach the window end.
+            auto now = comp->GetNowTime();
+            if (!now || now->GetTimeStamp() <= prevTime)
+            {
+                throw IllegalStateException(StringHelper::FormatSimple(
+                    "Component [{}] doesn't advance its time when updated.", compId));
+            }
+
+            if (now->GetTimeStamp() >= windowEnd)
+            {
+                aheadSteps.at(compId)++;
+            }
+        }
+    }
+
+    return advanced;
+}
+
+void TimeWindowExecutor::SetComponentUpdateDisabled(bool value)
+{
+    for (const auto &compId : mCompIds)
+    {
+        for (const auto &output : mComps.at(compId)->GetOutputs())
+        {
+            auto item = dynamic_pointer_cast<Output>(output);
+            if (item)
+            {
+                item->SetComponentUpdateDisabled(value);
+            }
+        }
+    }
+}
+
+bool TimeWindowExecutor::IsComponentFinished(const string &compId) const
+{
+    auto status = mComps.at(compId)->GetStatus();
+
+    return status == LinkableComponentStatus::Done
+           || status == LinkableComponentStatus::Failed
+           || status == LinkableComponentStatus::Finished;
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
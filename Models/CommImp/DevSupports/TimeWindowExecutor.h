@@ -0,0 +1,83 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  TimeWindowExecutor.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To advance linked components in lock-step time windows.
+ *
+ *    The executor advances all components window by window, e.g. one coupling
+ *    interval per window. Within a window, components are updated stage by stage
+ *    in the topological order of their dependencies, and the components in the same
+ *    stage are updated concurrently. Each stage ends with a barrier.
+ *
+ *    During the run, the outputs don't update their components on requests, thus
+ *    there is no recursive `Update()` from consumers to providers. Instead, providers
+ *    have filled their output buffers for the window before consumers are updated.
+ *
+ *    Within a window, each component takes as many internal steps as needed to reach
+ *    the window end, so no component falls behind. Past the window end, a component
+ *    may look ahead until `maxLookahead` of its steps end past the window end, which
+ *    bounds the values buffered in its outputs. With the default of 1, components
+ *    stop at the first step reaching the window end.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "ComponentScheduler.h"
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+namespace DevSupports
+{
+/// @brief Lock-step executor advancing linked components in time windows.
+class TimeWindowExecutor
+{
+private:
+    double mWindowLength = 0;
+    int    mMaxLookahead = 1;
+    int    mNumThreads   = 0;
+
+    std::vector<std::string>                              mCompIds;
+    std::unordered_map<std::string, ILinkableComponent *> mComps;
+
+    ComponentScheduler mScheduler;
+
+public:
+    /// @brief Creates the executor.
+    ///
+    /// @param windowLength Length of the time window in days.
+    /// @param maxLookahead Maximum internal steps of a component ending past the
+    /// window end.
+    /// @param numThreads Number of worker threads, the number of hardware threads
+    /// is used if not positive.
+    TimeWindowExecutor(double windowLength, int maxLookahead = 1, int numThreads = 0);
+
+    void AddComponent(const std::string &compId, ILinkableComponent *comp);
+
+    /// @brief Declares that `consumer` takes inputs from `provider`.
+    void AddDependency(const std::string &consumer, const std::string &provider);
+
+    /// @brief Updates all prepared components until they are done or failed.
+    ///
+    /// @return The number of time steps updated of each component.
+    std::unordered_map<std::string, int> Run();
+
+private:
+    /// @brief Advances the components of a scheduling unit to the window end.
+    ///
+    /// @return True if any component was updated.
+    bool AdvanceUnit(
+        const std::vector<std::string> &compIds, double windowEnd,
+        std::unordered_map<std::string, int> &steps);
+
+    void SetComponentUpdateDisabled(bool value);
+
+    bool IsComponentFinished(const std::string &compId) const;
+};
+
+}  // namespace DevSupports
+}  // namespace CommImp
+}  // namespace OpenOasis
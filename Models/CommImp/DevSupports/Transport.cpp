@@ -0,0 +1,410 @@
+/** ***********************************************************************************
+ *    @File      :  Transport.cpp
+ *    @Brief     :  To move output values between ranks of a distributed coupling.
+ *
+ ** ***********************************************************************************/
+#include "Transport.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/Logger.h"
+#include "Models/Utils/StringHelper.h"
+#include <cstdint>
+#include <cstring>
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Utils;
+using namespace std;
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// ValuePacket.
+//
+
+namespace
+{
+template <typename T>
+void Write(string &buffer, size_t &pos, const T &value)
+{
+    memcpy(&buffer[pos], &value, sizeof(T));
+    pos += sizeof(T);
+}
+
+template <typename T>
+T Read(const string &buffer, size_t &pos)
+{
+    if (pos + sizeof(T) > buffer.size())
+    {
+        throw InvalidDataException("Truncated value packet.");
+    }
+
+    T value;
+    memcpy(&value, &buffer[pos], sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+}  // namespace
+
+string ValuePacket::Pack() const
+{
+    // Layout: channel size, channel, time, duration, ended, value count, values.
+    size_t size = sizeof(uint32_t) + channel.size() + 2 * sizeof(double)
+                  + sizeof(uint8_t) + sizeof(uint64_t) + values.size() * sizeof(double);
+
+    string buffer(size, '\0');
+    size_t pos = 0;
+    Write(buffer, pos, (uint32_t)channel.size());
+    memcpy(&buffer[pos], channel.data(), channel.size());
+    pos += channel.size();
+    Write(buffer, pos, time);
+    Write(buffer, pos, duration);
+    Write(buffer, pos, (uint8_t)ended);
+    Write(buffer, pos, (uint64_t)values.size());
+    if (!values.empty())
+    {
+        memcpy(&buffer[pos], values.data(), values.size() * sizeof(double));
+    }
+
+    return buffer;
+}
+
+ValuePacket ValuePacket::Unpack(const string &buffer)
+{
+    ValuePacket packet;
+    size_t      pos = 0;
+
+    auto channelSize = Read<uint32_t>(buffer, pos);
+    if (pos + channelSize > buffer.size())
+    {
+        throw InvalidDataException("Truncated value packet.");
+    }
+    packet.channel = buffer.substr(pos, channelSize);
+    pos += channelSize;
+
+    packet.time     = Read<double>(buffer, pos);
+    packet.duration = Read<double>(buffer, pos);
+    packet.ended    = Read<uint8_t>(buffer, pos) != 0;
+
+    auto count = Read<uint64_t>(buffer, pos);
+    if ((buffer.size() - pos) / sizeof(double) < count)
+    {
+        throw InvalidDataException("Truncated value packet.");
+    }
+
+    packet.values.resize(count);
+    if (count > 0)
+    {
+        memcpy(packet.values.data(), &buffer[pos], count * sizeof(double));
+    }
+
+    return packet;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Transport.
+//
+
+Transport::Transport(int rank, int size) : mRank(rank), mSize(size)
+{
+    if (size < 1 || rank < 0 || rank >= size)
+    {
+        throw ArgumentOutOfRangeException(StringHelper::FormatSimple(
+            "Invalid rank [{}] of transport with size [{}].", rank, size));
+    }
+}
+
+string Transport::GetChannel(const string &compId, const string &outputId)
+{
+    return compId + "/" + outputId;
+}
+
+int Transport::GetRank() const
+{
+    return mRank;
+}
+
+int Transport::GetSize() const
+{
+    return mSize;
+}
+
+bool Transport::Receive(const string &channel, ValuePacket &packet, bool wait)
+{
+    unique_lock<mutex> lock(mMutex);
+    if (wait)
+    {
+        mArrived.wait(lock, [&]() {
+            return mClosed || !mLostRanks.empty()
+                   || (mMailbox.count(channel) && !mMailbox[channel].empty());
+        });
+    }
+
+    // The packets queued are still received after a rank is lost.
+    auto iter = mMailbox.find(channel);
+    if (iter == mMailbox.end() || iter->second.empty())
+    {
+        if (!mLostRanks.empty())
+        {
+            throw IllegalStateException(StringHelper::FormatSimple(
+                "Rank [{}] of transport is lost.", mLostRanks.front()));
+        }
+        return false;
+    }
+
+    packet = std::move(iter->second.front());
+    iter->second.pop_front();
+    return true;
+}
+
+void Transport::Close()
+{
+    {
+        lock_guard<mutex> lock(mMutex);
+        mClosed = true;
+    }
+
+    mArrived.notify_all();
+}
+
+void Transport::Deliver(ValuePacket packet)
+{
+    {
+        lock_guard<mutex> lock(mMutex);
+        mMailbox[packet.channel].push_back(std::move(packet));
+    }
+
+    mArrived.notify_all();
+}
+
+void Transport::Lose(int rank)
+{
+    {
+        lock_guard<mutex> lock(mMutex);
+        mLostRanks.push_back(rank);
+    }
+
+    mArrived.notify_all();
+}
+
+void Transport::CheckRank(int rank) const
+{
+    if (rank < 0 || rank >= mSize)
+    {
+        throw ArgumentOutOfRangeException(StringHelper::FormatSimple(
+            "Rank [{}] is out of range [0, {}).", rank, mSize));
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// LoopbackTransport.
+//
+
+LoopbackTransport::LoopbackTransport(
+    int rank, int size, const shared_ptr<Group> &group) :
+    Transport(rank, size), mGroup(group)
+{}
+
+vector<shared_ptr<LoopbackTransport>> LoopbackTransport::CreateGroup(int size)
+{
+    auto group = make_shared<Group>(size);
+
+    vector<shared_ptr<LoopbackTransport>> transports;
+    for (int rank = 0; rank < size; rank++)
+    {
+        transports.push_back(make_shared<LoopbackTransport>(rank, size, group));
+        (*group)[rank] = transports.back();
+    }
+
+    return transports;
+}
+
+void LoopbackTransport::Send(int rank, const ValuePacket &packet)
+{
+    CheckRank(rank);
+
+    auto target = (*mGroup)[rank].lock();
+    if (!target)
+    {
+        throw IllegalStateException(
+            StringHelper::FormatSimple("Rank [{}] of transport is closed.", rank));
+    }
+
+    // Goes through the packed buffer, as other transports do.
+    target->Deliver(ValuePacket::Unpack(packet.Pack()));
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// TcpTransport.
+//
+
+TcpTransport::TcpTransport(int rank, const vector<string> &endpoints, int timeoutMs) :
+    Transport(rank, max((int)endpoints.size(), 1))
+{
+    if ((int)endpoints.size() != mSize)
+    {
+        throw IllegalArgumentException("Endpoints of tcp transport are empty.");
+    }
+
+    auto parse = [&endpoints](int rank) {
+        const auto &endpoint = endpoints[rank];
+        auto        pos      = endpoint.rfind(':');
+        if (pos == string::npos)
+        {
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "Invalid endpoint [{}] of rank [{}].", endpoint, rank));
+        }
+
+        string host = endpoint.substr(0, pos);
+        int    port = StringHelper::FromString<int>(endpoint.substr(pos + 1));
+        return make_pair(host, port);
+    };
+
+    mPeers.resize(mSize);
+    for (int i = 0; i < mSize; i++)
+    {
+        mSendMutexes.push_back(make_unique<mutex>());
+    }
+
+    // Connects to the lower ranks, then accepts the higher ranks.
+    TcpListener listener(parse(mRank).second);
+    for (int peer = 0; peer < mRank; peer++)
+    {
+        auto endpoint = parse(peer);
+        auto socket   = TcpSocket::Connect(endpoint.first, endpoint.second, timeoutMs);
+        if (!socket.Send(to_string(mRank)))
+        {
+            throw IllegalStateException(
+                StringHelper::FormatSimple("Failed to greet rank [{}].", peer));
+        }
+
+        mPeers[peer] = std::move(socket);
+    }
+
+    for (int i = mRank + 1; i < mSize; i++)
+    {
+        auto   socket = listener.Accept();
+        string greeting;
+        int    peer = -1;
+        if (socket.Receive(greeting))
+        {
+            peer = StringHelper::FromString<int>(greeting);
+        }
+
+        if (peer <= mRank || peer >= mSize || mPeers[peer].IsOpen())
+        {
+            throw IllegalStateException(StringHelper::FormatSimple(
+                "Unexpected connection from rank [{}].", greeting));
+        }
+
+        mPeers[peer] = std::move(socket);
+    }
+
+    for (int peer = 0; peer < mSize; peer++)
+    {
+        if (peer != mRank)
+        {
+            mReceivers.emplace_back(&TcpTransport::ReceiveLoop, this, peer);
+        }
+    }
+}
+
+TcpTransport::~TcpTransport()
+{
+    Close();
+}
+
+void TcpTransport::Send(int rank, const ValuePacket &packet)
+{
+    CheckRank(rank);
+
+    if (rank == mRank)
+    {
+        Deliver(packet);
+        return;
+    }
+
+    auto              buffer = packet.Pack();
+    lock_guard<mutex> lock(*mSendMutexes[rank]);
+    if (!mPeers[rank].Send(buffer))
+    {
+        throw IllegalStateException(
+            StringHelper::FormatSimple("Connection to rank [{}] is closed.", rank));
+    }
+}
+
+void TcpTransport::Close()
+{
+    // Says goodbye by the packet ended on no channel, before shutting down.
+    mClosing = true;
+
+    ValuePacket goodbye;
+    goodbye.ended = true;
+
+    const auto buffer = goodbye.Pack();
+    for (size_t peer = 0; peer < mPeers.size(); peer++)
+    {
+        lock_guard<mutex> lock(*mSendMutexes[peer]);
+        if (mPeers[peer].IsOpen())
+        {
+            mPeers[peer].Send(buffer);
+        }
+    }
+
+    for (auto &peer : mPeers)
+    {
+        peer.Shutdown();
+    }
+
+    for (auto &receiver : mReceivers)
+    {
+        if (receiver.joinable())
+        {
+            receiver.join();
+        }
+    }
+
+    for (auto &peer : mPeers)
+    {
+        peer.Close();
+    }
+
+    Transport::Close();
+}
+
+void TcpTransport::ReceiveLoop(int rank)
+{
+    string buffer;
+    bool   farewell = false;
+    while (mPeers[rank].Receive(buffer))
+    {
+        try
+        {
+            auto packet = ValuePacket::Unpack(buffer);
+            if (packet.channel.empty() && packet.ended)
+            {
+                farewell = true;
+                continue;
+            }
+
+            Deliver(std::move(packet));
+        }
+        catch (const exception &e)
+        {
+            Logger::Error(StringHelper::FormatSimple(
+                "Invalid packet from rank [{}]: {}", rank, e.what()));
+        }
+    }
+
+    // The connection closed by neither side's transport, e.g. the peer crashed.
+    if (!farewell && !mClosing)
+    {
+        Logger::Error(StringHelper::FormatSimple(
+            "Connection to rank [{}] is closed unexpectedly.", rank));
+        Lose(rank);
+    }
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
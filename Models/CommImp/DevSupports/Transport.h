@@ -0,0 +1,166 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  Transport.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To move output values between ranks of a distributed coupling.
+ *
+ *    Components of a coupling can be placed on several ranks (processes, possibly
+ *    on different hosts). The values of an output are moved to other ranks as
+ *    packets, each holding the values of all elements at one time step packed into
+ *    a contiguous buffer of doubles, rather than element by element.
+ *
+ *    Packets are addressed to a rank and a channel (see `GetChannel()`), and are
+ *    queued by channel in the receiving rank until received, in arrival order.
+ *
+ *    A rank lost before closing its transport, e.g. crashed, fails the receivers of
+ *    the other ranks rather than leaving them waiting.
+ *
+ *    Two transports are provided:
+ *        1. `LoopbackTransport`, all ranks in one process, for testing;
+ *        2. `TcpTransport`, one rank per process, fully connected by TCP.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Models/Utils/TcpSocket.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+namespace DevSupports
+{
+/// @brief Values of an output at one time step.
+struct ValuePacket
+{
+    std::string         channel;
+    double              time     = 0;  // Time stamp in days.
+    double              duration = 0;  // Duration in days.
+    bool                ended    = false;  // No more packets on the channel.
+    std::vector<double> values;
+
+    /// @brief Packs the packet into a contiguous buffer.
+    std::string Pack() const;
+
+    /// @brief Unpacks a packet from the buffer packed by `Pack()`.
+    static ValuePacket Unpack(const std::string &buffer);
+};
+
+
+/// @brief Transport of value packets among ranks.
+class Transport
+{
+protected:
+    int mRank = 0;
+    int mSize = 1;
+
+    bool                    mClosed = false;
+    std::vector<int>        mLostRanks;
+    std::mutex              mMutex;
+    std::condition_variable mArrived;
+
+    std::unordered_map<std::string, std::deque<ValuePacket>> mMailbox;
+
+public:
+    Transport(int rank, int size);
+    virtual ~Transport() = default;
+
+    /// @brief Gets the channel of the output of the component.
+    static std::string
+    GetChannel(const std::string &compId, const std::string &outputId);
+
+    int GetRank() const;
+
+    int GetSize() const;
+
+    /// @brief Sends the packet to the rank.
+    virtual void Send(int rank, const ValuePacket &packet) = 0;
+
+    /// @brief Receives the earliest packet arrived on the channel.
+    ///
+    /// @param channel Channel to receive from.
+    /// @param packet The packet received.
+    /// @param wait Whether to wait until a packet arrives.
+    /// @return False if no packet received, i.e., not waiting or transport closed.
+    /// @throw IllegalStateException If no packet is queued and a rank is lost.
+    bool Receive(const std::string &channel, ValuePacket &packet, bool wait = true);
+
+    /// @brief Closes the transport, waking up the waiting receivers.
+    virtual void Close();
+
+protected:
+    void Deliver(ValuePacket packet);
+
+    /// @brief Marks the rank lost, waking up the waiting receivers.
+    void Lose(int rank);
+
+    void CheckRank(int rank) const;
+};
+
+
+/// @brief Transport among ranks in one process, passing the packed buffers directly.
+class LoopbackTransport : public Transport
+{
+private:
+    using Group = std::vector<std::weak_ptr<LoopbackTransport>>;
+
+    std::shared_ptr<Group> mGroup;
+
+public:
+    LoopbackTransport(int rank, int size, const std::shared_ptr<Group> &group);
+
+    /// @brief Creates connected transports of all ranks.
+    static std::vector<std::shared_ptr<LoopbackTransport>> CreateGroup(int size);
+
+    void Send(int rank, const ValuePacket &packet) override;
+};
+
+
+/// @brief Transport among ranks connected by TCP.
+///
+/// Each rank listens on the port of its own endpoint, connects to the lower ranks
+/// and accepts the higher ranks, thus all ranks must be started with the same
+/// endpoints. Packets from each peer are received by a dedicated thread.
+///
+/// Closing the transport says goodbye to the peers, so a peer connection closed
+/// without the goodbye means the peer is lost.
+class TcpTransport : public Transport
+{
+private:
+    std::vector<Utils::TcpSocket>             mPeers;
+    std::vector<std::unique_ptr<std::mutex>>  mSendMutexes;
+    std::vector<std::thread>                  mReceivers;
+    std::atomic<bool>                         mClosing = false;
+
+public:
+    /// @brief Connects the rank with all other ranks.
+    ///
+    /// @param rank Rank of the current process.
+    /// @param endpoints Endpoints "{host}:{port}" of all ranks, indexed by rank.
+    /// @param timeoutMs Time to wait for other ranks in milliseconds.
+    TcpTransport(
+        int rank, const std::vector<std::string> &endpoints, int timeoutMs = 30000);
+
+    virtual ~TcpTransport();
+
+    void Send(int rank, const ValuePacket &packet) override;
+
+    void Close() override;
+
+private:
+    void ReceiveLoop(int rank);
+};
+
+}  // namespace DevSupports
+}  // namespace CommImp
+}  // namespace OpenOasis
@@ -0,0 +1,126 @@
+/** ***********************************************************************************
+ *    @File      :  TransportPublisher.cpp
+ *    @Brief     :  To publish output values to the consumers on other ranks.
+ *
+ ** ***********************************************************************************/
+#include "TransportPublisher.h"
+#include "ExtensionMethods.h"
+#include "Models/Inc/LinkableComponentStatusChangeEventArgs.h"
+#include "Models/Utils/CommConstants.h"
+
+
+namespace OpenOasis::CommImp::DevSupports
+{
+using namespace Utils;
+using namespace std;
+
+
+TransportPublisher::TransportPublisher(const shared_ptr<Transport> &transport) :
+    mTransport(transport)
+{}
+
+void TransportPublisher::AddRoute(
+    const shared_ptr<IOutput> &output, int rank, const string &channel)
+{
+    // Consumers on the same rank share the values, which are sent once.
+    for (const auto &route : mRoutes)
+    {
+        if (route.output == output && route.rank == rank)
+        {
+            return;
+        }
+    }
+
+    Route route;
+    route.output  = output;
+    route.rank    = rank;
+    route.channel = channel;
+    if (channel.empty())
+    {
+        const auto &comp = output->GetComponent().lock();
+        route.channel    = Transport::GetChannel(comp->GetId(), output->GetId());
+    }
+
+    mRoutes.push_back(route);
+}
+
+void TransportPublisher::Attach(ILinkableComponent &component)
+{
+    component.AddListener(
+        [this](shared_ptr<LinkableComponentStatusChangeEventArgs> args) {
+            auto status = args->GetNewStatus();
+            if (status == LinkableComponentStatus::Updated)
+            {
+                Publish();
+            }
+            else if (
+                status == LinkableComponentStatus::Done
+                || status == LinkableComponentStatus::Failed)
+            {
+                End();
+            }
+        });
+}
+
+int TransportPublisher::Publish()
+{
+    int count = 0;
+    for (auto &route : mRoutes)
+    {
+        if (route.ended)
+        {
+            continue;
+        }
+
+        const auto &values = route.output->GetValues();
+        const auto &times  = route.output->GetTimeSet()->GetTimes();
+        int         steps  = min((int)times.size(), values->GetIndexCount({0}));
+        for (int t = 0; t < steps; t++)
+        {
+            double endTime = ExtensionMethods::EndTimeStamp(times[t]);
+            if (endTime <= route.lastTime)
+            {
+                continue;
+            }
+
+            // Values of all elements are packed at once, copied from the row of
+            // dense values.
+            ValuePacket packet;
+            packet.channel  = route.channel;
+            packet.time     = times[t]->GetTimeStamp();
+            packet.duration = times[t]->GetDurationInDays();
+
+            auto row = ExtensionMethods::GetElementValuesForTime<real>(values, t);
+            packet.values.assign(row.begin(), row.end());
+
+            mTransport->Send(route.rank, packet);
+            route.lastTime = endTime;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void TransportPublisher::End()
+{
+    Publish();
+
+    for (auto &route : mRoutes)
+    {
+        if (route.ended)
+        {
+            continue;
+        }
+
+        ValuePacket packet;
+        packet.channel = route.channel;
+        packet.time    = route.lastTime;
+        packet.ended   = true;
+
+        mTransport->Send(route.rank, packet);
+        route.ended = true;
+    }
+}
+
+}  // namespace OpenOasis::CommImp::DevSupports
@@ -0,0 +1,70 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  TransportPublisher.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To publish output values to the consumers on other ranks.
+ *
+ *    The publisher listens to the status of the producer component. Whenever it
+ *    turns `Updated` or `Done`, the new time steps of the routed outputs are sent
+ *    to the consumer ranks, one packet per time step, where `TransportOutput`s
+ *    receive them. When the producer stops, an ending packet is sent for each route.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Transport.h"
+#include "Models/Inc/ILinkableComponent.h"
+#include "Models/Inc/IOutput.h"
+#include <limits>
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+namespace DevSupports
+{
+/// @brief Publisher sending the values of local outputs to other ranks.
+class TransportPublisher
+{
+private:
+    struct Route
+    {
+        std::shared_ptr<IOutput> output;
+        int                      rank;
+        std::string              channel;
+        double                   lastTime = std::numeric_limits<double>::lowest();
+        bool                     ended    = false;
+    };
+
+    std::shared_ptr<Transport> mTransport;
+    std::vector<Route>         mRoutes;
+
+public:
+    TransportPublisher(const std::shared_ptr<Transport> &transport);
+
+    /// @brief Routes the values of the output to the rank, unless routed already.
+    ///
+    /// @param output Output of the producer component.
+    /// @param rank Rank of the consumer.
+    /// @param channel Channel of the route, `Transport::GetChannel()` by default.
+    void AddRoute(
+        const std::shared_ptr<IOutput> &output, int rank,
+        const std::string &channel = "");
+
+    /// @brief Publishes after each update of the component.
+    /// @attention The publisher must outlive the updates of the component.
+    void Attach(ILinkableComponent &component);
+
+    /// @brief Sends the time steps not published yet.
+    /// @return The number of packets sent.
+    int Publish();
+
+    /// @brief Sends the remaining time steps and the ending packets.
+    void End();
+};
+
+}  // namespace DevSupports
+}  // namespace CommImp
+}  // namespace OpenOasis
@@ -9,6 +9,7 @@
 #include "Utils/Exception.h"
 #include "Utils/StringHelper.h"
 #include "Utils/MapHelper.h"
+#include <algorithm>
 #include <set>
 
 
@@ -44,7 +45,75 @@ void LinkLoader::LoadComponents()
 
         ComponentInfo infos = {confs["type"], confs["task"], confs["dll"]};
         mComps.emplace(id, infos);
+
+        string process = confs.count("process") ? confs["process"] : "";
+        if (StringHelper::ToLower(process) == "isolated")
+        {
+            mIsolatedComps[id] = ParseCpus(confs.count("cpus") ? confs["cpus"] : "");
+        }
+
+        string rankId = confs.count("rank") ? confs["rank"] : "0";
+        int    rank   = StringHelper::FromString<int>(rankId);
+        if (rank < 0)
+        {
+            throw IllegalArgumentException(
+                StringHelper::FormatSimple("Invalid rank of component [{}].", id));
+        }
+        mCompRanks[id] = rank;
+    }
+
+    // Get the endpoints of ranks, if distributed.
+    auto hostsJson = mLoader.GetJson(mLoader.GetJson(), "hosts");
+    if (hostsJson.has_value() && hostsJson.value().is_array())
+    {
+        auto hosts   = hostsJson.value();
+        int  hostNum = mLoader.GetArraySize(hosts);
+        for (int i = 0; i < hostNum; i++)
+        {
+            mRankHosts.push_back(mLoader.GetValue<string>(hosts, i).value());
+        }
+    }
+
+    for (const auto &pair : mCompRanks)
+    {
+        if (!mRankHosts.empty() && pair.second >= (int)mRankHosts.size())
+        {
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "Rank [{}] of component [{}] has no host.", pair.second, pair.first));
+        }
+    }
+}
+
+vector<int> LinkLoader::ParseCpus(const string &cpus)
+{
+    // CPU list like "0-3,8".
+    vector<int> result;
+    for (auto item : StringHelper::Split(cpus, ','))
+    {
+        item = StringHelper::Trim(item);
+        if (item.empty())
+        {
+            continue;
+        }
+
+        auto pos   = item.find('-');
+        int  first = StringHelper::FromString<int>(item.substr(0, pos));
+        int  last  = pos == string::npos ?
+                         first :
+                         StringHelper::FromString<int>(item.substr(pos + 1));
+        if (first < 0 || last < first)
+        {
+            throw IllegalArgumentException(
+                StringHelper::FormatSimple("Invalid CPU list [{}].", cpus));
+        }
+
+        for (int cpu = first; cpu <= last; cpu++)
+        {
+            result.push_back(cpu);
+        }
     }
+
+    return result;
 }
 
 vector<string> LinkLoader::GetComponentIds() const
@@ -57,6 +126,36 @@ LinkLoader::ComponentInfo LinkLoader::GetComponentInfo(const string &id) const
     return mComps.at(id);
 }
 
+bool LinkLoader::IsComponentIsolated(const string &compId) const
+{
+    return mIsolatedComps.count(compId) > 0;
+}
+
+vector<int> LinkLoader::GetComponentCpus(const string &compId) const
+{
+    if (mIsolatedComps.count(compId) == 0)
+    {
+        return {};
+    }
+
+    return mIsolatedComps.at(compId);
+}
+
+int LinkLoader::GetComponentRank(const string &compId) const
+{
+    if (mCompRanks.count(compId) == 0)
+    {
+        return 0;
+    }
+
+    return mCompRanks.at(compId);
+}
+
+vector<string> LinkLoader::GetRankHosts() const
+{
+    return mRankHosts;
+}
+
 void LinkLoader::LoadLinks()
 {
     auto linksJson = mLoader.GetJson(mLoader.GetJson(), "links").value();
@@ -70,7 +169,11 @@ void LinkLoader::LoadLinks()
         auto linkJson = mLoader.GetJson(linksJson, id).value();
 
         // Get the mode and parameters of the current link.
-        auto   mode   = mLoader.GetValue<string>(linkJson, "mode");
+        auto mode = mLoader.GetValue<string>(linkJson, "link_mode");
+        if (!mode.has_value())
+        {
+            mode = mLoader.GetValue<string>(linkJson, "mode");
+        }
         string modeId = mode.has_value() ? mode.value() : "PULL";
         linkModes[id] = modeId;
 
@@ -84,10 +187,73 @@ void LinkLoader::LoadLinks()
         {
             LoadPipeline(id, pipelinesJson, i, linkGroups);
         }
+
+        // Collect the adaptive coupling configurations of the target component.
+        if (parms.count("max_coupling_interval") && linkGroups.count(id))
+        {
+            auto &confs = mCouplingConfigs[linkGroups[id].back()];
+            confs.insert(parms.begin(), parms.end());
+        }
     }
 
     // Collect the coupling groups.
     CollectIteratorGroups(linkGroups, linkModes, linkConfs);
+
+    CheckAsyncOutputs();
+}
+
+void LinkLoader::CheckAsyncOutputs() const
+{
+    for (const auto &pair : mOuts)
+    {
+        const auto &compId = pair.first;
+
+        set<string> outputIds, asyncIds;
+        for (const auto &output : pair.second)
+        {
+            string outputId = GenerateUniqueElementId(compId, output);
+            outputIds.insert(outputId);
+            if (mAsyncOutputs.count(outputId))
+            {
+                asyncIds.insert(outputId);
+            }
+        }
+
+        if (asyncIds.empty())
+        {
+            continue;
+        }
+
+        // The asynchronous output drives its component on a dedicated thread, which
+        // must be the only one updating the component.
+        if (outputIds.size() != 1 || asyncIds.size() != 1)
+        {
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "Component [{}] exchanged asynchronously must provide exactly one "
+                "output.",
+                compId));
+        }
+
+        if (mCompProviders.count(compId))
+        {
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "Component [{}] exchanged asynchronously can't consume other "
+                "components.",
+                compId));
+        }
+
+        for (const auto &group : mIterGroups)
+        {
+            if (find(group.second.begin(), group.second.end(), compId)
+                != group.second.end())
+            {
+                throw IllegalArgumentException(StringHelper::FormatSimple(
+                    "Component [{}] exchanged asynchronously can't be in loop group "
+                    "[{}].",
+                    compId, group.first));
+            }
+        }
+    }
 }
 
 vector<LinkLoader::ElementInfo>
@@ -174,6 +340,29 @@ LinkLoader::GetInputProviders(const string &compId, const ElementInfo &input) co
     return res;
 }
 
+int LinkLoader::GetAsyncBufferSize(
+    const string &compId, const ElementInfo &output) const
+{
+    string outputId = GenerateUniqueElementId(compId, output);
+    if (mAsyncOutputs.count(outputId) == 0)
+    {
+        return 0;
+    }
+
+    return mAsyncOutputs.at(outputId);
+}
+
+vector<string> LinkLoader::GetComponentProviders(const string &compId) const
+{
+    if (mCompProviders.count(compId) == 0)
+    {
+        return {};
+    }
+
+    const auto &providers = mCompProviders.at(compId);
+    return vector<string>(providers.begin(), providers.end());
+}
+
 unordered_map<string, vector<string>> LinkLoader::GetIteratorGroups() const
 {
     return mIterGroups;
@@ -189,6 +378,16 @@ multimap<string, string> LinkLoader::GetIteratorConfigs(const string &iterId) co
     return mIterConfigs.at(iterId);
 }
 
+unordered_map<string, string> LinkLoader::GetCouplingConfigs(const string &compId) const
+{
+    if (mCouplingConfigs.count(compId) == 0)
+    {
+        return {};
+    }
+
+    return mCouplingConfigs.at(compId);
+}
+
 void LinkLoader::CollectIteratorGroups(
     const unordered_map<string, vector<string>>                &linkGroups,
     const unordered_map<string, string>                        &linkModes,
@@ -206,24 +405,39 @@ void LinkLoader::CollectIteratorGroups(
             continue;
         }
 
-        // Check if the link has been added to a group.
-        auto comps = pair.second;
+        // Put the link into the group sharing components with it, groups bridged
+        // by the link are merged, or a new group is started.
+        auto comps  = pair.second;
+        int  target = -1;
         for (int i = 0; i < maxGroupSize; i++)
         {
-            if (groups[i].count(comps.front()))
+            if (!groups[i].count(comps.front()) && !groups[i].count(comps.back()))
             {
-                groups[i].insert(comps.back());
-                links[i].insert(linkId);
-                break;
+                continue;
             }
 
-            if (groups[i].count(comps.back()))
+            if (target < 0)
             {
-                groups[i].insert(comps.front());
-                links[i].insert(linkId);
-                break;
+                target = i;
+                continue;
             }
+
+            groups[target].insert(groups[i].begin(), groups[i].end());
+            links[target].insert(links[i].begin(), links[i].end());
+            groups[i].clear();
+            links[i].clear();
+        }
+
+        if (target < 0)
+        {
+            auto iter = find_if(groups.begin(), groups.end(), [](const auto &group) {
+                return group.empty();
+            });
+            target    = (int)distance(groups.begin(), iter);
         }
+
+        groups[target].insert(comps.begin(), comps.end());
+        links[target].insert(linkId);
     }
 
     for (int i = 0; i < maxGroupSize; i++)
@@ -278,6 +492,19 @@ void LinkLoader::LoadPipeline(
     auto   sOperator = mLoader.GetValue<string>(pipelineJson, "spatial_operators");
     string sOptId    = sOperator.has_value() ? sOperator.value() : "";
 
+    // Get the exchange mode, synchronous by default.
+    auto   exchange   = mLoader.GetValue<string>(pipelineJson, "exchange_mode");
+    string exchangeId = exchange.has_value() ? exchange.value() : "SYNC";
+    bool   isAsync    = StringHelper::ToUpper(exchangeId) == "ASYNC";
+
+    auto bufferSize = mLoader.GetValue<int>(pipelineJson, "async_buffer");
+    int  asyncSize  = bufferSize.has_value() ? bufferSize.value() : 2;
+    if (isAsync && asyncSize < 1)
+    {
+        throw IllegalArgumentException(StringHelper::FormatSimple(
+            "Invalid async buffer size [{}] in link [{}].", asyncSize, linkId));
+    }
+
     // Get the target element.
     auto   tarElement  = mLoader.GetMap(pipelineJson, "tar_element");
     string tarElemId   = tarElement["id"];
@@ -302,6 +529,17 @@ void LinkLoader::LoadPipeline(
 
         // Collect the exchange item map.
         CollectExchangeItemMap(srcCompId, srcElemInfo, tarCompId, tarElemInfo);
+
+        if (isAsync)
+        {
+            mAsyncOutputs[GenerateUniqueElementId(srcCompId, srcElemInfo)] = asyncSize;
+        }
+    }
+
+    // Collect the component dependencies.
+    if (srcCompId != tarCompId)
+    {
+        mCompProviders[tarCompId].insert(srcCompId);
     }
 
     // Collect the coupling groups.
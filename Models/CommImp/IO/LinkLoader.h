@@ -19,20 +19,24 @@
  *
  *    ```json
  *    {
+ *        "hosts": ["node1:7000", "node2:7000"],
  *        "comps": {
  *            "comp1": {
  *                "description": "{some description about comp1}",
  *                "type": "{component type of comp1}",
  *                "task": "{path_to_taskfile}/task.yaml",
  *                "dll": "{path_to_dllfile}/OasisFlows.dll",
- *                "link": false
+ *                "link": false,
+ *                "process": "isolated",
+ *                "cpus": "0-3,8"
  *            },
  *            "comp2": {
  *                "description": "{some description about comp2}",
  *                "type": "{component type of comp2}",
  *                "task": "{path_to_taskfile}/task.yaml",
  *                "dll": "{path_to_dllfile}/OasisFlows.dll",
- *                "link": false
+ *                "link": false,
+ *                "rank": "1"
  *            },
  *            ...
  *        },
@@ -60,7 +64,9 @@
  *                            "type": "{type of the specified element}"
  *                        },
  *                        "temporal_operators": "accumulate",
- *                        "spatial_operators": "average"
+ *                        "spatial_operators": "average",
+ *                        "exchange_mode": "async",
+ *                        "async_buffer": 2
  *                    }
  *                    ...
  *                ],
@@ -68,6 +74,10 @@
  *                "params":{
  *                    "max_iter_steps": "25",
  *                    "tolerance": "0.001",
+ *                    "relaxation": "0.25",
+ *                    "acceleration": "aitken",
+ *                    "history_depth": "5",
+ *                    "threads": "4",
  *                    ...
  *                }
  *            },
@@ -76,9 +86,32 @@
  *    }
  *    ```
  *
+ *    A component with "process" of "isolated" runs in a child process, optionally
+ *    pinned to the "cpus" listed, see `RemoteComponent`.
+ *
+ *    Components are placed on rank 0 unless "rank" given. The optional "hosts" list
+ *    the endpoints "{host}:{port}" of all ranks, indexed by rank, which exchange
+ *    values over TCP, see `Transport`. Pipelines between components on different
+ *    ranks move the values through the transport.
+ *
+ *    The optional "exchange_mode" of a pipeline is "sync" by default. In "async" mode,
+ *    the source component runs ahead of the target component by at most
+ *    "async_buffer" (default 2) time steps, see `AsyncOutput`. The source component
+ *    is then driven by its asynchronous output only, so it must provide exactly one
+ *    output, take no inputs and stay out of loop groups.
+ *
+ *    Components connected by "loop" links are collected into a loop group, which is
+ *    iterated to convergence by an `IterationController` with the merged "params".
+ *
+ *    If "params" of a link contain "max_coupling_interval", the target component
+ *    pulls inputs at an adaptive interval between "min_coupling_interval" and
+ *    "max_coupling_interval" (in seconds), keeping the relative change of received
+ *    values near "coupling_tolerance", see `CouplingStepController`.
+ *
  ** ***********************************************************************************/
 #pragma once
 #include "Models/Utils/JsonHandler.h"
+#include <set>
 
 
 namespace OpenOasis::CommImp::IO
@@ -111,9 +144,33 @@ private:
     std::unordered_map<std::string, std::vector<std::string>> mInputProviders;
 
     std::unordered_map<std::string, ComponentInfo>            mComps;
+
+    // Components running in child processes, contains:
+    // - component id
+    // - CPUs pinned to, empty if not pinned
+    std::unordered_map<std::string, std::vector<int>> mIsolatedComps;
+
+    // Placement of components, contains:
+    // - component id
+    // - rank, 0 by default
+    std::unordered_map<std::string, int> mCompRanks;
+
+    // Endpoints of ranks, indexed by rank.
+    std::vector<std::string> mRankHosts;
+
     std::unordered_map<std::string, std::vector<ElementInfo>> mInps;
     std::unordered_map<std::string, std::vector<ElementInfo>> mOuts;
 
+    // Asynchronous outputs, contains:
+    // - unique output id
+    // - buffer size of the asynchronous exchange
+    std::unordered_map<std::string, int> mAsyncOutputs;
+
+    // Component dependencies, contains:
+    // - consumer component id
+    // - provider component ids
+    std::unordered_map<std::string, std::set<std::string>> mCompProviders;
+
     // Iterator groups, contains:
     // - iterator group id
     // - component ids
@@ -125,6 +182,12 @@ private:
     std::unordered_map<std::string, std::multimap<std::string, std::string>>
         mIterConfigs;
 
+    // Adaptive coupling configurations, contains:
+    // - consumer component id
+    // - coupling configurations
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>
+        mCouplingConfigs;
+
 public:
     LinkLoader(const std::string &json) : mLinkFile(json), mLoader(json)
     {}
@@ -135,6 +198,18 @@ public:
 
     ComponentInfo GetComponentInfo(const std::string &compId) const;
 
+    /// @brief Checks whether the component is configured to run in a child process.
+    bool IsComponentIsolated(const std::string &compId) const;
+
+    /// @brief Gets the CPUs the component process is pinned to, empty if not pinned.
+    std::vector<int> GetComponentCpus(const std::string &compId) const;
+
+    /// @brief Gets the rank the component is placed on.
+    int GetComponentRank(const std::string &compId) const;
+
+    /// @brief Gets the endpoints "{host}:{port}" of ranks, empty if not distributed.
+    std::vector<std::string> GetRankHosts() const;
+
     std::vector<ElementInfo> GetComponentOutputs(const std::string &compId) const;
 
     std::unordered_map<std::string, std::vector<ElementInfo>>
@@ -145,6 +220,14 @@ public:
     std::unordered_map<std::string, std::vector<ElementInfo>>
     GetInputProviders(const std::string &compId, const ElementInfo &input) const;
 
+    /// @brief Gets the buffer size of the output exchanged asynchronously.
+    /// @return The number of time steps buffered, 0 if exchanged synchronously.
+    int GetAsyncBufferSize(const std::string &compId, const ElementInfo &output) const;
+
+    /// @brief Gets the components providing inputs to the specified component.
+    /// @return The provider component ids, empty if the component is independent.
+    std::vector<std::string> GetComponentProviders(const std::string &compId) const;
+
     /// @brief Gets iterator groups consisted of components.
     /// @return The iterator groups, where each group contains a set of components.
     std::unordered_map<std::string, std::vector<std::string>> GetIteratorGroups() const;
@@ -153,7 +236,14 @@ public:
     std::multimap<std::string, std::string>
     GetIteratorConfigs(const std::string &iterId) const;
 
+    /// @brief Gets the adaptive coupling configurations of specified component.
+    /// @return The configurations, empty if inputs are pulled at every time step.
+    std::unordered_map<std::string, std::string>
+    GetCouplingConfigs(const std::string &compId) const;
+
 private:
+    static std::vector<int> ParseCpus(const std::string &cpus);
+
     void LoadComponents();
     void LoadLinks();
     void LoadPipeline(
@@ -164,6 +254,10 @@ private:
         const std::string &srcCompId, const ElementInfo &output,
         const std::string &tarCompId, const ElementInfo &input);
 
+    /// @brief Checks the components exchanged asynchronously are only driven by
+    /// their asynchronous outputs.
+    void CheckAsyncOutputs() const;
+
     void CollectIteratorGroups(
         const std::unordered_map<std::string, std::vector<std::string>> &linkGroups,
         const std::unordered_map<std::string, std::string>              &linkModes,
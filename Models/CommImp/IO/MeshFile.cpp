@@ -0,0 +1,529 @@
+/** ***********************************************************************************
+ *    @File      :  MeshFile.cpp
+ *    @Brief     :  Binary mesh file, mapped into memory without parsing.
+ *
+ ** ***********************************************************************************/
+#include "MeshFile.h"
+#include "MeshLoader.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/FilePathHelper.h"
+#include "Models/Utils/StringHelper.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace OpenOasis::CommImp::IO
+{
+using namespace Utils;
+using namespace std;
+
+static_assert(sizeof(size_t) == sizeof(uint64_t), "Indexes are mapped as size_t.");
+static_assert(
+    is_trivially_copyable_v<Coordinate> && sizeof(Coordinate) == 3 * sizeof(real),
+    "Coordinates are mapped as packed reals.");
+
+namespace
+{
+constexpr char     MeshMagic[8] = {'O', 'A', 'S', 'I', 'S', 'M', 'S', 'H'};
+constexpr uint32_t MeshVersion  = 2;
+
+// The csv files of `MeshLoader`, in the order of their stamps in the header.
+constexpr const char *SourceFiles[] = {
+    "nodes.csv", "faces.csv", "cells.csv", "patches.csv", "zones.csv"};
+constexpr size_t SourceCount = size(SourceFiles);
+
+struct MeshHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t realSize;
+    uint64_t nodeCount;
+    uint64_t faceCount;
+    uint64_t cellCount;
+    uint64_t faceNodeCount;
+    uint64_t cellFaceCount;
+    uint64_t patchCount;
+    uint64_t patchFaceCount;
+    uint64_t zoneCount;
+    uint64_t zoneFaceCount;
+    uint64_t nameSize;
+    uint64_t sourceSizes[SourceCount];
+    int64_t  sourceTimes[SourceCount];
+};
+
+/// @brief Offsets of the sections in the file.
+struct MeshLayout
+{
+    size_t nodeCoords, faceCoords, cellCoords;
+    size_t faceNodeOffsets, faceNodes;
+    size_t cellFaceOffsets, cellFaces;
+    size_t patchOffsets, patchFaces;
+    size_t zoneOffsets, zoneFaces;
+    size_t nameOffsets, names;
+    size_t end;
+};
+
+size_t AlignOffset(size_t offset)
+{
+    return (offset + 7) / 8 * 8;
+}
+
+MeshLayout CalculateLayout(const MeshHeader &h)
+{
+    const size_t coor = sizeof(Coordinate), idx = sizeof(uint64_t);
+
+    MeshLayout layout;
+    layout.nodeCoords = AlignOffset(sizeof(MeshHeader));
+    layout.faceCoords = AlignOffset(layout.nodeCoords + h.nodeCount * coor);
+    layout.cellCoords = AlignOffset(layout.faceCoords + h.faceCount * coor);
+
+    // Sections of indexes are aligned naturally.
+    layout.faceNodeOffsets = AlignOffset(layout.cellCoords + h.cellCount * coor);
+    layout.faceNodes       = layout.faceNodeOffsets + (h.faceCount + 1) * idx;
+    layout.cellFaceOffsets = layout.faceNodes + h.faceNodeCount * idx;
+    layout.cellFaces       = layout.cellFaceOffsets + (h.cellCount + 1) * idx;
+    layout.patchOffsets    = layout.cellFaces + h.cellFaceCount * idx;
+    layout.patchFaces      = layout.patchOffsets + (h.patchCount + 1) * idx;
+    layout.zoneOffsets     = layout.patchFaces + h.patchFaceCount * idx;
+    layout.zoneFaces       = layout.zoneOffsets + (h.zoneCount + 1) * idx;
+    layout.nameOffsets     = layout.zoneFaces + h.zoneFaceCount * idx;
+    layout.names = layout.nameOffsets + (h.patchCount + h.zoneCount + 1) * idx;
+    layout.end   = layout.names + h.nameSize;
+
+    return layout;
+}
+
+template <typename T>
+Span<const T> GetSection(const char *data, size_t offset, size_t count)
+{
+    return Span<const T>(reinterpret_cast<const T *>(data + offset), count);
+}
+
+/// @brief Checks the offsets of CSR start from 0, increase and end at the count.
+void CheckOffsets(Span<const size_t> offsets, size_t count, const string &meta)
+{
+    bool valid = (offsets[0] == 0) && (offsets[offsets.size() - 1] == count);
+    for (size_t i = 1; valid && i < offsets.size(); i++)
+    {
+        valid = offsets[i - 1] <= offsets[i];
+    }
+
+    if (!valid)
+    {
+        throw InvalidDataException(
+            StringHelper::FormatSimple("Invalid [{}] offsets in mesh file.", meta));
+    }
+}
+
+/// @brief Checks the indexes of CSR are all less than the count of items referred.
+void CheckIndexes(Span<const size_t> indexes, size_t count, const string &meta)
+{
+    for (size_t index : indexes)
+    {
+        if (index >= count)
+        {
+            throw InvalidDataException(StringHelper::FormatSimple(
+                "Invalid [{}] index {} in mesh file.", meta, index));
+        }
+    }
+}
+
+/// @brief Gets the sizes and modified times(ns) of the csv files, 0 for the missing.
+void StampSources(const string &meshDir, uint64_t *sizes, int64_t *times)
+{
+    for (size_t i = 0; i < SourceCount; i++)
+    {
+        struct stat st;
+        const auto &file = FilePathHelper::Combine(meshDir, SourceFiles[i]);
+        if (stat(file.c_str(), &st) != 0)
+        {
+            sizes[i] = 0;
+            times[i] = 0;
+            continue;
+        }
+
+        sizes[i] = st.st_size;
+        times[i] = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+    }
+}
+
+/// @brief Packs the int indexes of rows in CSR, one row per item of the count.
+void ToOffsets(
+    const CsvRows<int> &rows, size_t count, vector<uint64_t> &offsets,
+    vector<uint64_t> &indexes, const string &meta)
+{
+    if (rows.GetRowCount() != count)
+    {
+        throw InvalidDataException(StringHelper::FormatSimple(
+            "Invalid [{}] rows {}, {} expected.", meta, rows.GetRowCount(), count));
+    }
+
+    offsets.assign(rows.offsets.begin(), rows.offsets.end());
+    indexes.assign(rows.values.begin(), rows.values.end());
+}
+
+}  // namespace
+
+
+shared_ptr<MeshFile> MeshFile::Open(const string &path)
+{
+    auto file   = shared_ptr<MeshFile>(new MeshFile());
+    file->mFile = MappedFile::Open(path);
+
+    MeshHeader header;
+    if (file->mFile->GetSize() < sizeof(header))
+    {
+        throw InvalidDataException(
+            StringHelper::FormatSimple("Invalid mesh file [{}], too short.", path));
+    }
+
+    const auto *data = static_cast<const char *>(file->mFile->GetData());
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, MeshMagic, sizeof(MeshMagic)) != 0)
+    {
+        throw InvalidDataException(
+            StringHelper::FormatSimple("Invalid mesh file [{}], not a mesh.", path));
+    }
+
+    if (header.version != MeshVersion || header.realSize != sizeof(real))
+    {
+        throw InvalidDataException(StringHelper::FormatSimple(
+            "Unsupported mesh file [{}] of version {} and real size {}.", path,
+            header.version, header.realSize));
+    }
+
+    // The counts are limited by the file size before the layout is calculated, so
+    // the sizes of sections don't overflow.
+    const uint64_t limit = file->mFile->GetSize();
+    for (uint64_t count :
+         {header.nodeCount, header.faceCount, header.cellCount, header.faceNodeCount,
+          header.cellFaceCount, header.patchCount, header.patchFaceCount,
+          header.zoneCount, header.zoneFaceCount, header.nameSize})
+    {
+        if (count > limit)
+        {
+            throw InvalidDataException(
+                StringHelper::FormatSimple("Invalid mesh file [{}], truncated.", path));
+        }
+    }
+
+    const auto layout = CalculateLayout(header);
+    if (layout.end != file->mFile->GetSize())
+    {
+        throw InvalidDataException(StringHelper::FormatSimple(
+            "Invalid mesh file [{}], size {} but {} expected.", path,
+            file->mFile->GetSize(), layout.end));
+    }
+
+    const auto &h = header;
+
+    file->mNodeCoords = GetSection<Coordinate>(data, layout.nodeCoords, h.nodeCount);
+    file->mFaceCoords = GetSection<Coordinate>(data, layout.faceCoords, h.faceCount);
+    file->mCellCoords = GetSection<Coordinate>(data, layout.cellCoords, h.cellCount);
+
+    file->mFaceNodeOffsets =
+        GetSection<size_t>(data, layout.faceNodeOffsets, h.faceCount + 1);
+    file->mFaceNodes = GetSection<size_t>(data, layout.faceNodes, h.faceNodeCount);
+    file->mCellFaceOffsets =
+        GetSection<size_t>(data, layout.cellFaceOffsets, h.cellCount + 1);
+    file->mCellFaces = GetSection<size_t>(data, layout.cellFaces, h.cellFaceCount);
+    file->mPatchOffsets =
+        GetSection<size_t>(data, layout.patchOffsets, h.patchCount + 1);
+    file->mPatchFaces  = GetSection<size_t>(data, layout.patchFaces, h.patchFaceCount);
+    file->mZoneOffsets = GetSection<size_t>(data, layout.zoneOffsets, h.zoneCount + 1);
+    file->mZoneFaces   = GetSection<size_t>(data, layout.zoneFaces, h.zoneFaceCount);
+    file->mNameOffsets = GetSection<size_t>(
+        data, layout.nameOffsets, h.patchCount + h.zoneCount + 1);
+    file->mNames = GetSection<char>(data, layout.names, h.nameSize);
+
+    CheckOffsets(file->mFaceNodeOffsets, header.faceNodeCount, "Face");
+    CheckOffsets(file->mCellFaceOffsets, header.cellFaceCount, "Cell");
+    CheckOffsets(file->mPatchOffsets, header.patchFaceCount, "Patch");
+    CheckOffsets(file->mZoneOffsets, header.zoneFaceCount, "Zone");
+    CheckOffsets(file->mNameOffsets, header.nameSize, "Name");
+
+    // The indexes are checked once here, so the spans returned never refer to items
+    // out of the file.
+    CheckIndexes(file->mFaceNodes, header.nodeCount, "Node");
+    CheckIndexes(file->mCellFaces, header.faceCount, "Face");
+    CheckIndexes(file->mPatchFaces, header.faceCount, "Patch");
+    CheckIndexes(file->mZoneFaces, header.faceCount, "Zone");
+
+    return file;
+}
+
+void MeshFile::Write(const string &path, MeshLoader &loader)
+{
+    const auto &nodeCoords = loader.GetNodeCoordinates();
+    const auto &faceCoords = loader.GetFaceCoordinates();
+    const auto &cellCoords = loader.GetCellCoordinates();
+
+    // Patches and zones are sorted by names, so the file is reproducible.
+    map<string, vector<int>> patches(
+        loader.GetPatches().begin(), loader.GetPatches().end());
+    map<string, vector<int>> zones(loader.GetZones().begin(), loader.GetZones().end());
+
+    auto toCoords = [](const unordered_map<int, Coordinate> &table) {
+        vector<Coordinate> coords(table.size());
+        for (size_t i = 0; i < coords.size(); i++)
+        {
+            coords[i] = table.at((int)i);
+        }
+        return coords;
+    };
+
+    vector<uint64_t> faceNodeOffsets, faceNodes, cellFaceOffsets, cellFaces;
+    ToOffsets(
+        loader.GetFaceNodes(), faceCoords.size(), faceNodeOffsets, faceNodes, "Face");
+    ToOffsets(
+        loader.GetCellFaces(), cellCoords.size(), cellFaceOffsets, cellFaces, "Cell");
+
+    vector<uint64_t> patchOffsets = {0}, patchFaces, zoneOffsets = {0}, zoneFaces;
+    vector<uint64_t> nameOffsets = {0};
+    string           names;
+    for (auto [table, offsets, indexes] :
+         {make_tuple(&patches, &patchOffsets, &patchFaces),
+          make_tuple(&zones, &zoneOffsets, &zoneFaces)})
+    {
+        for (const auto &[name, faces] : *table)
+        {
+            indexes->insert(indexes->end(), faces.begin(), faces.end());
+            offsets->push_back(indexes->size());
+
+            names += name;
+            nameOffsets.push_back(names.size());
+        }
+    }
+
+    MeshHeader header;
+    memcpy(header.magic, MeshMagic, sizeof(MeshMagic));
+    header.version        = MeshVersion;
+    header.realSize       = sizeof(real);
+    header.nodeCount      = nodeCoords.size();
+    header.faceCount      = faceCoords.size();
+    header.cellCount      = cellCoords.size();
+    header.faceNodeCount  = faceNodes.size();
+    header.cellFaceCount  = cellFaces.size();
+    header.patchCount     = patches.size();
+    header.patchFaceCount = patchFaces.size();
+    header.zoneCount      = zones.size();
+    header.zoneFaceCount  = zoneFaces.size();
+    header.nameSize       = names.size();
+    StampSources(loader.GetMeshDirectory(), header.sourceSizes, header.sourceTimes);
+
+    const auto layout = CalculateLayout(header);
+
+    // Writes a temporary file and renames it at last, so that a mesh file is never
+    // read while partly written. The temporary file is named by the process, thread
+    // and time, so the writers of the same mesh file at once never share it.
+    string temp = StringHelper::FormatSimple(
+        "{}.{}.{}.tmp", path, getpid(),
+        hash<thread::id>()(this_thread::get_id())
+            ^ (size_t)chrono::steady_clock::now().time_since_epoch().count());
+
+    ofstream stream(temp, ios::binary | ios::trunc);
+    if (!stream)
+    {
+        throw FileLoadException(
+            StringHelper::FormatSimple("Failed to create mesh file [{}].", temp));
+    }
+
+    const char padding[8] = {};
+
+    auto write = [&](const void *data, size_t size, size_t offset) {
+        stream.write(padding, offset - (size_t)stream.tellp());
+        stream.write(static_cast<const char *>(data), size);
+    };
+
+    auto writeCoords = [&](const unordered_map<int, Coordinate> &table, size_t offset) {
+        const auto coords = toCoords(table);
+        write(coords.data(), coords.size() * sizeof(Coordinate), offset);
+    };
+
+    auto writeIndexes = [&](const vector<uint64_t> &indexes, size_t offset) {
+        write(indexes.data(), indexes.size() * sizeof(uint64_t), offset);
+    };
+
+    write(&header, sizeof(header), 0);
+    writeCoords(nodeCoords, layout.nodeCoords);
+    writeCoords(faceCoords, layout.faceCoords);
+    writeCoords(cellCoords, layout.cellCoords);
+    writeIndexes(faceNodeOffsets, layout.faceNodeOffsets);
+    writeIndexes(faceNodes, layout.faceNodes);
+    writeIndexes(cellFaceOffsets, layout.cellFaceOffsets);
+    writeIndexes(cellFaces, layout.cellFaces);
+    writeIndexes(patchOffsets, layout.patchOffsets);
+    writeIndexes(patchFaces, layout.patchFaces);
+    writeIndexes(zoneOffsets, layout.zoneOffsets);
+    writeIndexes(zoneFaces, layout.zoneFaces);
+    writeIndexes(nameOffsets, layout.nameOffsets);
+    write(names.data(), names.size(), layout.names);
+    stream.close();
+
+    if (!stream)
+    {
+        filesystem::remove(filesystem::path(temp));
+        throw FileLoadException(
+            StringHelper::FormatSimple("Failed to write mesh file [{}].", temp));
+    }
+
+    filesystem::rename(filesystem::path(temp), filesystem::path(path));
+}
+
+void MeshFile::ConvertFromCsv(const string &meshDir, const string &path)
+{
+    MeshLoader loader(meshDir);
+    loader.LoadCsv();
+
+    Write(path, loader);
+}
+
+bool MeshFile::IsUpToDate(const string &path, const string &meshDir)
+{
+    MeshHeader header;
+
+    ifstream stream(path, ios::binary);
+    if (!stream.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    {
+        return false;
+    }
+
+    if (memcmp(header.magic, MeshMagic, sizeof(MeshMagic)) != 0
+        || header.version != MeshVersion)
+    {
+        return false;
+    }
+
+    uint64_t sizes[SourceCount];
+    int64_t  times[SourceCount];
+    StampSources(meshDir, sizes, times);
+
+    return equal(sizes, sizes + SourceCount, header.sourceSizes)
+           && equal(times, times + SourceCount, header.sourceTimes);
+}
+
+size_t MeshFile::GetNodeCount() const
+{
+    return mNodeCoords.size();
+}
+
+size_t MeshFile::GetFaceCount() const
+{
+    return mFaceCoords.size();
+}
+
+size_t MeshFile::GetCellCount() const
+{
+    return mCellCoords.size();
+}
+
+size_t MeshFile::GetPatchCount() const
+{
+    return mPatchOffsets.size() - 1;
+}
+
+size_t MeshFile::GetZoneCount() const
+{
+    return mZoneOffsets.size() - 1;
+}
+
+Span<const Coordinate> MeshFile::GetNodeCoordinates() const
+{
+    return mNodeCoords;
+}
+
+Span<const Coordinate> MeshFile::GetFaceCoordinates() const
+{
+    return mFaceCoords;
+}
+
+Span<const Coordinate> MeshFile::GetCellCoordinates() const
+{
+    return mCellCoords;
+}
+
+Span<const size_t> MeshFile::GetFaceNodes(size_t faceIndex) const
+{
+    size_t beg = mFaceNodeOffsets[faceIndex], end = mFaceNodeOffsets[faceIndex + 1];
+    return Span<const size_t>(mFaceNodes.data() + beg, end - beg);
+}
+
+Span<const size_t> MeshFile::GetCellFaces(size_t cellIndex) const
+{
+    size_t beg = mCellFaceOffsets[cellIndex], end = mCellFaceOffsets[cellIndex + 1];
+    return Span<const size_t>(mCellFaces.data() + beg, end - beg);
+}
+
+string MeshFile::GetPatchName(size_t patchIndex) const
+{
+    size_t beg = mNameOffsets[patchIndex], end = mNameOffsets[patchIndex + 1];
+    return string(mNames.data() + beg, end - beg);
+}
+
+Span<const size_t> MeshFile::GetPatchFaces(size_t patchIndex) const
+{
+    size_t beg = mPatchOffsets[patchIndex], end = mPatchOffsets[patchIndex + 1];
+    return Span<const size_t>(mPatchFaces.data() + beg, end - beg);
+}
+
+string MeshFile::GetZoneName(size_t zoneIndex) const
+{
+    return GetPatchName(GetPatchCount() + zoneIndex);
+}
+
+Span<const size_t> MeshFile::GetZoneFaces(size_t zoneIndex) const
+{
+    size_t beg = mZoneOffsets[zoneIndex], end = mZoneOffsets[zoneIndex + 1];
+    return Span<const size_t>(mZoneFaces.data() + beg, end - beg);
+}
+
+Spatial::Mesh MeshFile::ToMesh() const
+{
+    const size_t nNodes = GetNodeCount();
+    const size_t nFaces = GetFaceCount();
+    const size_t nCells = GetCellCount();
+
+    Spatial::Mesh mesh;
+    mesh.nodes.reserve(nNodes);
+    mesh.faces.reserve(nFaces);
+    mesh.cells.reserve(nCells);
+
+    for (size_t nIdx = 0; nIdx < nNodes; nIdx++)
+    {
+        mesh.nodes[nIdx].coor = mNodeCoords[nIdx];
+    }
+
+    for (size_t fIdx = 0; fIdx < nFaces; fIdx++)
+    {
+        auto &face    = mesh.faces[fIdx];
+        auto  indexes = GetFaceNodes(fIdx);
+
+        face.centroid = mFaceCoords[fIdx];
+        face.nodeIndexes.assign(indexes.begin(), indexes.end());
+    }
+
+    for (size_t cIdx = 0; cIdx < nCells; cIdx++)
+    {
+        auto &cell    = mesh.cells[cIdx];
+        auto  indexes = GetCellFaces(cIdx);
+
+        cell.centroid = mCellCoords[cIdx];
+        cell.faceIndexes.assign(indexes.begin(), indexes.end());
+    }
+
+    return mesh;
+}
+
+}  // namespace OpenOasis::CommImp::IO
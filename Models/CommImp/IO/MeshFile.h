@@ -0,0 +1,101 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  MeshFile.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  Binary mesh file, mapped into memory without parsing.
+ *
+ *    The binary mesh file holds the same data as the csv files of `MeshLoader`, with
+ *    the ids as the continuous indexes from 0. It's laid out as:
+ *
+ *      header(with the sizes and modified times of the csv files converted from)
+ *      node coordinates(real x 3, nodes)
+ *      face coordinates(real x 3, faces)
+ *      cell coordinates(real x 3, cells)
+ *      face nodes(CSR, offsets of uint64 x (faces + 1), indexes of uint64)
+ *      cell faces(CSR, offsets of uint64 x (cells + 1), indexes of uint64)
+ *      patch faces(CSR, offsets of uint64 x (patches + 1), indexes of uint64)
+ *      zone faces(CSR, offsets of uint64 x (zones + 1), indexes of uint64)
+ *      names of patches and zones(offsets of uint64 x (patches + zones + 1), chars)
+ *
+ *    where each section starts at 8 bytes alignment, in little endian.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Models/CommImp/Spatial/Mesh.h"
+#include "Models/Utils/MappedFile.h"
+#include "Models/Utils/Span.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+namespace OpenOasis::CommImp::IO
+{
+using Spatial::Coordinate;
+
+class MeshLoader;
+
+/// @brief Read-only binary mesh file.
+class MeshFile final
+{
+public:
+    /// Default name of the binary mesh file in a mesh directory.
+    static constexpr const char *DefaultFileName = "mesh.omsh";
+
+private:
+    std::shared_ptr<Utils::MappedFile> mFile;
+
+    Utils::Span<const Coordinate> mNodeCoords;
+    Utils::Span<const Coordinate> mFaceCoords;
+    Utils::Span<const Coordinate> mCellCoords;
+
+    Utils::Span<const size_t> mFaceNodeOffsets, mFaceNodes;
+    Utils::Span<const size_t> mCellFaceOffsets, mCellFaces;
+    Utils::Span<const size_t> mPatchOffsets, mPatchFaces;
+    Utils::Span<const size_t> mZoneOffsets, mZoneFaces;
+    Utils::Span<const size_t> mNameOffsets;
+    Utils::Span<const char>   mNames;
+
+public:
+    /// @brief Opens the binary mesh file, which checks the header and indexes.
+    static std::shared_ptr<MeshFile> Open(const std::string &path);
+
+    /// @brief Writes the mesh data loaded into a binary mesh file.
+    static void Write(const std::string &path, MeshLoader &loader);
+
+    /// @brief Converts the csv files in the mesh directory to a binary mesh file.
+    static void ConvertFromCsv(const std::string &meshDir, const std::string &path);
+
+    /// @brief Checks the binary mesh file is of this version and the csv files in the
+    /// mesh directory are unchanged since converted, by their sizes and modified times.
+    static bool IsUpToDate(const std::string &path, const std::string &meshDir);
+
+    size_t GetNodeCount() const;
+    size_t GetFaceCount() const;
+    size_t GetCellCount() const;
+    size_t GetPatchCount() const;
+    size_t GetZoneCount() const;
+
+    Utils::Span<const Coordinate> GetNodeCoordinates() const;
+    Utils::Span<const Coordinate> GetFaceCoordinates() const;
+    Utils::Span<const Coordinate> GetCellCoordinates() const;
+
+    Utils::Span<const size_t> GetFaceNodes(size_t faceIndex) const;
+    Utils::Span<const size_t> GetCellFaces(size_t cellIndex) const;
+
+    std::string               GetPatchName(size_t patchIndex) const;
+    Utils::Span<const size_t> GetPatchFaces(size_t patchIndex) const;
+
+    std::string               GetZoneName(size_t zoneIndex) const;
+    Utils::Span<const size_t> GetZoneFaces(size_t zoneIndex) const;
+
+    /// @brief Builds the mesh for `Grid`.
+    Spatial::Mesh ToMesh() const;
+
+private:
+    MeshFile() = default;
+};
+
+}  // namespace OpenOasis::CommImp::IO
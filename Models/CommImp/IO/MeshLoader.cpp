@@ -4,10 +4,11 @@
  *
  ** ***********************************************************************************/
 #include "MeshLoader.h"
+#include "MeshFile.h"
 #include "Models/Utils/Exception.h"
 #include "Models/Utils/FilePathHelper.h"
 #include "Models/Utils/StringHelper.h"
-#include "Models/Utils/CsvHandler.h"
+#include "Models/Utils/CsvChunkReader.h"
 #include <set>
 
 
@@ -16,6 +17,29 @@ namespace OpenOasis::CommImp::IO
 using namespace std;
 using namespace Utils;
 
+namespace
+{
+vector<int> GetRow(const CsvRows<int> &rows, size_t i)
+{
+    const auto beg = rows.values.begin();
+    return vector<int>(beg + rows.offsets[i], beg + rows.offsets[i + 1]);
+}
+
+/// @brief Returns the maximum number of values in a row.
+size_t GetColumnCount(const CsvRows<int> &rows)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < rows.GetRowCount(); ++i)
+    {
+        count = max(count, rows.GetRowSize(i));
+    }
+
+    return count;
+}
+
+}  // namespace
+
+
 MeshLoader::MeshLoader(const string &meshDir)
 {
     if (!FilePathHelper::DirectoryExists(meshDir))
@@ -29,34 +53,46 @@ MeshLoader::MeshLoader(const string &meshDir)
 
 void MeshLoader::Load()
 {
-#pragma omp parallel sections
+    const auto &file = FilePathHelper::Combine(mMeshDir, MeshFile::DefaultFileName);
+    if (MeshFile::IsUpToDate(file, mMeshDir))
     {
-#pragma omp section
-        {
-            LoadNodes();
-        }
-#pragma omp section
-        {
-            LoadFaces();
-        }
-#pragma omp section
-        {
-            LoadCells();
-        }
-#pragma omp section
-        {
-            LoadPatches();
-        }
-#pragma omp section
-        {
-            LoadZones();
-        }
+        LoadBinary(file);
+        return;
     }
 
+    LoadCsv();
+}
+
+void MeshLoader::LoadCsv()
+{
+    // Each file is parsed in parallel by chunks.
+    LoadNodes();
+    LoadFaces();
+    LoadCells();
+    LoadPatches();
+    LoadZones();
+
     GenerateFaceCoordinates();
     GenerateCellCoordinates();
 }
 
+Spatial::Mesh MeshLoader::LoadMesh()
+{
+    const auto &file = FilePathHelper::Combine(mMeshDir, MeshFile::DefaultFileName);
+    if (MeshFile::IsUpToDate(file, mMeshDir))
+    {
+        return MeshFile::Open(file)->ToMesh();
+    }
+
+    LoadCsv();
+    return ToMesh();
+}
+
+const string &MeshLoader::GetMeshDirectory() const
+{
+    return mMeshDir;
+}
+
 unordered_map<string, vector<int>> &MeshLoader::GetPatches()
 {
     return mPatchFaces;
@@ -82,12 +118,12 @@ unordered_map<int, Coordinate> &MeshLoader::GetCellCoordinates()
     return mCellCoords;
 }
 
-unordered_map<int, vector<int>> &MeshLoader::GetFaceNodes()
+CsvRows<int> &MeshLoader::GetFaceNodes()
 {
     return mFaceNodes;
 }
 
-unordered_map<int, vector<int>> &MeshLoader::GetCellFaces()
+CsvRows<int> &MeshLoader::GetCellFaces()
 {
     return mCellFaces;
 }
@@ -98,20 +134,18 @@ void MeshLoader::LoadNodes(const string &nodeFile)
     if (!FilePathHelper::FileExists(file))
         return;
 
-    CsvLoader loader(file, true, true);
-    if (loader.GetColumnCount() < 3)
-    {
-        throw InvalidDataException("Invalid Node data, to few columns.");
-    }
+    const auto rows = CsvChunkReader::Read<real>(file, true, CsvLabelMode::Index);
 
-    auto ids = loader.GetRowLabels().value();
-    CheckIds(ids, "Node");
-
-    for (std::size_t i = 0; i < ids.size(); ++i)
+    mNodeCoords.reserve(rows.GetRowCount());
+    for (size_t i = 0; i < rows.GetRowCount(); ++i)
     {
-        auto coor = loader.GetRow<real>(i).value();
+        if (rows.GetRowSize(i) < 3)
+        {
+            throw InvalidDataException("Invalid Node data, to few columns.");
+        }
 
-        mNodeCoords[i] = {coor[0], coor[1], coor[2]};
+        const real *coor = rows.values.data() + rows.offsets[i];
+        mNodeCoords[i]   = {coor[0], coor[1], coor[2]};
     }
 }
 
@@ -121,19 +155,13 @@ void MeshLoader::LoadFaces(const string &faceFile)
     if (!FilePathHelper::FileExists(file))
         return;
 
-    CsvLoader loader(file, true, true);
-    if (loader.GetColumnCount() < 2)
+    auto rows = CsvChunkReader::Read<int>(file, true, CsvLabelMode::Index);
+    if (GetColumnCount(rows) < 2)
     {
         throw InvalidDataException("Invalid Face data, to few columns.");
     }
 
-    auto ids = loader.GetRowLabels().value();
-    CheckIds(ids, "Face");
-
-    for (std::size_t i = 0; i < ids.size(); ++i)
-    {
-        mFaceNodes[i] = loader.GetRow<int>(i).value();
-    }
+    mFaceNodes = move(rows);
 }
 
 void MeshLoader::LoadCells(const string &cellFile)
@@ -142,19 +170,13 @@ void MeshLoader::LoadCells(const string &cellFile)
     if (!FilePathHelper::FileExists(file))
         return;
 
-    CsvLoader loader(file, true, true);
-    if (loader.GetColumnCount() < 3)
+    auto rows = CsvChunkReader::Read<int>(file, true, CsvLabelMode::Index);
+    if (GetColumnCount(rows) < 3)
     {
         throw InvalidDataException("Invalid Cell data, to few columns.");
     }
 
-    auto ids = loader.GetRowLabels().value();
-    CheckIds(ids, "Cell");
-
-    for (std::size_t i = 0; i < ids.size(); ++i)
-    {
-        mCellFaces[i] = loader.GetRow<int>(i).value();
-    }
+    mCellFaces = move(rows);
 }
 
 void MeshLoader::LoadPatches(const string &patchFile)
@@ -163,17 +185,15 @@ void MeshLoader::LoadPatches(const string &patchFile)
     if (!FilePathHelper::FileExists(file))
         return;
 
-    CsvLoader loader(file, false, true);
-    if (loader.GetColumnCount() < 1)
+    const auto rows = CsvChunkReader::Read<int>(file, false, CsvLabelMode::Text);
+    if (GetColumnCount(rows) < 1)
     {
         throw InvalidDataException("Invalid Patch data, to few columns.");
     }
 
-    auto ids = loader.GetRowLabels().value();
-
-    for (const auto &id : ids)
+    for (size_t i = 0; i < rows.GetRowCount(); ++i)
     {
-        mPatchFaces[id] = loader.GetRow<int>(id).value();
+        mPatchFaces[rows.labels[i]] = GetRow(rows, i);
     }
 }
 
@@ -183,54 +203,78 @@ void MeshLoader::LoadZones(const string &zoneFile)
     if (!FilePathHelper::FileExists(file))
         return;
 
-    CsvLoader loader(file, false, true);
-    if (loader.GetColumnCount() < 3)
+    const auto rows = CsvChunkReader::Read<int>(file, false, CsvLabelMode::Text);
+    if (GetColumnCount(rows) < 3)
     {
         throw InvalidDataException("Invalid Zone data, to few columns.");
     }
 
-    auto ids = loader.GetRowLabels().value();
-
-    for (const auto &id : ids)
+    for (size_t i = 0; i < rows.GetRowCount(); ++i)
     {
-        mZoneFaces[id] = loader.GetRow<int>(id).value();
+        mZoneFaces[rows.labels[i]] = GetRow(rows, i);
     }
 }
 
-void MeshLoader::CheckIds(const vector<string> &ids, const string &meta)
+void MeshLoader::LoadBinary(const string &file)
 {
-    vector<int> ids_int(ids.size());
-    transform(
-        begin(ids), end(ids), begin(ids_int), [](const auto &id) { return stoi(id); });
+    const auto meshFile = MeshFile::Open(file);
+
+    auto toIds = [](Span<const size_t> indexes) {
+        return vector<int>(indexes.begin(), indexes.end());
+    };
+
+    auto addRow = [](CsvRows<int> &rows, Span<const size_t> indexes) {
+        rows.values.insert(rows.values.end(), indexes.begin(), indexes.end());
+        rows.offsets.push_back(rows.values.size());
+    };
 
-    if (ids_int.front() != 0)
+    const auto nodeCoords = meshFile->GetNodeCoordinates();
+    const auto faceCoords = meshFile->GetFaceCoordinates();
+    const auto cellCoords = meshFile->GetCellCoordinates();
+
+    for (size_t i = 0; i < nodeCoords.size(); i++)
     {
-        throw InvalidDataException(StringHelper::FormatSimple(
-            "Invalid [{}] data, ids don't start from 0.", meta));
+        mNodeCoords[i] = nodeCoords[i];
     }
 
-    if (ids_int.back() != int(ids_int.size()) - 1)
+    for (size_t i = 0; i < faceCoords.size(); i++)
     {
-        throw InvalidDataException(StringHelper::FormatSimple(
-            "Invalid [{}] data, non-incremental ids.", meta));
+        mFaceCoords[i] = faceCoords[i];
+        addRow(mFaceNodes, meshFile->GetFaceNodes(i));
+    }
+
+    for (size_t i = 0; i < cellCoords.size(); i++)
+    {
+        mCellCoords[i] = cellCoords[i];
+        addRow(mCellFaces, meshFile->GetCellFaces(i));
+    }
+
+    for (size_t i = 0; i < meshFile->GetPatchCount(); i++)
+    {
+        mPatchFaces[meshFile->GetPatchName(i)] = toIds(meshFile->GetPatchFaces(i));
+    }
+
+    for (size_t i = 0; i < meshFile->GetZoneCount(); i++)
+    {
+        mZoneFaces[meshFile->GetZoneName(i)] = toIds(meshFile->GetZoneFaces(i));
     }
 }
 
 void MeshLoader::GenerateFaceCoordinates()
 {
-    for (const auto &face : mFaceNodes)
+    for (size_t id = 0; id < mFaceNodes.GetRowCount(); ++id)
     {
-        int id = face.first;
+        const int *nodes = mFaceNodes.values.data() + mFaceNodes.offsets[id];
+        const int  size  = (int)mFaceNodes.GetRowSize(id);
 
         real x = 0, y = 0, z = 0;
-        for (int nId : face.second)
+        for (int i = 0; i < size; ++i)
         {
-            x += mNodeCoords[nId].x;
-            y += mNodeCoords[nId].y;
-            z += mNodeCoords[nId].z;
+            x += mNodeCoords[nodes[i]].x;
+            y += mNodeCoords[nodes[i]].y;
+            z += mNodeCoords[nodes[i]].z;
         }
 
-        int size = (int)face.second.size();
         x /= size;
         y /= size;
         z /= size;
@@ -241,19 +285,19 @@ void MeshLoader::GenerateFaceCoordinates()
 
 void MeshLoader::GenerateCellCoordinates()
 {
-    for (const auto &cell : mCellFaces)
+    for (size_t id = 0; id < mCellFaces.GetRowCount(); ++id)
     {
-        int id = cell.first;
+        const int *faces = mCellFaces.values.data() + mCellFaces.offsets[id];
+        const int  size  = (int)mCellFaces.GetRowSize(id);
 
         real x = 0, y = 0, z = 0;
-        for (int fId : cell.second)
+        for (int i = 0; i < size; ++i)
         {
-            x += mFaceCoords[fId].x;
-            y += mFaceCoords[fId].y;
-            z += mFaceCoords[fId].z;
+            x += mFaceCoords[faces[i]].x;
+            y += mFaceCoords[faces[i]].y;
+            z += mFaceCoords[faces[i]].z;
         }
 
-        int size = (int)cell.second.size();
         x /= size;
         y /= size;
         z /= size;
@@ -262,4 +306,37 @@ void MeshLoader::GenerateCellCoordinates()
     }
 }
 
-}  // namespace OpenOasis::CommImp::IO
\ No newline at end of file
+Spatial::Mesh MeshLoader::ToMesh()
+{
+    Spatial::Mesh mesh;
+    mesh.nodes.reserve(mNodeCoords.size());
+    mesh.faces.reserve(mFaceNodes.GetRowCount());
+    mesh.cells.reserve(mCellFaces.GetRowCount());
+
+    for (const auto &[id, coor] : mNodeCoords)
+    {
+        mesh.nodes[id].coor = coor;
+    }
+
+    const auto beg = [](const CsvRows<int> &rows, size_t id) {
+        return rows.values.begin() + rows.offsets[id];
+    };
+
+    for (size_t id = 0; id < mFaceNodes.GetRowCount(); ++id)
+    {
+        auto &face    = mesh.faces[id];
+        face.centroid = mFaceCoords[id];
+        face.nodeIndexes.assign(beg(mFaceNodes, id), beg(mFaceNodes, id + 1));
+    }
+
+    for (size_t id = 0; id < mCellFaces.GetRowCount(); ++id)
+    {
+        auto &cell    = mesh.cells[id];
+        cell.centroid = mCellCoords[id];
+        cell.faceIndexes.assign(beg(mCellFaces, id), beg(mCellFaces, id + 1));
+    }
+
+    return mesh;
+}
+
+}  // namespace OpenOasis::CommImp::IO
@@ -22,9 +22,14 @@
  *    patches.csv, used for storing patch faces indexes, formated as :
  *               "pId, fId1, fId2, fId3, ..."
  *
+ *    If the binary mesh file "mesh.omsh" converted from them exists(see `MeshFile`)
+ *    and they are unchanged since converted, it's loaded instead.
+ *
  ** ***********************************************************************************/
 #pragma once
 #include "Models/CommImp/Spatial/Coordinate.h"
+#include "Models/CommImp/Spatial/Mesh.h"
+#include "Models/Utils/CsvChunkReader.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -33,6 +38,7 @@
 namespace OpenOasis::CommImp::IO
 {
 using Spatial::Coordinate;
+using Utils::CsvRows;
 
 /// @brief Default `Mesh` data loader.
 /// @details In default mode, coordinates are defined on nodes.
@@ -48,8 +54,9 @@ private:
     std::unordered_map<int, Coordinate> mFaceCoords;
     std::unordered_map<int, Coordinate> mCellCoords;
 
-    std::unordered_map<int, std::vector<int>> mFaceNodes;
-    std::unordered_map<int, std::vector<int>> mCellFaces;
+    // Rows of the face nodes and cell faces as parsed, where the ids are the rows.
+    CsvRows<int> mFaceNodes;
+    CsvRows<int> mCellFaces;
 
 public:
     MeshLoader(const std::string &meshDir);
@@ -58,6 +65,15 @@ public:
 
     virtual void Load();
 
+    /// @brief Loads the mesh data from the csv files, ignoring the binary mesh file.
+    void LoadCsv();
+
+    /// @brief Loads the mesh for `Grid`, which is built from the binary mesh file
+    /// directly if it's up to date, without the mesh data of the loader.
+    Spatial::Mesh LoadMesh();
+
+    const std::string &GetMeshDirectory() const;
+
     virtual std::unordered_map<std::string, std::vector<int>> &GetPatches();
     virtual std::unordered_map<std::string, std::vector<int>> &GetZones();
 
@@ -65,8 +81,8 @@ public:
     virtual std::unordered_map<int, Coordinate> &GetFaceCoordinates();
     virtual std::unordered_map<int, Coordinate> &GetCellCoordinates();
 
-    virtual std::unordered_map<int, std::vector<int>> &GetFaceNodes();
-    virtual std::unordered_map<int, std::vector<int>> &GetCellFaces();
+    virtual CsvRows<int> &GetFaceNodes();
+    virtual CsvRows<int> &GetCellFaces();
 
 protected:
     void LoadNodes(const std::string &file = "nodes.csv");
@@ -74,10 +90,11 @@ protected:
     void LoadCells(const std::string &file = "cells.csv");
     void LoadZones(const std::string &file = "zones.csv");
     void LoadPatches(const std::string &file = "patches.csv");
-
-    void CheckIds(const std::vector<std::string> &ids, const std::string &meta);
+    void LoadBinary(const std::string &file);
 
     void GenerateFaceCoordinates();
     void GenerateCellCoordinates();
+
+    Spatial::Mesh ToMesh();
 };
 }  // namespace OpenOasis::CommImp::IO
@@ -8,6 +8,7 @@
 #include "ElementSet.h"
 #include "TimeSet.h"
 #include "ValueSet2D.h"
+#include "ValueSetDense.h"
 #include "Quantity.h"
 #include "DevSupports/ExchangeItemHelper.h"
 #include "DevSupports/ExtensionMethods.h"
@@ -222,27 +223,41 @@ bool Input::IsValidQuerySpecifier(const shared_ptr<IBaseExchangeItem> &querier)
 
 void Input::AcceptValues(const vector<shared_ptr<IValueSet>> &values)
 {
+    int  elementCount = mElementSet->GetElementCount();
+    auto denseValues  = dynamic_pointer_cast<ValueSetDense<real>>(mValues);
+
     for (int t = 0; t < (int)mTimeSet->GetTimes().size(); ++t)
     {
-        for (int e = 0; e < mElementSet->GetElementCount(); ++e)
+        // Sum up the values of providers at the time, element by element.
+        vector<real> sums(elementCount, 0.0);
+        for (const auto &valueset : values)
         {
-            real value = 0.0;
-            for (const auto &valueset : values)
-            {
-                if (t >= valueset->GetIndexCount({0})
-                    || e >= valueset->GetIndexCount({0, 0}))
-                    continue;
-
-                real data = any_cast<real>(valueset->GetValue({t, e}));
-                any  miss = valueset->GetValueDefinition()->GetMissingDataValue();
+            if (t >= valueset->GetIndexCount({0}))
+                continue;
 
-                if (data == any_cast<real>(miss))
-                    continue;
+            any  missValue = valueset->GetValueDefinition()->GetMissingDataValue();
+            real miss      = any_cast<real>(missValue);
 
-                value += data;
+            const auto &data =
+                ExtensionMethods::GetElementValuesForTime<real>(valueset, t);
+            int         size = min(elementCount, (int)data.size());
+            for (int e = 0; e < size; ++e)
+            {
+                if (data[e] != miss)
+                    sums[e] += data[e];
             }
+        }
 
-            mValues->SetOrAddValue({t, e}, value);
+        if (denseValues && t < denseValues->GetTimesCount()
+            && elementCount == denseValues->GetElementsCount())
+        {
+            denseValues->SetElementValuesForTime(t, sums);
+            continue;
+        }
+
+        for (int e = 0; e < elementCount; ++e)
+        {
+            mValues->SetOrAddValue({t, e}, sums[e]);
         }
     }
 }
@@ -12,6 +12,7 @@
 #include "SpaceAdaptedOutputFactory.h"
 #include "DevSupports/ExtensionMethods.h"
 #include "DevSupports/ExchangeItemHelper.h"
+#include "DevSupports/CouplingStepController.h"
 #include "Models/Utils/Exception.h"
 #include "Models/Utils/StringHelper.h"
 #include "Models/Utils/MapHelper.h"
@@ -159,6 +160,18 @@ bool LinkableComponent::GetCascadingUpdateCallsDisabled() const
     return mCascadingUpdateCallsDisabled;
 }
 
+void LinkableComponent::SetCouplingStepController(
+    const shared_ptr<DevSupports::CouplingStepController> &controller)
+{
+    mCouplingStepController = controller;
+}
+
+shared_ptr<DevSupports::CouplingStepController>
+LinkableComponent::GetCouplingStepController() const
+{
+    return mCouplingStepController;
+}
+
 bool LinkableComponent::IsIterationConverged() const
 {
     return true;
@@ -253,8 +266,11 @@ void LinkableComponent::Update()
     // Indicate that we are waiting data.
     SetStatus(LinkableComponentStatus::WaitingForData);
 
-    // Prepare all required input data.
-    PullInputs();
+    // Prepare all required input data, unless the coupling interval not elapsed,
+    // then the last received data is kept.
+    if (!mCouplingStepController
+        || mCouplingStepController->IsExchangeDue(mCurrentTime->GetTimeStamp()))
+        PullInputs();
 
     // Indicate that we are starting to compute.
     SetStatus(LinkableComponentStatus::Updating);
@@ -294,7 +310,13 @@ void LinkableComponent::PullInputs()
 
         const auto &values = input->GetValues();
         ApplyInputData(values);
+
+        if (mCouplingStepController)
+            mCouplingStepController->Observe(input->GetId(), values);
     }
+
+    if (mCouplingStepController)
+        mCouplingStepController->CompleteExchange(mCurrentTime->GetTimeStamp());
 }
 
 void LinkableComponent::UpdateInputs()
@@ -310,19 +332,9 @@ void LinkableComponent::UpdateInputs()
         const auto &valueset = input->GetValues();
 
         int elments = valueset->GetIndexCount({0});
-        while (!timeset->GetTimes().empty())
-        {
-            if (timeset->GetTimes().front()->GetTimeStamp() < lastTimestamp)
-            {
-                // Remove the expired time and values synchronously.
-                timeset->RemoveTime(0);
-                valueset->RemoveValue({0});
-            }
-            else
-            {
-                break;
-            }
-        }
+
+        // Remove the expired time and values synchronously.
+        ExtensionMethods::RemoveTimesBefore(timeset, valueset, lastTimestamp);
 
         if (timeset->GetTimes().empty())
         {
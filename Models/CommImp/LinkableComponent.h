@@ -23,6 +23,11 @@ namespace CommImp
 {
 using Utils::EventHandler;
 
+namespace DevSupports
+{
+class CouplingStepController;
+}
+
 /// @brief Generic implementation of `ILinkableComponent` with more process details.
 ///
 /// The implementation here predefines a set of methods that are useful in
@@ -59,6 +64,9 @@ protected:
     std::vector<std::shared_ptr<IInput>>  mInputs;
     std::vector<std::shared_ptr<IOutput>> mOutputs;
 
+    // Inputs are pulled at every time step if no coupling step controller is set.
+    std::shared_ptr<DevSupports::CouplingStepController> mCouplingStepController;
+
     std::shared_ptr<ITimeSet> mTimeExtent = nullptr;
 
     LinkableComponentStatus mStatus = LinkableComponentStatus::Created;
@@ -147,6 +155,13 @@ public:
 
     virtual bool IsOptimizationTerminated() const;
 
+    /// @brief Sets the controller adapting the interval of pulling inputs.
+    virtual void SetCouplingStepController(
+        const std::shared_ptr<DevSupports::CouplingStepController> &controller);
+
+    virtual std::shared_ptr<DevSupports::CouplingStepController>
+    GetCouplingStepController() const;
+
     ///////////////////////////////////////////////////////////////////////////////////
     // Additional methods for time info and time stepping.
     //
@@ -9,6 +9,8 @@
 #include "Models/Utils/CommConstants.h"
 #include "ThirdPart/Eigen/Sparse"
 #include "Vector.h"
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 
@@ -360,12 +362,25 @@ public:
 //
 
 /// @brief Sparse matrix having double elements.
+///
+/// The matrix is assembled in `mValues` by random access, then `Compress()` packs
+/// the nonzero values into compressed sparse rows(CSR), which the products walk
+/// contiguously and in parallel by rows.
 class DoubleSparseMatrix
 {
 private:
     int mRowCount    = 0;
     int mColumnCount = 0;
 
+    // Compressed sparse rows, valid while `mIsCompressed` and `mValues` is empty.
+    bool                     mIsCompressed = false;
+    std::vector<int>         mRowStarts;
+    std::vector<int>         mColumns;
+    std::vector<Utils::real> mEntries;
+
+    // Least count of nonzero values to run the products in parallel.
+    static constexpr int mParallelThreshold = 4096;
+
 public:
     class Index
     {
@@ -394,12 +409,15 @@ public:
         size_t operator()(const Index &key) const
         {
             using std::hash;
-            using std::size_t;
+            using std::uint64_t;
 
-            return ((hash<int>()(key.mRow) ^ (hash<int>()(key.mCol) << 1)) >> 1);
+            // Packs both indices, the former mix collided for most rows and columns.
+            uint64_t packed = ((uint64_t)(unsigned)key.mRow << 32) | (unsigned)key.mCol;
+            return hash<uint64_t>()(packed);
         }
     };
 
+    /// Values being assembled, which are moved into the CSR arrays by `Compress()`.
     std::unordered_map<Index, Utils::real, HashFunc, EqualFunc> mValues;
 
 public:
@@ -426,6 +444,162 @@ public:
         mColumnCount = value;
     }
 
+    bool IsCompressed() const
+    {
+        return mIsCompressed;
+    }
+
+    /// @brief Number of the stored values, zeros are pruned after compressed.
+    int GetNonZerosCount() const
+    {
+        return mIsCompressed ? (int)mEntries.size() : (int)mValues.size();
+    }
+
+    /// @brief Packs the assembled nonzero values into CSR arrays, the columns of
+    /// each row are sorted ascending.
+    void Compress()
+    {
+        if (mIsCompressed)
+            return;
+
+        mRowStarts.assign(mRowCount + 1, 0);
+        for (const auto &entry : mValues)
+        {
+            if (entry.second != 0)
+                mRowStarts[entry.first.mRow + 1]++;
+        }
+
+        for (int i = 0; i < mRowCount; i++)
+        {
+            mRowStarts[i + 1] += mRowStarts[i];
+        }
+
+        mColumns.resize(mRowStarts.back());
+        mEntries.resize(mRowStarts.back());
+
+        std::vector<int> cursors(mRowStarts.begin(), mRowStarts.end() - 1);
+        for (const auto &entry : mValues)
+        {
+            if (entry.second == 0)
+                continue;
+
+            int k       = cursors[entry.first.mRow]++;
+            mColumns[k] = entry.first.mCol;
+            mEntries[k] = entry.second;
+        }
+
+        std::vector<std::pair<int, Utils::real>> row;
+        for (int i = 0; i < mRowCount; i++)
+        {
+            row.clear();
+            for (int k = mRowStarts[i]; k < mRowStarts[i + 1]; k++)
+            {
+                row.emplace_back(mColumns[k], mEntries[k]);
+            }
+
+            std::sort(row.begin(), row.end());
+            for (int k = mRowStarts[i]; k < mRowStarts[i + 1]; k++)
+            {
+                mColumns[k] = row[k - mRowStarts[i]].first;
+                mEntries[k] = row[k - mRowStarts[i]].second;
+            }
+        }
+
+        decltype(mValues)().swap(mValues);
+        mIsCompressed = true;
+    }
+
+    /// @brief Sets all rows from the nonzero values of each row, given as pairs of
+    /// column and value, which are compressed directly.
+    void SetRows(const std::vector<std::vector<std::pair<int, Utils::real>>> &rows)
+    {
+        if ((int)rows.size() != mRowCount)
+            throw std::runtime_error("Matrix rows count mismatch");
+
+        decltype(mValues)().swap(mValues);
+        mRowStarts.assign(1, 0);
+        mColumns.clear();
+        mEntries.clear();
+
+        std::vector<std::pair<int, Utils::real>> row;
+        for (const auto &entries : rows)
+        {
+            row = entries;
+            std::sort(row.begin(), row.end());
+            for (const auto &entry : row)
+            {
+                if (entry.second == 0)
+                    continue;
+
+                if (entry.first < 0 || entry.first >= mColumnCount)
+                    throw std::runtime_error("Matrxi index out of range");
+
+                mColumns.push_back(entry.first);
+                mEntries.push_back(entry.second);
+            }
+
+            mRowStarts.push_back((int)mColumns.size());
+        }
+
+        mIsCompressed = true;
+    }
+
+    /// @brief Sets the compressed rows directly, e.g. loaded from file, whose columns
+    /// must be sorted in each row.
+    void SetCompressed(
+        std::vector<int> rowStarts, std::vector<int> columns,
+        std::vector<Utils::real> entries)
+    {
+        if ((int)rowStarts.size() != mRowCount + 1 || rowStarts.front() != 0
+            || rowStarts.back() != (int)columns.size()
+            || columns.size() != entries.size())
+            throw std::runtime_error("Matrix compressed rows mismatch");
+
+        decltype(mValues)().swap(mValues);
+        mRowStarts    = std::move(rowStarts);
+        mColumns      = std::move(columns);
+        mEntries      = std::move(entries);
+        mIsCompressed = true;
+    }
+
+    /// @brief Returns the starts of the compressed rows, empty unless compressed.
+    const std::vector<int> &GetRowStarts() const
+    {
+        return mRowStarts;
+    }
+
+    /// @brief Returns the columns of the compressed values.
+    const std::vector<int> &GetColumns() const
+    {
+        return mColumns;
+    }
+
+    /// @brief Returns the compressed values.
+    const std::vector<Utils::real> &GetEntries() const
+    {
+        return mEntries;
+    }
+
+    /// @brief Moves the compressed values back for assembling.
+    void Decompress()
+    {
+        if (!mIsCompressed)
+            return;
+
+        for (int i = 0; i < mRowCount; i++)
+        {
+            for (int k = mRowStarts[i]; k < mRowStarts[i + 1]; k++)
+            {
+                mValues[Index(i, mColumns[k])] = mEntries[k];
+            }
+        }
+
+        mRowStarts.clear();
+        mColumns.clear();
+        mEntries.clear();
+        mIsCompressed = false;
+    }
+
     std::vector<Utils::real> Product(const std::vector<Utils::real> &vector2)
     {
         auto outputValues = std::vector<Utils::real>(mRowCount);
@@ -438,9 +612,76 @@ public:
         if (vector2.empty())
             return;
 
-        for (auto &entry : mValues)
+        Product(res.data(), vector2.data());
+    }
+
+    /// @brief Adds the product to the `res` of row count, `vector2` has column count.
+    void Product(Utils::real *res, const Utils::real *vector2) const
+    {
+        if (!mIsCompressed)
+        {
+            for (const auto &entry : mValues)
+            {
+                res[entry.first.mRow] += entry.second * vector2[entry.first.mCol];
+            }
+            return;
+        }
+
+        const int         *starts  = mRowStarts.data();
+        const int         *columns = mColumns.data();
+        const Utils::real *entries = mEntries.data();
+
+#pragma omp parallel for schedule(static) \
+    if ((int)mEntries.size() >= mParallelThreshold)
+        for (int i = 0; i < mRowCount; i++)
+        {
+            Utils::real sum = 0;
+
+#pragma omp simd reduction(+ : sum)
+            for (int k = starts[i]; k < starts[i + 1]; k++)
+            {
+                sum += entries[k] * vector2[columns[k]];
+            }
+
+            res[i] += sum;
+        }
+    }
+
+    /// @brief Adds the products of several vectors, e.g. values at several times, to
+    /// the `res` rows in one pass, so each matrix row is loaded only once.
+    void Product(
+        const std::vector<Utils::real *>       &res,
+        const std::vector<const Utils::real *> &vectors) const
+    {
+        const int count = (int)std::min(res.size(), vectors.size());
+        if (!mIsCompressed || count == 1)
+        {
+            for (int t = 0; t < count; t++)
+            {
+                Product(res[t], vectors[t]);
+            }
+            return;
+        }
+
+        const int         *starts  = mRowStarts.data();
+        const int         *columns = mColumns.data();
+        const Utils::real *entries = mEntries.data();
+
+#pragma omp parallel for schedule(static) \
+    if ((int)mEntries.size() * count >= mParallelThreshold)
+        for (int i = 0; i < mRowCount; i++)
         {
-            res[entry.first.mRow] += entry.second * vector2[entry.first.mCol];
+            for (int k = starts[i]; k < starts[i + 1]; k++)
+            {
+                const Utils::real entry  = entries[k];
+                const int         column = columns[k];
+
+#pragma omp simd
+                for (int t = 0; t < count; t++)
+                {
+                    res[t][i] += entry * vectors[t][column];
+                }
+            }
         }
     }
 
@@ -450,23 +691,30 @@ public:
 
     bool IsCellEmpty(int row, int column)
     {
+        if (mIsCompressed)
+            return Find(row, column) < 0;
+
         auto index = Index(row, column);
         return mValues.find(index) == mValues.end();
     }
 
     Utils::real operator()(int row, int column)
     {
-        auto index = Index(row, column);
-
-        const auto &iterator = mValues.find(index);
-        if (iterator == mValues.end())
-            throw std::runtime_error("Matrxi index out of range");
-
-        return iterator->second;
+        return At(row, column);
     }
 
+    /// @brief Gets the value, pruned zeros are got as zero after compressed.
     Utils::real At(int row, int column)
     {
+        if (mIsCompressed)
+        {
+            if (row < 0 || row >= mRowCount || column < 0 || column >= mColumnCount)
+                throw std::runtime_error("Matrxi index out of range");
+
+            int k = Find(row, column);
+            return k < 0 ? 0 : mEntries[k];
+        }
+
         auto index = Index(row, column);
 
         const auto &iterator = mValues.find(index);
@@ -476,11 +724,38 @@ public:
         return iterator->second;
     }
 
+    /// @brief Sets the value, which decompresses the matrix if it's not stored.
     void SetValue(int row, int column, Utils::real value)
     {
+        if (mIsCompressed)
+        {
+            int k = Find(row, column);
+            if (k >= 0)
+            {
+                mEntries[k] = value;
+                return;
+            }
+
+            Decompress();
+        }
+
         auto index     = Index(row, column);
         mValues[index] = value;
     }
+
+private:
+    /// @brief Finds the position of the compressed value, or -1 if not stored.
+    int Find(int row, int column) const
+    {
+        if (row < 0 || row >= mRowCount)
+            return -1;
+
+        auto first = mColumns.begin() + mRowStarts[row];
+        auto last  = mColumns.begin() + mRowStarts[row + 1];
+        auto iter  = std::lower_bound(first, last, column);
+
+        return iter != last && *iter == column ? (int)(iter - mColumns.begin()) : -1;
+    }
 };
 
 }  // namespace OpenOasis::CommImp::Numeric
\ No newline at end of file
@@ -9,7 +9,10 @@
  ** ***********************************************************************************/
 #pragma once
 #include "Models/Utils/CommMacros.h"
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <numeric>
 
 
 namespace OpenOasis
@@ -12,6 +12,7 @@
 #include "Tensor.h"
 #include <array>
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 
 
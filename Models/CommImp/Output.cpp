@@ -40,7 +40,8 @@ Output::Output(Output &&obj)
     mConsumers      = obj.mConsumers;
     mAdaptedOutputs = obj.mAdaptedOutputs;
 
-    mComponent = obj.mComponent;
+    mComponent               = obj.mComponent;
+    mComponentUpdateDisabled = obj.mComponentUpdateDisabled;
 }
 
 string Output::GetId() const
@@ -280,6 +281,8 @@ shared_ptr<IValueDefinition> Output::GetValueDefinition() const
 
 shared_ptr<IValueSet> Output::GetValues()
 {
+    lock_guard<recursive_mutex> lock(mValuesMutex);
+
     // Get the earlist time which no value request will be made earlier than.
     const auto earliestTime =
         ExchangeItemHelper::GetEarliestConsumerTime(GetInstance());
@@ -317,6 +320,13 @@ bool Output::IsValidQuerySpecifier(const shared_ptr<IBaseExchangeItem> &querier)
 
 void Output::Update()
 {
+    // The component is driven externally, only refresh the buffered values.
+    if (mComponentUpdateDisabled)
+    {
+        RefreshAdaptedOutputs();
+        return;
+    }
+
     const auto &latestTime = ExchangeItemHelper::GetLatestConsumerTime(GetInstance());
     if (!latestTime)
         return;
@@ -356,19 +366,8 @@ void Output::ReduceValuesAndTimes(const shared_ptr<ITime> &lastTime)
         lastTimestamp = lastTime->GetTimeStamp();
     }
 
-    while (!mTimeSet->GetTimes().empty())
-    {
-        if (mTimeSet->GetTimes().front()->GetTimeStamp() < lastTimestamp)
-        {
-            // Remove the expired time and values synchronously.
-            mTimeSet->RemoveTime(0);
-            mValues->RemoveValue({0});
-        }
-        else
-        {
-            break;
-        }
-    }
+    // Remove the expired time and values synchronously.
+    ExtensionMethods::RemoveTimesBefore(mTimeSet, mValues, lastTimestamp);
 }
 
 void Output::RefreshAdaptedOutputs()
@@ -399,6 +398,16 @@ void Output::SetComponent(shared_ptr<ILinkableComponent> component)
     mComponent = component;
 }
 
+void Output::SetComponentUpdateDisabled(bool value)
+{
+    mComponentUpdateDisabled = value;
+}
+
+bool Output::GetComponentUpdateDisabled() const
+{
+    return mComponentUpdateDisabled;
+}
+
 shared_ptr<Output> Output::GetInstance()
 {
     return shared_from_this();
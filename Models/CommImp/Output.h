@@ -17,6 +17,7 @@
 #include "Models/Inc/AdditionalControl/ISpaceExtension.h"
 #include "Models/Inc/IElementSet.h"
 #include "Models/Utils/EventHandler.h"
+#include <mutex>
 
 
 namespace OpenOasis
@@ -62,6 +63,14 @@ protected:
 
     std::vector<std::shared_ptr<IAdaptedOutput>> mAdaptedOutputs;
 
+    /// The `mComponentUpdateDisabled` indicates whether the component is driven
+    /// externally (e.g. by a lock-step executor), in which case the output only
+    /// delivers the values buffered, without updating the component on requests.
+    bool mComponentUpdateDisabled = false;
+
+    /// Serializes the value requests from consumers running concurrently.
+    std::recursive_mutex mValuesMutex;
+
 public:
     virtual ~Output() = default;
 
@@ -151,6 +160,10 @@ public:
 
     virtual void SetComponent(std::shared_ptr<ILinkableComponent> component);
 
+    virtual void SetComponentUpdateDisabled(bool value);
+
+    virtual bool GetComponentUpdateDisabled() const;
+
 protected:
     std::shared_ptr<Output> GetInstance();
 
@@ -0,0 +1,97 @@
+/** ***********************************************************************************
+ *    @File      :  RemoteInput.cpp
+ *    @Brief     :  To provide an input of a component running in a child process.
+ *
+ ** ***********************************************************************************/
+#include "RemoteInput.h"
+#include "TimeSet.h"
+#include "Time.h"
+#include "ValueSetDense.h"
+#include "Models/Inc/IOutput.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
+
+
+namespace OpenOasis::CommImp
+{
+using namespace Utils;
+using namespace std;
+
+
+RemoteInput::RemoteInput(
+    const string &id, const shared_ptr<ILinkableComponent> &comp,
+    const shared_ptr<IQuantity> &quantity, const shared_ptr<IElementSet> &elementSet) :
+    Input(id, comp)
+{
+    if (!comp || !quantity)
+    {
+        throw IllegalArgumentException(StringHelper::FormatSimple(
+            "Input [{}] requires a component and a quantity.", id));
+    }
+
+    // No time is requested from the providers until the first pull.
+    mElementSet = elementSet;
+    mValues     = make_shared<ValueSetDense<real>>(quantity);
+}
+
+Span<const real> RemoteInput::PullValues(double time)
+{
+    mTimeSet = make_shared<TimeSet>(vector<shared_ptr<ITime>>{make_shared<Time>(time)});
+
+    auto values = dynamic_pointer_cast<ValueSetDense<real>>(GetValues());
+    if (values->GetTimesCount() == 0)
+    {
+        return {};
+    }
+
+    return values->GetElementValuesForTimeSpan(0);
+}
+
+void RemoteInput::Update()
+{
+    auto values = dynamic_pointer_cast<ValueSetDense<real>>(mValues);
+
+    int          count = mElementSet ? mElementSet->GetElementCount() : -1;
+    vector<real> sums;
+    for (const auto &provider : mProviders)
+    {
+        // Rows of dense value sets are read in place, others are converted.
+        auto provided = provider.lock()->GetValues();
+        auto dense    = dynamic_pointer_cast<ValueSetDense<real>>(provided);
+        if (!dense)
+        {
+            dense = make_shared<ValueSetDense<real>>(provided);
+        }
+
+        if (dense->GetTimesCount() == 0)
+        {
+            continue;
+        }
+
+        auto row = dense->GetElementValuesForTimeSpan(0);
+        count    = count < 0 ? (int)row.size() : count;
+        if ((int)row.size() != count)
+        {
+            throw InvalidDataException(StringHelper::FormatSimple(
+                "Input [{}] has {} values, but {} are provided.",
+                mId,
+                count,
+                row.size()));
+        }
+
+        auto miss = any_cast<real>(dense->GetValueDefinition()->GetMissingDataValue());
+        sums.resize(count, 0.);
+        for (int e = 0; e < count; e++)
+        {
+            sums[e] += row[e] != miss ? row[e] : 0.;
+        }
+    }
+
+    values->RemoveTimesFrom(0);
+    if (!sums.empty())
+    {
+        values->AddElementValuesForTime(sums);
+    }
+}
+
+}  // namespace OpenOasis::CommImp
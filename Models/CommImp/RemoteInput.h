@@ -0,0 +1,59 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  RemoteInput.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To provide an input of a component running in a child process.
+ *
+ *    The remote input stands in for an input of a `RemoteComponent`, consuming the
+ *    outputs linked in the launcher process. The remote component pulls the values
+ *    before each of its updates and writes them into shared memory for the child.
+ *
+ *    As for the remote output, the value definition and element set are given
+ *    locally, e.g. by the provider. Between two remote components neither side
+ *    knows the elements, so the element set may be absent, and the number of values
+ *    is taken from the providers.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Input.h"
+#include "Models/Utils/CommConstants.h"
+#include "Models/Utils/Span.h"
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+/// @brief Input item collecting the values for an input of a remote component.
+class RemoteInput : public Input
+{
+public:
+    virtual ~RemoteInput() = default;
+
+    /// @brief Creates the remote input.
+    ///
+    /// @param id Id of the input in the remote component.
+    /// @param comp Remote component the input belongs to.
+    /// @param quantity Value definition of the input.
+    /// @param elementSet Element set of the input, or null if unknown.
+    RemoteInput(
+        const std::string &id, const std::shared_ptr<ILinkableComponent> &comp,
+        const std::shared_ptr<IQuantity>   &quantity,
+        const std::shared_ptr<IElementSet> &elementSet);
+
+    /// @brief Pulls the values of the providers at the time.
+    ///
+    /// @return Values of all elements, summed over the providers as `Input` does,
+    /// which are valid until the next pull. Empty if no provider has values.
+    Utils::Span<const Utils::real> PullValues(double time);
+
+protected:
+    /// @brief Takes the values of the first time of each provider, the number of
+    /// values follows the providers if the element set is absent.
+    virtual void Update() override;
+};
+
+}  // namespace CommImp
+}  // namespace OpenOasis
@@ -0,0 +1,76 @@
+/** ***********************************************************************************
+ *    @File      :  RemoteOutput.cpp
+ *    @Brief     :  To provide an output of a component running in a child process.
+ *
+ ** ***********************************************************************************/
+#include "RemoteOutput.h"
+#include "TimeSet.h"
+#include "Time.h"
+#include "ValueSetDense.h"
+#include "Models/Utils/CommConstants.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
+#include <type_traits>
+
+
+namespace OpenOasis::CommImp
+{
+using namespace Utils;
+using namespace std;
+
+
+RemoteOutput::RemoteOutput(
+    const string &id, const shared_ptr<ILinkableComponent> &comp,
+    const shared_ptr<IQuantity> &quantity, const shared_ptr<IElementSet> &elementSet) :
+    Output(id, comp)
+{
+    if (!comp || !quantity)
+    {
+        throw IllegalArgumentException(StringHelper::FormatSimple(
+            "Output [{}] requires a component and a quantity.", id));
+    }
+
+    mElementSet = elementSet;
+    mTimeSet    = make_shared<TimeSet>();
+    mValues     = make_shared<ValueSetDense<real>>(quantity);
+}
+
+void RemoteOutput::AppendValues(double time, Span<const double> values)
+{
+    const auto &times = mTimeSet->GetTimes();
+    if (!times.empty()
+        && time <= times.back()->GetTimeStamp() + Time::EpsilonForTimeCompare)
+    {
+        return;
+    }
+
+    if (mElementSet && mElementSet->GetElementCount() != (int)values.size())
+    {
+        throw InvalidDataException(StringHelper::FormatSimple(
+            "Output [{}] has {} values, but {} elements.",
+            mId,
+            values.size(),
+            mElementSet->GetElementCount()));
+    }
+
+    auto dense = dynamic_pointer_cast<ValueSetDense<real>>(mValues);
+    if constexpr (is_same_v<real, double>)
+    {
+        dense->AddElementValuesForTime(values);
+    }
+    else
+    {
+        dense->AddElementValuesForTime(vector<real>(values.begin(), values.end()));
+    }
+
+    mTimeSet->AddTime(make_shared<Time>(time));
+
+    BroadcastEventWithMsg("Values received from remote component");
+}
+
+void RemoteOutput::AppendValues(double time, const vector<double> &values)
+{
+    AppendValues(time, Span<const double>(values));
+}
+
+}  // namespace OpenOasis::CommImp
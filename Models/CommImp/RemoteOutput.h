@@ -0,0 +1,55 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  RemoteOutput.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To provide an output of a component running in a child process.
+ *
+ *    The remote output stands in for an output of a `RemoteComponent`, whose values
+ *    are published into shared memory by the child process. As for the transport
+ *    output, the value definition and element set are given locally, e.g. by the
+ *    consumer.
+ *
+ *    The remote component appends the latest values after each of its updates, so
+ *    the output updates it as `Output` does with a local component.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Output.h"
+#include "Models/Utils/Span.h"
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+/// @brief Output item holding the values of an output of a remote component.
+class RemoteOutput : public Output
+{
+public:
+    virtual ~RemoteOutput() = default;
+
+    /// @brief Creates the remote output.
+    ///
+    /// @param id Id of the output in the remote component.
+    /// @param comp Remote component the output belongs to.
+    /// @param quantity Value definition of the output.
+    /// @param elementSet Element set of the output.
+    RemoteOutput(
+        const std::string &id, const std::shared_ptr<ILinkableComponent> &comp,
+        const std::shared_ptr<IQuantity>   &quantity,
+        const std::shared_ptr<IElementSet> &elementSet);
+
+    /// @brief Appends the values of the output at the time stamp, unless the time
+    /// doesn't advance, e.g. the remote component is done.
+    ///
+    /// The values are copied into the buffered times directly, e.g. from the
+    /// shared memory segment of the remote component.
+    void AppendValues(double time, Utils::Span<const double> values);
+
+    void AppendValues(double time, const std::vector<double> &values);
+};
+
+}  // namespace CommImp
+}  // namespace OpenOasis
@@ -12,6 +12,7 @@
 #include "Models/CommImp/DevSupports/SpaceMapAdaptor.h"
 #include "Models/CommImp/DevSupports/SpaceLengthAdaptor.h"
 #include "Models/CommImp/DevSupports/SpaceAreaAdaptor.h"
+#include "Models/CommImp/DevSupports/SpaceTimeAdaptor.h"
 #include "Models/Utils/Exception.h"
 #include "Models/Utils/VectorHelper.h"
 #include "Models/Utils/StringHelper.h"
@@ -29,10 +30,13 @@ using namespace std;
 vector<shared_ptr<SpaceAdaptedOutputFactory::SpatialMethod>>
     SpaceAdaptedOutputFactory::mAvailableMethods;
 
-SpaceAdaptedOutputFactory::StaticConstructor
-             SpaceAdaptedOutputFactory::mStaticConstructor      = StaticConstructor();
+// The prefixes must be initialized before the methods constructed from them.
 const string SpaceAdaptedOutputFactory::mElementMapperPrefix    = "ElementMapper";
 const string SpaceAdaptedOutputFactory::mElementOperationPrefix = "ElementOperation";
+const string SpaceAdaptedOutputFactory::mSpaceTimeMapperPrefix  = "SpaceTimeMapper";
+
+SpaceAdaptedOutputFactory::StaticConstructor
+    SpaceAdaptedOutputFactory::mStaticConstructor = StaticConstructor();
 
 SpaceAdaptedOutputFactory::StaticConstructor::StaticConstructor()
 {
@@ -252,6 +256,11 @@ SpaceAdaptedOutputFactory::GetAvailableAdaptedOutputIds(
         tsAdaptee->GetElementSet()->GetElementType(),
         tsTarget->GetElementSet()->GetElementType());
 
+    GetAvailableSpaceTimeMethods(
+        methods,
+        tsAdaptee->GetElementSet()->GetElementType(),
+        tsTarget->GetElementSet()->GetElementType());
+
     return methods;
 }
 
@@ -301,6 +310,49 @@ void SpaceAdaptedOutputFactory::GetAvailableMappingMethods(
     }
 }
 
+void SpaceAdaptedOutputFactory::GetAvailableSpaceTimeMethods(
+    vector<shared_ptr<IIdentifiable>> &methods, ElementType sourceElementType,
+    ElementType targetElementType)
+{
+    vector<shared_ptr<IIdentifiable>> mappingMethods;
+    GetAvailableMappingMethods(mappingMethods, sourceElementType, targetElementType);
+
+    for (const auto &mappingMethod : mappingMethods)
+    {
+        const auto &id     = mappingMethod->GetId();
+        auto        method = make_shared<Identifier>(
+            mSpaceTimeMapperPrefix + id.substr(mElementMapperPrefix.size()));
+        method->SetDescription(mappingMethod->GetDescription() + ", time interpolated");
+
+        methods.push_back(method);
+    }
+}
+
+bool SpaceAdaptedOutputFactory::IsSpaceTimeMethod(
+    const shared_ptr<IIdentifiable> &identifiable)
+{
+    return StringHelper::StartsWith(identifiable->GetId(), mSpaceTimeMapperPrefix);
+}
+
+shared_ptr<IIdentifiable> SpaceAdaptedOutputFactory::GetMappingMethod(
+    const shared_ptr<IIdentifiable> &identifiable)
+{
+    if (!IsSpaceTimeMethod(identifiable))
+    {
+        throw invalid_argument(StringHelper::FormatSimple(
+            "Invalid indentifier {}, identifier is not a space-time method.",
+            identifiable->GetId()));
+    }
+
+    auto method = FindMethod(make_shared<Identifier>(
+        mElementMapperPrefix
+        + identifiable->GetId().substr(mSpaceTimeMapperPrefix.size())));
+
+    auto mappingMethod = make_shared<Identifier>(method->mId);
+    mappingMethod->SetDescription(method->mDescription);
+    return mappingMethod;
+}
+
 shared_ptr<IAdaptedOutput> SpaceAdaptedOutputFactory::CreateAdaptedOutput(
     const shared_ptr<IIdentifiable> &adaptedOutputId,
     const shared_ptr<IOutput> &adaptee, const shared_ptr<IInput> &target)
@@ -312,11 +364,20 @@ shared_ptr<IAdaptedOutput> SpaceAdaptedOutputFactory::CreateAdaptedOutput(
         targetElmtSet = tsTarget->GetElementSet();
     }
 
-    auto method = FindMethod(adaptedOutputId);
-
     shared_ptr<IAdaptedOutput> adaptedOutput;
 
-    if (method->mElementMapperMethod != ElementMapperMethod::None)
+    if (IsSpaceTimeMethod(adaptedOutputId))
+    {
+        if (!targetElmtSet)
+        {
+            throw invalid_argument(
+                "Target not defined or spatial definition is not an element set. Can not create adaptor");
+        }
+        adaptedOutput =
+            make_shared<SpaceTimeAdaptor>(adaptedOutputId, adaptee, targetElmtSet);
+    }
+    else if (
+        FindMethod(adaptedOutputId)->mElementMapperMethod != ElementMapperMethod::None)
     {
         if (!targetElmtSet)
         {
@@ -479,6 +540,13 @@ vector<shared_ptr<IArgument>> SpaceAdaptedOutputFactory::GetAdaptedOutputArgumen
                     StringHelper::ToString((int)method->mToElementsShapeType));
                 tempVar5->SetDescription("Valid To-Element Types");
                 arguments.push_back(tempVar5);
+
+                if (method->mElementMapperMethod == ElementMapperMethod::Inverse)
+                {
+                    auto inverseArgs = CreateInverseArguments();
+                    arguments.insert(
+                        arguments.end(), inverseArgs.begin(), inverseArgs.end());
+                }
                 return arguments;
             }
         }
@@ -487,5 +555,40 @@ vector<shared_ptr<IArgument>> SpaceAdaptedOutputFactory::GetAdaptedOutputArgumen
         "Unknown methodID: [{}] .", methodIdentifier->GetId()));
 }
 
+vector<shared_ptr<IArgument>> SpaceAdaptedOutputFactory::CreateInverseArguments()
+{
+    auto neighbours = make_shared<ArgumentInt>("InverseNeighbours", 0);
+    neighbours->SetDescription("Number of the nearest sources weighted, 0 for all");
+
+    auto radius = make_shared<ArgumentDouble>("InverseRadius", 0.);
+    radius->SetDescription("Distance within which sources are weighted, 0 for all");
+
+    auto power = make_shared<ArgumentDouble>("InversePower", 1.);
+    power->SetDescription("Power of the distance in the weights");
+
+    return {neighbours, radius, power};
+}
+
+void SpaceAdaptedOutputFactory::SetInverseArguments(
+    ElementMapper &mapper, const vector<shared_ptr<IArgument>> &arguments)
+{
+    for (const auto &argument : arguments)
+    {
+        const auto &id = argument->GetId();
+        if (id == "InverseNeighbours")
+        {
+            mapper.SetInverseNeighbours(any_cast<int>(argument->GetValue()));
+        }
+        else if (id == "InverseRadius")
+        {
+            mapper.SetInverseRadius((real)any_cast<double>(argument->GetValue()));
+        }
+        else if (id == "InversePower")
+        {
+            mapper.SetInversePower((real)any_cast<double>(argument->GetValue()));
+        }
+    }
+}
+
 
 }  // namespace OpenOasis::CommImp
\ No newline at end of file
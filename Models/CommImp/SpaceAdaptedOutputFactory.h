@@ -108,6 +108,24 @@ public:
         std::vector<std::shared_ptr<IIdentifiable>> &methods,
         ElementType                                  sourceElementType);
 
+    /// @brief Gives a list of descriptions (strings) for available space-time methods,
+    /// which interpolate in time and map the elements in one pass, given the
+    /// combination of fromElementType and toElementType.
+    ///
+    /// @param sourceElementType Element type of elements in the fromElementSet.
+    /// @param targetElementType Element type of elements in the toElementSet.
+    /// @param[out] methods ArrayList of method descriptions.
+    static void GetAvailableSpaceTimeMethods(
+        std::vector<std::shared_ptr<IIdentifiable>> &methods,
+        ElementType sourceElementType, ElementType targetElementType);
+
+    /// @brief Checks if the provided id is a space-time method of this factory.
+    static bool IsSpaceTimeMethod(const std::shared_ptr<IIdentifiable> &identifiable);
+
+    /// @brief Gets the mapping method used by the space-time method.
+    static std::shared_ptr<IIdentifiable>
+    GetMappingMethod(const std::shared_ptr<IIdentifiable> &identifiable);
+
     static std::shared_ptr<IDescribable>
     GetAdaptedOutputDescription(std::shared_ptr<IIdentifiable> identifiable);
 
@@ -129,6 +147,16 @@ public:
     static std::vector<std::shared_ptr<IArgument>>
     GetAdaptedOutputArguments(std::shared_ptr<IIdentifiable> methodIdentifier);
 
+    /// @brief Creates the arguments of the Inverse mapping methods with the default
+    /// values, "InverseNeighbours", "InverseRadius" and "InversePower".
+    static std::vector<std::shared_ptr<IArgument>> CreateInverseArguments();
+
+    /// @brief Sets the options of the Inverse method given by the arguments to the
+    /// element mapper, other arguments are ignored.
+    static void SetInverseArguments(
+        ElementMapper                                &mapper,
+        const std::vector<std::shared_ptr<IArgument>> &arguments);
+
 private:
     ///////////////////////////////////////////////////////////////////////////////////
     // Static spatial adapted methods constructor.
@@ -145,6 +173,7 @@ private:
 
     static const std::string mElementMapperPrefix;
     static const std::string mElementOperationPrefix;
+    static const std::string mSpaceTimeMapperPrefix;
 
 private:
     ///////////////////////////////////////////////////////////////////////////////////
@@ -352,7 +352,7 @@ bool GeomCalculator::IsValidePolygon(const Polygon &polygon)
 
     if (CalculateAreaOfPolygon(polygon) <= EPSILON)
     {
-        throw false;
+        return false;
     }
 
     for (size_t i = 1; i < polygon.size() - 1; i++)
@@ -360,7 +360,7 @@ bool GeomCalculator::IsValidePolygon(const Polygon &polygon)
         auto line1 = GenerateLineFromPolygon(polygon, i);
         if (CalculateLengthOfLine(line1) <= EPSILON)
         {
-            throw false;
+            return false;
         }
 
         for (size_t j = 0; j < i; ++j)
@@ -368,7 +368,7 @@ bool GeomCalculator::IsValidePolygon(const Polygon &polygon)
             auto line2 = GenerateLineFromPolygon(polygon, j);
             if (IsLineIntersected(line1, line2))
             {
-                throw false;
+                return false;
             }
         }
     }
@@ -419,157 +419,116 @@ bool GeomCalculator::IsPointInPolygon(const Point &point, const Polygon &polygon
 
 real GeomCalculator::CalculatePolygonSharedArea(const Polygon &p1, const Polygon &p2)
 {
-    const auto &triangleListA = SplitPolygonToTriangles(p1);
-    const auto &triangleListB = SplitPolygonToTriangles(p2);
+    // Clips by the convex one at once, or else by the convex parts of the concave one.
+    if (IsConvexPolygon(p2))
+    {
+        return CalculateAreaOfPolygon(ClipPolygon(p1, p2));
+    }
 
-    real area = 0;
-    for (size_t ia = 0; ia < triangleListA.size(); ia++)
+    if (IsConvexPolygon(p1))
     {
-        const auto &triangleA = triangleListA[ia];
+        return CalculateAreaOfPolygon(ClipPolygon(p2, p1));
+    }
 
-        for (size_t ib = 0; ib < triangleListB.size(); ib++)
-        {
-            const auto &triangleB = triangleListB[ib];
-            area = area + CalculateTriangleSharedArea(triangleA, triangleB);
-        }
+    return CalculatePolygonSharedArea(p1, SplitPolygonToConvexParts(p2));
+}
+
+real GeomCalculator::CalculatePolygonSharedArea(
+    const Polygon &polygon, const vector<Polygon> &convexParts)
+{
+    real area = 0;
+    for (const auto &part : convexParts)
+    {
+        area += CalculateAreaOfPolygon(ClipPolygon(polygon, part));
     }
 
     return area;
 }
 
-real GeomCalculator::CalculateTriangleSharedArea(
-    const Polygon &triangleA, const Polygon &triangleB)
+Polygon GeomCalculator::ClipPolygon(const Polygon &subject, const Polygon &clip)
 {
-    try
+    // Sutherland-Hodgman algorithm, clips the subject by the line of each clip edge
+    // in turn, keeping the part on the inner side.
+    //
+    // A concave subject may be clipped into pieces joined by degenerate edges, which
+    // makes no difference to the area.
+    //
+
+    real orientation = CalculateSignedAreaOfPolygon(clip);
+    if (clip.size() < 3 || orientation == 0)
     {
-        size_t i = 1;  // Index for "next" node in polygon a.
+        return {};
+    }
 
-        // Index for "next" node in polygon b.
-        // -1 indicates that the first has not yet been found.
-        size_t j = -1;
+    Polygon output = subject;
+    Polygon input;
+    for (size_t i = 0; i < clip.size() && !output.empty(); i++)
+    {
+        const Point &a = clip[i], &b = clip[IncrementModula(i, clip.size())];
 
-        real    area = 0;      // Intersection area.
-        Polygon interPolygon;  // Intersection polygon.
+        // Signed distance (scaled) of point to the edge, positive at the inner side.
+        auto side = [&](const Point &p) {
+            real cross = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+            return orientation > 0 ? cross : -cross;
+        };
 
-        // Latest intersection node found.
-        Point pInter(triangleA.at(0));
-        Intersect(triangleA, triangleB, pInter, i, j, interPolygon);
+        input.swap(output);
+        output.clear();
 
-        // First intersection point between triangles.
-        Point pFirst = pInter;
-        if (j != -1)
+        const Point *prev     = &input.back();
+        real         prevSide = side(*prev);
+        for (const auto &curr : input)
         {
-            bool complete = false;
-            int  count    = 0;
-            while (!complete)
+            real currSide = side(curr);
+            if ((currSide >= 0) != (prevSide >= 0))
             {
-                // coordinates for vectors pointing to next triangleA and triangleB
-                // point respectively.
-                real vax = triangleA.at(i).x - pInter.x;
-                real vay = triangleA.at(i).y - pInter.y;
-                real vbx = triangleB.at(j).x - pInter.x;
-                real vby = triangleB.at(j).y - pInter.y;
-
-                // The sideOf tells if the vb vector or the va vector is the one
-                // pointing "left" If sideOf is positive, vb is pointing left, otherwise
-                // va is pointing left The "left" vector is the one that is inside the
-                // polygon.
-                real sideOf = vax * vby - vay * vbx;
-
-                // Make sure to get out of EPSILON reach from the original point, hence
-                // 2*EPSILON
-                if (sideOf < 0
-                    && IsPointInPolygon(
-                        Point{
-                            pInter.x + 2 * EPSILON * vax, pInter.y + 2 * EPSILON * vay},
-                        triangleB))
-                {
-                    Intersect(triangleA, triangleB, pInter, i, j, interPolygon);
-                }
-                else if (
-                    sideOf > 0
-                    && IsPointInPolygon(
-                        Point{
-                            pInter.x + 2 * EPSILON * vbx, pInter.y + 2 * EPSILON * vby},
-                        triangleA))
-                {
-                    Intersect(triangleB, triangleA, pInter, j, i, interPolygon);
-                }
-                // can be true if the point is on the edge of the triangleB.
-                else if (IsPointInPolygon(
-                             Point{
-                                 pInter.x + 2 * EPSILON * vax,
-                                 pInter.y + 2 * EPSILON * vay},
-                             triangleB))
-                {
-                    Intersect(triangleA, triangleB, pInter, i, j, interPolygon);
-                }
-                // can be true if the point is on the edge of the triangleA
-                // Should never happen, since above test basically does the same.
-                else if (IsPointInPolygon(
-                             Point{
-                                 pInter.x + 2 * EPSILON * vbx,
-                                 pInter.y + 2 * EPSILON * vby},
-                             triangleA))
-                {
-                    Intersect(triangleB, triangleA, pInter, j, i, interPolygon);
-                }
-                // triangleA and triangleB only touches one another but do not
-                // intersect
-                else
-                {
-                    return 0.0;
-                }
-
-                if (!interPolygon.empty())
-                {
-                    complete = (CalculatePointsDistance(pInter, pFirst) < EPSILON);
-                }
+                real t = prevSide / (prevSide - currSide);
+                output.push_back(
+                    Point{
+                        prev->x + t * (curr.x - prev->x),
+                        prev->y + t * (curr.y - prev->y)});
+            }
 
-                count++;
-                if (count > 20)
-                {
-                    throw runtime_error("Failed to find intersection polygon");
-                }
+            if (currSide >= 0)
+            {
+                output.push_back(curr);
             }
 
-            area = CalculateAreaOfPolygon(interPolygon);
+            prev     = &curr;
+            prevSide = currSide;
         }
-        else
-        {
-            // internal point in triangle a
-            const auto &pointsA = triangleA;
-            real        xPa     = (pointsA[0].x + pointsA[1].x + pointsA[2].x) / 3.0;
-            real        yPa     = (pointsA[0].y + pointsA[1].y + pointsA[2].y) / 3.0;
-
-            Point pa{xPa, yPa};
+    }
 
-            // internal point in triangle b
-            const auto &pointsB = triangleB;
-            real        xPb     = (pointsB[0].x + pointsB[1].x + pointsB[2].x) / 3.0;
-            real        yPb     = (pointsB[0].y + pointsB[1].y + pointsB[2].y) / 3.0;
+    return output;
+}
 
-            Point pb{xPb, yPb};
+vector<Polygon> GeomCalculator::SplitPolygonToConvexParts(const Polygon &polygon)
+{
+    if (IsConvexPolygon(polygon))
+    {
+        return {polygon};
+    }
 
-            // triangleA is completely inside triangleB
-            if (IsPointInPolygon(pa, triangleB) || IsPointInPolygon(pb, triangleA))
-            {
-                real area1 = CalculateAreaOfPolygon(triangleA);
-                real area2 = CalculateAreaOfPolygon(triangleB);
-                area       = min(area1, area2);
-            }
-            else  // triangleA and triangleB do dot intersect
-            {
-                area = 0;
-            }
-        }
+    return SplitPolygonToTriangles(polygon);
+}
 
-        return area;
+bool GeomCalculator::IsConvexPolygon(const Polygon &polygon)
+{
+    if (polygon.size() < 3)
+    {
+        return false;
     }
-    catch (const runtime_error &e)
+
+    real orientation = CalculateSignedAreaOfPolygon(polygon);
+    for (size_t i = 0; i < polygon.size(); i++)
     {
-        throw runtime_error("GetTriangleSharedArea failed");
+        if (CalculateTurn(polygon, i) * orientation < 0)
+        {
+            return false;
+        }
     }
+
+    return true;
 }
 
 vector<Polygon> GeomCalculator::SplitPolygonToTriangles(const Polygon &polygon)
@@ -586,6 +545,21 @@ vector<Polygon> GeomCalculator::SplitPolygonToTriangles(const Polygon &polygon)
     {
         auto i    = FindTrianglePoints(localPolygon);
         auto n    = localPolygon.size();
+
+        // No ear left only if the rest is degenerated, drops the flattest vertex.
+        if (i == n)
+        {
+            vector<real> turns(n);
+            for (size_t k = 0; k < n; k++)
+            {
+                turns[k] = abs(CalculateTurn(localPolygon, k));
+            }
+
+            auto flattest = min_element(turns.begin(), turns.end()) - turns.begin();
+            localPolygon.erase(localPolygon.begin() + flattest);
+            continue;
+        }
+
         auto prev = (i == 0) ? n - 1 : i - 1;
         auto next = (i == n - 1) ? 0 : i + 1;
 
@@ -604,20 +578,35 @@ vector<Polygon> GeomCalculator::SplitPolygonToTriangles(const Polygon &polygon)
 
 bool GeomCalculator::IsAngleConvex(const Polygon &polygon, size_t i)
 {
-    // Acute angles are convex.
+    // The angle is convex if it turns the same way as the polygon goes around.
 
     if (polygon.empty())
     {
         return false;
     }
 
+    return CalculateTurn(polygon, i) * CalculateSignedAreaOfPolygon(polygon) > 0;
+}
+
+real GeomCalculator::CalculateTurn(const Polygon &polygon, size_t i)
+{
     auto prevIndex = DecrementModula(i, polygon.size());
     auto nextIndex = IncrementModula(i, polygon.size());
 
     const Point &p1 = polygon[prevIndex], &p2 = polygon[nextIndex], &p = polygon[i];
-    real         dot = (p1.x - p.x) * (p2.x - p.x) + (p1.y - p.y) * (p2.y - p.y);
+    return (p.x - p1.x) * (p2.y - p.y) - (p.y - p1.y) * (p2.x - p.x);
+}
+
+real GeomCalculator::CalculateSignedAreaOfPolygon(const Polygon &polygon)
+{
+    real area = 0.0;
+    for (size_t i = 0; i < polygon.size(); ++i)
+    {
+        size_t j = IncrementModula(i, polygon.size());
+        area += polygon[i].x * polygon[j].y - polygon[j].x * polygon[i].y;
+    }
 
-    return (dot >= EPSILON) ? true : false;
+    return 0.5 * area;
 }
 
 size_t GeomCalculator::FindTrianglePoints(const Polygon &polygon)
@@ -655,7 +644,7 @@ bool GeomCalculator::IsTriangleIntersected(const Polygon &polygon, size_t index)
 
     size_t i           = 0;
     bool   insertected = false;
-    while (i < points.size() - 1 && !insertected)
+    while (i < points.size() && !insertected)
     {
         bool skip = (i == index || i == prevIndex || i == nextIndex);
         if (!skip && IsPointInPolygon(points[i], triangulation))
@@ -808,40 +797,6 @@ real GeomCalculator::CalculateLengthOfLineInsidePolygon(
     return lengthInside;
 }
 
-bool GeomCalculator::IsSharedPoint(
-    const Line &LineA, const Line &LineB, Point &intersectionPoint)
-{
-    if (IsLineIntersected(LineA, LineB))
-    {
-        intersectionPoint = GenerateLineCrossPoint(LineA, LineB);
-        return true;
-    }
-
-    if (IsPointInLine(LineA[1], LineB))
-    {
-        intersectionPoint = LineA[1];
-        return true;
-    }
-
-    if (IsPointInLine(LineB[1], LineA))
-    {
-        intersectionPoint = LineB[1];
-        return true;
-    }
-    if (IsPointInLine(LineB[0], LineA))
-    {
-        intersectionPoint = LineB[0];
-        return true;
-    }
-    if (IsPointInLine(LineA[0], LineB))
-    {
-        intersectionPoint = LineA[0];
-        return true;
-    }
-
-    return false;
-}
-
 bool GeomCalculator::IsPointInLineInterior(const Point &point, const Line &line)
 {
     bool result = false;
@@ -873,89 +828,6 @@ bool GeomCalculator::IsPointInLineInterior(const Point &point, const Line &line)
     return result;
 }
 
-void GeomCalculator::Intersect(
-    const Polygon &triangleA, const Polygon &triangleB, Point &p, size_t &i, size_t &j,
-    Polygon &sharedPolygon)
-{
-    Line lineA;
-    Line lineB;
-
-    size_t im1    = DecrementModula(i, 3);  // "i-1"
-    int    count1 = 0;
-    bool   found  = false;
-
-    while ((count1 < 3) && (!found))
-    {
-        lineA = GenerateLineFromPolygon(triangleA, im1);
-        if (count1 == 0)
-        {
-            lineA[0] = p;
-        }
-
-        real   MinDist  = -1;  // Distance used when a line is crossed more than once.
-        size_t jm1      = 0;   // "j-1"
-        size_t jm1Store = -1;
-        while (jm1 < 3)
-        {
-            lineB = GenerateLineFromPolygon(triangleB, jm1);
-            found = IsSharedPoint(lineA, lineB, p);
-
-            real Dist = CalculatePointsDistance(lineA[0], p);
-            if (Dist < EPSILON)
-            {
-                found = false;
-            }
-
-            if (found)
-            {
-                if ((MinDist < 0) || (Dist < MinDist))
-                {
-                    MinDist  = Dist;
-                    jm1Store = jm1;
-                }
-            }
-            jm1++;
-        }
-
-        if (jm1Store > -1)
-        {
-            lineB = GenerateLineFromPolygon(triangleB, jm1Store);
-            found = IsSharedPoint(lineA, lineB, p);
-
-            Point HelpCoordinate(p);
-            Point HelpNode(HelpCoordinate);
-            sharedPolygon.push_back(HelpNode);
-
-            j = IncrementModula(jm1Store, 3);
-        }
-
-        if (!found)
-        {
-            count1++;
-            im1 = IncrementModula(im1, 3);
-            i   = IncrementModula(i, 3);
-            if (j != -1)
-            {
-                Point HelpCoordinate(lineA[1]);
-                Point HelpNode(HelpCoordinate);
-                sharedPolygon.push_back(HelpNode);
-            }
-        }
-    }
-
-    lineA = GenerateLineFromPolygon(triangleA, DecrementModula(i, 3));
-    if (CalculatePointsDistance(p, lineA[1]) < EPSILON)
-    {
-        i = IncrementModula(i, 3);
-    }
-
-    lineB = GenerateLineFromPolygon(triangleB, DecrementModula(j, 3));
-    if (CalculatePointsDistance(p, lineB[1]) < EPSILON)
-    {
-        j = IncrementModula(j, 3);
-    }
-}
-
 size_t GeomCalculator::IncrementModula(size_t i, size_t n)
 {
     i++;
@@ -965,12 +837,7 @@ size_t GeomCalculator::IncrementModula(size_t i, size_t n)
 
 size_t GeomCalculator::DecrementModula(size_t i, size_t n)
 {
-    i--;
-    if (i < 0)
-    {
-        i = n - 1;
-    }
-    return i;
+    return (i == 0) ? n - 1 : i - 1;
 }
 
 bool GeomCalculator::IsPointInExtent(const Point &point, const GeomExtent &extent)
@@ -981,8 +848,9 @@ bool GeomCalculator::IsPointInExtent(const Point &point, const GeomExtent &exten
 
 bool GeomCalculator::IsExtentOverlap(const GeomExtent &e1, const GeomExtent &e2)
 {
-    return e1.xMax > e2.xMin && e1.xMin < e2.xMax && e1.yMax > e2.yMin
-           && e1.yMin < e2.yMax && e1.zMax > e2.zMin && e1.zMin < e2.zMax;
+    // Touching counts, so flat extents(e.g. points or 2d elements in z) overlap.
+    return e1.xMax >= e2.xMin && e1.xMin <= e2.xMax && e1.yMax >= e2.yMin
+           && e1.yMin <= e2.yMax && e1.zMax >= e2.zMin && e1.zMin <= e2.zMax;
 }
 
 void GeomCalculator::UpdateExtent(GeomExtent &extent, const Point &point)
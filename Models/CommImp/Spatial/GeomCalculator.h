@@ -47,6 +47,11 @@ public:
 
     static real CalculatePolygonSharedArea(const Polygon &p1, const Polygon &p2);
 
+    /// @brief Calculates the area of polygon shared with the convex parts of another
+    /// polygon, which are split once for comparing with many polygons.
+    static real CalculatePolygonSharedArea(
+        const Polygon &polygon, const std::vector<Polygon> &convexParts);
+
     static real CalculateLineSharedLength(const Line &l1, const Line &l2);
 
     static real CalculateLengthOfPolygon(const Polygon &polygon);
@@ -73,6 +78,8 @@ public:
 
     static bool IsExtentOverlap(const GeomExtent &e1, const GeomExtent &e2);
 
+    static bool IsConvexPolygon(const Polygon &polygon);
+
 
     ///////////////////////////////////////////////////////////////////////////////////
     // Methods for generating geometric objects.
@@ -84,6 +91,13 @@ public:
 
     static std::vector<Polygon> SplitPolygonToTriangles(const Polygon &polygon);
 
+    /// @brief Splits polygon into triangles if it's concave, or else keeps it whole.
+    static std::vector<Polygon> SplitPolygonToConvexParts(const Polygon &polygon);
+
+    /// @brief Clips the subject polygon by the convex clip polygon.
+    /// @returns The shared part of the two polygons, or empty if they don't overlap.
+    static Polygon ClipPolygon(const Polygon &subject, const Polygon &clip);
+
     static void UpdateExtent(GeomExtent &extent, const Point &point);
 
     static void UpdateExtent(GeomExtent &extent, const GeomExtent &other);
@@ -98,25 +112,12 @@ protected:
     /// from polygon are intersected by any of the other points.
     static bool IsTriangleIntersected(const Polygon &polygon, size_t i);
 
-    /// @brief Calculates the intersection area of triangle polygon a and b.
-    static real CalculateTriangleSharedArea(const Polygon &p1, const Polygon &p2);
-
-    /// @brief Checks if two lines shared a point either as a
-    /// real crossing point or as a shared end point or a end point of
-    /// the one line being in the other line.
-    static bool IsSharedPoint(const Line &l1, const Line &l2, Point &p);
-
     static bool IsValidePolygon(const Polygon &polygon);
 
     /// @brief Determines if a point is included in a lines interior
     /// and not an endpoint.
     static bool IsPointInLineInterior(const Point &point, const Line &line);
 
-    /// @brief Calculates the intersection points of triangle xypolygon a and b.
-    static void Intersect(
-        const Polygon &p1, const Polygon &p2, Point &p, size_t &i, size_t &j,
-        Polygon &sharedPolygon);
-
     /// @brief Retrieves the lineNumber line segment.
     static Line GenerateLineFromPolyline(const Polyline &polyline, size_t number);
     static Line GenerateLineFromPolygon(const Polygon &polygon, size_t number);
@@ -124,6 +125,13 @@ protected:
     /// @brief Decides if the angle at index point is convex or concave.
     static bool IsAngleConvex(const Polygon &polygon, size_t i);
 
+    /// @brief Calculates the cross product of the edges at index point, which is
+    /// positive if turns left.
+    static real CalculateTurn(const Polygon &polygon, size_t i);
+
+    /// @brief Calculates the area of polygon, which is positive if counterclockwise.
+    static real CalculateSignedAreaOfPolygon(const Polygon &polygon);
+
     /// @brief Gets the next index in a circular list {0, ..., n-1}.
     static size_t IncrementModula(size_t i, size_t n);
 
@@ -5,6 +5,7 @@
  ** ***********************************************************************************/
 #include "Grid.h"
 #include "MeshCalculator.h"
+#include <numeric>
 
 
 namespace OpenOasis::CommImp::Spatial
@@ -12,6 +13,88 @@ namespace OpenOasis::CommImp::Spatial
 using namespace Utils;
 using namespace std;
 
+namespace
+{
+/// @brief Packs the indexes of each element into connectivity.
+/// @param getIndexes Returns the indexes related to the element.
+template <typename GetIndexes>
+Connectivity ToConnectivity(size_t count, const GetIndexes &getIndexes)
+{
+    Connectivity conn;
+    conn.offsets.assign(count + 1, 0);
+
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)count; i++)
+    {
+        conn.offsets[i + 1] = getIndexes(i).size();
+    }
+
+    partial_sum(conn.offsets.begin(), conn.offsets.end(), conn.offsets.begin());
+    conn.indexes.resize(conn.offsets.back());
+
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)count; i++)
+    {
+        const auto &indexes = getIndexes(i);
+        copy(indexes.begin(), indexes.end(), conn.indexes.begin() + conn.offsets[i]);
+    }
+
+    return conn;
+}
+
+/// @brief Inverts the connectivity from elements to the related ones.
+/// The indexes in each row are ascending, so the result is deterministic.
+/// @param count Number of the related elements.
+Connectivity Transpose(const Connectivity &conn, size_t count)
+{
+    const long long nRows = conn.Size();
+
+    Connectivity trans;
+    trans.offsets.assign(count + 1, 0);
+
+    // Counts the indexes of each row of the transpose.
+#pragma omp parallel for
+    for (long long i = 0; i < nRows; i++)
+    {
+        for (size_t j : conn[i])
+        {
+#pragma omp atomic
+            trans.offsets[j + 1]++;
+        }
+    }
+
+    partial_sum(trans.offsets.begin(), trans.offsets.end(), trans.offsets.begin());
+    trans.indexes.resize(trans.offsets.back());
+
+    // Scatters the indexes to their rows, then sorts each row.
+    vector<size_t> cursors(trans.offsets.begin(), trans.offsets.end() - 1);
+
+#pragma omp parallel for
+    for (long long i = 0; i < nRows; i++)
+    {
+        for (size_t j : conn[i])
+        {
+            size_t pos;
+#pragma omp atomic capture
+            pos = cursors[j]++;
+
+            trans.indexes[pos] = i;
+        }
+    }
+
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (long long j = 0; j < (long long)count; j++)
+    {
+        sort(
+            trans.indexes.begin() + trans.offsets[j],
+            trans.indexes.begin() + trans.offsets[j + 1]);
+    }
+
+    return trans;
+}
+
+}  // namespace
+
 
 // ------------------------------------------------------------------------------------
 
@@ -20,8 +103,16 @@ Grid::Grid(
     const unordered_map<size_t, Coordinate>     &faceCoords,
     const unordered_map<size_t, Coordinate>     &cellCoords,
     const unordered_map<size_t, vector<size_t>> &faceNodes,
-    const unordered_map<size_t, vector<size_t>> &cellFaces)
+    const unordered_map<size_t, vector<size_t>> &cellFaces,
+    const unordered_map<string, vector<size_t>> &patchFaces,
+    const unordered_map<string, vector<size_t>> &zoneCells,
+    int                                          version) :
+    mVersion(version)
 {
+    // Patches and zones are not stored by the grid yet.
+    (void)patchFaces;
+    (void)zoneCells;
+
 #pragma omp parallel sections
     {
 #pragma omp section
@@ -71,6 +162,36 @@ const Mesh &Grid::GetMesh() const
     return mMesh;
 }
 
+const CompactMesh &Grid::GetCompactMesh() const
+{
+    return mCompactMesh;
+}
+
+void Grid::SetRenumberMethod(RenumberMethod method)
+{
+    mRenumberMethod = method;
+}
+
+RenumberMethod Grid::GetRenumberMethod() const
+{
+    return mRenumberMethod;
+}
+
+const vector<size_t> &Grid::GetOriginalNodes() const
+{
+    return mNodeOrder;
+}
+
+const vector<size_t> &Grid::GetOriginalFaces() const
+{
+    return mFaceOrder;
+}
+
+const vector<size_t> &Grid::GetOriginalCells() const
+{
+    return mCellOrder;
+}
+
 void Grid::RefineCell(size_t cellIndex)
 {
     // TODO: Implement refine cell.
@@ -83,12 +204,17 @@ void Grid::RelaxCell(size_t cellIndex)
 
 void Grid::Activate()
 {
+    // Unpack the connections released by the last activation.
+    RestoreMeshConnectivity();
+
+    // Renumber mesh elements for memory locality.
+    RenumberMesh();
+
     // Complete mesh topological connections.
     CollectCellsSharedNode();
     CollectFacesSharedNode();
     CollectCellsSharedFace();
     CollectCellNeighbors();
-    CollectFaceCellSides();
 
     // Sort node counterclockwise.
     SortNodes();
@@ -98,83 +224,225 @@ void Grid::Activate()
     CalculateFaceArea();
     CalculateFacePerimeter();
 
+    // Orient the cells to the face normals calculated.
+    CollectFaceCellSides();
+
     // Activate mesh cell structures.
     CalculateCellSurface();
     CalculateCellVolume();
 
     // Check mesh validation.
     CheckMesh();
+
+    // Pack mesh data for numerical calculation.
+    BuildCompactMesh();
+    ReleaseMeshConnectivity();
 }
 
-void Grid::CollectCellsSharedNode()
+void Grid::RenumberMesh()
 {
-#pragma omp parallel for schedule(dynamic)
-    for (auto nIdx = 0; nIdx < GetNumNodes(); nIdx++)
+    const size_t nNodes = GetNumNodes();
+    const size_t nFaces = GetNumFaces();
+    const size_t nCells = GetNumCells();
+
+    // Renumbering is based on the current indexes, so a mesh activated again keeps
+    // the orders composed to the original indexes.
+    auto compose = [](vector<size_t> &order, vector<size_t> &&newOrder) {
+        if (order.size() != newOrder.size())
+        {
+            order = move(newOrder);
+            return;
+        }
+
+        for (auto &idx : newOrder)
+        {
+            idx = order[idx];
+        }
+        order = move(newOrder);
+    };
+
+    if (mRenumberMethod == RenumberMethod::None)
     {
-        mMesh.nodes[nIdx].cellIndexes.clear();
+        auto identity = [](vector<size_t> &order, size_t count) {
+            if (order.size() != count)
+            {
+                order.resize(count);
+                iota(order.begin(), order.end(), 0);
+            }
+        };
+
+        identity(mNodeOrder, nNodes);
+        identity(mFaceOrder, nFaces);
+        identity(mCellOrder, nCells);
+        return;
     }
 
-    for (auto cIdx = 0; cIdx < GetNumCells(); cIdx++)
+    // Order cells, then faces by cells and nodes by faces.
+    CollectCellsSharedFace();
+
+    vector<size_t> cellOrder;
+    if (mRenumberMethod == RenumberMethod::ReverseCuthillMcKee)
     {
-        const auto &nodeIdxs = MeshCalculator::GetCellNodeIndexes(cIdx, mMesh);
-        for (auto nIdx : nodeIdxs)
-            mMesh.nodes[nIdx].cellIndexes.push_back(cIdx);
+        CollectCellNeighbors();
+        cellOrder =
+            MeshRenumberer::OrderByReverseCuthillMcKee(mCompactMesh.cellNeighbors);
+    }
+    else
+    {
+        vector<Coordinate> centroids(nCells);
+        for (size_t cIdx = 0; cIdx < nCells; cIdx++)
+        {
+            centroids[cIdx] = mMesh.cells.at(cIdx).centroid;
+        }
+        cellOrder = MeshRenumberer::OrderByHilbertCurve(centroids);
     }
-}
 
-void Grid::CollectFacesSharedNode()
-{
-#pragma omp parallel for schedule(dynamic)
-    for (auto nIdx = 0; nIdx < GetNumNodes(); nIdx++)
+    const auto &faces = mMesh.faces;
+
+    auto cellRanks = MeshRenumberer::InvertOrder(cellOrder);
+    auto faceOrder =
+        MeshRenumberer::OrderFacesByCells(mCompactMesh.faceCells, cellRanks);
+    auto faceRanks = MeshRenumberer::InvertOrder(faceOrder);
+    auto nodeOrder = MeshRenumberer::OrderNodesByFaces(
+        ToConnectivity(
+            nFaces, [&](size_t fIdx) -> auto & { return faces.at(fIdx).nodeIndexes; }),
+        faceOrder, nNodes);
+    auto nodeRanks = MeshRenumberer::InvertOrder(nodeOrder);
+
+    // Rebuild the mesh in the new indexes, the connections are collected later.
+    Mesh mesh;
+    mesh.nodes.reserve(nNodes);
+    mesh.faces.reserve(nFaces);
+    mesh.cells.reserve(nCells);
+
+    for (size_t nIdx = 0; nIdx < nNodes; nIdx++)
     {
-        mMesh.nodes[nIdx].faceIndexes.clear();
+        mesh.nodes[nIdx].coor = mMesh.nodes.at(nodeOrder[nIdx]).coor;
     }
 
-    for (auto fIdx = 0; fIdx < GetNumFaces(); fIdx++)
+    for (size_t fIdx = 0; fIdx < nFaces; fIdx++)
+    {
+        auto &face    = mesh.faces[fIdx];
+        auto &oldFace = mMesh.faces.at(faceOrder[fIdx]);
+
+        face.centroid = oldFace.centroid;
+        face.nodeIndexes.reserve(oldFace.nodeIndexes.size());
+        for (size_t nIdx : oldFace.nodeIndexes)
+        {
+            face.nodeIndexes.push_back(nodeRanks[nIdx]);
+        }
+    }
+
+    for (size_t cIdx = 0; cIdx < nCells; cIdx++)
     {
-        const auto &nodeIndexes = mMesh.faces[fIdx].nodeIndexes;
-        for (auto nIdx : nodeIndexes)
+        auto &cell    = mesh.cells[cIdx];
+        auto &oldCell = mMesh.cells.at(cellOrder[cIdx]);
+
+        cell.centroid = oldCell.centroid;
+        cell.faceIndexes.reserve(oldCell.faceIndexes.size());
+        for (size_t fIdx : oldCell.faceIndexes)
         {
-            mMesh.nodes[nIdx].faceIndexes.push_back(fIdx);
+            cell.faceIndexes.push_back(faceRanks[fIdx]);
         }
     }
+
+    mMesh = move(mesh);
+
+    compose(mNodeOrder, move(nodeOrder));
+    compose(mFaceOrder, move(faceOrder));
+    compose(mCellOrder, move(cellOrder));
 }
 
-void Grid::CollectCellsSharedFace()
+void Grid::CollectCellsSharedNode()
 {
+    const long long nCells = GetNumCells();
+
+    vector<vector<size_t>> cellNodes(nCells);
+
 #pragma omp parallel for schedule(dynamic)
-    for (auto fIdx = 0; fIdx < GetNumFaces(); fIdx++)
+    for (long long cIdx = 0; cIdx < nCells; cIdx++)
     {
-        mMesh.faces[fIdx].cellIndexes.clear();
+        cellNodes[cIdx] = MeshCalculator::GetCellNodeIndexes(cIdx, mMesh);
     }
 
-    for (auto cIdx = 0; cIdx < GetNumCells(); cIdx++)
+    mCompactMesh.nodeCells = Transpose(
+        ToConnectivity(nCells, [&](size_t cIdx) -> auto & { return cellNodes[cIdx]; }),
+        GetNumNodes());
+}
+
+void Grid::CollectFacesSharedNode()
+{
+    const auto &faces = mMesh.faces;
+
+    mCompactMesh.nodeFaces = Transpose(
+        ToConnectivity(
+            GetNumFaces(),
+            [&](size_t fIdx) -> auto & { return faces.at(fIdx).nodeIndexes; }),
+        GetNumNodes());
+}
+
+void Grid::CollectCellsSharedFace()
+{
+    const auto &cells = mMesh.cells;
+
+    auto &faceCells = mCompactMesh.faceCells;
+    faceCells       = Transpose(
+        ToConnectivity(
+            GetNumCells(),
+            [&](size_t cIdx) -> auto & { return cells.at(cIdx).faceIndexes; }),
+        GetNumFaces());
+
+#pragma omp parallel for
+    for (long long fIdx = 0; fIdx < (long long)GetNumFaces(); fIdx++)
     {
-        const auto &faceIndexes = mMesh.cells[cIdx].faceIndexes;
-        for (auto fIdx : faceIndexes)
-        {
-            mMesh.faces[fIdx].cellIndexes.push_back(cIdx);
-        }
+        const auto cIdxs = faceCells[fIdx];
+
+        mMesh.faces.at(fIdx).cellIndexes.assign(cIdxs.begin(), cIdxs.end());
     }
 }
 
 void Grid::CollectCellNeighbors()
 {
-#pragma omp parallel for schedule(dynamic)
-    for (auto cIdx = 0; cIdx < GetNumCells(); cIdx++)
+    const long long nCells = GetNumCells();
+
+    // Faces of each cell in ascending order, so the neighbors are ordered by the
+    // faces shared.
+    const auto &faceCells = mCompactMesh.faceCells;
+    const auto  cellFaces = Transpose(faceCells, nCells);
+
+    auto &neighbors = mCompactMesh.cellNeighbors;
+    neighbors.offsets.assign(nCells + 1, 0);
+
+#pragma omp parallel for
+    for (long long cIdx = 0; cIdx < nCells; cIdx++)
     {
-        mMesh.cells[cIdx].neighbors.clear();
+        size_t count = 0;
+        for (size_t fIdx : cellFaces[cIdx])
+        {
+            count += (faceCells.Count(fIdx) == 2) ? 1 : 0;
+        }
+        neighbors.offsets[cIdx + 1] = count;
     }
 
-    for (auto fIdx = 0; fIdx < GetNumFaces(); fIdx++)
+    partial_sum(
+        neighbors.offsets.begin(), neighbors.offsets.end(), neighbors.offsets.begin());
+    neighbors.indexes.resize(neighbors.offsets.back());
+
+#pragma omp parallel for
+    for (long long cIdx = 0; cIdx < nCells; cIdx++)
     {
-        const auto &cellIndexes = mMesh.faces[fIdx].cellIndexes;
-        if (cellIndexes.size() != 2)
-            continue;
+        size_t pos = neighbors.offsets[cIdx];
+        for (size_t fIdx : cellFaces[cIdx])
+        {
+            const auto cIdxs = faceCells[fIdx];
+            if (cIdxs.size() != 2)
+                continue;
 
-        auto c1 = cellIndexes[0], c2 = cellIndexes[1];
-        mMesh.cells[c1].neighbors.push_back(c2);
-        mMesh.cells[c2].neighbors.push_back(c1);
+            neighbors.indexes[pos++] = (cIdxs[0] == (size_t)cIdx) ? cIdxs[1] : cIdxs[0];
+        }
+
+        const auto nIdxs = neighbors[cIdx];
+        mMesh.cells.at(cIdx).neighbors.assign(nIdxs.begin(), nIdxs.end());
     }
 }
 
@@ -270,6 +538,152 @@ void Grid::CalculateCellVolume()
 void Grid::CheckMesh()
 {}
 
+// TODO: Implement the patches, zones and distances, which aren't activated yet.
+
+void Grid::CheckPatch()
+{}
+
+void Grid::CheckZone()
+{}
+
+void Grid::CollectPatchFaces()
+{}
+
+void Grid::CollectZoneCells()
+{}
+
+void Grid::CollectBoundaryCells()
+{}
+
+void Grid::CollectBoundaryFaces()
+{}
+
+void Grid::CalculateCellToCellDist()
+{}
+
+void Grid::CalculateCellToFaceDist()
+{}
+
+void Grid::BuildCompactMesh()
+{
+    const long long nNodes = GetNumNodes();
+    const long long nFaces = GetNumFaces();
+    const long long nCells = GetNumCells();
+
+    // The inverse connectivity has been packed while collected.
+    auto &compact = mCompactMesh;
+
+    compact.nodeCoords.resize(nNodes);
+
+#pragma omp parallel for
+    for (long long nIdx = 0; nIdx < nNodes; nIdx++)
+    {
+        compact.nodeCoords[nIdx] = mMesh.nodes.at(nIdx).coor;
+    }
+
+    compact.faceCentroids.resize(nFaces);
+    compact.faceNormals.resize(nFaces);
+    compact.faceAreas.resize(nFaces);
+    compact.facePerimeters.resize(nFaces);
+
+#pragma omp parallel for
+    for (long long fIdx = 0; fIdx < nFaces; fIdx++)
+    {
+        const auto &face = mMesh.faces.at(fIdx);
+
+        compact.faceCentroids[fIdx]  = face.centroid;
+        compact.faceNormals[fIdx]    = face.normal;
+        compact.faceAreas[fIdx]      = face.area;
+        compact.facePerimeters[fIdx] = face.perimeter;
+    }
+
+    compact.cellCentroids.resize(nCells);
+    compact.cellSurfaces.resize(nCells);
+    compact.cellVolumes.resize(nCells);
+
+#pragma omp parallel for
+    for (long long cIdx = 0; cIdx < nCells; cIdx++)
+    {
+        const auto &cell = mMesh.cells.at(cIdx);
+
+        compact.cellCentroids[cIdx] = cell.centroid;
+        compact.cellSurfaces[cIdx]  = cell.surface;
+        compact.cellVolumes[cIdx]   = cell.volume;
+    }
+
+    const auto &faces = mMesh.faces;
+    const auto &cells = mMesh.cells;
+
+    compact.faceNodes = ToConnectivity(
+        nFaces, [&](size_t fIdx) -> auto & { return faces.at(fIdx).nodeIndexes; });
+    compact.cellFaces = ToConnectivity(
+        nCells, [&](size_t cIdx) -> auto & { return cells.at(cIdx).faceIndexes; });
+
+    compact.faceCellSides.resize(compact.faceCells.indexes.size());
+
+#pragma omp parallel for
+    for (long long fIdx = 0; fIdx < nFaces; fIdx++)
+    {
+        const auto &sides = faces.at(fIdx).cellOwnable;
+        copy(
+            sides.begin(), sides.end(),
+            compact.faceCellSides.begin() + compact.faceCells.offsets[fIdx]);
+    }
+}
+
+void Grid::ReleaseMeshConnectivity()
+{
+#pragma omp parallel sections
+    {
+#pragma omp section
+        {
+            for (auto &face : mMesh.faces)
+            {
+                vector<size_t>().swap(face.second.nodeIndexes);
+                vector<size_t>().swap(face.second.cellIndexes);
+                vector<int>().swap(face.second.cellOwnable);
+            }
+        }
+#pragma omp section
+        {
+            for (auto &cell : mMesh.cells)
+            {
+                vector<size_t>().swap(cell.second.faceIndexes);
+                vector<size_t>().swap(cell.second.neighbors);
+            }
+        }
+    }
+}
+
+void Grid::RestoreMeshConnectivity()
+{
+    const long long nFaces = GetNumFaces();
+    const long long nCells = GetNumCells();
+
+    // Not activated yet, the mesh holds its connections.
+    if (mCompactMesh.faceNodes.Size() != (size_t)nFaces
+        || mCompactMesh.cellFaces.Size() != (size_t)nCells)
+    {
+        return;
+    }
+
+#pragma omp parallel for
+    for (long long fIdx = 0; fIdx < nFaces; fIdx++)
+    {
+        const auto nIdxs = mCompactMesh.faceNodes[fIdx];
+
+        mMesh.faces.at(fIdx).nodeIndexes.assign(nIdxs.begin(), nIdxs.end());
+    }
+
+#pragma omp parallel for
+    for (long long cIdx = 0; cIdx < nCells; cIdx++)
+    {
+        const auto fIdxs = mCompactMesh.cellFaces[cIdx];
+
+        mMesh.cells.at(cIdx).faceIndexes.assign(fIdxs.begin(), fIdxs.end());
+    }
+}
+
 size_t Grid::GetNumCells() const
 {
     return mMesh.cells.size();
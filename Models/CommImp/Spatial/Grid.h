@@ -11,6 +11,7 @@
 #include "Models/CommImp/Numeric/Vector.h"
 #include "Models/Utils/EventHandler.h"
 #include "Mesh.h"
+#include "MeshRenumberer.h"
 #include <string>
 
 
@@ -34,6 +35,17 @@ protected:
     int  mVersion = 0;
     Mesh mMesh;
 
+    // Compact arrays of the mesh built when activated, which then hold all the
+    // connections of the mesh elements, released from `mMesh`.
+    CompactMesh mCompactMesh;
+
+    // Renumbering of the mesh when activated, and the original indexes of the mesh
+    // elements in the renumbered order.
+    RenumberMethod      mRenumberMethod = RenumberMethod::None;
+    std::vector<size_t> mNodeOrder;
+    std::vector<size_t> mFaceOrder;
+    std::vector<size_t> mCellOrder;
+
 public:
     virtual ~Grid() = default;
     Grid(const Mesh &mesh);
@@ -54,6 +66,7 @@ public:
     //
 
     /// @brief Extract topology and geometry data.
+    /// The connections of the elements are then only kept in the compact mesh.
     virtual void Activate();
 
     /// @brief Refine the mesh cell of a given index @p cellIndex for adaptive mesh.
@@ -62,6 +75,12 @@ public:
     /// @brief Relax the mesh cell of a given index @p cellIndex .
     virtual void RelaxCell(size_t cellIndex);
 
+    /// @brief Sets the method to renumber the mesh when activated, for better memory
+    /// locality. Faces are then ordered by their owner cells, and nodes by faces.
+    void SetRenumberMethod(RenumberMethod method);
+
+    RenumberMethod GetRenumberMethod() const;
+
     ///////////////////////////////////////////////////////////////////////////////////
     // Methods used for mesh element access and query.
     //
@@ -78,11 +97,22 @@ public:
     size_t GetNumFaces() const;
     size_t GetNumNodes() const;
 
+    /// @brief Returns the mesh elements. Once activated, their geometry is kept but
+    /// their connections, e.g. `Face::cellIndexes`, are in `GetCompactMesh()` only.
     const Cell &GetCell(size_t cellIndex) const;
     const Face &GetFace(size_t faceIndex) const;
     const Node &GetNode(size_t nodeIndex) const;
     const Mesh &GetMesh() const;
 
+    /// @brief Returns the compact mesh arrays, which are valid after activated.
+    const CompactMesh &GetCompactMesh() const;
+
+    /// @brief Returns the original index of each element before renumbered, i.e. the
+    /// field value of cell `i` belongs to the original cell `GetOriginalCells()[i]`.
+    const std::vector<size_t> &GetOriginalNodes() const;
+    const std::vector<size_t> &GetOriginalFaces() const;
+    const std::vector<size_t> &GetOriginalCells() const;
+
     ///////////////////////////////////////////////////////////////////////////////////
     // Methods used for mesh topological analysis.
     //
@@ -110,6 +140,9 @@ protected:
     // Methods used for activating mesh data.
     //
 
+    /// @brief Renumbers the mesh elements by the renumber method.
+    virtual void RenumberMesh();
+
     virtual void CollectCellsSharedNode();
     virtual void CollectFacesSharedNode();
     virtual void CollectCellsSharedFace();
@@ -133,6 +166,15 @@ protected:
 
     virtual void CalculateCellToCellDist();
     virtual void CalculateCellToFaceDist();
+
+    /// @brief Packs the activated mesh data into the compact mesh arrays.
+    virtual void BuildCompactMesh();
+
+    /// @brief Frees the connections of the mesh elements packed in the compact mesh.
+    virtual void ReleaseMeshConnectivity();
+
+    /// @brief Unpacks the face nodes and cell faces released, for activating again.
+    virtual void RestoreMeshConnectivity();
 };
 
 }  // namespace OpenOasis::CommImp::Spatial
\ No newline at end of file
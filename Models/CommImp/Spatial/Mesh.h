@@ -9,6 +9,7 @@
  ** ***********************************************************************************/
 #pragma once
 #include "Models/CommImp/Numeric/Vector.h"
+#include "Models/Utils/Span.h"
 #include "Coordinate.h"
 #include <vector>
 #include <unordered_map>
@@ -23,15 +24,10 @@ namespace Spatial
 {
 /// @brief The mesh nodes data structure.
 /// (Point type).
+/// The faces and cells sharing the node are only kept in `CompactMesh`.
 struct Node
 {
     Coordinate coor;  // unit(m).
-
-    // Indexes of mesh faces shared node.
-    std::vector<size_t> faceIndexes;
-
-    // Indexes of mesh cells shared node.
-    std::vector<size_t> cellIndexes;
 };
 
 
@@ -103,6 +99,62 @@ struct Mesh
     std::unordered_map<size_t, Cell> cells;
 };
 
+
+/// @brief Connectivity of mesh elements in compressed sparse rows(CSR).
+/// The indexes related to element i are `indexes[offsets[i], offsets[i + 1])`.
+struct Connectivity
+{
+    std::vector<size_t> offsets = {0};
+    std::vector<size_t> indexes;
+
+    size_t Size() const
+    {
+        return offsets.size() - 1;
+    }
+
+    size_t Count(size_t i) const
+    {
+        return offsets[i + 1] - offsets[i];
+    }
+
+    Utils::Span<const size_t> operator[](size_t i) const
+    {
+        return Utils::Span<const size_t>(indexes.data() + offsets[i], Count(i));
+    }
+};
+
+
+/// @brief Compact mesh structure of arrays.
+/// Elements are indexed by the continuous mesh indexes, and related elements are
+/// packed in `Connectivity`, so the numerical loops stream through the arrays.
+///
+/// `Mesh` is the assembly form the grid activates. Once packed, the connections are
+/// released from its elements and only stored here, and the element geometry is
+/// kept in both for the element queries.
+struct CompactMesh
+{
+    std::vector<Coordinate> nodeCoords;
+
+    std::vector<Coordinate>            faceCentroids;
+    std::vector<Numeric::Vector<real>> faceNormals;
+    std::vector<real>                  faceAreas;
+    std::vector<real>                  facePerimeters;
+
+    std::vector<Coordinate> cellCentroids;
+    std::vector<real>       cellSurfaces;
+    std::vector<real>       cellVolumes;
+
+    Connectivity faceNodes;  // Sorted counterclockwise.
+    Connectivity faceCells;
+    Connectivity cellFaces;
+    Connectivity cellNeighbors;
+    Connectivity nodeFaces;
+    Connectivity nodeCells;
+
+    // Orientation of the cells to the face normal, corresponds to `faceCells`.
+    std::vector<int> faceCellSides;
+};
+
 }  // namespace Spatial
 }  // namespace CommImp
 }  // namespace OpenOasis
@@ -0,0 +1,284 @@
+/** ***********************************************************************************
+ *    @File      :  MeshRenumberer.cpp
+ *    @Brief     :  To renumber mesh elements for memory locality.
+ *
+ ** ***********************************************************************************/
+#include "MeshRenumberer.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+
+namespace OpenOasis::CommImp::Spatial
+{
+using namespace std;
+
+namespace
+{
+/// @brief Returns the position of the cell on the Hilbert curve of order 16.
+uint64_t HilbertIndex(uint32_t x, uint32_t y)
+{
+    uint64_t index = 0;
+    for (uint32_t s = 1u << 15; s > 0; s >>= 1)
+    {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        index += (uint64_t)s * s * ((3 * rx) ^ ry);
+
+        // Rotates the quadrant.
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            swap(x, y);
+        }
+    }
+
+    return index;
+}
+
+}  // namespace
+
+
+vector<size_t> MeshRenumberer::OrderByReverseCuthillMcKee(const Connectivity &neighbors)
+{
+    const size_t count   = neighbors.Size();
+    const size_t Invalid = numeric_limits<size_t>::max();
+
+    vector<size_t> order;
+    order.reserve(count);
+
+    vector<size_t> levels(count, Invalid);
+
+    // Visits the cells reachable from the root level by level, and returns the last
+    // level and the depth.
+    vector<size_t> visits;
+    auto           traverse = [&](size_t root) {
+        visits.assign(1, root);
+        levels[root] = 0;
+
+        size_t levelBeg = 0;
+        for (size_t i = 0; i < visits.size(); i++)
+        {
+            size_t cIdx = visits[i];
+            if (levels[cIdx] != levels[visits[levelBeg]])
+            {
+                levelBeg = i;
+            }
+
+            for (size_t nIdx : neighbors[cIdx])
+            {
+                if (levels[nIdx] == Invalid)
+                {
+                    levels[nIdx] = levels[cIdx] + 1;
+                    visits.push_back(nIdx);
+                }
+            }
+        }
+
+        size_t depth = levels[visits.back()];
+        for (size_t cIdx : visits)
+        {
+            levels[cIdx] = Invalid;
+        }
+
+        vector<size_t> last(visits.begin() + levelBeg, visits.end());
+        return make_pair(move(last), depth);
+    };
+
+    auto byDegree = [&](size_t a, size_t b) {
+        return make_tuple(neighbors.Count(a), a) < make_tuple(neighbors.Count(b), b);
+    };
+
+    vector<size_t> cells(count);
+    iota(cells.begin(), cells.end(), 0);
+    sort(cells.begin(), cells.end(), byDegree);
+
+    vector<bool> visited(count, false);
+    for (size_t start : cells)
+    {
+        if (visited[start])
+            continue;
+
+        // Finds a pseudo-peripheral cell of the component as the root (George-Liu).
+        size_t root        = start;
+        auto [last, depth] = traverse(root);
+        for (int iter = 0; iter < 8; iter++)
+        {
+            size_t next = *min_element(last.begin(), last.end(), byDegree);
+
+            auto [nextLast, nextDepth] = traverse(next);
+            if (nextDepth <= depth)
+                break;
+
+            root  = next;
+            last  = move(nextLast);
+            depth = nextDepth;
+        }
+
+        // Cuthill-McKee ordering from the root.
+        size_t head = order.size();
+        order.push_back(root);
+        visited[root] = true;
+
+        vector<size_t> adjacent;
+        for (; head < order.size(); head++)
+        {
+            adjacent.clear();
+            for (size_t nIdx : neighbors[order[head]])
+            {
+                if (!visited[nIdx])
+                {
+                    visited[nIdx] = true;
+                    adjacent.push_back(nIdx);
+                }
+            }
+
+            sort(adjacent.begin(), adjacent.end(), byDegree);
+            order.insert(order.end(), adjacent.begin(), adjacent.end());
+        }
+    }
+
+    reverse(order.begin(), order.end());
+    return order;
+}
+
+vector<size_t> MeshRenumberer::OrderByHilbertCurve(const vector<Coordinate> &points)
+{
+    const long long count = points.size();
+
+    real xMin = numeric_limits<real>::max(), xMax = numeric_limits<real>::lowest();
+    real yMin = numeric_limits<real>::max(), yMax = numeric_limits<real>::lowest();
+    for (const auto &point : points)
+    {
+        xMin = min(xMin, point.x), xMax = max(xMax, point.x);
+        yMin = min(yMin, point.y), yMax = max(yMax, point.y);
+    }
+
+    // Scales the extent uniformly to keep the curve square.
+    const real span  = max(xMax - xMin, yMax - yMin);
+    const real scale = (span > 0) ? 65535 / span : 0;
+
+    vector<uint64_t> indexes(count);
+
+#pragma omp parallel for
+    for (long long i = 0; i < count; i++)
+    {
+        auto x = (uint32_t)((points[i].x - xMin) * scale);
+        auto y = (uint32_t)((points[i].y - yMin) * scale);
+
+        indexes[i] = HilbertIndex(min(x, 65535u), min(y, 65535u));
+    }
+
+    vector<size_t> order(count);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return make_tuple(indexes[a], a) < make_tuple(indexes[b], b);
+    });
+
+    return order;
+}
+
+vector<size_t> MeshRenumberer::OrderFacesByCells(
+    const Connectivity &faceCells, const vector<size_t> &cellRanks)
+{
+    const long long count = faceCells.Size();
+
+    // Sorts by the owner cell, and the boundary faces go first.
+    vector<tuple<size_t, size_t, size_t>> keys(count);
+
+#pragma omp parallel for
+    for (long long fIdx = 0; fIdx < count; fIdx++)
+    {
+        size_t owner = numeric_limits<size_t>::max(), other = 0;
+        for (size_t cIdx : faceCells[fIdx])
+        {
+            owner = min(owner, cellRanks[cIdx]);
+            other = max(other, cellRanks[cIdx]);
+        }
+
+        if (faceCells.Count(fIdx) < 2)
+        {
+            other = 0;
+        }
+
+        keys[fIdx] = {owner, other, fIdx};
+    }
+
+    sort(keys.begin(), keys.end());
+
+    vector<size_t> order(count);
+    for (long long i = 0; i < count; i++)
+    {
+        order[i] = get<2>(keys[i]);
+    }
+
+    return order;
+}
+
+vector<size_t> MeshRenumberer::OrderNodesByFaces(
+    const Connectivity &faceNodes, const vector<size_t> &faceOrder, size_t nodeCount)
+{
+    vector<size_t> order;
+    order.reserve(nodeCount);
+
+    vector<bool> visited(nodeCount, false);
+    for (size_t fIdx : faceOrder)
+    {
+        for (size_t nIdx : faceNodes[fIdx])
+        {
+            if (!visited[nIdx])
+            {
+                visited[nIdx] = true;
+                order.push_back(nIdx);
+            }
+        }
+    }
+
+    // Nodes not on any face keep their relative order at the end.
+    for (size_t nIdx = 0; nIdx < nodeCount; nIdx++)
+    {
+        if (!visited[nIdx])
+        {
+            order.push_back(nIdx);
+        }
+    }
+
+    return order;
+}
+
+vector<size_t> MeshRenumberer::InvertOrder(const vector<size_t> &order)
+{
+    vector<size_t> ranks(order.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        ranks[order[i]] = i;
+    }
+
+    return ranks;
+}
+
+size_t MeshRenumberer::CalculateBandwidth(
+    const Connectivity &neighbors, const vector<size_t> &order)
+{
+    const auto ranks = InvertOrder(order);
+
+    size_t bandwidth = 0;
+    for (size_t cIdx = 0; cIdx < neighbors.Size(); cIdx++)
+    {
+        for (size_t nIdx : neighbors[cIdx])
+        {
+            size_t r0 = ranks[cIdx], r1 = ranks[nIdx];
+            bandwidth = max(bandwidth, (r0 > r1) ? r0 - r1 : r1 - r0);
+        }
+    }
+
+    return bandwidth;
+}
+
+}  // namespace OpenOasis::CommImp::Spatial
@@ -0,0 +1,61 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  MeshRenumberer.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To renumber mesh elements for memory locality.
+ *
+ *    Each order lists the original indexes of elements in the new order, i.e. the
+ *    element `order[i]` is renumbered as `i`.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Mesh.h"
+
+
+namespace OpenOasis::CommImp::Spatial
+{
+/// @brief Methods to renumber the mesh cells.
+enum class RenumberMethod
+{
+    None,
+    ReverseCuthillMcKee,  // Reduces the bandwidth of the cell adjacency.
+    HilbertCurve,         // Sorts cells along the Hilbert curve of centroids.
+};
+
+
+/// @brief Collections of mesh renumbering functions.
+class MeshRenumberer final
+{
+public:
+    /// @brief Orders cells by the reverse Cuthill-McKee algorithm.
+    /// @param neighbors Neighboring cells of each cell.
+    static std::vector<size_t>
+    OrderByReverseCuthillMcKee(const Connectivity &neighbors);
+
+    /// @brief Orders points along the Hilbert curve over the x-y plane.
+    static std::vector<size_t>
+    OrderByHilbertCurve(const std::vector<Coordinate> &points);
+
+    /// @brief Orders faces by their owner(the first in new order) and then neighbor
+    /// cells.
+    /// @param cellRanks New index of each cell.
+    static std::vector<size_t> OrderFacesByCells(
+        const Connectivity &faceCells, const std::vector<size_t> &cellRanks);
+
+    /// @brief Orders nodes as they are first visited by the faces in new order.
+    /// @param faceOrder Original index of each face in new order.
+    static std::vector<size_t> OrderNodesByFaces(
+        const Connectivity &faceNodes, const std::vector<size_t> &faceOrder,
+        size_t nodeCount);
+
+    /// @brief Inverts the order to the new index of each element, or vice versa.
+    static std::vector<size_t> InvertOrder(const std::vector<size_t> &order);
+
+    /// @brief Calculates the maximum index distance between neighbors in the order.
+    static size_t
+    CalculateBandwidth(const Connectivity &neighbors, const std::vector<size_t> &order);
+};
+
+}  // namespace OpenOasis::CommImp::Spatial
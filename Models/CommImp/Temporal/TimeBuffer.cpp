@@ -7,6 +7,7 @@
 #include "Models/CommImp/Time.h"
 #include "Models/CommImp/DevSupports/ExtensionMethods.h"
 #include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
 
 
 namespace OpenOasis::CommImp::Temporal
@@ -15,6 +16,83 @@ using namespace DevSupports;
 using namespace Utils;
 using namespace std;
 
+namespace
+{
+// Kernels combining the contiguous rows of values into the result, each one is a
+// single loop vectorized by the compiler.
+
+/// @brief out = a.
+void Copy(Span<real> out, const real *a)
+{
+    copy(a, a + out.size(), out.begin());
+}
+
+/// @brief out = wa * a + wb * b.
+void Blend(Span<real> out, const real *a, real wa, const real *b, real wb)
+{
+    real *o = out.data();
+    int   n = (int)out.size();
+
+#pragma omp simd
+    for (int i = 0; i < n; i++)
+    {
+        o[i] = wa * a[i] + wb * b[i];
+    }
+}
+
+/// @brief out += wa * a + wb * b.
+void AddBlend(Span<real> out, const real *a, real wa, const real *b, real wb)
+{
+    real *o = out.data();
+    int   n = (int)out.size();
+
+#pragma omp simd
+    for (int i = 0; i < n; i++)
+    {
+        o[i] += wa * a[i] + wb * b[i];
+    }
+}
+
+/// @brief out += w * a.
+void AddScaled(Span<real> out, const real *a, real w)
+{
+    real *o = out.data();
+    int   n = (int)out.size();
+
+#pragma omp simd
+    for (int i = 0; i < n; i++)
+    {
+        o[i] += w * a[i];
+    }
+}
+
+/// @brief out += sum(w_k * rows_k), the rows are combined block by block so that the
+/// block of out stays in cache while all rows are added.
+void AddWeightedRows(
+    Span<real> out, const vector<const real *> &rows, const vector<real> &weights)
+{
+    const int blockSize = 1024;
+
+    real *o = out.data();
+    int   n = (int)out.size();
+    for (int begin = 0; begin < n; begin += blockSize)
+    {
+        int end = min(begin + blockSize, n);
+        for (size_t k = 0; k < rows.size(); k++)
+        {
+            const real *a = rows[k];
+            real        w = weights[k];
+
+#pragma omp simd
+            for (int i = begin; i < end; i++)
+            {
+                o[i] += w * a[i];
+            }
+        }
+    }
+}
+}  // namespace
+
 
 TimeBuffer::TimeBuffer()
 {
@@ -44,7 +122,7 @@ void TimeBuffer::Create()
     mRelaxationFactor           = 1.0;
 
     mTimes  = make_shared<TimeSet>();
-    mValues = make_shared<ValueSet2D>();
+    mValues = make_shared<ValueSetDense<real>>();
 }
 
 void TimeBuffer::AddValues(const shared_ptr<ITime> &time, const vector<real> &values)
@@ -66,7 +144,7 @@ void TimeBuffer::AddValuesToBuffer(
 
         // Order of times: The end time is allowed to overlap with at most
         // Time::EpsilonForTimeCompare with the new time.
-        if (mTimes->GetTimes().size() > 0
+        if (mTimes->GetCount() > 0
             && time->GetTimeStamp() + Time::EpsilonForTimeCompare
                    < ExtensionMethods::EndTimeStamp(mTimes->GetTimeHorizon()))
         {
@@ -77,7 +155,8 @@ void TimeBuffer::AddValuesToBuffer(
     }
     else
     {
-        if (time->GetDurationInDays() > 0)
+        // The first time decides whether the buffer holds spans or stamps.
+        if (mTimes->GetCount() > 0 && time->GetDurationInDays() > 0)
         {
             throw runtime_error(
                 "Time with duration added to time set without durations.");
@@ -95,12 +174,23 @@ void TimeBuffer::AddValuesToBuffer(
         }
     }
 
-    mTimes->AddTime(make_shared<Time>(time));  // save a copy of time
-
-    for (int i = 0; i < (int)values.size(); ++i)
+    // Tracks whether the spans are contiguous and of the same length, for which the
+    // weight plans are reusable.
+    int count = mTimes->GetCount();
+    if (count == 0)
+    {
+        mSpanStep       = time->GetDurationInDays();
+        mIsUniformSpans = true;
+    }
+    else if (!IsUniformNext((*mTimes)[count - 1], *time))
     {
-        mValues->SetOrAddValue({mTimes->GetCount() - 1, i}, values[i]);
+        mIsUniformSpans = false;
+        mWeightPlans.clear();
     }
+
+    mTimes->AddTime(make_shared<Time>(time));  // save a copy of time
+
+    mValues->AddElementValuesForTime(values);
 }
 
 real TimeBuffer::GetRelaxationFactor() const
@@ -128,7 +218,7 @@ shared_ptr<ITime> TimeBuffer::GetTimeAt(int timeStep) const
 
 void TimeBuffer::CheckBuffer() const
 {
-    if (mTimes->GetCount() != mValues->GetIndexCount({0}))
+    if (mTimes->GetCount() != mValues->GetTimesCount())
     {
         throw runtime_error("Different numbers of values and times in buffer");
     }
@@ -146,16 +236,23 @@ vector<real> TimeBuffer::GetValuesAt(int timeStep) const
         CheckBuffer();
     }
 
-    vector<real> values;
-    for (const auto &val : mValues->GetElementValuesForTime(timeStep))
-    {
-        values.push_back(any_cast<real>(val));
-    }
+    return mValues->GetElementValuesForTimeSpan(timeStep).ToVector();
+}
 
-    return values;
+const real *TimeBuffer::RowAt(int timeStep) const
+{
+    return mValues->GetElementValuesForTimeSpan(timeStep).data();
 }
 
 vector<real> TimeBuffer::GetValues(const shared_ptr<ITime> &requestedTime)
+{
+    vector<real> returnValues(mValues->GetTimesCount() != 0 ? GetValuesCount() : 0);
+    GetValues(requestedTime, returnValues);
+
+    return returnValues;
+}
+
+void TimeBuffer::GetValues(const shared_ptr<ITime> &requestedTime, Span<real> values)
 {
     if (mDoExtendedDataVerification)
     {
@@ -175,44 +272,51 @@ vector<real> TimeBuffer::GetValues(const shared_ptr<ITime> &requestedTime)
         }
     }
 
-    vector<real> returnValues;
-    if (mValues->GetIndexCount({0}) != 0)
+    if (mValues->GetTimesCount() == 0)
     {
-        if (mTimes->HasDurations() && requestedTime->GetDurationInDays() > 0)
-        {
-            returnValues = MapFromTimeSpansToTimeSpan(requestedTime);
-        }
-        else if (
-            mTimes->HasDurations()
-            && requestedTime->GetDurationInDays() <= Time::EpsilonForTimeCompare)
-        {
-            returnValues = MapFromTimeSpansToTimeStamp(requestedTime);
-        }
-        else if (!mTimes->HasDurations() && requestedTime->GetDurationInDays() > 0)
-        {
-            returnValues = MapFromTimeStampsToTimeSpan(requestedTime);
-        }
-        else  // time stamps
-        {
-            returnValues = MapFromTimeStampsToTimeStamp(requestedTime);
-        }
+        return;
     }
 
-    return returnValues;
+    if ((int)values.size() != GetValuesCount())
+    {
+        throw invalid_argument(StringHelper::FormatSimple(
+            "Values of size [{}] can not hold the [{}] buffered elements.",
+            values.size(),
+            GetValuesCount()));
+    }
+
+    // The mappings accumulate into the values.
+    fill(values.begin(), values.end(), 0);
+
+    if (mTimes->HasDurations() && requestedTime->GetDurationInDays() > 0)
+    {
+        MapFromTimeSpansToTimeSpan(requestedTime, values);
+    }
+    else if (
+        mTimes->HasDurations()
+        && requestedTime->GetDurationInDays() <= Time::EpsilonForTimeCompare)
+    {
+        MapFromTimeSpansToTimeStamp(requestedTime, values);
+    }
+    else if (!mTimes->HasDurations() && requestedTime->GetDurationInDays() > 0)
+    {
+        MapFromTimeStampsToTimeSpan(requestedTime, values);
+    }
+    else  // time stamps
+    {
+        MapFromTimeStampsToTimeStamp(requestedTime, values);
+    }
 }
 
-vector<real>
-TimeBuffer::MapFromTimeStampsToTimeStamp(const shared_ptr<ITime> &requestedTimeStamp)
+void TimeBuffer::MapFromTimeStampsToTimeStamp(
+    const shared_ptr<ITime> &requestedTimeStamp, Span<real> vr)
 {
     try
     {
-        int  elementCount = mValues->GetIndexCount({0, 0});
-        real tr           = requestedTimeStamp->GetTimeStamp();  // Requested TimeStamp
-
-        vector<real> vr(elementCount);  // Values to return
+        real tr = requestedTimeStamp->GetTimeStamp();  // Requested TimeStamp
 
-        const auto &times = mTimes->GetTimes();
-        if (times.size() == 1)
+        auto &times = *mTimes;
+        if (times.GetCount() == 1)
         {
             //-------------------------------------------------------------------------
             //    Buffered  TimesStamps:|          >tb0<
@@ -221,18 +325,15 @@ TimeBuffer::MapFromTimeStampsToTimeStamp(const shared_ptr<ITime> &requestedTimeS
             // or Requested TimeStamp:  |                >tr<
             //                           -------------------------------------------> t
             // ------------------------------------------------------------------------
-            if (tr > (times.front()->GetTimeStamp() + Time::EpsilonForTimeCompare)
+            if (tr > (times[0]->GetTimeStamp() + Time::EpsilonForTimeCompare)
                 && !mDoExtrapolate)
             {
                 throw runtime_error("Extrapolation not allowed");
             }
 
-            for (int i = 0; i < elementCount; i++)
-            {
-                vr[i] = any_cast<real>(mValues->GetValue({0, i}));
-            }
+            Copy(vr, RowAt(0));
         }
-        else if (tr <= times.front()->GetTimeStamp())
+        else if (tr <= times[0]->GetTimeStamp())
         {
             //-------------------------------------------------------------------------
             //  Buffered  TimesStamps:|          >tb0<   >tb1<   >tb2<  >tbN<
@@ -242,34 +343,22 @@ TimeBuffer::MapFromTimeStampsToTimeStamp(const shared_ptr<ITime> &requestedTimeS
             real tb0 = times[0]->GetTimeStamp();
             real tb1 = times[1]->GetTimeStamp();
 
-            for (int i = 0; i < elementCount; i++)
-            {
-                real sbi0 = any_cast<real>(mValues->GetValue({0, i}));
-                real sbi1 = any_cast<real>(mValues->GetValue({i, i}));
-                vr[i] =
-                    ((sbi0 - sbi1) / (tb0 - tb1)) * (tr - tb0) * (1 - mRelaxationFactor)
-                    + sbi0;
-            }
+            real k = (tr - tb0) * (1 - mRelaxationFactor) / (tb0 - tb1);
+            Blend(vr, RowAt(0), 1 + k, RowAt(1), -k);
         }
-        else if (tr > times.back()->GetTimeStamp())
+        else if (tr > times[times.GetCount() - 1]->GetTimeStamp())
         {
             //-------------------------------------------------------------------------
             //  Buffered  TimesStamps:|  >tb0<  >tb1<  >tb2<  >tbN_2<  >tbN_1<
             //  Requested TimeStamp:  |                                         >tr<
             //                         ---------------------------------------------> t
             // ------------------------------------------------------------------------
-            int  size  = times.size();
+            int  size  = times.GetCount();
             real tbN_2 = times[size - 2]->GetTimeStamp();
             real tbN_1 = times[size - 1]->GetTimeStamp();
 
-            for (int i = 0; i < elementCount; i++)
-            {
-                real sbiN_2 = any_cast<real>(mValues->GetValue({size - 2, i}));
-                real sbiN_1 = any_cast<real>(mValues->GetValue({size - 1, i}));
-                vr[i]       = ((sbiN_1 - sbiN_2) / (tbN_1 - tbN_2)) * (tr - tbN_1)
-                            * (1 - mRelaxationFactor)
-                        + sbiN_1;
-            }
+            real k = (tr - tbN_1) * (1 - mRelaxationFactor) / (tbN_1 - tbN_2);
+            Blend(vr, RowAt(size - 1), 1 + k, RowAt(size - 2), -k);
         }
         else
         {
@@ -278,25 +367,15 @@ TimeBuffer::MapFromTimeStampsToTimeStamp(const shared_ptr<ITime> &requestedTimeS
             //  Requested TimeStamp:   |                   >tr<
             //                         ---------------------------------------------> t
             // ------------------------------------------------------------------------
-            const auto &iter = find_if(begin(times), end(times), [&tr](const auto &t) {
-                return t->GetTimeStamp() >= tr;
-            });
-
-            int iHigh = distance(begin(times), iter);
+            int iHigh = FindTimeIndex(tr, false);
 
             real fraction =
                 (tr - times[iHigh - 1]->GetTimeStamp())
                 / (times[iHigh]->GetTimeStamp() - times[iHigh - 1]->GetTimeStamp());
 
-            for (int i = 0; i < elementCount; i++)
-            {
-                real sbinA = any_cast<real>(mValues->GetValue({iHigh - 1, i}));
-                real sbinB = any_cast<real>(mValues->GetValue({iHigh, i}));
-                vr[i]      = sbinA + fraction * (sbinB - sbinA);
-            }
+            Blend(vr, RowAt(iHigh - 1), 1 - fraction, RowAt(iHigh), fraction);
         }
 
-        return vr;
     }
     catch (const runtime_error &e)
     {
@@ -304,14 +383,11 @@ TimeBuffer::MapFromTimeStampsToTimeStamp(const shared_ptr<ITime> &requestedTimeS
     }
 }
 
-vector<real>
-TimeBuffer::MapFromTimeSpansToTimeSpan(const shared_ptr<ITime> &requestedTime)
+void TimeBuffer::MapFromTimeSpansToTimeSpan(
+    const shared_ptr<ITime> &requestedTime, Span<real> vr)
 {
     try
     {
-        int          elementCount = mValues->GetIndexCount({0, 0});
-        vector<real> vr(elementCount);  // Values to return
-
         // Begin time in requester time interval
         real trb = requestedTime->GetTimeStamp();
         // End time in requester time interval
@@ -319,9 +395,9 @@ TimeBuffer::MapFromTimeSpansToTimeSpan(const shared_ptr<ITime> &requestedTime)
         // length of requested time interval
         real trl = tre - trb;
 
-        const auto &times = mTimes->GetTimes();
-        int         size  = (int)times.size();
-        if (times.empty())
+        auto &times = *mTimes;
+        int   size  = times.GetCount();
+        if (times.GetCount() == 0)
         {
             throw runtime_error("No times in buffer");
         }
@@ -344,30 +420,21 @@ TimeBuffer::MapFromTimeSpansToTimeSpan(const shared_ptr<ITime> &requestedTime)
                 if (size >= 2 && mRelaxationFactor != 1)
                 {
                     // Linear interpolation
-                    real tbe0 = ExtensionMethods::End(times[0])->GetTimeStamp();
+                    real tbe0 = ExtensionMethods::EndTimeStamp(times[0]);
                     // real tbb1 = times[1]->GetTimeStamp();
-                    real tbe1 = ExtensionMethods::End(times[1])->GetTimeStamp();
-
-                    for (int i = 0; i < elementCount; i++)
-                    {
-                        real sbi0 = any_cast<real>(mValues->GetValue({0, i}));
-                        real sbi1 = any_cast<real>(mValues->GetValue({1, i}));
-                        vr[i]     = sbi0
-                                - (1 - mRelaxationFactor) * (sbi1 - sbi0)
-                                      * (tbe0 + tbb0 - tre - trb) / (tbe1 - tbb0);
-                    }
+                    real tbe1 = ExtensionMethods::EndTimeStamp(times[1]);
+
+                    real k = (1 - mRelaxationFactor) * (tbe0 + tbb0 - tre - trb)
+                             / (tbe1 - tbb0);
+                    Blend(vr, RowAt(0), 1 + k, RowAt(1), -k);
                 }
                 else
                 {
                     // Nearest value interpolation
-                    for (int i = 0; i < elementCount; i++)
-                    {
-                        real sbi0 = any_cast<real>(mValues->GetValue({0, i}));
-                        vr[i]     = sbi0;
-                    }
+                    Copy(vr, RowAt(0));
                 }
 
-                return vr;
+                return;
             }
 
             //-------------------------------------------------------------------------
@@ -377,34 +444,24 @@ TimeBuffer::MapFromTimeSpansToTimeSpan(const shared_ptr<ITime> &requestedTime)
             //-------------------------------------------------------------------------
             if (trb < tbb0)  // && tre > tbb0
             {
-                real tbe0 = ExtensionMethods::End(times[0])->GetTimeStamp();
+                real tbe0 = ExtensionMethods::EndTimeStamp(times[0]);
                 if (size >= 2 && mRelaxationFactor != 1)
                 {
-                    real tbe1 = ExtensionMethods::End(times[1])->GetTimeStamp();
+                    real tbe1 = ExtensionMethods::EndTimeStamp(times[1]);
 
                     // Linear interpolation, use tbb0 as "endpoint" of interval
-                    for (int i = 0; i < elementCount; i++)
-                    {
-                        real sbi0 = any_cast<real>(mValues->GetValue({0, i}));
-                        real sbi1 = any_cast<real>(mValues->GetValue({1, i}));
-                        vr[i] += ((tbb0 - trb) / trl)
-                                 * (sbi0
-                                    - (1 - mRelaxationFactor) * (sbi1 - sbi0)
-                                          * (tbe0 - trb) / (tbe1 - tbb0));
-                    }
+                    real f = (tbb0 - trb) / trl;
+                    real k = (1 - mRelaxationFactor) * (tbe0 - trb) / (tbe1 - tbb0);
+                    AddBlend(vr, RowAt(0), f * (1 + k), RowAt(1), -f * k);
                 }
                 else
                 {
                     // Nearest value interpolation
-                    for (int i = 0; i < elementCount; i++)
-                    {
-                        real sbi0 = any_cast<real>(mValues->GetValue({0, i}));
-                        vr[i] += sbi0 * (tbb0 - trb) / trl;
-                    }
+                    AddScaled(vr, RowAt(0), (tbb0 - trb) / trl);
                 }
             }
 
-            real tbeN0 = ExtensionMethods::End(times.back())->GetTimeStamp();
+            real tbeN0 = ExtensionMethods::EndTimeStamp(times[size - 1]);
 
             //--------------------------------------------------------------------------
             // B     tbb0|---?----|-------|tbeN0
@@ -415,30 +472,20 @@ TimeBuffer::MapFromTimeSpansToTimeSpan(const shared_ptr<ITime> &requestedTime)
                 if (size >= 2 && mRelaxationFactor != 1)
                 {
                     // Linear interpolation
-                    real tbeN1 = ExtensionMethods::End(times[size - 2])->GetTimeStamp();
+                    real tbeN1 = ExtensionMethods::EndTimeStamp(times[size - 2]);
                     real tbbN1 = times[size - 2]->GetTimeStamp();
 
-                    for (int i = 0; i < elementCount; i++)
-                    {
-                        real sbiN0 = any_cast<real>(mValues->GetValue({size - 1, i}));
-                        real sbiN1 = any_cast<real>(mValues->GetValue({size - 2, i}));
-                        ;
-                        vr[i] = sbiN0
-                                + (1 - mRelaxationFactor) * (sbiN0 - sbiN1)
-                                      * (trb + tre - tbeN0 - tbeN1) / (tbeN0 - tbbN1);
-                    }
+                    real k = (1 - mRelaxationFactor) * (trb + tre - tbeN0 - tbeN1)
+                             / (tbeN0 - tbbN1);
+                    Blend(vr, RowAt(size - 1), 1 + k, RowAt(size - 2), -k);
                 }
                 else
                 {
                     // Nearest value interpolation
-                    for (int i = 0; i < elementCount; i++)
-                    {
-                        real sbiN0 = any_cast<real>(mValues->GetValue({size - 1, i}));
-                        vr[i]      = sbiN0;
-                    }
+                    Copy(vr, RowAt(size - 1));
                 }
 
-                return vr;
+                return;
             }
 
             //--------------------------------------------------------------------------
@@ -450,115 +497,29 @@ TimeBuffer::MapFromTimeSpansToTimeSpan(const shared_ptr<ITime> &requestedTime)
             {
                 if (size >= 2 && mRelaxationFactor != 1)
                 {
-                    real tbeN1 = ExtensionMethods::End(times[size - 2])->GetTimeStamp();
+                    real tbeN1 = ExtensionMethods::EndTimeStamp(times[size - 2]);
                     real tbbN1 = times[size - 2]->GetTimeStamp();
-                    for (int i = 0; i < elementCount; i++)
-                    {
-                        real sbiN0 = any_cast<real>(mValues->GetValue({size - 1, i}));
-                        real sbiN1 = any_cast<real>(mValues->GetValue({size - 2, i}));
-                        vr[i] += ((tre - tbeN0) / (tre - trb))
-                                 * (sbiN0
-                                    + (1 - mRelaxationFactor) * (sbiN0 - sbiN1)
-                                          * (tre - tbeN1) / (tbeN0 - tbbN1));
-                    }
+                    real f = (tre - tbeN0) / (tre - trb);
+                    real k = (1 - mRelaxationFactor) * (tre - tbeN1) / (tbeN0 - tbbN1);
+                    AddBlend(vr, RowAt(size - 1), f * (1 + k), RowAt(size - 2), -f * k);
                 }
                 else
                 {
-                    for (int i = 0; i < elementCount; i++)
-                    {
-                        real sbiN0 = any_cast<real>(mValues->GetValue({size - 1, i}));
-                        vr[i] += sbiN0 * ((tre - tbeN0) / (tre - trb));
-                    }
+                    AddScaled(vr, RowAt(size - 1), (tre - tbeN0) / (tre - trb));
                 }
             }
         }
 
-        int nstart = 0;
-        int nend   = size - 1;
-
-        // Narrow down the number of spans to investigate, based on the requested span.
-        if (nend > 10)
-        {
-            // Assuming 4 spans in the buffer, use end-time in GetIntrval
-            // will provide the right indices
-            // spans                 |-0-|-1-|-2-|-3-|
-            // endStamp intervals      0 | 1 | 2 | 3 | 4
-
-            const auto &iter1 =
-                find_if(begin(times), end(times), [&trb](const auto &t) {
-                    return t->GetTimeStamp() >= trb;
-                });
-            nstart = distance(begin(times), iter1);
-
-            const auto &iter2 =
-                find_if(begin(times), end(times), [&tre](const auto &t) {
-                    return ExtensionMethods::End(t)->GetTimeStamp() >= tre;
-                });
-            nend = distance(begin(times), iter2);
-            nend = min(nend, size - 1);
-        }
-
-        for (int n = nstart; n <= nend; n++)
+        // Aggregates the buffered spans overlapped by the requested span, the first
+        // one is the earliest span ending after the requested begin time. A span
+        // ending at the begin time within round-off isn't overlapped, otherwise the
+        // aligned requests would alternate between two plans.
+        int first = FindTimeIndex(trb + Time::EpsilonForTimeCompare, true);
+        if (first < size)
         {
-            real tbbn = times[n]->GetTimeStamp();
-            real tben = ExtensionMethods::End(times[n])->GetTimeStamp();
-
-            //---------------------------------------------------------------------------
-            // B:       tbbn|--------------------------|tben
-            // R:     trb|-------------------------------------|tre
-            // I:           |--------------------------|
-            //---------------------------------------------------------------------------
-            if (trb <= tbbn && tre >= tben)
-            {
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbin = any_cast<real>(mValues->GetValue({n, i}));
-                    vr[i] += sbin * (tben - tbbn) / (tre - trb);
-                }
-            }
-
-            //---------------------------------------------------------------------------
-            // B:      tbbn|-----------------------|tben
-            // R+I:          trb|--------------|tre
-            // --------------------------------------------------------------------------
-            else if (tbbn <= trb && tre <= tben)  // cover all
-            {
-                for (int i = 0; i < elementCount; i++)
-                {
-                    vr[i] += any_cast<real>(mValues->GetValue({n, i}));
-                }
-            }
-
-            //---------------------------------------------------------------------------
-            // B:     tbbn|-----------------|tben
-            // R:                 trb|--------------|tre
-            // I:                    |------|
-            // --------------------------------------------------------------------------
-            else if (tbbn < trb && trb < tben && tre > tben)
-            {
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbin = any_cast<real>(mValues->GetValue({n, i}));
-                    vr[i] += sbin * (tben - trb) / (tre - trb);
-                }
-            }
-
-            //---------------------------------------------------------------------------
-            // B:           tbbn|-----------------|tben
-            // R:      trb|--------------|tre
-            // I:               |--------|
-            // --------------------------------------------------------------------------
-            else if (trb < tbbn && tre > tbbn && tre < tben)
-            {
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbin = any_cast<real>(mValues->GetValue({n, i}));
-                    vr[i] += sbin * (tre - tbbn) / (tre - trb);
-                }
-            }
+            ApplyWeightPlan(vr, first, GetWeightPlan(first, trb, tre));
         }
 
-        return vr;
     }
     catch (const runtime_error &e)
     {
@@ -566,14 +527,11 @@ TimeBuffer::MapFromTimeSpansToTimeSpan(const shared_ptr<ITime> &requestedTime)
     }
 }
 
-vector<real>
-TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
+void TimeBuffer::MapFromTimeStampsToTimeSpan(
+    const shared_ptr<ITime> &requestedTime, Span<real> vr)
 {
     try
     {
-        int          elementCount = mValues->GetIndexCount({0, 0});
-        vector<real> vr(elementCount);  // Values to return
-
         // Begin time in requester time interval
         real trb = requestedTime->GetTimeStamp();
         // End time in requester time interval
@@ -581,8 +539,8 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
         // length of requested time interval
         // real trl = tre - trb;
 
-        const auto &times = mTimes->GetTimes();
-        int         size  = (int)times.size();
+        auto &times = *mTimes;
+        int   size  = times.GetCount();
 
         //-----------------------------------------------------------------------------
         // This handles values within the time horizon of the buffer, i.e.
@@ -595,18 +553,10 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
         // based on the requested span.
         if (nend > 4)
         {
-            const auto &iter1 =
-                find_if(begin(times), end(times), [&trb](const auto &t) {
-                    return t->GetTimeStamp() >= trb;
-                });
-            nstart = distance(begin(times), iter1);
+            nstart = FindTimeIndex(trb, false);
             nstart = max(nstart, 1);
 
-            const auto &iter2 =
-                find_if(begin(times), end(times), [&tre](const auto &t) {
-                    return ExtensionMethods::End(t)->GetTimeStamp() >= tre;
-                });
-            nend = distance(begin(times), iter2);
+            nend = FindTimeIndex(tre, true);
             nend = min(nend, size - 1);
         }
 
@@ -624,12 +574,7 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
             if (trb <= tbn && tre >= tbnp1)
             {
                 real factor = (tbnp1 - tbn) / (tre - trb);
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbin   = any_cast<real>(mValues->GetValue({n - 1, i}));
-                    real sbinp1 = any_cast<real>(mValues->GetValue({n, i}));
-                    vr[i] += 0.5 * (sbin + sbinp1) * factor;
-                }
+                AddBlend(vr, RowAt(n - 1), 0.5 * factor, RowAt(n), 0.5 * factor);
             }
 
             //-------------------------------------------------------------------------
@@ -639,12 +584,7 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
             else if (tbn <= trb && tre <= tbnp1)  // cover all
             {
                 real fraction = ((tre + trb) / 2 - tbn) / (tbnp1 - tbn);
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbin   = any_cast<real>(mValues->GetValue({n - 1, i}));
-                    real sbinp1 = any_cast<real>(mValues->GetValue({n, i}));
-                    vr[i] += sbin + (sbinp1 - sbin) * fraction;
-                }
+                AddBlend(vr, RowAt(n - 1), 1 - fraction, RowAt(n), fraction);
             }
 
             //-------------------------------------------------------------------------
@@ -656,12 +596,9 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
             {
                 real fraction = ((tbnp1 - trb) / 2) / (tbnp1 - tbn);
                 real factor   = (tbnp1 - trb) / (tre - trb);
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbin   = any_cast<real>(mValues->GetValue({n - 1, i}));
-                    real sbinp1 = any_cast<real>(mValues->GetValue({n, i}));
-                    vr[i] += (sbinp1 - (sbinp1 - sbin) * fraction) * factor;
-                }
+                real wn   = fraction * factor;
+                real wnp1 = (1 - fraction) * factor;
+                AddBlend(vr, RowAt(n - 1), wn, RowAt(n), wnp1);
             }
 
             //-------------------------------------------------------------------------
@@ -673,12 +610,9 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
             {
                 real fraction = ((tre - tbn) / 2) / (tbnp1 - tbn);
                 real factor   = (tre - tbn) / (tre - trb);
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbin   = any_cast<real>(mValues->GetValue({n - 1, i}));
-                    real sbinp1 = any_cast<real>(mValues->GetValue({n, i}));
-                    vr[i] += (sbin + (sbinp1 - sbin) * fraction) * factor;
-                }
+                real wn   = (1 - fraction) * factor;
+                real wnp1 = fraction * factor;
+                AddBlend(vr, RowAt(n - 1), wn, RowAt(n), wnp1);
             }
         }
 
@@ -694,11 +628,7 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
         if (size == 1)
         {
             // TODO: Test if extrapolation is ok.
-            for (int i = 0; i < elementCount; i++)
-            {
-                real sbi0 = any_cast<real>(mValues->GetValue({0, i}));
-                vr[i]     = sbi0;
-            }
+            Copy(vr, RowAt(0));
         }
         else
         {
@@ -718,12 +648,8 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
                 real fraction =
                     (1 - mRelaxationFactor) * 0.5 * (tb0 - trb) / (tb1 - tb0);
                 real factor = ((tb0 - trb) / (tre - trb));
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbi0 = any_cast<real>(mValues->GetValue({0, i}));
-                    real sbi1 = any_cast<real>(mValues->GetValue({1, i}));
-                    vr[i] += factor * (sbi0 - fraction * (sbi1 - sbi0));
-                }
+                real w0 = factor * (1 + fraction);
+                AddBlend(vr, RowAt(0), w0, RowAt(1), -factor * fraction);
             }
 
             //-------------------------------------------------------------------------
@@ -736,12 +662,9 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
                 real factor = ((tre - tbN_1) / (tre - trb));
                 real fraction =
                     (1 - mRelaxationFactor) * 0.5 * (tre - tbN_1) / (tbN_1 - tbN_2);
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbiN_1 = any_cast<real>(mValues->GetValue({size - 1, i}));
-                    real sbiN_2 = any_cast<real>(mValues->GetValue({size - 2, i}));
-                    vr[i] += factor * (sbiN_1 + fraction * (sbiN_1 - sbiN_2));
-                }
+                real wN_1 = factor * (1 + fraction);
+                real wN_2 = -factor * fraction;
+                AddBlend(vr, RowAt(size - 1), wN_1, RowAt(size - 2), wN_2);
             }
 
             //-------------------------------------------------------------------------
@@ -752,13 +675,7 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
             {
                 real fraction = (1 - mRelaxationFactor) * (0.5 * (trb + tre) - tbN_1)
                                 / (tbN_1 - tbN_2);
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbiN_1 = any_cast<real>(mValues->GetValue({size - 1, i}));
-                    real sbiN_2 = any_cast<real>(mValues->GetValue({size - 2, i}));
-
-                    vr[i] = sbiN_1 + (sbiN_1 - sbiN_2) * fraction;
-                }
+                Blend(vr, RowAt(size - 1), 1 + fraction, RowAt(size - 2), -fraction);
             }
 
             //-------------------------------------------------------------------------
@@ -769,16 +686,10 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
             {
                 real fraction =
                     (1 - mRelaxationFactor) / (tb1 - tb0) * (tb0 - 0.5 * (trb + tre));
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbi0 = any_cast<real>(mValues->GetValue({0, i}));
-                    real sbi1 = any_cast<real>(mValues->GetValue({1, i}));
-                    vr[i]     = sbi0 - (sbi1 - sbi0) * fraction;
-                }
+                Blend(vr, RowAt(0), 1 + fraction, RowAt(1), -fraction);
             }
         }
 
-        return vr;
     }
     catch (const runtime_error &e)
     {
@@ -786,16 +697,13 @@ TimeBuffer::MapFromTimeStampsToTimeSpan(const shared_ptr<ITime> &requestedTime)
     }
 }
 
-vector<real>
-TimeBuffer::MapFromTimeSpansToTimeStamp(const shared_ptr<ITime> &requestedTimeStamp)
+void TimeBuffer::MapFromTimeSpansToTimeStamp(
+    const shared_ptr<ITime> &requestedTimeStamp, Span<real> vr)
 {
     try
     {
-        int          elementCount = mValues->GetIndexCount({0, 0});
-        vector<real> vr(elementCount);  // Values to return
-
-        const auto &times = mTimes->GetTimes();
-        int         size  = (int)times.size();
+        auto &times = *mTimes;
+        int   size  = times.GetCount();
 
         real tr = requestedTimeStamp->GetTimeStamp();  // Requested TimeStamp
 
@@ -813,17 +721,14 @@ TimeBuffer::MapFromTimeSpansToTimeStamp(const shared_ptr<ITime> &requestedTimeSt
             if (!mDoExtrapolate)
             {
                 if (times[0]->GetTimeStamp() - Time::EpsilonForTimeCompare > tr
-                    || tr > ExtensionMethods::End(times.back())->GetTimeStamp()
+                    || tr > ExtensionMethods::EndTimeStamp(times[size - 1])
                                 + Time::EpsilonForTimeCompare)
                 {
                     throw runtime_error("Extrapolation not allowed");
                 }
             }
 
-            for (int i = 0; i < elementCount; i++)  // For each element
-            {
-                vr[i] = any_cast<real>(mValues->GetValue({0, i}));
-            }
+            Copy(vr, RowAt(0));
         }
 
         //-----------------------------------------------------------------------------
@@ -842,10 +747,7 @@ TimeBuffer::MapFromTimeSpansToTimeStamp(const shared_ptr<ITime> &requestedTimeSt
                 }
 
                 // Very close to the first point, just provide that value
-                for (int i = 0; i < elementCount; i++)  // For each element
-                {
-                    vr[i] = any_cast<real>(mValues->GetValue({0, i}));
-                }
+                Copy(vr, RowAt(0));
             }
             else
             {
@@ -853,12 +755,7 @@ TimeBuffer::MapFromTimeSpansToTimeStamp(const shared_ptr<ITime> &requestedTimeSt
                 real tbb0     = times[0]->GetTimeStamp();
                 real tbb1     = times[1]->GetTimeStamp();
                 real fraction = (tr - tbb0) / (tbb0 - tbb1) * (1 - mRelaxationFactor);
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbi0 = any_cast<real>(mValues->GetValue({0, i}));
-                    real sbi1 = any_cast<real>(mValues->GetValue({1, i}));
-                    vr[i]     = (sbi0 - sbi1) * fraction + sbi0;
-                }
+                Blend(vr, RowAt(0), 1 + fraction, RowAt(1), -fraction);
             }
         }
 
@@ -867,35 +764,27 @@ TimeBuffer::MapFromTimeSpansToTimeStamp(const shared_ptr<ITime> &requestedTimeSt
         //  Requested TimeStamp:  |                                           >tr<
         //                         -------------------------------------------------> t
         // ----------------------------------------------------------------------------
-        else if (tr >= ExtensionMethods::End(times.back())->GetTimeStamp())
+        else if (tr >= ExtensionMethods::EndTimeStamp(times[size - 1]))
         {
             // Check if we are allowed to extrapolate
             if (!mDoExtrapolate)
             {
-                if (tr > times.back()->GetTimeStamp() + Time::EpsilonForTimeCompare)
+                if (tr > times[size - 1]->GetTimeStamp() + Time::EpsilonForTimeCompare)
                 {
                     throw runtime_error("Extrapolation not allowed");
                 }
 
                 // Very close to the last point, just provide that value
-                for (int i = 0; i < elementCount; i++)
-                {
-                    vr[i] = any_cast<real>(mValues->GetValue({size - 1, i}));
-                }
+                Copy(vr, RowAt(size - 1));
             }
             else
             {
                 // Extrapolate from the last two values
-                real tbeN_2 = ExtensionMethods::End(times[size - 2])->GetTimeStamp();
-                real tbeN_1 = ExtensionMethods::End(times[size - 1])->GetTimeStamp();
+                real tbeN_2 = ExtensionMethods::EndTimeStamp(times[size - 2]);
+                real tbeN_1 = ExtensionMethods::EndTimeStamp(times[size - 1]);
                 real fraction =
                     (tr - tbeN_1) / (tbeN_1 - tbeN_2) * (1 - mRelaxationFactor);
-                for (int i = 0; i < elementCount; i++)
-                {
-                    real sbiN_2 = any_cast<real>(mValues->GetValue({size - 2, i}));
-                    real sbiN_1 = any_cast<real>(mValues->GetValue({size - 1, i}));
-                    vr[i]       = (sbiN_1 - sbiN_2) * fraction + sbiN_1;
-                }
+                Blend(vr, RowAt(size - 1), 1 + fraction, RowAt(size - 2), -fraction);
             }
         }
 
@@ -910,19 +799,11 @@ TimeBuffer::MapFromTimeSpansToTimeStamp(const shared_ptr<ITime> &requestedTimeSt
             // Example: assuming 4 spans in the buffer,
             // spans                 |-0-|-1-|-2-|-3-|
             // endStamp intervals      0 | 1 | 2 | 3 | 4
-            const auto &iter = find_if(begin(times), end(times), [tr](const auto &t) {
-                return t->GetTimeStamp() <= tr
-                       && t->GetTimeStamp() + t->GetDurationInDays() >= tr;
-            });
-            int         interval = distance(begin(times), iter);
+            int interval = FindTimeIndex(tr, true);
 
-            for (int i = 0; i < elementCount; i++)
-            {
-                vr[i] = any_cast<real>(mValues->GetValue({interval, i}));
-            }
+            Copy(vr, RowAt(interval));
         }
 
-        return vr;
     }
     catch (const runtime_error &e)
     {
@@ -930,6 +811,148 @@ TimeBuffer::MapFromTimeSpansToTimeStamp(const shared_ptr<ITime> &requestedTimeSt
     }
 }
 
+int TimeBuffer::FindTimeIndex(double timestamp, bool byEnd)
+{
+    int  count  = mTimes->GetCount();
+    int &cursor = byEnd ? mEndCursor : mStartCursor;
+
+    auto key = [&](int index) {
+        const auto &time = (*mTimes)[index];
+        return byEnd ? ExtensionMethods::EndTimeStamp(time) : time->GetTimeStamp();
+    };
+    auto isFound = [&](int index) {
+        return (index == 0 || key(index - 1) < timestamp)
+               && (index == count || key(index) >= timestamp);
+    };
+
+    // Tries the latest found and its next, which serve monotonic requests in O(1).
+    for (int index : {cursor, cursor + 1})
+    {
+        if (index <= count && isFound(index))
+        {
+            return cursor = index;
+        }
+    }
+
+    int first = 0, last = count;
+    while (first < last)
+    {
+        int mid = first + (last - first) / 2;
+        if (key(mid) < timestamp)
+            first = mid + 1;
+        else
+            last = mid;
+    }
+
+    return cursor = first;
+}
+
+bool TimeBuffer::IsUniformNext(const shared_ptr<ITime> &prev, const ITime &time) const
+{
+    real prevEnd = ExtensionMethods::EndTimeStamp(prev);
+    return abs(time.GetDurationInDays() - mSpanStep) <= Time::EpsilonForTimeCompare
+           && abs(time.GetTimeStamp() - prevEnd) <= Time::EpsilonForTimeCompare;
+}
+
+void TimeBuffer::RecheckUniformSpans()
+{
+    // Spans cleared from uniform spans leave them uniform.
+    if (mIsUniformSpans)
+    {
+        return;
+    }
+
+    // No plan is cached while the spans are irregular, so the step is free to change.
+    int count       = mTimes->GetCount();
+    mSpanStep       = count > 0 ? (*mTimes)[0]->GetDurationInDays() : 0;
+    mIsUniformSpans = true;
+    for (int i = 1; i < count && mIsUniformSpans; i++)
+    {
+        mIsUniformSpans = IsUniformNext((*mTimes)[i - 1], *(*mTimes)[i]);
+    }
+}
+
+const TemporalWeightPlan &
+TimeBuffer::GetWeightPlan(int first, real trb, real tre)
+{
+    // The plan only depends on the request relative to the spans if the spans are
+    // contiguous and of the same length, and the request is inside the buffer.
+    int  size      = mTimes->GetCount();
+    real tbbFirst  = (*mTimes)[first]->GetTimeStamp();
+    bool cacheable = mIsUniformSpans && mSpanStep > 0
+                     && trb >= (*mTimes)[0]->GetTimeStamp()
+                     && tre <= ExtensionMethods::EndTimeStamp((*mTimes)[size - 1]);
+    if (!cacheable)
+    {
+        BuildWeightPlan(first, trb, tre, mScratchPlan);
+        return mScratchPlan;
+    }
+
+    // Relative geometry in steps, quantized to tolerate the round-off errors.
+    auto quantize = [this](real value) {
+        return llround(value / mSpanStep * 1e6);
+    };
+    auto key = make_pair(quantize(trb - tbbFirst), quantize(tre - trb));
+
+    auto iter = mWeightPlans.find(key);
+    if (iter != mWeightPlans.end())
+    {
+        return iter->second;
+    }
+
+    // Irregular requests should not grow the cache without limit.
+    if (mWeightPlans.size() >= 64)
+    {
+        mWeightPlans.clear();
+    }
+
+    auto &plan = mWeightPlans[key];
+    BuildWeightPlan(first, trb, tre, plan);
+    return plan;
+}
+
+void TimeBuffer::BuildWeightPlan(
+    int first, real trb, real tre, TemporalWeightPlan &plan) const
+{
+    plan.rows.clear();
+    plan.weights.clear();
+
+    //---------------------------------------------------------------------------------
+    // B:       tbbn|-----|-----|-----|-----|tben
+    // R:          trb|-----------------|tre
+    // I:             |--|-----|-----|--|
+    //---------------------------------------------------------------------------------
+    // Each span is weighted by the fraction of the requested span it overlaps.
+    for (int n = first; n < mTimes->GetCount(); n++)
+    {
+        real tbbn = (*mTimes)[n]->GetTimeStamp();
+        real tben = ExtensionMethods::EndTimeStamp((*mTimes)[n]);
+        if (tbbn >= tre)
+        {
+            break;
+        }
+
+        real overlap = min(tre, tben) - max(trb, tbbn);
+        if (overlap > 0)
+        {
+            plan.rows.push_back(n - first);
+            plan.weights.push_back(overlap / (tre - trb));
+        }
+    }
+}
+
+void TimeBuffer::ApplyWeightPlan(
+    Span<real> values, int first, const TemporalWeightPlan &plan)
+{
+    mScratchRows.resize(plan.rows.size());
+    for (size_t k = 0; k < mScratchRows.size(); k++)
+    {
+        mScratchRows[k] = RowAt(first + plan.rows[k]);
+    }
+
+    AddWeightedRows(values, mScratchRows, plan.weights);
+}
+
 int TimeBuffer::GetTimesCount() const
 {
     return mTimes->GetCount();
@@ -937,7 +960,7 @@ int TimeBuffer::GetTimesCount() const
 
 int TimeBuffer::GetValuesCount() const
 {
-    return mValues->GetIndexCount({0, 0});
+    return mValues->GetElementsCount();
 }
 
 void TimeBuffer::ClearAfter(shared_ptr<ITime> time)
@@ -948,32 +971,23 @@ void TimeBuffer::ClearAfter(shared_ptr<ITime> time)
         if (clearTimestamp <= (*mTimes)[i]->GetTimeStamp())
         {
             // clear after current time.
-            int numberOfValuesToRemove = mTimes->GetCount() - i;
-            mTimes->RemoveTimeRange(i, numberOfValuesToRemove);
-
-            for (int j = numberOfValuesToRemove; j >= 0; --j)
-                mValues->RemoveValue({j + i});
+            mTimes->RemoveTimeRange(i, mTimes->GetCount() - i);
+            mValues->RemoveTimesFrom(i);
+            break;
         }
     }
+
+    RecheckUniformSpans();
 }
 
 void TimeBuffer::ClearBefore(shared_ptr<ITime> time)
 {
     real clearTimestamp = ExtensionMethods::Start(time)->GetTimeStamp();
 
-    while (!mTimes->GetTimes().empty())
-    {
-        if (mTimes->GetTimes().front()->GetTimeStamp() < clearTimestamp)
-        {
-            // Remove the expired time and values synchronously.
-            mTimes->RemoveTime(0);
-            mValues->RemoveValue({0});
-        }
-        else
-        {
-            break;
-        }
-    }
+    // Remove the expired time and values synchronously.
+    ExtensionMethods::RemoveTimesBefore(mTimes, mValues, clearTimestamp);
+
+    RecheckUniformSpans();
 }
 
 void TimeBuffer::Reset()
@@ -982,6 +996,12 @@ void TimeBuffer::Reset()
     mRelaxationFactor             = 0;
     mLastBufferSizeMessageCounter = 0;
     mDoExtendedDataVerification   = false;
+    mStartCursor                  = 0;
+    mEndCursor                    = 0;
+    mIsUniformSpans               = true;
+    mSpanStep                     = 0;
+
+    mWeightPlans.clear();
 
     mValues.reset();
     mTimes.reset();
@@ -990,35 +1010,27 @@ void TimeBuffer::Reset()
 vector<vector<real>> TimeBuffer::GetAllValues()
 {
     vector<vector<real>> returnValues;
-    for (int i = 0; i < mValues->GetIndexCount({0}); ++i)
+    for (int i = 0; i < mValues->GetTimesCount(); ++i)
     {
-        vector<real> values;
-        for (int j = 0; j < mValues->GetIndexCount({0, i}); ++j)
-        {
-            values.push_back(any_cast<real>(mValues->GetValue({i, j})));
-        }
-
-        returnValues.push_back(values);
+        returnValues.push_back(mValues->GetElementValuesForTimeSpan(i).ToVector());
     }
     return returnValues;
 }
 
 void TimeBuffer::SetOrAddValues(shared_ptr<ITime> time, vector<real> values)
 {
-    const auto &times = mTimes->GetTimes();
-    const auto &iter  = find_if(begin(times), end(times), [&time](const auto &t) {
-        return abs(t->GetTimeStamp() - time->GetTimeStamp())
-               <= Time::EpsilonForTimeCompare;
-    });
-
-    int index = (iter != times.end()) ? -1 : distance(begin(times), iter);
-    if (index < 0)
+    double timestamp = time->GetTimeStamp();
+
+    int index = FindTimeIndex(timestamp - Time::EpsilonForTimeCompare, false);
+    if (index == mTimes->GetCount()
+        || abs((*mTimes)[index]->GetTimeStamp() - timestamp)
+               > Time::EpsilonForTimeCompare)
     {
         AddValues(time, values);  // add new time-values.
     }
     else
     {
-        mValues->SetOrAddValue({index}, values);  // set existed values.
+        mValues->SetElementValuesForTime(index, values);  // set existed values.
     }
 }
 
@@ -1027,7 +1039,7 @@ shared_ptr<TimeSet> TimeBuffer::GetTimeSet() const
     return mTimes;
 }
 
-shared_ptr<ValueSet2D> TimeBuffer::GetValueSet() const
+shared_ptr<ValueSetDense<real>> TimeBuffer::GetValueSet() const
 {
     return mValues;
 }
@@ -29,7 +29,9 @@
  ** ***********************************************************************************/
 #pragma once
 #include "Models/CommImp/TimeSet.h"
-#include "Models/CommImp/ValueSet2D.h"
+#include "Models/CommImp/ValueSetDense.h"
+#include "Models/Utils/Span.h"
+#include <map>
 
 
 namespace OpenOasis
@@ -39,6 +41,15 @@ namespace CommImp
 namespace Temporal
 {
 using Utils::real;
+using Utils::Span;
+
+/// @brief Weights of the buffered rows aggregated into a requested span, which
+/// works like the mapping matrix of `ElementMapper` in time.
+struct TemporalWeightPlan
+{
+    std::vector<int>  rows;  // Rows relative to the first overlapped one.
+    std::vector<real> weights;
+};
 
 /// @brief The TimeBuffer class provides temporal buffering functionality.
 class TimeBuffer
@@ -46,7 +57,7 @@ class TimeBuffer
 protected:
     bool mDoExtrapolate = true;
 
-    std::shared_ptr<ValueSet2D> mValues = nullptr;
+    std::shared_ptr<ValueSetDense<real>> mValues = nullptr;
 
     std::shared_ptr<TimeSet> mTimes = nullptr;
 
@@ -56,6 +67,20 @@ protected:
 
     bool mDoExtendedDataVerification = false;
 
+    // Indices found by the latest lookups, as requested times are mostly monotonic.
+    int mStartCursor = 0;
+    int mEndCursor   = 0;
+
+    // Weight plans keyed by the relative request geometry in steps, which are only
+    // reused when the buffered spans are contiguous and of the same length.
+    bool mIsUniformSpans = true;
+    real mSpanStep       = 0;
+
+    std::map<std::pair<long long, long long>, TemporalWeightPlan> mWeightPlans;
+    TemporalWeightPlan mScratchPlan;
+
+    std::vector<const real *> mScratchRows;
+
 public:
     virtual ~TimeBuffer()
     {}
@@ -93,6 +118,11 @@ public:
     /// may be found by interpolation, extrapolation and/or aggregation.
     std::vector<real> GetValues(const std::shared_ptr<ITime> &requestedTime);
 
+    /// @brief Writes the values that corresponds to the requestedTime into `values`,
+    /// which must hold `GetValuesCount()` elements, without allocating. It's left
+    /// untouched if the buffer is empty.
+    void GetValues(const std::shared_ptr<ITime> &requestedTime, Span<real> values);
+
     void SetRelaxationFactor(real value);
 
     real GetRelaxationFactor() const;
@@ -103,7 +133,7 @@ public:
 
     std::shared_ptr<TimeSet> GetTimeSet() const;
 
-    std::shared_ptr<ValueSet2D> GetValueSet() const;
+    std::shared_ptr<ValueSetDense<real>> GetValueSet() const;
 
     ///////////////////////////////////////////////////////////////////////////////////
     // Methods for getting and setting the data extension flag.
@@ -147,23 +177,48 @@ protected:
 
     /// @brief A ValueSet corresponding to a TimeSpan is calculated using interpolation
     /// or extrapolation in corresponding lists of ValueSets and TimeStamps.
-    std::vector<real>
-    MapFromTimeStampsToTimeSpan(const std::shared_ptr<ITime> &requestedTime);
+    void MapFromTimeStampsToTimeSpan(
+        const std::shared_ptr<ITime> &requestedTime, Span<real> vr);
 
     /// @brief A ValueSet for a time stamp is calculated using interpolation
     /// or extrapolation in corresponding lists of ValueSets and TimeSpans.
-    std::vector<real>
-    MapFromTimeSpansToTimeStamp(const std::shared_ptr<ITime> &requestedTimeStamp);
+    void MapFromTimeSpansToTimeStamp(
+        const std::shared_ptr<ITime> &requestedTimeStamp, Span<real> vr);
 
     /// @brief A ValueSet corresponding to a TimeSpan is calculated using interpolation
     /// or extrapolation in corresponding lists of ValueSets and TimeSpans.
-    std::vector<real>
-    MapFromTimeSpansToTimeSpan(const std::shared_ptr<ITime> &requestedTime);
+    void MapFromTimeSpansToTimeSpan(
+        const std::shared_ptr<ITime> &requestedTime, Span<real> vr);
 
     /// @brief A ValueSet corresponding to Time Stamp is calculated using interpolation
     /// or extrapolation in corresponding lists of ValueSets and TimeStamps.
-    std::vector<real>
-    MapFromTimeStampsToTimeStamp(const std::shared_ptr<ITime> &requestedTimeStamp);
+    void MapFromTimeStampsToTimeStamp(
+        const std::shared_ptr<ITime> &requestedTimeStamp, Span<real> vr);
+
+    /// @brief Finds the first buffered time whose start (or end if `byEnd`) time stamp
+    /// is not earlier than the time stamp, or the times count if there's none.
+    /// The last found index is checked first, then a binary search is used.
+    int FindTimeIndex(double timestamp, bool byEnd);
+
+    /// @brief Gets the contiguous values of all elements at the time step.
+    const real *RowAt(int timeStep) const;
+
+    /// @brief Whether the time follows the previous span contiguously with the same
+    /// length as the buffered spans.
+    bool IsUniformNext(const std::shared_ptr<ITime> &prev, const ITime &time) const;
+
+    /// @brief Checks the uniformity of the spans left after clearing, so the weight
+    /// plans are reused again once the irregular spans are cleared.
+    void RecheckUniformSpans();
+
+    /// @brief Gets the weight plan of the requested span, cached if reusable.
+    /// @param first The first buffered span overlapped by the request.
+    const TemporalWeightPlan &GetWeightPlan(int first, real trb, real tre);
+
+    void BuildWeightPlan(int first, real trb, real tre, TemporalWeightPlan &plan) const;
+
+    void
+    ApplyWeightPlan(Span<real> values, int first, const TemporalWeightPlan &plan);
 };
 
 }  // namespace Temporal
@@ -74,7 +74,7 @@ void Time::SetDurationInDays(double value)
 DateTime Time::ToDatetime(const shared_ptr<ITime> &time)
 {
     DateTime date(DateTime::Zero());
-    date.AddDays(time->GetTimeStamp() * 24.0);
+    date.AddDays(time->GetTimeStamp());
 
     return date;
 }
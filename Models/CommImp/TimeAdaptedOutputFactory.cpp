@@ -4,7 +4,9 @@
  *
  ** ***********************************************************************************/
 #include "TimeAdaptedOutputFactory.h"
+#include "SpaceAdaptedOutputFactory.h"
 #include "Models/CommImp/DevSupports/TimeAdaptor.h"
+#include "Models/CommImp/DevSupports/SpaceTimeAdaptor.h"
 #include "Models/Utils/VectorHelper.h"
 #include "Models/Utils/Exception.h"
 
@@ -54,7 +56,25 @@ TimeAdaptedOutputFactory::GetAvailableAdaptedOutputIds(
     }
 
     vector<shared_ptr<IIdentifiable>> ids;
-    ids.emplace_back(make_shared<TimeAdaptor>(adaptee->GetId()));
+    ids.emplace_back(make_shared<TimeAdaptor>(adaptee->GetId(), adaptee));
+
+    // Space-time adaptors do the mapping to the target elements along with time.
+    const auto &sourceElmtSet = adaptee->GetElementSet();
+    const auto &targetElmtSet = target ? target->GetElementSet() : nullptr;
+    if (sourceElmtSet && targetElmtSet && sourceElmtSet != targetElmtSet)
+    {
+        vector<shared_ptr<IIdentifiable>> methods;
+        SpaceAdaptedOutputFactory::GetAvailableSpaceTimeMethods(
+            methods, sourceElmtSet->GetElementType(), targetElmtSet->GetElementType());
+
+        for (const auto &method : methods)
+        {
+            auto adaptor =
+                make_shared<SpaceTimeAdaptor>(method, adaptee, targetElmtSet);
+            adaptor->SetDescription(method->GetDescription());
+            ids.emplace_back(adaptor);
+        }
+    }
 
     for (int i = 0; i < (int)ids.size(); i++)
     {
@@ -31,7 +31,7 @@ TimeSet::TimeSet(const shared_ptr<ITimeSet> &timeSet)
     mTimeHorizon = make_shared<Time>(timeSet->GetTimeHorizon());
     for (const auto &time : timeSet->GetTimes())
     {
-        mTimes.emplace_back(make_shared<Time>(time));
+        mTimes.PushBack(make_shared<Time>(time));
     }
 }
 
@@ -48,17 +48,17 @@ TimeSet::TimeSet(const vector<shared_ptr<ITime>> &times, double hourOffset)
     mOffsetFromUtcInHours = hourOffset;
     mTimes                = times;
 
-    Sort();
-    SetTimeHorizonFromTimes();
-
     mHasDuration = all_of(begin(times), end(times), [](const auto &time) {
         return time->GetDurationInDays() > Time::EpsilonForTimeCompare;
     });
+
+    Sort();
+    SetTimeHorizonFromTimes();
 }
 
 vector<shared_ptr<ITime>> TimeSet::GetTimes() const
 {
-    return mTimes;
+    return mTimes.ToVector();
 }
 
 bool TimeSet::HasDurations() const
@@ -83,51 +83,68 @@ void TimeSet::AddTime(shared_ptr<ITime> time)
         return;
     }
 
-    auto isOverlapped = any_of(begin(mTimes), end(mTimes), [&time](const auto &t) {
-        return abs(t->GetTimeStamp() - time->GetTimeStamp())
-               <= Time::EpsilonForTimeCompare;
-    });
-    if (isOverlapped)
+    // Binary searches the position, which is the back mostly.
+    double timestamp = time->GetTimeStamp();
+    size_t first = 0, last = mTimes.GetSize();
+    while (first < last)
+    {
+        size_t mid = first + (last - first) / 2;
+        if (mTimes[mid]->GetTimeStamp() < timestamp)
+            first = mid + 1;
+        else
+            last = mid;
+    }
+
+    // Only the neighbours may overlap with the time, as the times are sorted.
+    auto isOverlapped = [&](size_t index) {
+        return index < mTimes.GetSize()
+               && abs(mTimes[index]->GetTimeStamp() - timestamp)
+                      <= Time::EpsilonForTimeCompare;
+    };
+    if (isOverlapped(first) || (first > 0 && isOverlapped(first - 1)))
     {
         return;
     }
 
     mHasDuration = HasDuration(time);
-    mTimes.push_back(time);
+    mTimes.Insert(first, time);
 
-    Sort();
     SetTimeHorizonFromTimes();
 }
 
 void TimeSet::RemoveTime(int index)
 {
-    if (index < 0 || index >= (int)mTimes.size())
+    if (index < 0 || index >= (int)mTimes.GetSize())
     {
         throw IllegalArgumentException(StringHelper::FormatSimple(
-            "Index [{}] of time to remove out of range [{}] .", index, mTimes.size()));
+            "Index [{}] of time to remove out of range [{}] .",
+            index,
+            mTimes.GetSize()));
     }
 
-    mTimes.erase(mTimes.begin() + index);
+    mTimes.Erase(index);
     SetTimeHorizonFromTimes();
 }
 
 void TimeSet::Sort()
 {
     auto comp = [](const shared_ptr<ITime> &t1, const shared_ptr<ITime> &t2) {
-        return t1->GetTimeStamp() <= t2->GetTimeStamp();
+        return t1->GetTimeStamp() < t2->GetTimeStamp();
     };
 
-    sort(begin(mTimes), end(mTimes), comp);
+    auto times = mTimes.ToVector();
+    stable_sort(begin(times), end(times), comp);
+    mTimes = RingBuffer<shared_ptr<ITime>>(times);
 }
 
 void TimeSet::RemoveTimeRange(int index, int count)
 {
-    if (!mTimes.empty())
+    if (!mTimes.IsEmpty())
     {
-        index      = min(max(index, 0), (int)mTimes.size());
-        count      = max(count, 0);
-        size_t end = min(index + count, (int)mTimes.size());
-        mTimes.erase(mTimes.begin() + index, mTimes.begin() + end);
+        index = min(max(index, 0), (int)mTimes.GetSize());
+        count = max(count, 0);
+        mTimes.Erase(index, count);
+        SetTimeHorizonFromTimes();
     }
 }
 
@@ -138,36 +155,36 @@ bool TimeSet::HasDuration(const shared_ptr<ITime> &time) const
 
 void TimeSet::Reset()
 {
-    mTimes                = {};
+    mTimes.Clear();
     mTimeHorizon          = make_shared<Time>();
     mOffsetFromUtcInHours = 8.;
 }
 
 shared_ptr<ITime> &TimeSet::operator[](int timeIndex)
 {
-    return mTimes.at(timeIndex);
+    return mTimes.At(timeIndex);
 }
 
 int TimeSet::GetCount() const
 {
-    return mTimes.size();
+    return mTimes.GetSize();
 }
 
 void TimeSet::SetTimeHorizonFromTimes()
 {
-    if (mTimes.empty())
+    if (mTimes.IsEmpty())
     {
         mTimeHorizon = make_shared<Time>();
         return;
     }
 
-    const auto &front = mTimes.front();
-    const auto &back  = mTimes.back();
+    const auto &front = mTimes.Front();
+    const auto &back  = mTimes.Back();
 
     auto end = back;
     if (mHasDuration)  // update the last time point with its duration.
     {
-        end = make_shared<Time>(Time::ToDatetime(back), back->GetDurationInDays());
+        end = make_shared<Time>(back->GetTimeStamp() + back->GetDurationInDays(), 0.);
     }
 
     mTimeHorizon = make_shared<Time>(front, end);
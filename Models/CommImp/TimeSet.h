@@ -10,6 +10,7 @@
 #pragma once
 #include "Models/Inc/ITimeSet.h"
 #include "Models/Inc/ITime.h"
+#include "Models/Utils/RingBuffer.h"
 
 
 namespace OpenOasis
@@ -20,7 +21,8 @@ namespace CommImp
 class TimeSet : public ITimeSet
 {
 protected:
-    std::vector<std::shared_ptr<ITime>> mTimes;  // Sorted time stamps or time spans.
+    // Sorted time stamps or time spans, expired from the front in O(1).
+    Utils::RingBuffer<std::shared_ptr<ITime>> mTimes;
 
     // An instance of `ITime` with duration indicated total time span in mTimes.
     std::shared_ptr<ITime> mTimeHorizon;
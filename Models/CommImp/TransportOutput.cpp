@@ -0,0 +1,105 @@
+/** ***********************************************************************************
+ *    @File      :  TransportOutput.cpp
+ *    @Brief     :  To provide an output receiving values from another rank.
+ *
+ ** ***********************************************************************************/
+#include "TransportOutput.h"
+#include "TimeSet.h"
+#include "Time.h"
+#include "ValueSetDense.h"
+#include "DevSupports/ExchangeItemHelper.h"
+#include "DevSupports/ExtensionMethods.h"
+#include "Models/Utils/CommConstants.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/StringHelper.h"
+#include <limits>
+
+
+namespace OpenOasis::CommImp
+{
+using namespace DevSupports;
+using namespace Utils;
+using namespace std;
+
+
+TransportOutput::TransportOutput(
+    const string &id, const shared_ptr<ILinkableComponent> &comp,
+    const shared_ptr<IQuantity> &quantity, const shared_ptr<IElementSet> &elementSet,
+    const shared_ptr<Transport> &transport, const string &channel) :
+    Output(id, comp),
+    mTransport(transport), mChannel(channel)
+{
+    if (!quantity || !transport)
+    {
+        throw IllegalArgumentException(StringHelper::FormatSimple(
+            "Output [{}] requires a quantity and a transport.", id));
+    }
+
+    mElementSet = elementSet;
+    mTimeSet    = make_shared<TimeSet>();
+    mValues     = make_shared<ValueSetDense<real>>(quantity);
+}
+
+string TransportOutput::GetChannel() const
+{
+    return mChannel;
+}
+
+bool TransportOutput::IsEnded() const
+{
+    return mEnded;
+}
+
+void TransportOutput::Reset()
+{
+    Output::Reset();
+    mTransport.reset();
+}
+
+void TransportOutput::Update()
+{
+    const auto &latestTime = ExchangeItemHelper::GetLatestConsumerTime(GetInstance());
+    if (!latestTime)
+    {
+        RefreshAdaptedOutputs();
+        return;
+    }
+
+    double queryTimestamp = latestTime->GetTimeStamp();
+    auto   available      = [this]() {
+        const auto &times = mTimeSet->GetTimes();
+        if (times.empty())
+        {
+            return numeric_limits<double>::lowest();
+        }
+        return ExtensionMethods::EndTimeStamp(times.back());
+    };
+
+    // Receives the published steps until the query is covered or the producer ends.
+    ValuePacket packet;
+    while (!mEnded && available() < queryTimestamp
+           && mTransport->Receive(mChannel, packet))
+    {
+        if (packet.ended)
+        {
+            mEnded = true;
+            break;
+        }
+
+        AppendPacket(packet);
+    }
+
+    RefreshAdaptedOutputs();
+}
+
+void TransportOutput::AppendPacket(const ValuePacket &packet)
+{
+    vector<real> values(packet.values.begin(), packet.values.end());
+    dynamic_pointer_cast<ValueSetDense<real>>(mValues)->AddElementValuesForTime(values);
+
+    mTimeSet->AddTime(make_shared<Time>(packet.time, packet.duration));
+
+    BroadcastEventWithMsg("Values received from transport");
+}
+
+}  // namespace OpenOasis::CommImp
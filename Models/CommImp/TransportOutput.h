@@ -0,0 +1,75 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  TransportOutput.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To provide an output receiving values from another rank.
+ *
+ *    The transport output stands in for an output of a producer component placed
+ *    on another rank, whose values are published by a `TransportPublisher`. The
+ *    value definition and element set of the remote output are given locally, only
+ *    the values are moved, as packed buffers.
+ *
+ *    When requested, the output receives the published time steps until the latest
+ *    consumer time is covered, waiting if they haven't arrived yet, or until the
+ *    producer ends.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Output.h"
+#include "DevSupports/Transport.h"
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+/// @brief Output item receiving the values of a remote output through a transport.
+class TransportOutput : public Output
+{
+private:
+    std::shared_ptr<DevSupports::Transport> mTransport;
+    std::string                             mChannel;
+    bool                                    mEnded = false;
+
+public:
+    virtual ~TransportOutput() = default;
+
+    /// @brief Creates the transport output.
+    ///
+    /// @param id Id of the output.
+    /// @param comp Local component the output is attached to, e.g. the consumer.
+    /// @param quantity Value definition of the remote output.
+    /// @param elementSet Element set of the remote output.
+    /// @param transport Transport receiving the values.
+    /// @param channel Channel the remote output is published on.
+    TransportOutput(
+        const std::string &id, const std::shared_ptr<ILinkableComponent> &comp,
+        const std::shared_ptr<IQuantity>                &quantity,
+        const std::shared_ptr<IElementSet>              &elementSet,
+        const std::shared_ptr<DevSupports::Transport>   &transport,
+        const std::string                               &channel);
+
+    std::string GetChannel() const;
+
+    /// @brief Whether the remote producer has ended.
+    bool IsEnded() const;
+
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Override methods inherited from `Output`.
+    //
+
+    virtual void Reset() override;
+
+protected:
+    /// @brief Receives the published time steps until the latest consumer time is
+    /// covered, instead of updating the component.
+    virtual void Update() override;
+
+private:
+    void AppendPacket(const DevSupports::ValuePacket &packet);
+};
+
+}  // namespace CommImp
+}  // namespace OpenOasis
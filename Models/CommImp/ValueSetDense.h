@@ -0,0 +1,454 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  ValueSetDense.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To represent a dense two-dimensional list of typed values.
+ *
+ *    Unlike `ValueSet2D` holding a `std::any` per value, the dense value set keeps
+ *    all values in one row-major (time x element) buffer of type `T`, and all times
+ *    have the same number of elements. The typed methods, e.g. `Get()` and
+ *    `GetElementValuesForTimeSpan()`, access the buffer directly, while the methods
+ *    of `IValueSet` are kept for compatibility, boxing and unboxing the values.
+ *
+ *    The rows are kept in a ring, so the expired earliest times are removed in O(1)
+ *    and the buffer is reused by the later times without reallocation.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "Models/Inc/IValueSet.h"
+#include "Models/Inc/IQuantity.h"
+#include "Models/Utils/CommConstants.h"
+#include "Models/Utils/Exception.h"
+#include "Models/Utils/Span.h"
+#include "Models/Utils/StringHelper.h"
+#include <algorithm>
+
+
+namespace OpenOasis
+{
+namespace CommImp
+{
+using namespace Utils;
+
+/// @brief Implementation of `IValueSet` in two dimension with contiguous storage.
+template <typename T>
+class ValueSetDense : public IValueSet
+{
+protected:
+    std::vector<T> mValues;  // Row-major values, i.e., time by time.
+    int            mTimes    = 0;
+    int            mElements = 0;
+    int            mCapacity = 0;  // Number of rows of the buffer.
+    int            mHead     = 0;  // Row of the earliest time.
+
+    std::shared_ptr<IValueDefinition> mValueDef;
+
+public:
+    virtual ~ValueSetDense() = default;
+
+    ValueSetDense(
+        const std::shared_ptr<IValueDefinition> &valueDef = nullptr, int times = 0,
+        int elements = 0) :
+        mValues((size_t)times * elements), mTimes(times), mElements(elements),
+        mCapacity(times), mValueDef(valueDef)
+    {
+        if (times < 0 || elements < 0)
+        {
+            throw IllegalArgumentException("Negative times or elements of value set.");
+        }
+    }
+
+    ValueSetDense(
+        const std::vector<std::vector<T>>       &values2D,
+        const std::shared_ptr<IValueDefinition> &valueDef) :
+        mValueDef(valueDef)
+    {
+        if (!values2D.empty())
+        {
+            mElements = (int)values2D.front().size();
+            Reserve((int)values2D.size());
+        }
+
+        for (const auto &values : values2D)
+        {
+            AddElementValuesForTime(values);
+        }
+    }
+
+    /// @brief Copies the values of the value set, which must be of type `T`.
+    ValueSetDense(const std::shared_ptr<IValueSet> &valueSet) :
+        mValueDef(valueSet->GetValueDefinition())
+    {
+        if (auto dense = std::dynamic_pointer_cast<ValueSetDense<T>>(valueSet))
+        {
+            mValues   = dense->mValues;
+            mTimes    = dense->mTimes;
+            mElements = dense->mElements;
+            mCapacity = dense->mCapacity;
+            mHead     = dense->mHead;
+            return;
+        }
+
+        int times = valueSet->GetIndexCount({0});
+        for (int t = 0; t < times; t++)
+        {
+            std::vector<T> values;
+            for (const auto &value : valueSet->GetElementValuesForTime(t))
+            {
+                values.push_back(std::any_cast<T>(value));
+            }
+
+            AddElementValuesForTime(values);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Typed methods accessing the contiguous values.
+    //
+
+    int GetTimesCount() const
+    {
+        return mTimes;
+    }
+
+    int GetElementsCount() const
+    {
+        return mElements;
+    }
+
+    void SetValueDefinition(const std::shared_ptr<IValueDefinition> &value)
+    {
+        mValueDef = value;
+    }
+
+    T Get(int timeIndex, int elementIndex) const
+    {
+        return mValues[Offset(timeIndex, elementIndex)];
+    }
+
+    void Set(int timeIndex, int elementIndex, T value)
+    {
+        mValues[Offset(timeIndex, elementIndex)] = value;
+    }
+
+    Span<const T> GetElementValuesForTimeSpan(int timeIndex) const
+    {
+        CheckTimeIndex(timeIndex);
+        return Span<const T>(mValues.data() + RowOffset(timeIndex), mElements);
+    }
+
+    Span<T> GetElementValuesForTimeSpan(int timeIndex)
+    {
+        CheckTimeIndex(timeIndex);
+        return Span<T>(mValues.data() + RowOffset(timeIndex), mElements);
+    }
+
+    /// @brief Sets the values of all elements at the time.
+    void SetElementValuesForTime(int timeIndex, Span<const T> values)
+    {
+        CheckTimeIndex(timeIndex);
+        CheckElementsCount(values.size());
+        std::copy(values.begin(), values.end(), mValues.begin() + RowOffset(timeIndex));
+    }
+
+    /// @brief Appends the values of all elements at a new time, the first time
+    /// determines the number of elements.
+    void AddElementValuesForTime(Span<const T> values)
+    {
+        if (mTimes == 0 && mElements != (int)values.size())
+        {
+            Relayout(mCapacity, (int)values.size());
+        }
+
+        CheckElementsCount(values.size());
+        AddTime();
+        auto first = mValues.begin() + RowOffset(mTimes - 1);
+        std::copy(values.begin(), values.end(), first);
+    }
+
+    /// @brief Reserves the buffer for the times, avoiding reallocations when the
+    /// times slide over a window no longer than it.
+    void Reserve(int times)
+    {
+        if (times > mCapacity)
+        {
+            Relayout(times, mElements);
+        }
+    }
+
+    /// @brief Removes the values of the earliest times in O(1).
+    void RemoveTimesBefore(int timeIndex)
+    {
+        timeIndex = std::clamp(timeIndex, 0, mTimes);
+        mTimes -= timeIndex;
+        mHead = mTimes == 0 ? 0 : (mHead + timeIndex) % mCapacity;
+    }
+
+    /// @brief Removes the values of the time and the later times.
+    void RemoveTimesFrom(int timeIndex)
+    {
+        mTimes = std::clamp(timeIndex, 0, mTimes);
+        mHead  = mTimes == 0 ? 0 : mHead;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Implement methods inherited from `IValueSet`.
+    //
+
+    std::shared_ptr<IValueDefinition> GetValueDefinition() const override
+    {
+        return mValueDef;
+    }
+
+    int GetNumberOfIndices() const override
+    {
+        // Two-dimensional valueset.
+        return 2;
+    }
+
+    int GetIndexCount(const std::vector<int> &indices) const override
+    {
+        if (indices.empty() || indices.size() > 2)
+        {
+            throw ArgumentOutOfRangeException(
+                "The given indices were out of the value set dimensions(2).");
+        }
+
+        if (indices.size() == 1)
+        {
+            return mTimes;
+        }
+
+        CheckTimeIndex(indices[0]);
+        return mElements;
+    }
+
+    std::any GetValue(const std::vector<int> &indices) const override
+    {
+        CheckAllDimensionSpecified(indices);
+        return Get(indices[0], indices[1]);
+    }
+
+    /// @brief Sets the value, a new time is appended if the time index equals the
+    /// times count, and the elements are extended if the element index exceeds.
+    void SetOrAddValue(const std::vector<int> &indices, const std::any &value) override
+    {
+        CheckAllDimensionSpecified(indices);
+
+        int tIndex = indices[0], eIndex = indices[1];
+        if (tIndex < 0 || eIndex < 0)
+        {
+            throw IllegalArgumentException("Negative time or element index.");
+        }
+
+        if (tIndex > mTimes)
+        {
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "Time index [{}] far exceed valueset time range [{}] .",
+                tIndex,
+                mTimes));
+        }
+
+        T typedValue = Unbox(value);
+        if (eIndex >= mElements)
+        {
+            Resize(mTimes, eIndex + 1);
+        }
+
+        if (tIndex == mTimes)
+        {
+            Resize(mTimes + 1, mElements);
+        }
+
+        mValues[Offset(tIndex, eIndex)] = typedValue;
+    }
+
+    /// @brief Removes the values of a time, removing an element is not supported.
+    void RemoveValue(const std::vector<int> &indices) override
+    {
+        if (indices.size() != 1)
+        {
+            throw NotSupportedException(
+                "Only the values of a time can be removed from the dense value set.");
+        }
+
+        CheckTimeIndex(indices[0]);
+
+        // The earliest time is the common case, removed by moving the head only.
+        if (indices[0] == 0)
+        {
+            RemoveTimesBefore(1);
+            return;
+        }
+
+        for (int t = indices[0]; t + 1 < mTimes; t++)
+        {
+            auto next = mValues.begin() + RowOffset(t + 1);
+            std::copy(next, next + mElements, mValues.begin() + RowOffset(t));
+        }
+
+        mTimes--;
+    }
+
+    bool IsValues2D() const override
+    {
+        return true;
+    }
+
+    std::vector<std::any> GetTimeSeriesValuesForElement(int elementIndex) const override
+    {
+        std::vector<std::any> values;
+        for (int t = 0; t < mTimes; t++)
+        {
+            values.emplace_back(Get(t, elementIndex));
+        }
+
+        return values;
+    }
+
+    void SetTimeSeriesValuesForElement(
+        int elementIndex, const std::vector<std::any> &values) override
+    {
+        if ((int)values.size() != mTimes)
+        {
+            throw IllegalArgumentException(
+                "Invalid timeseries values length out of current valueset.");
+        }
+
+        for (int t = 0; t < mTimes; t++)
+        {
+            Set(t, elementIndex, Unbox(values[t]));
+        }
+    }
+
+    std::vector<std::any> GetElementValuesForTime(int timeIndex) const override
+    {
+        auto values = GetElementValuesForTimeSpan(timeIndex);
+        return std::vector<std::any>(values.begin(), values.end());
+    }
+
+    void SetElementValuesForTime(
+        int timeIndex, const std::vector<std::any> &values) override
+    {
+        CheckTimeIndex(timeIndex);
+        CheckElementsCount(values.size());
+
+        auto target = GetElementValuesForTimeSpan(timeIndex);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            target[i] = Unbox(values[i]);
+        }
+    }
+
+protected:
+    size_t RowOffset(int timeIndex) const
+    {
+        return (size_t)((mHead + timeIndex) % mCapacity) * mElements;
+    }
+
+    size_t Offset(int timeIndex, int elementIndex) const
+    {
+        CheckTimeIndex(timeIndex);
+
+        if (elementIndex < 0 || elementIndex >= mElements)
+        {
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "Invalid elementindex ({}), only {} elements available.",
+                elementIndex,
+                mElements));
+        }
+
+        return RowOffset(timeIndex) + elementIndex;
+    }
+
+    /// @brief Extends the times and elements, the new values are default.
+    void Resize(int times, int elements)
+    {
+        if (elements != mElements)
+        {
+            Relayout(std::max(mCapacity, times), elements);
+        }
+
+        while (mTimes < times)
+        {
+            AddTime();
+            auto first = mValues.begin() + RowOffset(mTimes - 1);
+            std::fill(first, first + mElements, T());
+        }
+    }
+
+    /// @brief Appends a time row, doubling the buffer if it is full.
+    void AddTime()
+    {
+        if (mTimes == mCapacity)
+        {
+            Relayout(std::max(mCapacity * 2, 8), mElements);
+        }
+
+        mTimes++;
+    }
+
+    /// @brief Copies the times to a new buffer with the head at the first row.
+    void Relayout(int capacity, int elements)
+    {
+        std::vector<T> values((size_t)capacity * elements);
+        int            width = std::min(elements, mElements);
+        for (int t = 0; t < mTimes; t++)
+        {
+            auto first = mValues.begin() + RowOffset(t);
+            std::copy(first, first + width, values.begin() + (size_t)t * elements);
+        }
+
+        mValues.swap(values);
+        mCapacity = capacity;
+        mElements = elements;
+        mHead     = 0;
+    }
+
+    T Unbox(const std::any &value) const
+    {
+        if (value.type() != typeid(T))
+        {
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "The set value type [{}] doesn't match the valueset [{}] .",
+                value.type().name(),
+                typeid(T).name()));
+        }
+
+        return std::any_cast<T>(value);
+    }
+
+    void CheckAllDimensionSpecified(const std::vector<int> &indices) const
+    {
+        if (indices.size() != 2)
+        {
+            throw ArgumentOutOfRangeException(
+                "Invalid indices exceeded or omitted the value set dimensions(2).");
+        }
+    }
+
+    void CheckTimeIndex(int timeIndex) const
+    {
+        if (timeIndex < 0 || timeIndex >= mTimes)
+        {
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "Invalid timeindex ({}), only {} times available.", timeIndex, mTimes));
+        }
+    }
+
+    void CheckElementsCount(size_t count) const
+    {
+        if ((int)count != mElements)
+        {
+            throw IllegalArgumentException(StringHelper::FormatSimple(
+                "Invalid elements values length [{}] out of current valueset [{}].",
+                count,
+                mElements));
+        }
+    }
+};
+
+}  // namespace CommImp
+}  // namespace OpenOasis
@@ -7,8 +7,16 @@
  *    @Desc      :  OpenOasis component launcher.
  *
  ** ***********************************************************************************/
-// #include "Models/CommImp/DevSupports/IterationController.h"
+#include "Models/CommImp/AsyncOutput.h"
+#include "Models/CommImp/DevSupports/ComponentScheduler.h"
+#include "Models/CommImp/DevSupports/CouplingStepController.h"
+#include "Models/CommImp/DevSupports/ElementMapper.h"
+#include "Models/CommImp/DevSupports/IterationController.h"
+#include "Models/CommImp/DevSupports/RemoteComponent.h"
+#include "Models/CommImp/DevSupports/TimeWindowExecutor.h"
+#include "Models/CommImp/DevSupports/TransportPublisher.h"
 #include "Models/CommImp/LinkableComponent.h"
+#include "Models/CommImp/TransportOutput.h"
 #include "Models/CommImp/IO/LinkLoader.h"
 #include "Models/Utils/Logger.h"
 #include "Models/wrappers/OasisFlows.h"
@@ -18,6 +26,7 @@
 #include <iostream>
 #include <thread>
 #include <iomanip>
+#include <set>
 
 
 using namespace OpenOasis;
@@ -39,6 +48,21 @@ int main(int argc, const char *argv[])
     // Add optional arguments.
     args::ValueFlag<string> logLevel(
         parser, "", "Log level (debug, info, warn, err)", {"log"});
+    args::ValueFlag<int> numThreads(
+        parser, "", "Number of threads to run components (default: all cores)",
+        {"threads"});
+    args::ValueFlag<double> windowSeconds(
+        parser, "", "Lock-step time window in seconds (default: none)", {"window"});
+    args::ValueFlag<int> lookaheadSteps(
+        parser, "", "Maximum internal steps of a component past a window",
+        {"lookahead"});
+    args::Flag isolate(
+        parser, "", "Run each component in a child process", {"isolate"});
+    args::ValueFlag<int> rankFlag(
+        parser, "", "Rank of this process in a distributed coupling", {"rank"});
+    args::ValueFlag<string> mapCacheDir(
+        parser, "", "Directory to cache the element mapping matrices between runs",
+        {"map-cache"});
 
     // Parse command line arguments.
     try
@@ -52,6 +76,13 @@ int main(int argc, const char *argv[])
         return 1;
     }
 
+    // Isolated components are updated by their processes, not window by window.
+    if (windowSeconds && isolate)
+    {
+        cerr << "Lock-step windows are not supported for isolated components." << endl;
+        return 1;
+    }
+
     // Set log level.
     string logLevelStr = "info";
     if (logLevel)
@@ -81,12 +112,57 @@ int main(int argc, const char *argv[])
     linkLoader.Load();
     spdlog::info("Link configuration loaded.");
 
+    if (windowSeconds)
+    {
+        auto compIds = linkLoader.GetComponentIds();
+        auto isolated =
+            find_if(compIds.begin(), compIds.end(), [&linkLoader](const auto &id) {
+                return linkLoader.IsComponentIsolated(id);
+            });
+        if (isolated != compIds.end())
+        {
+            spdlog::error(
+                "Lock-step windows are not supported for isolated component {}.",
+                *isolated);
+            return 1;
+        }
+    }
+
+    // Reuse the mapping matrices of unchanged element sets from the previous runs.
+    if (mapCacheDir)
+    {
+        DevSupports::ElementMapper::SetCacheDirectory(mapCacheDir.Get());
+        spdlog::info("Mapping matrices cached in: {}", mapCacheDir.Get());
+    }
+
+    // Connect the ranks of a distributed coupling.
+    int  rank  = rankFlag ? rankFlag.Get() : 0;
+    auto hosts = linkLoader.GetRankHosts();
+
+    shared_ptr<DevSupports::Transport> transport;
+    if (!hosts.empty())
+    {
+        try
+        {
+            transport = make_shared<DevSupports::TcpTransport>(rank, hosts);
+        }
+        catch (const exception &e)
+        {
+            spdlog::error("Failed to connect rank {}: {}", rank, e.what());
+            return 1;
+        }
+
+        spdlog::info("Rank {} of {} connected.", rank, hosts.size());
+    }
+
     // Init library loader.
     LibraryLoader libLoader;
 
     // Load components.
     unordered_map<string, ILinkableComponent *> components;
 
+    vector<shared_ptr<DevSupports::RemoteComponent>> remotes;
+
     auto compIds = linkLoader.GetComponentIds();
     for (auto compId : compIds)
     {
@@ -95,6 +171,35 @@ int main(int argc, const char *argv[])
         auto taskFile = compInfo[1];
         auto dllPath  = compInfo[2];
 
+        // Components placed on other ranks are loaded by their own processes.
+        if (transport && linkLoader.GetComponentRank(compId) != rank)
+        {
+            continue;
+        }
+
+        // Run the component in a child process, loading the dll/so there.
+        if (isolate || linkLoader.IsComponentIsolated(compId))
+        {
+            try
+            {
+                auto cpus = linkLoader.GetComponentCpus(compId);
+                remotes.push_back(make_shared<DevSupports::RemoteComponent>(
+                    compId, type, taskFile, dllPath, cpus));
+            }
+            catch (const exception &e)
+            {
+                spdlog::error("Failed to start component {}: {}", compId, e.what());
+                return 1;
+            }
+
+            components[compId] = remotes.back().get();
+            spdlog::info(
+                "Component {} started in process {}",
+                compId,
+                remotes.back()->GetProcessId());
+            continue;
+        }
+
         if (!libLoader.Load(dllPath))
         {
             spdlog::error("Failed to load dll/so from {}", dllPath);
@@ -141,6 +246,15 @@ int main(int argc, const char *argv[])
         auto compPtr = comp.second;
         auto args    = compPtr->GetArguments();
 
+        // Exchange items of remote components are set up in their processes.
+        if (dynamic_cast<DevSupports::RemoteComponent *>(compPtr))
+        {
+            compPtr->Initialize();
+            compPtr->Validate();
+            spdlog::info("Component {} initialized.", compId);
+            continue;
+        }
+
         // Prepare inputs.
         auto inputs     = *(find_if(begin(args), end(args), [](const auto &it) {
             return it->GetId() == "INPUTTERS";
@@ -189,40 +303,421 @@ int main(int argc, const char *argv[])
         spdlog::info("Component {} initialized.", compId);
     }
 
-    // // Link components (uncomplete).
-    // for (auto comp : components)
-    // {
-    //     auto srcCompId  = comp.first;
-    //     auto inputInfos = linkLoader.GetComponentInputs(srcCompId);
-    //     for (auto inputInfo : inputInfos)
-    //     {
-    //         auto consumers = linkLoader.GetOutputConsumers(srcCompId, inputInfo);
-    //         for (auto consumer : consumers)
-    //         {
-    //             auto dstCompId = consumer.first;
-    //         }
-    //     }
-    // }
-
-    // Run components separately.
+    // Adapt the coupling intervals of consumers configured.
     for (auto comp : components)
     {
-        auto compPtr = comp.second;
-        compPtr->Prepare();
+        auto confs    = linkLoader.GetCouplingConfigs(comp.first);
+        auto linkable = dynamic_cast<LinkableComponent *>(comp.second);
+        if (confs.empty() || !linkable)
+        {
+            continue;
+        }
+
+        auto getConf = [&confs](const string &key, double defaultValue) {
+            return confs.count(key) ? StringHelper::FromString<double>(confs[key]) :
+                                      defaultValue;
+        };
+
+        double minInterval = getConf("min_coupling_interval", 60.);
+        double maxInterval = getConf("max_coupling_interval", minInterval);
+        double tolerance   = getConf("coupling_tolerance", 0.01);
+
+        linkable->SetCouplingStepController(
+            make_shared<DevSupports::CouplingStepController>(
+                minInterval / 86400., maxInterval / 86400., tolerance));
+        spdlog::info(
+            "Component {} couples adaptively in [{}s, {}s].",
+            comp.first,
+            minInterval,
+            maxInterval);
+    }
+
+    // Link the inputs of local components to the outputs of their providers.
+    auto findItem = [](const auto &items, const string &id) {
+        auto iter = find_if(items.begin(), items.end(), [&id](const auto &item) {
+            return item->GetId() == id;
+        });
+        return iter != items.end() ? *iter : nullptr;
+    };
+
+    // Outputs exchanged asynchronously are wrapped, and drive their components.
+    unordered_map<string, shared_ptr<AsyncOutput>> asyncOutputs;
+    set<string>                                    asyncComps;
+
+    // Outputs on other ranks are received by the transport outputs, one per channel
+    // shared by all consumers on this rank, which only refer to them weakly.
+    unordered_map<string, shared_ptr<TransportOutput>> transportOutputs;
+    for (auto comp : components)
+    {
+        // Inputs of remote components are added with the quantity and elements of
+        // their first provider, and checked on preparing.
+        auto remoteComp = dynamic_cast<DevSupports::RemoteComponent *>(comp.second);
+        for (const auto &inputInfo : linkLoader.GetComponentInputs(comp.first))
+        {
+            auto input = findItem(comp.second->GetInputs(), inputInfo[0]);
+            if (!input && !remoteComp)
+            {
+                spdlog::error(
+                    "Input {} of component {} not found.", inputInfo[0], comp.first);
+                return 1;
+            }
+
+            for (const auto &provider :
+                 linkLoader.GetInputProviders(comp.first, inputInfo))
+            {
+                // Providers on other ranks are linked through the transport, the
+                // values are received with the quantity and elements of the input.
+                if (!components.count(provider.first))
+                {
+                    if (remoteComp)
+                    {
+                        spdlog::error(
+                            "Inputs of isolated component {} can't be linked across "
+                            "ranks.",
+                            comp.first);
+                        return 1;
+                    }
+
+                    for (const auto &outputInfo : provider.second)
+                    {
+                        auto channel = DevSupports::Transport::GetChannel(
+                            provider.first, outputInfo[0]);
+                        try
+                        {
+                            auto &output = transportOutputs[channel];
+                            if (!output)
+                            {
+                                output = make_shared<TransportOutput>(
+                                    channel,
+                                    input->GetComponent().lock(),
+                                    dynamic_pointer_cast<IQuantity>(
+                                        input->GetValueDefinition()),
+                                    input->GetElementSet(),
+                                    transport,
+                                    channel);
+                            }
+                            output->AddConsumer(input);
+                        }
+                        catch (const exception &e)
+                        {
+                            spdlog::error(
+                                "Failed to link output {} of component {}: {}",
+                                outputInfo[0],
+                                provider.first,
+                                e.what());
+                            return 1;
+                        }
+                    }
+                    continue;
+                }
+
+                auto providerComp = components.at(provider.first);
+                for (const auto &outputInfo : provider.second)
+                {
+                    auto output = findItem(providerComp->GetOutputs(), outputInfo[0]);
+
+                    // Outputs of remote components are added with the quantity and
+                    // elements of the input, and checked on preparing. Between two
+                    // remote components, neither definition is known locally.
+                    auto remote =
+                        dynamic_cast<DevSupports::RemoteComponent *>(providerComp);
+                    if (!output && remote)
+                    {
+                        auto quantity =
+                            input ? dynamic_pointer_cast<IQuantity>(
+                                input->GetValueDefinition()) :
+                                    DevSupports::RemoteComponent::CreateOpaqueQuantity(
+                                        outputInfo[0]);
+                        output = remote->AddOutput(
+                            outputInfo[0],
+                            quantity,
+                            input ? input->GetElementSet() : nullptr);
+                    }
+
+                    if (!output)
+                    {
+                        spdlog::error(
+                            "Output {} of component {} not found.",
+                            outputInfo[0],
+                            provider.first);
+                        return 1;
+                    }
+
+                    if (!input)
+                    {
+                        auto valueDef = output->GetValueDefinition();
+                        input         = remoteComp->AddInput(
+                            inputInfo[0],
+                            dynamic_pointer_cast<IQuantity>(valueDef),
+                            output->GetElementSet());
+                    }
+
+                    int bufferSize =
+                        linkLoader.GetAsyncBufferSize(provider.first, outputInfo);
+                    if (bufferSize > 0)
+                    {
+                        auto &asyncOutput = asyncOutputs[provider.first];
+                        if (!asyncOutput)
+                        {
+                            asyncOutput = make_shared<AsyncOutput>(
+                                output->GetId(), output, bufferSize);
+                        }
+
+                        asyncComps.insert(provider.first);
+                        output = asyncOutput;
+                    }
+
+                    output->AddConsumer(input);
+                }
+            }
+        }
+
+        spdlog::info("Component {} linked.", comp.first);
+    }
+
+    // Publish the outputs consumed on other ranks, the values are received by the
+    // transport outputs of the consumers.
+    DevSupports::TransportPublisher publisher(transport);
+    for (auto comp : components)
+    {
+        if (!transport)
+        {
+            continue;
+        }
+
+        bool isRemote  = dynamic_cast<DevSupports::RemoteComponent *>(comp.second);
+        bool published = false;
+        for (const auto &outputInfo : linkLoader.GetComponentOutputs(comp.first))
+        {
+            auto consumers = linkLoader.GetOutputConsumers(comp.first, outputInfo);
+            for (const auto &consumer : consumers)
+            {
+                int consumerRank = linkLoader.GetComponentRank(consumer.first);
+                if (consumerRank == rank)
+                {
+                    continue;
+                }
+
+                // Remote components don't notify updates to the publisher.
+                if (isRemote)
+                {
+                    spdlog::error(
+                        "Outputs of isolated component {} can't be published.",
+                        comp.first);
+                    return 1;
+                }
+
+                for (const auto &output : comp.second->GetOutputs())
+                {
+                    if (output->GetId() == outputInfo[0])
+                    {
+                        publisher.AddRoute(output, consumerRank);
+                        published = true;
+                    }
+                }
+            }
+        }
+
+        if (published)
+        {
+            publisher.Attach(*comp.second);
+            spdlog::info("Component {} publishes to other ranks.", comp.first);
+        }
+    }
+
+    // Loop groups are taken over by iteration controllers.
+    vector<shared_ptr<DevSupports::IterationController>> controllers;
+    unordered_map<string, string>                         owners;
+    for (const auto &group : linkLoader.GetIteratorGroups())
+    {
+        auto isLocal = [&components](const string &compId) {
+            return components.count(compId) > 0;
+        };
+        if (none_of(group.second.begin(), group.second.end(), isLocal))
+        {
+            continue;
+        }
+        else if (!all_of(group.second.begin(), group.second.end(), isLocal))
+        {
+            spdlog::error("Loop group {} can't span several ranks.", group.first);
+            return 1;
+        }
+
+        auto controller = make_shared<DevSupports::IterationController>(group.first);
+        controller->SetIterationConfigs(linkLoader.GetIteratorConfigs(group.first));
+        for (const auto &compId : group.second)
+        {
+            // Components are owned by their libraries, not by the controller.
+            auto comp = shared_ptr<ILinkableComponent>(
+                components.at(compId), [](ILinkableComponent *) {});
+            try
+            {
+                controller->AddComponent(comp);
+            }
+            catch (const exception &e)
+            {
+                spdlog::error(
+                    "Failed to build loop group {}: {}", group.first, e.what());
+                return 1;
+            }
+            owners[compId] = group.first;
+        }
+
+        controllers.push_back(controller);
+    }
+
+    // Components driven by the scheduler, with their providers.
+    unordered_map<string, ILinkableComponent *> scheduled;
+    unordered_map<string, set<string>>          providers;
+    for (auto comp : components)
+    {
+        // Components exchanged asynchronously are driven by their outputs.
+        if (asyncComps.count(comp.first))
+        {
+            continue;
+        }
+
+        string compId = owners.count(comp.first) ? owners[comp.first] : comp.first;
+        if (!owners.count(comp.first))
+        {
+            scheduled[compId] = comp.second;
+        }
+
+        for (const auto &provider : linkLoader.GetComponentProviders(comp.first))
+        {
+            // Providers on other ranks are waited for by the transport outputs of
+            // the inputs, and asynchronous providers by the rings of their outputs.
+            if (!components.count(provider) || asyncComps.count(provider))
+            {
+                continue;
+            }
+
+            string providerId = owners.count(provider) ? owners[provider] : provider;
+            if (providerId != compId)
+            {
+                providers[compId].insert(providerId);
+            }
+        }
+    }
+    for (const auto &controller : controllers)
+    {
+        scheduled[controller->GetId()] = controller.get();
+    }
+
+    // Run components concurrently, following their dependencies.
+    DevSupports::ComponentScheduler scheduler(numThreads ? numThreads.Get() : 0);
+    for (auto comp : scheduled)
+    {
+        scheduler.AddComponent(comp.first, comp.second);
+
+        for (const auto &provider : providers[comp.first])
+        {
+            scheduler.AddDependency(comp.first, provider);
+        }
+    }
+
+    auto stages = scheduler.GetStages();
+    for (size_t i = 0; i < stages.size(); i++)
+    {
+        string compList;
+        for (const auto &compId : stages[i])
+        {
+            compList += compList.empty() ? compId : ", " + compId;
+        }
+        spdlog::info("Scheduling stage {}: [{}].", i, compList);
+    }
+
+    for (auto comp : components)
+    {
+        comp.second->Prepare();
         spdlog::info("Component {} prepared.", comp.first);
+    }
 
-        auto compId = comp.first;
-        int  steps  = 0;
-        while (compPtr->GetStatus() != LinkableComponentStatus::Done
-               && compPtr->GetStatus() != LinkableComponentStatus::Failed)
+    for (const auto &controller : controllers)
+    {
+        controller->Initialize();
+        for (const auto &error : controller->Validate())
         {
-            compPtr->Update();
-            steps++;
+            spdlog::error("Controller {}: {}", controller->GetId(), error);
         }
-        spdlog::info("Component {} updated for {} steps.", compId, steps);
 
-        compPtr->Finish();
-        spdlog::info("Component {} finished.", compId);
+        controller->Prepare();
+        spdlog::info("Controller {} prepared.", controller->GetId());
+    }
+
+    for (const auto &asyncOutput : asyncOutputs)
+    {
+        asyncOutput.second->Start();
+        spdlog::info("Component {} runs asynchronously.", asyncOutput.first);
+    }
+
+    unordered_map<string, int> steps;
+    if (windowSeconds)
+    {
+        // Advance components in lock-step time windows.
+        DevSupports::TimeWindowExecutor executor(
+            windowSeconds.Get() / 86400.,
+            lookaheadSteps ? lookaheadSteps.Get() : 1,
+            numThreads ? numThreads.Get() : 0);
+
+        for (auto comp : scheduled)
+        {
+            executor.AddComponent(comp.first, comp.second);
+
+            for (const auto &provider : providers[comp.first])
+            {
+                executor.AddDependency(comp.first, provider);
+            }
+        }
+
+        spdlog::info("Running in lock-step windows of {}s.", windowSeconds.Get());
+        steps = executor.Run();
+    }
+    else
+    {
+        steps = scheduler.Run();
+    }
+
+    for (auto comp : scheduled)
+    {
+        spdlog::info(
+            "Component {} updated for {} steps.", comp.first, steps[comp.first]);
+    }
+
+    for (auto comp : components)
+    {
+        auto linkable = dynamic_cast<LinkableComponent *>(comp.second);
+        auto coupling = linkable ? linkable->GetCouplingStepController() : nullptr;
+        if (coupling)
+        {
+            spdlog::info(
+                "Component {} exchanged {} times, skipped {} times.",
+                comp.first,
+                coupling->GetExchangeCount(),
+                coupling->GetSkippedCount());
+        }
+    }
+
+    for (const auto &asyncOutput : asyncOutputs)
+    {
+        asyncOutput.second->Stop();
+    }
+
+    for (const auto &controller : controllers)
+    {
+        controller->Finish();
+    }
+
+    if (transport)
+    {
+        publisher.End();
+        transport->Close();
+    }
+
+    for (auto comp : components)
+    {
+        comp.second->Finish();
+        spdlog::info("Component {} finished.", comp.first);
     }
 
     spdlog::info("All components finished.");
@@ -0,0 +1,261 @@
+/** ***********************************************************************************
+ *    @File      :  CsvChunkReader.cpp
+ *    @Brief     :  To read large csv files of numbers by chunks in parallel.
+ *
+ ** ***********************************************************************************/
+#include "CsvChunkReader.h"
+#include "Exception.h"
+#include "MappedFile.h"
+#include "StringHelper.h"
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+
+namespace OpenOasis
+{
+namespace Utils
+{
+using namespace std;
+
+namespace
+{
+/// @brief A chunk of lines, and the sizes and positions of its rows.
+struct Chunk
+{
+    const char *beg;
+    const char *end;
+
+    size_t lineCount  = 0;
+    size_t rowCount   = 0;
+    size_t valueCount = 0;
+
+    size_t firstLine  = 0;
+    size_t firstRow   = 0;
+    size_t firstValue = 0;
+
+    string error;
+};
+
+string_view Trim(string_view field)
+{
+    const char *spaces = " \t\r";
+
+    size_t beg = field.find_first_not_of(spaces);
+    if (beg == string_view::npos)
+        return {};
+
+    size_t end = field.find_last_not_of(spaces);
+    return field.substr(beg, end - beg + 1);
+}
+
+/// @brief Calls `onLine(lineIndex, line)` for each line of data in the range, and
+/// returns the number of lines.
+template <typename OnLine>
+size_t ForEachLine(const char *beg, const char *end, const OnLine &onLine)
+{
+    size_t lineIdx = 0;
+    while (beg < end)
+    {
+        const char *next = static_cast<const char *>(memchr(beg, '\n', end - beg));
+        if (!next)
+            next = end;
+
+        auto line = Trim(string_view(beg, next - beg));
+        if (!line.empty() && line.front() != '#')
+        {
+            if (!onLine(lineIdx, line))
+                break;
+        }
+
+        beg = next + 1;
+        lineIdx++;
+    }
+
+    return lineIdx;
+}
+
+/// @brief Calls `onField(field)` for each non-empty field of the line after the
+/// label, and returns the label.
+template <typename OnField>
+string_view ForEachField(string_view line, char delimiter, const OnField &onField)
+{
+    size_t      pos   = line.find(delimiter);
+    string_view label = Trim(line.substr(0, pos));
+
+    while (pos != string_view::npos)
+    {
+        size_t next  = line.find(delimiter, pos + 1);
+        auto   field = Trim(line.substr(pos + 1, next - pos - 1));
+        if (!field.empty())
+        {
+            onField(field);
+        }
+        pos = next;
+    }
+
+    return label;
+}
+
+template <typename T>
+bool ParseNumber(string_view field, T &value)
+{
+    if (field.front() == '+')
+    {
+        field.remove_prefix(1);
+    }
+
+    auto res = from_chars(field.data(), field.data() + field.size(), value);
+    return res.ec == errc() && res.ptr == field.data() + field.size();
+}
+
+string_view Unquote(string_view label)
+{
+    if (label.size() >= 2 && label.front() == '"' && label.back() == '"')
+    {
+        return label.substr(1, label.size() - 2);
+    }
+
+    return label;
+}
+
+}  // namespace
+
+
+template <typename T>
+CsvRows<T> CsvChunkReader::Read(
+    const string &file, bool hasColumnHeader, CsvLabelMode labelMode, char delimiter,
+    size_t chunkSize)
+{
+    const auto  mapped = MappedFile::Open(file);
+    const char *beg    = static_cast<const char *>(mapped->GetData());
+    const char *end    = beg + mapped->GetSize();
+
+    // Skip the UTF-8 BOM and the column header.
+    if (end - beg >= 3 && memcmp(beg, "\xEF\xBB\xBF", 3) == 0)
+    {
+        beg += 3;
+    }
+
+    size_t headerLines = 0;
+    if (hasColumnHeader)
+    {
+        const char *data = end;
+        ForEachLine(beg, end, [&](size_t lineIdx, string_view line) {
+            headerLines = lineIdx + 1;
+            data        = line.data() + line.size();
+            return false;
+        });
+
+        const char *next = static_cast<const char *>(memchr(data, '\n', end - data));
+        beg              = next ? next + 1 : end;
+    }
+
+    // Split into chunks at line boundaries.
+    vector<Chunk> chunks;
+    for (const char *pos = beg; pos < end;)
+    {
+        const char *stop = pos + min(chunkSize, size_t(end - pos));
+        const char *next = static_cast<const char *>(memchr(stop, '\n', end - stop));
+        stop             = next ? next + 1 : end;
+
+        chunks.push_back({pos, stop});
+        pos = stop;
+    }
+
+    const long long nChunks = chunks.size();
+
+    // Counts the rows and values of each chunk.
+#pragma omp parallel for schedule(dynamic)
+    for (long long i = 0; i < nChunks; i++)
+    {
+        auto &chunk = chunks[i];
+        auto  count = [&](size_t, string_view line) {
+            chunk.rowCount++;
+            ForEachField(line, delimiter, [&](string_view) { chunk.valueCount++; });
+            return true;
+        };
+
+        chunk.lineCount = ForEachLine(chunk.beg, chunk.end, count);
+    }
+
+    CsvRows<T> rows;
+
+    size_t lineCount = headerLines, rowCount = 0, valueCount = 0;
+    for (auto &chunk : chunks)
+    {
+        chunk.firstLine  = lineCount;
+        chunk.firstRow   = rowCount;
+        chunk.firstValue = valueCount;
+
+        lineCount += chunk.lineCount;
+        rowCount += chunk.rowCount;
+        valueCount += chunk.valueCount;
+    }
+
+    rows.offsets.resize(rowCount + 1);
+    rows.values.resize(valueCount);
+    if (labelMode == CsvLabelMode::Text)
+    {
+        rows.labels.resize(rowCount);
+    }
+
+    // Parses the chunks into the rows.
+#pragma omp parallel for schedule(dynamic)
+    for (long long i = 0; i < nChunks; i++)
+    {
+        auto  &chunk = chunks[i];
+        size_t row   = chunk.firstRow;
+        size_t pos   = chunk.firstValue;
+
+        ForEachLine(chunk.beg, chunk.end, [&](size_t lineIdx, string_view line) {
+            auto label = ForEachField(line, delimiter, [&](string_view field) {
+                if (!ParseNumber(field, rows.values[pos++]) && chunk.error.empty())
+                {
+                    chunk.error = StringHelper::FormatSimple(
+                        "Invalid number [{}] at line {} of file [{}].", string(field),
+                        chunk.firstLine + lineIdx + 1, file);
+                }
+            });
+
+            if (labelMode == CsvLabelMode::Text)
+            {
+                rows.labels[row] = string(Unquote(label));
+            }
+            else
+            {
+                size_t index;
+                if ((label.empty() || !ParseNumber(label, index) || index != row)
+                    && chunk.error.empty())
+                {
+                    chunk.error = StringHelper::FormatSimple(
+                        "Invalid label [{}] at line {} of file [{}], {} expected.",
+                        string(label), chunk.firstLine + lineIdx + 1, file, row);
+                }
+            }
+
+            rows.offsets[++row] = pos;
+            return chunk.error.empty();
+        });
+    }
+
+    for (const auto &chunk : chunks)
+    {
+        if (!chunk.error.empty())
+        {
+            throw InvalidDataException(chunk.error);
+        }
+    }
+
+    return rows;
+}
+
+template CsvRows<int> CsvChunkReader::Read<int>(
+    const string &, bool, CsvLabelMode, char, size_t);
+template CsvRows<float> CsvChunkReader::Read<float>(
+    const string &, bool, CsvLabelMode, char, size_t);
+template CsvRows<double> CsvChunkReader::Read<double>(
+    const string &, bool, CsvLabelMode, char, size_t);
+
+}  // namespace Utils
+}  // namespace OpenOasis
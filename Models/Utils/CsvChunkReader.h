@@ -0,0 +1,75 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  CsvChunkReader.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To read large csv files of numbers by chunks in parallel.
+ *
+ *    The file is mapped into memory and split into chunks at line boundaries. The
+ *    chunks are scanned for the sizes in parallel at first, then parsed in parallel
+ *    straight into the preallocated rows, so no cell is kept as string.
+ *
+ *    The first column of each line is the row label, and the others are numbers. As
+ *    `CsvLoader`, empty lines and lines starting with '#' are skipped, lines may be
+ *    of unequal length, and spaces around the fields are ignored. Quoted fields with
+ *    delimiters are not supported.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+
+
+namespace OpenOasis
+{
+namespace Utils
+{
+/// @brief Rows of numbers in compressed sparse rows(CSR).
+/// Numbers of row i are `values[offsets[i], offsets[i + 1])`.
+template <typename T>
+struct CsvRows
+{
+    std::vector<std::string> labels;  // Only read for `CsvLabelMode::Text`.
+    std::vector<size_t>      offsets = {0};
+    std::vector<T>           values;
+
+    size_t GetRowCount() const
+    {
+        return offsets.size() - 1;
+    }
+
+    size_t GetRowSize(size_t row) const
+    {
+        return offsets[row + 1] - offsets[row];
+    }
+};
+
+
+/// @brief How the row labels are read.
+enum class CsvLabelMode
+{
+    Index,  // Labels must be the row indexes from 0, and are not kept.
+    Text,   // Labels are kept as text.
+};
+
+
+/// @brief CsvChunkReader reads csv files of numbers by chunks in parallel.
+class CsvChunkReader final
+{
+public:
+    /// @brief Reads the numbers of the csv file with the row labels.
+    ///
+    /// @tparam T Type of numbers, `int`, `float` or `double`.
+    /// @param hasColumnHeader Whether the first line is column header to skip.
+    /// @param chunkSize Bytes of each chunk parsed by a thread.
+    /// @throw FileLoadException If failed to read the file.
+    /// @throw InvalidDataException If a number or an index label is invalid.
+    template <typename T>
+    static CsvRows<T> Read(
+        const std::string &file, bool hasColumnHeader, CsvLabelMode labelMode,
+        char delimiter = ',', size_t chunkSize = 1 << 22);
+};
+
+}  // namespace Utils
+}  // namespace OpenOasis
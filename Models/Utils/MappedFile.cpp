@@ -0,0 +1,125 @@
+/** ***********************************************************************************
+ *    @File      :  MappedFile.cpp
+ *    @Brief     :  To map a file into memory for reading.
+ *
+ ** ***********************************************************************************/
+#include "MappedFile.h"
+#include "Exception.h"
+#include "StringHelper.h"
+
+#ifdef LINUX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+MappedFile::MappedFile(const string &path) : mPath(path)
+{}
+
+const string &MappedFile::GetPath() const
+{
+    return mPath;
+}
+
+size_t MappedFile::GetSize() const
+{
+    return mSize;
+}
+
+const void *MappedFile::GetData() const
+{
+    return mData;
+}
+
+
+// class MappedFile on Linux ---------------------------------------------------------
+#ifdef LINUX
+
+MappedFile::~MappedFile()
+{
+    if (mData)
+    {
+        munmap(const_cast<void *>(mData), mSize);
+    }
+}
+
+shared_ptr<MappedFile> MappedFile::Open(const string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw FileLoadException(StringHelper::FormatSimple(
+            "Failed to open file [{}]: {}.", path, strerror(errno)));
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw FileLoadException(StringHelper::FormatSimple(
+            "Failed to stat file [{}]: {}.", path, strerror(errno)));
+    }
+
+    auto file   = shared_ptr<MappedFile>(new MappedFile(path));
+    file->mSize = (size_t)info.st_size;
+
+    // Empty file can't be mapped.
+    if (file->mSize == 0)
+    {
+        close(fd);
+        return file;
+    }
+
+    void *data = mmap(nullptr, file->mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw FileLoadException(StringHelper::FormatSimple(
+            "Failed to map file [{}]: {}.", path, strerror(errno)));
+    }
+
+    file->mData = data;
+    return file;
+}
+
+
+// class MappedFile on other platforms -----------------------------------------------
+#else
+
+MappedFile::~MappedFile()
+{}
+
+shared_ptr<MappedFile> MappedFile::Open(const string &path)
+{
+    ifstream stream(path, ios::binary | ios::ate);
+    if (!stream)
+    {
+        throw FileLoadException(
+            StringHelper::FormatSimple("Failed to open file [{}].", path));
+    }
+
+    auto file   = shared_ptr<MappedFile>(new MappedFile(path));
+    file->mSize = (size_t)stream.tellg();
+    file->mBuffer.resize(file->mSize);
+
+    stream.seekg(0);
+    if (!stream.read(file->mBuffer.data(), file->mSize))
+    {
+        throw FileLoadException(
+            StringHelper::FormatSimple("Failed to read file [{}].", path));
+    }
+
+    file->mData = file->mBuffer.data();
+    return file;
+}
+
+#endif
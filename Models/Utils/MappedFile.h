@@ -0,0 +1,54 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  MappedFile.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To map a file into memory for reading.
+ *
+ *    The file is memory-mapped on Linux, so only the pages read are loaded. On other
+ *    platforms it's read into a buffer at once.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "CommMacros.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace OpenOasis
+{
+namespace Utils
+{
+/// @brief Read-only view of a whole file.
+class MappedFile final
+{
+private:
+    std::string       mPath;
+    std::size_t       mSize = 0;
+    const void       *mData = nullptr;
+    std::vector<char> mBuffer;  // Contents of the file if not memory-mapped.
+
+public:
+    ~MappedFile();
+
+    MappedFile(const MappedFile &)            = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /// @brief Opens the file for reading.
+    static std::shared_ptr<MappedFile> Open(const std::string &path);
+
+    const std::string &GetPath() const;
+
+    std::size_t GetSize() const;
+
+    const void *GetData() const;
+
+private:
+    MappedFile(const std::string &path);
+};
+
+}  // namespace Utils
+}  // namespace OpenOasis
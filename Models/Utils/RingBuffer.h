@@ -0,0 +1,212 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  RingBuffer.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  A circular buffer supporting O(1) appending and front removing.
+ *
+ *    The buffer only reallocates when an item is appended to a full buffer, doubling
+ *    its capacity. So a buffer sliding over a bounded window reaches a fixed capacity
+ *    after a few steps, and then appends and expires items without reallocation.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+
+namespace OpenOasis
+{
+namespace Utils
+{
+/// @brief A growable circular buffer of items in a sliding window.
+template <typename T>
+class RingBuffer
+{
+private:
+    std::vector<T> mSlots;
+    std::size_t    mHead = 0;  // Slot of the front item.
+    std::size_t    mSize = 0;
+
+public:
+    RingBuffer() = default;
+
+    explicit RingBuffer(std::size_t capacity) : mSlots(capacity)
+    {}
+
+    RingBuffer(const std::vector<T> &items) : mSlots(items), mSize(items.size())
+    {}
+
+    std::size_t GetCapacity() const
+    {
+        return mSlots.size();
+    }
+
+    std::size_t GetSize() const
+    {
+        return mSize;
+    }
+
+    bool IsEmpty() const
+    {
+        return mSize == 0;
+    }
+
+    /// @brief Makes room for the number of items, keeping the existed items.
+    void Reserve(std::size_t capacity)
+    {
+        if (capacity <= mSlots.size())
+        {
+            return;
+        }
+
+        std::vector<T> slots(capacity);
+        for (std::size_t i = 0; i < mSize; i++)
+        {
+            slots[i] = std::move((*this)[i]);
+        }
+
+        mSlots.swap(slots);
+        mHead = 0;
+    }
+
+    T &operator[](std::size_t index)
+    {
+        return mSlots[Slot(index)];
+    }
+
+    const T &operator[](std::size_t index) const
+    {
+        return mSlots[Slot(index)];
+    }
+
+    T &At(std::size_t index)
+    {
+        CheckIndex(index);
+        return (*this)[index];
+    }
+
+    const T &At(std::size_t index) const
+    {
+        CheckIndex(index);
+        return (*this)[index];
+    }
+
+    T &Front()
+    {
+        return At(0);
+    }
+
+    const T &Front() const
+    {
+        return At(0);
+    }
+
+    T &Back()
+    {
+        return At(mSize - 1);
+    }
+
+    const T &Back() const
+    {
+        return At(mSize - 1);
+    }
+
+    void PushBack(T item)
+    {
+        if (mSize == mSlots.size())
+        {
+            Reserve(std::max<std::size_t>(mSlots.size() * 2, 8));
+        }
+
+        mSlots[Slot(mSize)] = std::move(item);
+        mSize++;
+    }
+
+    /// @brief Removes the earliest items, at most the number of items held.
+    void PopFront(std::size_t count = 1)
+    {
+        count = std::min(count, mSize);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            (*this)[i] = T();  // release the resources held by the item.
+        }
+
+        mHead = mSize == count ? 0 : Slot(count);
+        mSize -= count;
+    }
+
+    /// @brief Inserts the item before the index, the items after are shifted.
+    void Insert(std::size_t index, T item)
+    {
+        index = std::min(index, mSize);
+        PushBack(std::move(item));
+
+        for (std::size_t i = mSize - 1; i > index; i--)
+        {
+            std::swap((*this)[i], (*this)[i - 1]);
+        }
+    }
+
+    /// @brief Removes the items in range [index, index + count).
+    void Erase(std::size_t index, std::size_t count = 1)
+    {
+        index = std::min(index, mSize);
+        count = std::min(count, mSize - index);
+        if (index == 0)
+        {
+            PopFront(count);
+            return;
+        }
+
+        for (std::size_t i = index; i + count < mSize; i++)
+        {
+            (*this)[i] = std::move((*this)[i + count]);
+        }
+
+        for (std::size_t i = mSize - count; i < mSize; i++)
+        {
+            (*this)[i] = T();
+        }
+
+        mSize -= count;
+    }
+
+    void Clear()
+    {
+        PopFront(mSize);
+    }
+
+    std::vector<T> ToVector() const
+    {
+        std::vector<T> items;
+        items.reserve(mSize);
+        for (std::size_t i = 0; i < mSize; i++)
+        {
+            items.push_back((*this)[i]);
+        }
+
+        return items;
+    }
+
+private:
+    std::size_t Slot(std::size_t index) const
+    {
+        std::size_t slot = mHead + index;
+        return slot < mSlots.size() ? slot : slot - mSlots.size();
+    }
+
+    void CheckIndex(std::size_t index) const
+    {
+        if (index >= mSize)
+        {
+            throw std::out_of_range("Index out of the ring buffer range.");
+        }
+    }
+};
+
+}  // namespace Utils
+}  // namespace OpenOasis
@@ -0,0 +1,146 @@
+/** ***********************************************************************************
+ *    @File      :  SharedMemory.cpp
+ *    @Brief     :  To provide named shared memory segments between processes.
+ *
+ ** ***********************************************************************************/
+#include "SharedMemory.h"
+#include "Exception.h"
+#include "StringHelper.h"
+
+#ifdef LINUX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+SharedMemory::SharedMemory(const string &name, size_t size, void *data, bool owner) :
+    mName(name), mSize(size), mData(data), mOwner(owner)
+{}
+
+const string &SharedMemory::GetName() const
+{
+    return mName;
+}
+
+size_t SharedMemory::GetSize() const
+{
+    return mSize;
+}
+
+void *SharedMemory::GetData() const
+{
+    return mData;
+}
+
+
+// class SharedMemory on Linux -------------------------------------------------------
+#ifdef LINUX
+
+SharedMemory::~SharedMemory()
+{
+    if (mData)
+    {
+        munmap(mData, mSize);
+    }
+
+    if (mOwner)
+    {
+        shm_unlink(mName.c_str());
+    }
+}
+
+shared_ptr<SharedMemory> SharedMemory::Create(const string &name, size_t size)
+{
+    shm_unlink(name.c_str());
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Failed to create shared memory [{}]: {}.", name, strerror(errno)));
+    }
+
+    if (ftruncate(fd, (off_t)size) != 0)
+    {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Failed to resize shared memory [{}]: {}.", name, strerror(errno)));
+    }
+
+    void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        shm_unlink(name.c_str());
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Failed to map shared memory [{}]: {}.", name, strerror(errno)));
+    }
+
+    return shared_ptr<SharedMemory>(new SharedMemory(name, size, data, true));
+}
+
+shared_ptr<SharedMemory> SharedMemory::Open(const string &name)
+{
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+    {
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Failed to open shared memory [{}]: {}.", name, strerror(errno)));
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Failed to stat shared memory [{}]: {}.", name, strerror(errno)));
+    }
+
+    size_t size = (size_t)info.st_size;
+    void  *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Failed to map shared memory [{}]: {}.", name, strerror(errno)));
+    }
+
+    return shared_ptr<SharedMemory>(new SharedMemory(name, size, data, false));
+}
+
+void SharedMemory::Remove(const string &name)
+{
+    shm_unlink(name.c_str());
+}
+
+
+// class SharedMemory on other platforms ---------------------------------------------
+#else
+
+SharedMemory::~SharedMemory()
+{}
+
+shared_ptr<SharedMemory> SharedMemory::Create(const string &name, size_t size)
+{
+    throw NotSupportedException("Shared memory is only supported on Linux.");
+}
+
+shared_ptr<SharedMemory> SharedMemory::Open(const string &name)
+{
+    throw NotSupportedException("Shared memory is only supported on Linux.");
+}
+
+void SharedMemory::Remove(const string &name)
+{
+    throw NotSupportedException("Shared memory is only supported on Linux.");
+}
+
+#endif
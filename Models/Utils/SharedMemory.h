@@ -0,0 +1,66 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  SharedMemory.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To provide named shared memory segments between processes.
+ *
+ *    Only POSIX shared memory (`shm_open`) on Linux is supported now, the methods
+ *    throw `NotSupportedException` on other platforms.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "CommMacros.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+
+namespace OpenOasis
+{
+namespace Utils
+{
+/// @brief Named shared memory segment mapped into the process.
+///
+/// The segment is removed from the system when its creator is destroyed, while the
+/// mappings opened by other processes stay valid until they are destroyed too.
+class SharedMemory final
+{
+private:
+    std::string mName;
+    std::size_t mSize  = 0;
+    void       *mData  = nullptr;
+    bool        mOwner = false;
+
+public:
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory &)            = delete;
+    SharedMemory &operator=(const SharedMemory &) = delete;
+
+    /// @brief Creates a zero-filled segment, replacing the one with the same name.
+    ///
+    /// @param name Segment name, e.g. "/oasis_comp1_out1".
+    /// @param size Segment size in bytes.
+    static std::shared_ptr<SharedMemory>
+    Create(const std::string &name, std::size_t size);
+
+    /// @brief Opens a segment created by another process.
+    static std::shared_ptr<SharedMemory> Open(const std::string &name);
+
+    /// @brief Removes the segment from the system, e.g. left by a crashed process.
+    static void Remove(const std::string &name);
+
+    const std::string &GetName() const;
+
+    std::size_t GetSize() const;
+
+    void *GetData() const;
+
+private:
+    SharedMemory(const std::string &name, std::size_t size, void *data, bool owner);
+};
+
+}  // namespace Utils
+}  // namespace OpenOasis
@@ -0,0 +1,88 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  Span.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To provide a non-owning view of contiguous elements.
+ *
+ *    A minimal stand-in of C++20 `std::span` for C++17.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+
+namespace OpenOasis
+{
+namespace Utils
+{
+/// @brief Non-owning view of a contiguous sequence of elements.
+template <typename T>
+class Span
+{
+private:
+    T          *mData = nullptr;
+    std::size_t mSize = 0;
+
+public:
+    Span() = default;
+
+    Span(T *data, std::size_t size) : mData(data), mSize(size)
+    {}
+
+    template <typename U, typename = std::enable_if_t<std::is_const_v<T>, U>>
+    Span(const std::vector<U> &values) : mData(values.data()), mSize(values.size())
+    {}
+
+    Span(std::vector<std::remove_const_t<T>> &values) :
+        mData(values.data()), mSize(values.size())
+    {}
+
+    /// @brief Converts to a span of const elements.
+    template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+    operator Span<const U>() const
+    {
+        return Span<const U>(mData, mSize);
+    }
+
+    T *data() const
+    {
+        return mData;
+    }
+
+    std::size_t size() const
+    {
+        return mSize;
+    }
+
+    bool empty() const
+    {
+        return mSize == 0;
+    }
+
+    T &operator[](std::size_t index) const
+    {
+        return mData[index];
+    }
+
+    T *begin() const
+    {
+        return mData;
+    }
+
+    T *end() const
+    {
+        return mData + mSize;
+    }
+
+    std::vector<std::remove_const_t<T>> ToVector() const
+    {
+        return std::vector<std::remove_const_t<T>>(begin(), end());
+    }
+};
+
+}  // namespace Utils
+}  // namespace OpenOasis
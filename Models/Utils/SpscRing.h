@@ -0,0 +1,100 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  SpscRing.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  A bounded lock-free single-producer/single-consumer ring buffer.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+
+namespace OpenOasis
+{
+namespace Utils
+{
+/// @brief A bounded lock-free ring buffer, which is safe only when there is exactly
+/// one thread pushing and one thread popping.
+template <typename T>
+class SpscRing
+{
+private:
+    // One slot is kept empty to tell a full ring from an empty one.
+    std::vector<std::optional<T>> mSlots;
+
+    alignas(64) std::atomic<std::size_t> mHead{0};  // Next slot to pop.
+    alignas(64) std::atomic<std::size_t> mTail{0};  // Next slot to push.
+
+public:
+    explicit SpscRing(std::size_t capacity) : mSlots(capacity + 1)
+    {}
+
+    SpscRing(const SpscRing &)            = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    std::size_t GetCapacity() const
+    {
+        return mSlots.size() - 1;
+    }
+
+    std::size_t GetSize() const
+    {
+        std::size_t head = mHead.load(std::memory_order_acquire);
+        std::size_t tail = mTail.load(std::memory_order_acquire);
+
+        return tail >= head ? tail - head : tail + mSlots.size() - head;
+    }
+
+    bool IsEmpty() const
+    {
+        return mHead.load(std::memory_order_acquire)
+               == mTail.load(std::memory_order_acquire);
+    }
+
+    /// @brief Pushes an item, called by the producer thread only.
+    /// The item is moved only if pushed successfully.
+    /// @return False if the ring is full.
+    bool TryPush(T &&item)
+    {
+        std::size_t tail = mTail.load(std::memory_order_relaxed);
+        std::size_t next = Next(tail);
+        if (next == mHead.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        mSlots[tail] = std::move(item);
+        mTail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Pops an item, called by the consumer thread only.
+    /// @return False if the ring is empty.
+    bool TryPop(T &item)
+    {
+        std::size_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = std::move(*mSlots[head]);
+        mSlots[head].reset();
+        mHead.store(Next(head), std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::size_t Next(std::size_t index) const
+    {
+        return index + 1 == mSlots.size() ? 0 : index + 1;
+    }
+};
+
+}  // namespace Utils
+}  // namespace OpenOasis
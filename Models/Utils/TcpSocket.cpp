@@ -0,0 +1,308 @@
+/** ***********************************************************************************
+ *    @File      :  TcpSocket.cpp
+ *    @Brief     :  To provide a message channel over a TCP connection.
+ *
+ ** ***********************************************************************************/
+#include "TcpSocket.h"
+#include "Exception.h"
+#include "StringHelper.h"
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#ifdef LINUX
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+TcpSocket::TcpSocket(int handle) : mHandle(handle)
+{}
+
+TcpSocket::~TcpSocket()
+{
+    Close();
+}
+
+TcpSocket::TcpSocket(TcpSocket &&other) noexcept : mHandle(other.mHandle)
+{
+    other.mHandle = -1;
+}
+
+TcpSocket &TcpSocket::operator=(TcpSocket &&other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        mHandle       = other.mHandle;
+        other.mHandle = -1;
+    }
+
+    return *this;
+}
+
+bool TcpSocket::IsOpen() const
+{
+    return mHandle >= 0;
+}
+
+
+// class TcpSocket on Linux ----------------------------------------------------------
+#ifdef LINUX
+
+namespace
+{
+bool WriteAll(int handle, const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t count = send(handle, data, size, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            return false;
+
+        data += count;
+        size -= (size_t)count;
+    }
+
+    return true;
+}
+
+bool ReadAll(int handle, char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t count = recv(handle, data, size, 0);
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            return false;
+
+        data += count;
+        size -= (size_t)count;
+    }
+
+    return true;
+}
+}  // namespace
+
+TcpSocket TcpSocket::Connect(const string &host, int port, int timeoutMs)
+{
+    addrinfo hints = {};
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo *addrs   = nullptr;
+    string    service = to_string(port);
+    int       error   = getaddrinfo(host.c_str(), service.c_str(), &hints, &addrs);
+    if (error != 0)
+    {
+        throw IllegalArgumentException(StringHelper::FormatSimple(
+            "Failed to resolve host [{}]: {}.", host, gai_strerror(error)));
+    }
+
+    // The peer may not be listening yet, retries until timeout.
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeoutMs);
+    while (true)
+    {
+        for (auto addr = addrs; addr; addr = addr->ai_next)
+        {
+            int handle = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+            if (handle < 0)
+            {
+                continue;
+            }
+
+            if (connect(handle, addr->ai_addr, addr->ai_addrlen) == 0)
+            {
+                freeaddrinfo(addrs);
+
+                int flag = 1;
+                setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+                return TcpSocket(handle);
+            }
+
+            close(handle);
+        }
+
+        if (chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+
+    freeaddrinfo(addrs);
+    throw IllegalStateException(
+        StringHelper::FormatSimple("Failed to connect to [{}:{}].", host, port));
+}
+
+void TcpSocket::Close()
+{
+    if (mHandle >= 0)
+    {
+        close(mHandle);
+        mHandle = -1;
+    }
+}
+
+void TcpSocket::Shutdown()
+{
+    if (mHandle >= 0)
+    {
+        shutdown(mHandle, SHUT_RDWR);
+    }
+}
+
+bool TcpSocket::Send(const string &message)
+{
+    if (mHandle < 0)
+    {
+        return false;
+    }
+
+    uint32_t size = (uint32_t)message.size();
+
+    return WriteAll(mHandle, reinterpret_cast<const char *>(&size), sizeof(size))
+           && WriteAll(mHandle, message.data(), message.size());
+}
+
+bool TcpSocket::Receive(string &message)
+{
+    if (mHandle < 0)
+    {
+        return false;
+    }
+
+    uint32_t size = 0;
+    if (!ReadAll(mHandle, reinterpret_cast<char *>(&size), sizeof(size)))
+    {
+        return false;
+    }
+
+    message.resize(size);
+    return size == 0 || ReadAll(mHandle, message.data(), size);
+}
+
+
+// class TcpListener on Linux --------------------------------------------------------
+
+TcpListener::TcpListener(int port)
+{
+    mHandle = socket(AF_INET, SOCK_STREAM, 0);
+    if (mHandle < 0)
+    {
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Failed to create socket: {}.", strerror(errno)));
+    }
+
+    int flag = 1;
+    setsockopt(mHandle, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+
+    sockaddr_in addr     = {};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port        = htons((uint16_t)port);
+
+    if (bind(mHandle, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0
+        || listen(mHandle, SOMAXCONN) != 0)
+    {
+        string reason = strerror(errno);
+        Close();
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Failed to listen on port [{}]: {}.", port, reason));
+    }
+}
+
+TcpListener::~TcpListener()
+{
+    Close();
+}
+
+TcpSocket TcpListener::Accept()
+{
+    while (true)
+    {
+        int handle = accept(mHandle, nullptr, nullptr);
+        if (handle < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (handle < 0)
+        {
+            throw IllegalStateException(StringHelper::FormatSimple(
+                "Failed to accept connection: {}.", strerror(errno)));
+        }
+
+        int flag = 1;
+        setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+        return TcpSocket(handle);
+    }
+}
+
+void TcpListener::Close()
+{
+    if (mHandle >= 0)
+    {
+        close(mHandle);
+        mHandle = -1;
+    }
+}
+
+
+// class TcpSocket and TcpListener on other platforms --------------------------------
+#else
+
+TcpSocket TcpSocket::Connect(const string &host, int port, int timeoutMs)
+{
+    throw NotSupportedException("Tcp socket is only supported on Linux.");
+}
+
+void TcpSocket::Close()
+{
+    mHandle = -1;
+}
+
+void TcpSocket::Shutdown()
+{}
+
+bool TcpSocket::Send(const string &message)
+{
+    throw NotSupportedException("Tcp socket is only supported on Linux.");
+}
+
+bool TcpSocket::Receive(string &message)
+{
+    throw NotSupportedException("Tcp socket is only supported on Linux.");
+}
+
+TcpListener::TcpListener(int port)
+{
+    throw NotSupportedException("Tcp socket is only supported on Linux.");
+}
+
+TcpListener::~TcpListener()
+{}
+
+TcpSocket TcpListener::Accept()
+{
+    throw NotSupportedException("Tcp socket is only supported on Linux.");
+}
+
+void TcpListener::Close()
+{
+    mHandle = -1;
+}
+
+#endif
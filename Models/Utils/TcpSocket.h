@@ -0,0 +1,82 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  TcpSocket.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To provide a message channel over a TCP connection.
+ *
+ *    Messages are framed by a 4 bytes length prefix, as `UnixSocket`. Only Linux is
+ *    supported now, the methods throw `NotSupportedException` on other platforms.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "CommMacros.h"
+#include <string>
+
+
+namespace OpenOasis
+{
+namespace Utils
+{
+/// @brief One end of a connected TCP stream socket.
+class TcpSocket final
+{
+private:
+    int mHandle = -1;
+
+public:
+    explicit TcpSocket(int handle = -1);
+    ~TcpSocket();
+
+    TcpSocket(const TcpSocket &)            = delete;
+    TcpSocket &operator=(const TcpSocket &) = delete;
+
+    TcpSocket(TcpSocket &&other) noexcept;
+    TcpSocket &operator=(TcpSocket &&other) noexcept;
+
+    /// @brief Connects to the listening peer, retrying until it's ready.
+    ///
+    /// @param host Host name or address of the peer.
+    /// @param port Port of the peer.
+    /// @param timeoutMs Time to keep retrying in milliseconds.
+    static TcpSocket Connect(const std::string &host, int port, int timeoutMs = 30000);
+
+    bool IsOpen() const;
+
+    void Close();
+
+    /// @brief Shuts down both directions, waking up the blocked `Receive()`.
+    void Shutdown();
+
+    /// @brief Sends a message.
+    /// @return False if the peer is closed.
+    bool Send(const std::string &message);
+
+    /// @brief Receives a message, blocking until a whole message arrives.
+    /// @return False if the peer is closed.
+    bool Receive(std::string &message);
+};
+
+
+/// @brief TCP socket listening for connections on a port of all interfaces.
+class TcpListener final
+{
+private:
+    int mHandle = -1;
+
+public:
+    explicit TcpListener(int port);
+    ~TcpListener();
+
+    TcpListener(const TcpListener &)            = delete;
+    TcpListener &operator=(const TcpListener &) = delete;
+
+    /// @brief Accepts a connection, blocking until a peer connects.
+    TcpSocket Accept();
+
+    void Close();
+};
+
+}  // namespace Utils
+}  // namespace OpenOasis
@@ -0,0 +1,116 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  ThreadPool.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  A fixed-size thread pool for running independent tasks.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+
+namespace OpenOasis
+{
+namespace Utils
+{
+/// @brief A fixed-size thread pool. Tasks are run in submission order by the first
+/// idle worker, the result (or exception) is delivered through a `std::future`.
+class ThreadPool
+{
+private:
+    std::vector<std::thread>          mWorkers;
+    std::queue<std::function<void()>> mTasks;
+
+    std::mutex              mMutex;
+    std::condition_variable mCondition;
+    bool                    mStopped = false;
+
+public:
+    /// @brief Creates the pool with `numThreads` workers, or with the number of
+    /// hardware threads if `numThreads` is not positive.
+    explicit ThreadPool(int numThreads = 0)
+    {
+        if (numThreads <= 0)
+        {
+            numThreads = (int)std::thread::hardware_concurrency();
+        }
+        numThreads = numThreads > 0 ? numThreads : 1;
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            mWorkers.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopped = true;
+        }
+        mCondition.notify_all();
+
+        for (auto &worker : mWorkers)
+        {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool &)            = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int GetThreadCount() const
+    {
+        return (int)mWorkers.size();
+    }
+
+    /// @brief Submits a task to the pool.
+    template <typename F>
+    auto Submit(F &&func) -> std::future<decltype(func())>
+    {
+        using R   = decltype(func());
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(func));
+
+        auto res = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTasks.emplace([task] { (*task)(); });
+        }
+        mCondition.notify_one();
+
+        return res;
+    }
+
+private:
+    void WorkerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this] { return mStopped || !mTasks.empty(); });
+
+                if (mStopped && mTasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(mTasks.front());
+                mTasks.pop();
+            }
+            task();
+        }
+    }
+};
+
+}  // namespace Utils
+}  // namespace OpenOasis
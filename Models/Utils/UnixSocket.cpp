@@ -0,0 +1,168 @@
+/** ***********************************************************************************
+ *    @File      :  UnixSocket.cpp
+ *    @Brief     :  To provide a message channel over a Unix domain socket.
+ *
+ ** ***********************************************************************************/
+#include "UnixSocket.h"
+#include "Exception.h"
+#include "StringHelper.h"
+#include <cstdint>
+
+#ifdef LINUX
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+UnixSocket::UnixSocket(int handle) : mHandle(handle)
+{}
+
+UnixSocket::~UnixSocket()
+{
+    Close();
+}
+
+UnixSocket::UnixSocket(UnixSocket &&other) noexcept : mHandle(other.mHandle)
+{
+    other.mHandle = -1;
+}
+
+UnixSocket &UnixSocket::operator=(UnixSocket &&other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        mHandle       = other.mHandle;
+        other.mHandle = -1;
+    }
+
+    return *this;
+}
+
+bool UnixSocket::IsOpen() const
+{
+    return mHandle >= 0;
+}
+
+
+// class UnixSocket on Linux ---------------------------------------------------------
+#ifdef LINUX
+
+namespace
+{
+bool WriteAll(int handle, const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t count = send(handle, data, size, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            return false;
+
+        data += count;
+        size -= (size_t)count;
+    }
+
+    return true;
+}
+
+bool ReadAll(int handle, char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t count = recv(handle, data, size, 0);
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            return false;
+
+        data += count;
+        size -= (size_t)count;
+    }
+
+    return true;
+}
+}  // namespace
+
+pair<UnixSocket, UnixSocket> UnixSocket::CreatePair()
+{
+    int handles[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, handles) != 0)
+    {
+        throw IllegalStateException(StringHelper::FormatSimple(
+            "Failed to create socket pair: {}.", strerror(errno)));
+    }
+
+    return {UnixSocket(handles[0]), UnixSocket(handles[1])};
+}
+
+void UnixSocket::Close()
+{
+    if (mHandle >= 0)
+    {
+        close(mHandle);
+        mHandle = -1;
+    }
+}
+
+bool UnixSocket::Send(const string &message)
+{
+    if (mHandle < 0)
+    {
+        return false;
+    }
+
+    uint32_t size = (uint32_t)message.size();
+
+    return WriteAll(mHandle, reinterpret_cast<const char *>(&size), sizeof(size))
+           && WriteAll(mHandle, message.data(), message.size());
+}
+
+bool UnixSocket::Receive(string &message)
+{
+    if (mHandle < 0)
+    {
+        return false;
+    }
+
+    uint32_t size = 0;
+    if (!ReadAll(mHandle, reinterpret_cast<char *>(&size), sizeof(size)))
+    {
+        return false;
+    }
+
+    message.resize(size);
+    return size == 0 || ReadAll(mHandle, message.data(), size);
+}
+
+
+// class UnixSocket on other platforms -----------------------------------------------
+#else
+
+pair<UnixSocket, UnixSocket> UnixSocket::CreatePair()
+{
+    throw NotSupportedException("Unix socket is only supported on Linux.");
+}
+
+void UnixSocket::Close()
+{
+    mHandle = -1;
+}
+
+bool UnixSocket::Send(const string &message)
+{
+    throw NotSupportedException("Unix socket is only supported on Linux.");
+}
+
+bool UnixSocket::Receive(string &message)
+{
+    throw NotSupportedException("Unix socket is only supported on Linux.");
+}
+
+#endif
@@ -0,0 +1,57 @@
+/** ***********************************************************************************
+ *    Copyright (C) 2024, The OpenOasis Contributors. Join us in the Oasis!
+ *
+ *    @File      :  UnixSocket.h
+ *    @License   :  Apache-2.0
+ *
+ *    @Desc      :  To provide a message channel over a Unix domain socket.
+ *
+ *    Messages are framed by a 4 bytes length prefix. Only Linux is supported now,
+ *    the methods throw `NotSupportedException` on other platforms.
+ *
+ ** ***********************************************************************************/
+#pragma once
+#include "CommMacros.h"
+#include <string>
+#include <utility>
+
+
+namespace OpenOasis
+{
+namespace Utils
+{
+/// @brief One end of a connected Unix domain stream socket.
+class UnixSocket final
+{
+private:
+    int mHandle = -1;
+
+public:
+    explicit UnixSocket(int handle = -1);
+    ~UnixSocket();
+
+    UnixSocket(const UnixSocket &)            = delete;
+    UnixSocket &operator=(const UnixSocket &) = delete;
+
+    UnixSocket(UnixSocket &&other) noexcept;
+    UnixSocket &operator=(UnixSocket &&other) noexcept;
+
+    /// @brief Creates a pair of connected sockets, e.g. to be shared by a parent
+    /// process and its child.
+    static std::pair<UnixSocket, UnixSocket> CreatePair();
+
+    bool IsOpen() const;
+
+    void Close();
+
+    /// @brief Sends a message.
+    /// @return False if the peer is closed.
+    bool Send(const std::string &message);
+
+    /// @brief Receives a message, blocking until a whole message arrives.
+    /// @return False if the peer is closed.
+    bool Receive(std::string &message);
+};
+
+}  // namespace Utils
+}  // namespace OpenOasis
@@ -0,0 +1,91 @@
+#pragma once
+#include "Models/CommImp/RemoteOutput.h"
+#include "Models/Utils/Exception.h"
+#include <atomic>
+#include <string>
+
+
+// Component appending the values `{step, 2 * step}` to its output at each update,
+// as the remote component does after its child process updated, and failing at the
+// step `failAt` if set. The steps may be read while updated by another thread.
+class ProducingComponent : public OpenOasis::ILinkableComponent
+{
+public:
+    std::shared_ptr<OpenOasis::CommImp::RemoteOutput> output;
+
+    std::atomic<int> steps    = 0;
+    int              maxSteps = 0;
+    int              failAt   = 0;
+
+    ProducingComponent(int maxSteps, const std::string &id = "producer") :
+        maxSteps(maxSteps), mId(id)
+    {}
+
+    void Update() override
+    {
+        if (steps + 1 == failAt)
+        {
+            throw OpenOasis::Utils::IllegalStateException("Producer failed.");
+        }
+
+        steps++;
+        output->AppendValues(steps, {(double)steps, 2. * steps});
+    }
+
+    OpenOasis::LinkableComponentStatus GetStatus() const override
+    {
+        return steps < maxSteps ? OpenOasis::LinkableComponentStatus::Updated
+                                : OpenOasis::LinkableComponentStatus::Done;
+    }
+
+    std::string GetId() const override
+    {
+        return mId;
+    }
+    std::string GetCaption() const override
+    {
+        return "";
+    }
+    void SetCaption(const std::string &) override
+    {}
+    std::string GetDescription() const override
+    {
+        return "";
+    }
+    void SetDescription(const std::string &) override
+    {}
+    std::vector<std::shared_ptr<OpenOasis::IArgument>> GetArguments() const override
+    {
+        return {};
+    }
+    std::vector<std::shared_ptr<OpenOasis::IInput>> GetInputs() const override
+    {
+        return {};
+    }
+    std::vector<std::shared_ptr<OpenOasis::IOutput>> GetOutputs() const override
+    {
+        return {output};
+    }
+    std::vector<std::shared_ptr<OpenOasis::IAdaptedOutputFactory>>
+    GetAdaptedOutputFactories() const override
+    {
+        return {};
+    }
+    void Initialize() override
+    {}
+    std::vector<std::string> Validate() override
+    {
+        return {};
+    }
+    void Prepare() override
+    {}
+    void Finish() override
+    {}
+    void RemoveListener(const ListenFunc &) override
+    {}
+    void AddListener(const ListenFunc &) override
+    {}
+
+private:
+    std::string mId;
+};
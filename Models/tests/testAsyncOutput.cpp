@@ -0,0 +1,104 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/tests/ProducingComponent.h"
+#include "Models/CommImp/AsyncOutput.h"
+#include "Models/CommImp/ElementSet.h"
+#include "Models/CommImp/Input.h"
+#include "Models/CommImp/Quantity.h"
+#include "Models/CommImp/RemoteOutput.h"
+#include "Models/CommImp/Time.h"
+#include "Models/CommImp/TimeSet.h"
+#include "Models/CommImp/Unit.h"
+#include "Models/CommImp/ValueSetDense.h"
+#include "Models/Utils/Exception.h"
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+TEST_CASE("AsyncOutput tests")
+{
+    const int capacity = 2;
+
+    auto quantity = make_shared<Quantity>(
+        make_shared<Unit>(PredefinedUnits::Meter), "depth", "Water depth");
+
+    vector<Element> elements;
+    elements.emplace_back("0", "0", "0", vector<Coordinate>{{0, 0, 0}});
+    elements.emplace_back("1", "1", "1", vector<Coordinate>{{1, 0, 0}});
+    auto elementSet =
+        make_shared<ElementSet>("points", "", ElementType::Point, elements);
+
+    auto comp    = make_shared<ProducingComponent>(8);
+    comp->output = make_shared<RemoteOutput>("out", comp, quantity, elementSet);
+
+    auto input = make_shared<Input>("in", comp);
+    input->SetValues(make_shared<ValueSetDense<real>>(quantity));
+    input->SetElementSet(elementSet);
+
+    auto output = make_shared<AsyncOutput>("async", comp->output, capacity);
+    output->AddConsumer(input);
+
+    auto queryAt = [&](double time) {
+        input->SetTimeSet(
+            make_shared<TimeSet>(vector<shared_ptr<ITime>>{make_shared<Time>(time)}));
+
+        auto values = dynamic_pointer_cast<ValueSetDense<real>>(output->GetValues());
+        int  times  = values->GetIndexCount({0});
+        return values->GetElementValuesForTimeSpan(times - 1);
+    };
+
+    SECTION("consume produced steps")
+    {
+        output->Start();
+        REQUIRE(output->IsStarted());
+
+        for (int step = 1; step <= 8; step++)
+        {
+            auto row = queryAt(step);
+            REQUIRE(row.size() == 2);
+            REQUIRE(row[0] == Approx(step));
+            REQUIRE(row[1] == Approx(2. * step));
+
+            // The producer is ahead by the ring capacity and the step in progress.
+            REQUIRE(comp->steps <= step + capacity + 1);
+        }
+
+        output->Stop();
+        REQUIRE(comp->steps == 8);
+    }
+
+    SECTION("query past the producer end")
+    {
+        output->Start();
+
+        // The consumer stops waiting once the producer is done.
+        input->SetTimeSet(
+            make_shared<TimeSet>(vector<shared_ptr<ITime>>{make_shared<Time>(20.)}));
+        output->GetValues();
+        REQUIRE(comp->steps == 8);
+
+        output->Stop();
+    }
+
+    SECTION("producer failure")
+    {
+        comp->failAt = 3;
+        output->Start();
+
+        REQUIRE_THROWS_AS(queryAt(5), IllegalStateException);
+        output->Stop();
+    }
+
+    SECTION("stop a blocked producer")
+    {
+        output->Start();
+        queryAt(1);
+
+        // The producer waits on the full ring, and is woken to stop.
+        output->Stop();
+        REQUIRE_FALSE(output->IsStarted());
+        REQUIRE(comp->steps <= 1 + capacity + 1);
+    }
+}
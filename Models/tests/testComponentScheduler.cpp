@@ -0,0 +1,216 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/DevSupports/ComponentScheduler.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace std;
+
+
+// Number of components updating at the same time, and its peak.
+struct Concurrency
+{
+    atomic<int> count = 0;
+    atomic<int> peak  = 0;
+};
+
+
+// Component pulling its providers to its next step on each update, which updates the
+// providers behind as `Output::Update()` does, and recording whether it was updated
+// concurrently, or read while updated.
+class StubComponent : public ILinkableComponent
+{
+public:
+    vector<StubComponent *> providers;
+
+    int          steps      = 0;
+    int          maxSteps   = 0;
+    atomic<int>  updating   = 0;
+    atomic<int>  reading    = 0;
+    atomic<bool> overlapped = false;
+
+    Concurrency *concurrency = nullptr;
+
+    StubComponent(int maxSteps) : maxSteps(maxSteps)
+    {}
+
+    void Serve(int step)
+    {
+        while (steps < step && GetStatus() == LinkableComponentStatus::Updated)
+        {
+            Update();
+        }
+
+        reading++;
+        if (updating > 0)
+        {
+            overlapped = true;
+        }
+        this_thread::sleep_for(chrono::microseconds(50));
+        reading--;
+    }
+
+    void Update() override
+    {
+        if (++updating > 1 || reading > 0)
+        {
+            overlapped = true;
+        }
+
+        if (concurrency)
+        {
+            int count = ++concurrency->count;
+            int peak  = concurrency->peak;
+            while (count > peak)
+            {
+                if (concurrency->peak.compare_exchange_weak(peak, count))
+                {
+                    break;
+                }
+            }
+        }
+
+        for (auto provider : providers)
+        {
+            provider->Serve(steps + 1);
+        }
+        this_thread::sleep_for(chrono::microseconds(200));
+        steps++;
+
+        if (concurrency)
+        {
+            concurrency->count--;
+        }
+        updating--;
+    }
+
+    LinkableComponentStatus GetStatus() const override
+    {
+        return steps < maxSteps ? LinkableComponentStatus::Updated
+                                : LinkableComponentStatus::Done;
+    }
+
+    string GetId() const override
+    {
+        return "";
+    }
+    string GetCaption() const override
+    {
+        return "";
+    }
+    void SetCaption(const string &) override
+    {}
+    string GetDescription() const override
+    {
+        return "";
+    }
+    void SetDescription(const string &) override
+    {}
+    vector<shared_ptr<IArgument>> GetArguments() const override
+    {
+        return {};
+    }
+    vector<shared_ptr<IInput>> GetInputs() const override
+    {
+        return {};
+    }
+    vector<shared_ptr<IOutput>> GetOutputs() const override
+    {
+        return {};
+    }
+    vector<shared_ptr<IAdaptedOutputFactory>> GetAdaptedOutputFactories() const override
+    {
+        return {};
+    }
+    void Initialize() override
+    {}
+    vector<string> Validate() override
+    {
+        return {};
+    }
+    void Prepare() override
+    {}
+    void Finish() override
+    {}
+    void RemoveListener(const ListenFunc &) override
+    {}
+    void AddListener(const ListenFunc &) override
+    {}
+};
+
+
+TEST_CASE("ComponentScheduler tests")
+{
+    const int steps = 40;
+
+    ComponentScheduler scheduler(4);
+
+    SECTION("three-component chain")
+    {
+        StubComponent a(steps), b(steps), c(steps);
+        b.providers = {&a};
+        c.providers = {&b};
+
+        scheduler.AddComponent("a", &a);
+        scheduler.AddComponent("b", &b);
+        scheduler.AddComponent("c", &c);
+        scheduler.AddDependency("b", "a");
+        scheduler.AddDependency("c", "b");
+
+        REQUIRE(scheduler.GetStages().size() == 3);
+
+        auto result = scheduler.Run();
+        REQUIRE(result.at("a") == steps);
+        REQUIRE(result.at("b") == steps);
+        REQUIRE(result.at("c") == steps);
+        REQUIRE_FALSE(a.overlapped);
+        REQUIRE_FALSE(b.overlapped);
+        REQUIRE_FALSE(c.overlapped);
+    }
+
+    SECTION("consumers sharing a provider")
+    {
+        StubComponent a(steps), b(steps), c(steps), d(steps);
+        b.providers = {&a};
+        c.providers = {&a};
+
+        scheduler.AddComponent("a", &a);
+        scheduler.AddComponent("b", &b);
+        scheduler.AddComponent("c", &c);
+        scheduler.AddComponent("d", &d);
+        scheduler.AddDependency("b", "a");
+        scheduler.AddDependency("c", "a");
+
+        auto result = scheduler.Run();
+        REQUIRE(result.at("d") == steps);
+        REQUIRE_FALSE(a.overlapped);
+        REQUIRE_FALSE(b.overlapped);
+        REQUIRE_FALSE(c.overlapped);
+    }
+
+    SECTION("consumers of a provider caught up run concurrently")
+    {
+        Concurrency consumers;
+
+        StubComponent a(steps), b(steps), c(steps);
+        b.providers   = {&a};
+        c.providers   = {&a};
+        b.concurrency = &consumers;
+        c.concurrency = &consumers;
+
+        scheduler.AddComponent("a", &a);
+        scheduler.AddComponent("b", &b);
+        scheduler.AddComponent("c", &c);
+        scheduler.AddDependency("b", "a");
+        scheduler.AddDependency("c", "a");
+
+        auto result = scheduler.Run();
+        REQUIRE(result.at("a") == steps);
+        REQUIRE(result.at("b") == steps);
+        REQUIRE(result.at("c") == steps);
+        REQUIRE_FALSE(a.overlapped);
+        REQUIRE(consumers.peak == 2);
+    }
+}
@@ -0,0 +1,144 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/DevSupports/ConvergenceAccelerator.h"
+#include <cmath>
+#include <functional>
+
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace std;
+
+using FixedPointMap = function<vector<real>(const vector<real> &)>;
+using Method        = ConvergenceAccelerator::Method;
+
+
+// Iterates x = G(x) from x0, returns the number of sweeps to reach the tolerance.
+int SolveFixedPoint(
+    ConvergenceAccelerator &accelerator, const FixedPointMap &sweep, vector<real> &x,
+    double tol = 1.e-8, int maxIter = 500)
+{
+    accelerator.Reset();
+    for (int iter = 1; iter <= maxIter; iter++)
+    {
+        auto result = sweep(x);
+
+        double norm = 0;
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            norm += (result[i] - x[i]) * (result[i] - x[i]);
+        }
+        if (sqrt(norm) < tol)
+        {
+            x = result;
+            return iter;
+        }
+
+        x = accelerator.Accelerate(x, result);
+    }
+
+    return maxIter + 1;
+}
+
+
+TEST_CASE("ConvergenceAccelerator tests")
+{
+    // Stiff two-way coupling of two fields, e.g., surface and subsurface heads,
+    // where each field responds strongly to the other: G(x) = b + M * x.
+    const int    n = 8;
+    const double a = 0.95;
+
+    FixedPointMap linearSweep = [&](const vector<real> &x) {
+        vector<real> y(2 * n);
+        for (int i = 0; i < n; i++)
+        {
+            y[i]     = 1.0 + 0.1 * i - a * x[n + i];
+            y[n + i] = 0.5 - a * x[i];
+        }
+        return y;
+    };
+
+    // Nonlinear coupling with a non-symmetric Jacobian.
+    FixedPointMap nonlinearSweep = [](const vector<real> &x) {
+        return vector<real>{cos(x[1]), 0.9 * sin(x[0]) + 0.5 * x[1] - 0.2};
+    };
+
+    SECTION("argument checks")
+    {
+        REQUIRE_THROWS(ConvergenceAccelerator(Method::Aitken, 0));
+        REQUIRE_THROWS(ConvergenceAccelerator(Method::Anderson, 0.5, 0));
+        REQUIRE_THROWS(ConvergenceAccelerator::ParseMethod("newton"));
+        REQUIRE(ConvergenceAccelerator::ParseMethod("Anderson") == Method::Anderson);
+
+        ConvergenceAccelerator accelerator;
+        REQUIRE_THROWS(accelerator.Accelerate({1, 2}, {1}));
+    }
+
+    SECTION("constant relaxation")
+    {
+        ConvergenceAccelerator accelerator(Method::Constant, 0.5);
+
+        vector<real> x = {0, 0};
+        auto         y = accelerator.Accelerate(x, {1, 2});
+        REQUIRE(y[0] == Approx(0.5));
+        REQUIRE(y[1] == Approx(1.0));
+        REQUIRE(accelerator.GetRelaxation() == Approx(0.5));
+    }
+
+    SECTION("linear stiff coupling")
+    {
+        ConvergenceAccelerator constant(Method::Constant, 0.25);
+        ConvergenceAccelerator aitken(Method::Aitken, 0.25);
+        ConvergenceAccelerator anderson(Method::Anderson, 0.25, 5);
+
+        vector<real> x1(2 * n, 0), x2(2 * n, 0), x3(2 * n, 0);
+
+        int constantIters = SolveFixedPoint(constant, linearSweep, x1);
+        int aitkenIters   = SolveFixedPoint(aitken, linearSweep, x2);
+        int andersonIters = SolveFixedPoint(anderson, linearSweep, x3);
+
+        REQUIRE(constantIters > 100);
+        REQUIRE(aitkenIters <= 15);
+        REQUIRE(andersonIters <= 5);
+
+        // Accelerated methods converge to the exact fixed point.
+        for (int i = 0; i < n; i++)
+        {
+            double xs = (1.0 + 0.1 * i - 0.5 * a) / (1 - a * a);
+            double xg = 0.5 - a * xs;
+            REQUIRE(x2[i] == Approx(xs).margin(1.e-6));
+            REQUIRE(x3[i] == Approx(xs).margin(1.e-6));
+            REQUIRE(x2[n + i] == Approx(xg).margin(1.e-6));
+            REQUIRE(x3[n + i] == Approx(xg).margin(1.e-6));
+        }
+    }
+
+    SECTION("nonlinear coupling")
+    {
+        ConvergenceAccelerator constant(Method::Constant, 0.25);
+        ConvergenceAccelerator aitken(Method::Aitken, 0.25);
+        ConvergenceAccelerator anderson(Method::Anderson, 0.25, 3);
+
+        vector<real> x1 = {0, 0}, x2 = {0, 0}, x3 = {0, 0};
+
+        int constantIters = SolveFixedPoint(constant, nonlinearSweep, x1);
+        int aitkenIters   = SolveFixedPoint(aitken, nonlinearSweep, x2);
+        int andersonIters = SolveFixedPoint(anderson, nonlinearSweep, x3);
+
+        REQUIRE(aitkenIters < constantIters);
+        REQUIRE(andersonIters < aitkenIters);
+
+        auto y = nonlinearSweep(x3);
+        REQUIRE(y[0] == Approx(x3[0]).margin(1.e-6));
+        REQUIRE(y[1] == Approx(x3[1]).margin(1.e-6));
+    }
+
+    SECTION("history reset on size change")
+    {
+        ConvergenceAccelerator accelerator(Method::Anderson, 1.0);
+
+        accelerator.Accelerate({0, 0}, {1, 1});
+        accelerator.Accelerate({1, 1}, {1.5, 1.5});
+
+        auto y = accelerator.Accelerate({0, 0, 0}, {1, 2, 3});
+        REQUIRE(y.size() == 3);
+        REQUIRE(y[2] == Approx(3));
+    }
+}
@@ -0,0 +1,85 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/DevSupports/CouplingStepController.h"
+#include "Models/CommImp/ValueSetDense.h"
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+shared_ptr<IValueSet> MakeValues(const vector<real> &values)
+{
+    return make_shared<ValueSetDense<real>>(
+        vector<vector<real>>{values}, shared_ptr<IValueDefinition>());
+}
+
+
+TEST_CASE("CouplingStepController tests")
+{
+    CouplingStepController controller(1., 8., 0.01);
+
+    // Exchanges the values at the time, and returns the new interval.
+    double time     = 0;
+    auto   exchange = [&](const vector<real> &values) {
+        REQUIRE(controller.IsExchangeDue(time));
+        controller.Observe("input", MakeValues(values));
+        controller.CompleteExchange(time);
+
+        time += controller.GetInterval();
+        return controller.GetInterval();
+    };
+
+    SECTION("exchange due")
+    {
+        REQUIRE(controller.IsExchangeDue(0));
+        controller.Observe("input", MakeValues({1, 2}));
+        controller.CompleteExchange(0);
+        REQUIRE(controller.GetInterval() == 1.);
+
+        REQUIRE_FALSE(controller.IsExchangeDue(0.5));
+        REQUIRE_FALSE(controller.IsExchangeDue(0.99));
+        REQUIRE(controller.IsExchangeDue(1.));
+        REQUIRE(controller.GetSkippedCount() == 2);
+        REQUIRE(controller.GetExchangeCount() == 1);
+    }
+
+    SECTION("interval growth and shrink")
+    {
+        // The first exchange has nothing to compare with.
+        REQUIRE(exchange({1, 2}) == 1.);
+
+        // Identical values widen the interval up to the maximum.
+        REQUIRE(exchange({1, 2}) == 2.);
+        REQUIRE(exchange({1, 2}) == 4.);
+        REQUIRE(exchange({1, 2}) == 8.);
+        REQUIRE(exchange({1, 2}) == 8.);
+        REQUIRE(controller.GetLastChange() == 0);
+
+        // A change near the tolerance keeps the interval.
+        REQUIRE(exchange({1.009, 2.018}) == 8.);
+
+        // Large changes shrink the interval down to the minimum.
+        double interval = controller.GetInterval();
+        REQUIRE(exchange({2, 4}) == Approx(interval * 0.5));
+        REQUIRE(exchange({4, 8}) == Approx(interval * 0.25));
+        REQUIRE(exchange({8, 16}) == 1.);
+        REQUIRE(exchange({16, 32}) == 1.);
+        REQUIRE(controller.GetLastChange() == Approx(0.5));
+    }
+
+    SECTION("incomparable values")
+    {
+        exchange({1, 2});
+        exchange({1, 2});
+        REQUIRE(controller.GetInterval() == 2.);
+
+        // Values of another size restart from the minimum interval.
+        REQUIRE(exchange({1, 2, 3}) == 1.);
+
+        controller.Reset();
+        REQUIRE(controller.GetExchangeCount() == 0);
+        REQUIRE(controller.IsExchangeDue(time));
+    }
+}
@@ -0,0 +1,76 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/Utils/CsvChunkReader.h"
+#include "Models/Utils/Exception.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+TEST_CASE("CsvChunkReader tests")
+{
+    const auto path = filesystem::temp_directory_path() / "testCsvChunkReader.csv";
+    const auto file = path.string();
+
+    auto write = [&](const string &content) {
+        ofstream stream(file, ios::binary | ios::trunc);
+        stream << content;
+    };
+
+    SECTION("index labels")
+    {
+        string csv = "id,x,y,z\r\n"
+                     "# comment line\n"
+                     "0, 1.5, -2, +3e2\n"
+                     "\n"
+                     "1,4,5,6\n";
+        for (int i = 2; i < 1000; i++)
+        {
+            csv += to_string(i) + "," + to_string(i) + ",0.25,\n";
+        }
+        write(csv);
+
+        // Small chunks to parse in many pieces.
+        for (size_t chunkSize : {size_t(7), size_t(1) << 22})
+        {
+            auto rows = CsvChunkReader::Read<double>(
+                file, true, CsvLabelMode::Index, ',', chunkSize);
+
+            REQUIRE(rows.GetRowCount() == 1000);
+            REQUIRE(rows.labels.empty());
+            REQUIRE(rows.GetRowSize(0) == 3);
+            REQUIRE(rows.values[0] == 1.5);
+            REQUIRE(rows.values[2] == 300);
+            REQUIRE(rows.values[5] == 6);
+            REQUIRE(rows.GetRowSize(999) == 2);
+            REQUIRE(rows.values[rows.offsets[999]] == 999);
+            REQUIRE(rows.offsets.back() == rows.values.size());
+        }
+    }
+
+    SECTION("text labels")
+    {
+        write("inlet,1,2,3\n\"outlet\",4\n");
+
+        auto rows = CsvChunkReader::Read<int>(file, false, CsvLabelMode::Text);
+        REQUIRE(rows.labels == vector<string>{"inlet", "outlet"});
+        REQUIRE(rows.values == vector<int>{1, 2, 3, 4});
+        REQUIRE(rows.offsets == vector<size_t>{0, 3, 4});
+    }
+
+    SECTION("invalid data")
+    {
+        write("id,a\n0,1\n2,3\n");
+        REQUIRE_THROWS_AS(
+            CsvChunkReader::Read<int>(file, true, CsvLabelMode::Index),
+            InvalidDataException);
+
+        write("id,a\n0,1\n1,x3\n");
+        REQUIRE_THROWS_AS(
+            CsvChunkReader::Read<int>(file, true, CsvLabelMode::Index),
+            InvalidDataException);
+    }
+
+    filesystem::remove(file);
+}
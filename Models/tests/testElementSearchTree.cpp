@@ -0,0 +1,65 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/DevSupports/ElementSearchTree.h"
+#include <set>
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace std;
+
+
+TEST_CASE("Element search tree tests")
+{
+    // Points on a 40 x 30 grid with unit spacing, indexed row by row.
+    ElementSearchTree<int> tree;
+    for (int j = 0; j < 30; j++)
+    {
+        for (int i = 0; i < 40; i++)
+        {
+            tree.AddElement(j * 40 + i, GeomExtent{(real)i, (real)i, (real)j, (real)j});
+        }
+    }
+
+    REQUIRE_THROWS(tree.FindElements(GeomExtent{}));
+    tree.Build();
+
+    SECTION("packing")
+    {
+        REQUIRE(tree.MaxElementsInNode() == tree.MaxElementsPerNode);
+        REQUIRE(tree.Depth() == 3);
+
+        auto extent = tree.GetExtent();
+        REQUIRE(extent.xMin == 0);
+        REQUIRE(extent.xMax == 39);
+        REQUIRE(extent.yMax == 29);
+    }
+
+    SECTION("extent queries")
+    {
+        auto elmts = tree.FindElements(GeomExtent{2.5, 5, 10, 11});
+        REQUIRE(
+            set<int>(elmts.begin(), elmts.end())
+            == set<int>{403, 404, 405, 443, 444, 445});
+        REQUIRE(tree.FindElements(GeomExtent{40.5, 41, 0, 1}).empty());
+
+        auto batch =
+            tree.FindElements(vector<GeomExtent>{{0, 39, 0, 29}, {7, 7, 3, 3}});
+        REQUIRE(batch[0].size() == 1200);
+        REQUIRE(batch[1] == vector<int>{127});
+    }
+
+    SECTION("nearest queries")
+    {
+        auto nearest = tree.FindNearest(GeomExtent{10.2, 10.2, 20.1, 20.1}, 3);
+        REQUIRE(nearest.size() == 3);
+        REQUIRE(nearest[0] == 810);
+        REQUIRE(set<int>(nearest.begin() + 1, nearest.end()) == set<int>{811, 850});
+
+        // Exact distance weighting the y axis more.
+        nearest = tree.FindNearest(GeomExtent{-5, -5, 0.4, 0.4}, 2, [](int e) {
+            return hypot(e % 40 + 5, 10 * (e / 40 - 0.4));
+        });
+        REQUIRE(nearest == vector<int>{0, 1});
+
+        REQUIRE(tree.FindNearest(GeomExtent{}, 2000).size() == 1200);
+    }
+}
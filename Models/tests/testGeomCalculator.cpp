@@ -0,0 +1,63 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/Spatial/GeomCalculator.h"
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp::Spatial;
+using namespace std;
+
+
+TEST_CASE("Polygon shared area tests")
+{
+    Polygon square   = {{0, 0}, {2, 0}, {2, 2}, {0, 2}};
+    Polygon shifted  = {{1, 1}, {3, 1}, {3, 3}, {1, 3}};
+    Polygon triangle = {{0, 0}, {4, 0}, {0, 4}};
+
+    // L shape of the square {0, 4} x {0, 4} without the corner {2, 4} x {2, 4},
+    // clockwise.
+    Polygon shapeL = {{0, 0}, {0, 4}, {2, 4}, {2, 2}, {4, 2}, {4, 0}};
+
+    SECTION("convex polygons")
+    {
+        REQUIRE(GeomCalculator::IsConvexPolygon(square));
+        REQUIRE(GeomCalculator::IsConvexPolygon(triangle));
+        REQUIRE_FALSE(GeomCalculator::IsConvexPolygon(shapeL));
+
+        auto shared = GeomCalculator::ClipPolygon(square, shifted);
+        REQUIRE(GeomCalculator::CalculateAreaOfPolygon(shared) == Approx(1));
+        REQUIRE(
+            GeomCalculator::CalculatePolygonSharedArea(square, triangle)
+            == Approx(4));
+        REQUIRE(
+            GeomCalculator::CalculatePolygonSharedArea(triangle, square)
+            == Approx(4));
+
+        Polygon far = {{5, 5}, {6, 5}, {6, 6}};
+        REQUIRE(GeomCalculator::CalculatePolygonSharedArea(far, square) == 0);
+    }
+
+    SECTION("concave polygons")
+    {
+        auto triangles = GeomCalculator::SplitPolygonToTriangles(shapeL);
+        REQUIRE(triangles.size() == 4);
+
+        real area = 0;
+        for (const auto &t : triangles)
+        {
+            area += GeomCalculator::CalculateAreaOfPolygon(t);
+        }
+        REQUIRE(area == Approx(12));
+
+        REQUIRE(
+            GeomCalculator::CalculatePolygonSharedArea(shapeL, shifted)
+            == Approx(3));
+        REQUIRE(
+            GeomCalculator::CalculatePolygonSharedArea(shapeL, triangle)
+            == Approx(8));
+
+        // Mirrored L shape, overlapping on {2, 4} x {0, 2} and {0, 2} x {2, 4}.
+        Polygon mirrored = {{4, 4}, {4, 0}, {2, 0}, {2, 2}, {0, 2}, {0, 4}};
+        REQUIRE(
+            GeomCalculator::CalculatePolygonSharedArea(shapeL, mirrored)
+            == Approx(8));
+    }
+}
@@ -0,0 +1,222 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/Spatial/Grid.h"
+#include <omp.h>
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::CommImp::Numeric;
+using namespace OpenOasis::CommImp::Spatial;
+using namespace std;
+
+
+// Mesh of `nx` by `ny` unit squares, numbered row by row from the bottom. The
+// horizontal faces come before the vertical ones, and the faces of each cell are
+// ordered bottom, right, top and left, e.g. for two squares side by side:
+//
+//   3 --2-- 4 --3-- 5
+//   |       |       |
+//   4   0   5   1   6
+//   |       |       |
+//   0 --0-- 1 --1-- 2
+Mesh CreateSquares(size_t nx, size_t ny)
+{
+    Mesh mesh;
+
+    auto node  = [&](size_t i, size_t j) { return j * (nx + 1) + i; };
+    auto hFace = [&](size_t i, size_t j) { return j * nx + i; };
+    auto vFace = [&](size_t i, size_t j) { return nx * (ny + 1) + j * (nx + 1) + i; };
+
+    auto addFace = [&](size_t fIdx, size_t n0, size_t n1) {
+        const auto &c0 = mesh.nodes[n0].coor;
+        const auto &c1 = mesh.nodes[n1].coor;
+
+        mesh.faces[fIdx].nodeIndexes = {n0, n1};
+        mesh.faces[fIdx].centroid    = {(c0.x + c1.x) / 2, (c0.y + c1.y) / 2, 0};
+    };
+
+    for (size_t j = 0; j <= ny; j++)
+    {
+        for (size_t i = 0; i <= nx; i++)
+        {
+            mesh.nodes[node(i, j)].coor = {(real)i, (real)j, 0};
+        }
+    }
+
+    for (size_t j = 0; j <= ny; j++)
+    {
+        for (size_t i = 0; i < nx; i++)
+        {
+            addFace(hFace(i, j), node(i, j), node(i + 1, j));
+        }
+    }
+
+    for (size_t j = 0; j < ny; j++)
+    {
+        for (size_t i = 0; i <= nx; i++)
+        {
+            addFace(vFace(i, j), node(i, j), node(i, j + 1));
+        }
+    }
+
+    for (size_t j = 0; j < ny; j++)
+    {
+        for (size_t i = 0; i < nx; i++)
+        {
+            auto &cell = mesh.cells[j * nx + i];
+            cell.faceIndexes = {
+                hFace(i, j), vFace(i + 1, j), hFace(i, j + 1), vFace(i, j)};
+            cell.centroid = {i + 0.5, j + 0.5, 0};
+        }
+    }
+
+    return mesh;
+}
+
+void RequireSame(const Vector<real> &a, const Vector<real> &b)
+{
+    for (size_t i = 0; i < a.Size(); i++)
+    {
+        REQUIRE(a(i) == Approx(b(i)));
+    }
+}
+
+TEST_CASE("Grid tests")
+{
+    auto grid = make_shared<Grid>(CreateSquares(2, 1));
+    grid->Activate();
+
+    const auto &mesh = grid->GetCompactMesh();
+
+    SECTION("compact geometry")
+    {
+        REQUIRE(mesh.nodeCoords.size() == 6);
+        for (size_t i = 0; i < 6; i++)
+        {
+            REQUIRE(mesh.nodeCoords[i].x == grid->GetNode(i).coor.x);
+            REQUIRE(mesh.nodeCoords[i].y == grid->GetNode(i).coor.y);
+        }
+
+        REQUIRE(mesh.faceAreas.size() == 7);
+        for (size_t i = 0; i < 7; i++)
+        {
+            const auto &face = grid->GetFace(i);
+            REQUIRE(mesh.faceCentroids[i].x == face.centroid.x);
+            REQUIRE(mesh.faceCentroids[i].y == face.centroid.y);
+            RequireSame(mesh.faceNormals[i], face.normal);
+            REQUIRE(mesh.faceAreas[i] == Approx(1.));
+            REQUIRE(mesh.facePerimeters[i] == face.perimeter);
+        }
+
+        REQUIRE(mesh.cellVolumes.size() == 2);
+        for (size_t i = 0; i < 2; i++)
+        {
+            const auto &cell = grid->GetCell(i);
+            REQUIRE(mesh.cellCentroids[i].x == cell.centroid.x);
+            REQUIRE(mesh.cellSurfaces[i] == cell.surface);
+            REQUIRE(mesh.cellVolumes[i] == cell.volume);
+        }
+    }
+
+    SECTION("compact face and cell connectivity")
+    {
+        REQUIRE(mesh.faceNodes.Size() == 7);
+        REQUIRE(mesh.faceNodes.offsets.back() == 14);
+        REQUIRE(
+            mesh.faceNodes.indexes
+            == vector<size_t>{0, 1, 1, 2, 3, 4, 4, 5, 0, 3, 1, 4, 2, 5});
+
+        REQUIRE(mesh.cellFaces.Size() == 2);
+        REQUIRE(mesh.cellFaces.offsets == vector<size_t>{0, 4, 8});
+        REQUIRE(mesh.cellFaces.indexes == vector<size_t>{0, 5, 2, 4, 1, 6, 3, 5});
+
+        // The sides of the cells are packed along the cells of each face.
+        REQUIRE(mesh.faceCellSides == vector<int>{-1, -1, 1, 1, 1, -1, 1, -1});
+    }
+
+    SECTION("inverse connectivity")
+    {
+        auto rows = [](const Connectivity &conn) {
+            vector<vector<size_t>> indexes;
+            for (size_t i = 0; i < conn.Size(); i++)
+            {
+                indexes.push_back(conn[i].ToVector());
+            }
+            return indexes;
+        };
+
+        using Rows = vector<vector<size_t>>;
+        REQUIRE(rows(mesh.nodeCells) == Rows{{0}, {0, 1}, {1}, {0}, {0, 1}, {1}});
+        REQUIRE(
+            rows(mesh.nodeFaces)
+            == Rows{{0, 4}, {0, 1, 5}, {1, 6}, {2, 4}, {2, 3, 5}, {3, 6}});
+        REQUIRE(rows(mesh.faceCells) == Rows{{0}, {1}, {0}, {1}, {0}, {0, 1}, {1}});
+        REQUIRE(rows(mesh.cellNeighbors) == Rows{{1}, {0}});
+
+    }
+
+    SECTION("connections released from the elements")
+    {
+        for (size_t i = 0; i < 7; i++)
+        {
+            REQUIRE(grid->GetFace(i).nodeIndexes.capacity() == 0);
+            REQUIRE(grid->GetFace(i).cellIndexes.capacity() == 0);
+            REQUIRE(grid->GetFace(i).cellOwnable.capacity() == 0);
+        }
+        for (size_t i = 0; i < 2; i++)
+        {
+            REQUIRE(grid->GetCell(i).faceIndexes.capacity() == 0);
+            REQUIRE(grid->GetCell(i).neighbors.capacity() == 0);
+        }
+
+        // Activated again from the connections packed.
+        const auto faceNodes     = mesh.faceNodes;
+        const auto faceCells     = mesh.faceCells;
+        const auto faceCellSides = mesh.faceCellSides;
+        const auto faceAreas     = mesh.faceAreas;
+
+        grid->Activate();
+
+        REQUIRE(mesh.faceNodes.indexes == faceNodes.indexes);
+        REQUIRE(mesh.faceCells.indexes == faceCells.indexes);
+        REQUIRE(mesh.faceCellSides == faceCellSides);
+        REQUIRE(mesh.faceAreas == faceAreas);
+        REQUIRE(grid->GetFace(0).nodeIndexes.capacity() == 0);
+    }
+
+    SECTION("parallel connectivity in the serial order")
+    {
+        auto build = [](int threads) {
+            int maxThreads = omp_get_max_threads();
+            omp_set_num_threads(threads);
+
+            auto grid = make_shared<Grid>(CreateSquares(40, 30));
+            grid->Activate();
+
+            omp_set_num_threads(maxThreads);
+            return grid;
+        };
+
+        auto serial   = build(1);
+        auto parallel = build(4);
+
+        const auto &expected = serial->GetCompactMesh();
+        const auto &actual   = parallel->GetCompactMesh();
+
+        auto requireSame = [](const Connectivity &a, const Connectivity &b) {
+            REQUIRE(a.offsets == b.offsets);
+            REQUIRE(a.indexes == b.indexes);
+        };
+
+        requireSame(actual.nodeCells, expected.nodeCells);
+        requireSame(actual.nodeFaces, expected.nodeFaces);
+        requireSame(actual.faceCells, expected.faceCells);
+        requireSame(actual.cellFaces, expected.cellFaces);
+        requireSame(actual.cellNeighbors, expected.cellNeighbors);
+        requireSame(actual.faceNodes, expected.faceNodes);
+        REQUIRE(actual.faceCellSides == expected.faceCellSides);
+
+        // Each inner node, e.g. the node (1, 1), is shared by four cells and faces.
+        REQUIRE(expected.nodeCells.Count(42) == 4);
+        REQUIRE(expected.nodeFaces.Count(42) == 4);
+    }
+}
@@ -0,0 +1,223 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/DevSupports/IterationController.h"
+#include "Models/CommImp/ElementSet.h"
+#include "Models/CommImp/Identifier.h"
+#include "Models/CommImp/Input.h"
+#include "Models/CommImp/Output.h"
+#include "Models/CommImp/Quantity.h"
+#include "Models/CommImp/Time.h"
+#include "Models/CommImp/TimeSet.h"
+#include "Models/CommImp/Unit.h"
+#include "Models/CommImp/ValueSetDense.h"
+#include <atomic>
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace std;
+
+
+// Component of one value `x = slope * y + offset`, where `y` is the value of its
+// input, stepping one day per time step within two days.
+class CoupledComponent : public LinkableComponent
+{
+public:
+    shared_ptr<Output> output;
+    shared_ptr<Input>  input;
+
+    shared_ptr<IQuantity>   quantity;
+    shared_ptr<IElementSet> elementSet;
+
+    double slope = 0, offset = 0;
+    double x = 0, y = 0;
+
+    atomic<int> evaluations = 0;
+    atomic<int> restores    = 0;
+
+    unordered_map<string, pair<double, double>> states;
+
+    CoupledComponent(const string &id, double slope, double offset) :
+        LinkableComponent(id), slope(slope), offset(offset)
+    {}
+
+    double Now() const
+    {
+        return mCurrentTime->GetTimeStamp();
+    }
+
+    shared_ptr<IIdentifiable> KeepCurrentState() override
+    {
+        string id     = to_string(states.size());
+        states[id]    = {Now(), x};
+        return make_shared<Identifier>(id);
+    }
+
+    void RestoreState(const shared_ptr<IIdentifiable> &stateId) override
+    {
+        const auto &state = states.at(stateId->GetId());
+        mCurrentTime      = make_shared<Time>(state.first);
+        x                 = state.second;
+        restores++;
+    }
+
+    void ClearState(const shared_ptr<IIdentifiable> &stateId) override
+    {
+        states.erase(stateId->GetId());
+    }
+
+protected:
+    void InitializeArguments() override
+    {}
+    void InitializeSpace() override
+    {}
+    void InitializeTime() override
+    {
+        mTimeExtent = make_shared<TimeSet>(
+            vector<shared_ptr<ITime>>{make_shared<Time>(0., 2.)});
+        mCurrentTime = make_shared<Time>(0.);
+    }
+    void InitializeInputs() override
+    {
+        input = make_shared<Input>("in", shared_from_this());
+        input->SetValues(make_shared<ValueSetDense<real>>(quantity));
+        input->SetTimeSet(
+            make_shared<TimeSet>(vector<shared_ptr<ITime>>{make_shared<Time>(0.)}));
+        input->SetElementSet(elementSet);
+        mInputs = {input};
+    }
+    void InitializeOutputs() override
+    {
+        output = make_shared<Output>("out", shared_from_this());
+        output->SetValues(make_shared<ValueSetDense<real>>(quantity));
+        output->SetTimeSet(make_shared<TimeSet>());
+        output->SetElementSet(elementSet);
+        mOutputs = {output};
+    }
+    vector<string> OnValidate() override
+    {
+        return {};
+    }
+    void PrepareInputs() override
+    {}
+    void PrepareOutputs() override
+    {}
+
+    void ApplyInputData(const shared_ptr<IValueSet> &values) override
+    {
+        auto dense = dynamic_pointer_cast<ValueSetDense<real>>(values);
+        y          = dense->GetTimesCount() > 0 ? dense->Get(0, 0) : 0.;
+    }
+
+    void UpdateOutputs(const vector<shared_ptr<IOutput>> &) override
+    {
+        // The output keeps the values of the latest time step only.
+        auto values = dynamic_pointer_cast<ValueSetDense<real>>(output->GetValues());
+        auto times  = dynamic_pointer_cast<TimeSet>(output->GetTimeSet());
+        if (values->GetTimesCount() == 0)
+        {
+            values->AddElementValuesForTime(vector<real>{x});
+            times->AddTime(make_shared<Time>(Now()));
+            return;
+        }
+
+        values->Set(0, 0, x);
+        (*times)[0] = make_shared<Time>(Now());
+    }
+
+    void PerformTimestep(const vector<shared_ptr<IOutput>> &) override
+    {
+        x            = slope * y + offset;
+        mCurrentTime = make_shared<Time>(Now() + 1.);
+        evaluations++;
+    }
+};
+
+
+TEST_CASE("IterationController tests")
+{
+    auto quantity = make_shared<Quantity>(
+        make_shared<Unit>(PredefinedUnits::Meter), "depth", "Water depth", (real)-9999);
+
+    vector<Element> elements;
+    elements.emplace_back("0", "0", "0", vector<Coordinate>{{0, 0, 0}});
+    auto elementSet =
+        make_shared<ElementSet>("points", "", ElementType::Point, elements);
+
+    // The fixed point of x = 0.5 * y + 1, y = 0.5 * x + 1 is x = y = 2.
+    auto a = make_shared<CoupledComponent>("a", 0.5, 1.);
+    auto b = make_shared<CoupledComponent>("b", 0.5, 1.);
+    for (const auto &comp : {a, b})
+    {
+        comp->quantity   = quantity;
+        comp->elementSet = elementSet;
+        comp->Initialize();
+    }
+
+    a->output->AddConsumer(b->input);
+    b->output->AddConsumer(a->input);
+
+    for (const auto &comp : {a, b})
+    {
+        comp->Validate();
+        comp->Prepare();
+    }
+
+    auto controller = make_shared<IterationController>("loop");
+    controller->SetIterationConfigs(
+        {{"tolerance", "1e-8"}, {"max_iter_steps", "100"}, {"threads", "2"}});
+
+    SECTION("converge in each time step")
+    {
+        controller->AddComponent(a);
+        controller->AddComponent(b);
+        controller->Initialize();
+        REQUIRE(controller->Validate().empty());
+        controller->Prepare();
+
+        int steps = 0;
+        while (controller->GetStatus() == LinkableComponentStatus::Updated)
+        {
+            controller->Update();
+            steps++;
+
+            REQUIRE(controller->IsIterationConverged());
+            REQUIRE(controller->GetResidual() <= 1e-8);
+            REQUIRE(a->x == Approx(2.).epsilon(1e-6));
+            REQUIRE(b->x == Approx(2.).epsilon(1e-6));
+
+            // Starting from the converged values, the second step only takes the
+            // iteration measuring the residual.
+            int iterations = controller->GetIterationCount();
+            REQUIRE(iterations >= (steps == 1 ? 3 : 2));
+            REQUIRE(iterations < 100);
+
+            // The states are restored before each sweep but the first one, so the
+            // components advance one time step per controller step.
+            REQUIRE(a->Now() == Approx(steps));
+            REQUIRE(b->Now() == Approx(steps));
+        }
+
+        REQUIRE(steps == 2);
+        REQUIRE(controller->GetStatus() == LinkableComponentStatus::Done);
+        REQUIRE(a->evaluations == a->restores + steps);
+        REQUIRE(b->evaluations == b->restores + steps);
+        REQUIRE(a->states.empty());
+        REQUIRE(b->states.empty());
+    }
+
+    SECTION("stop at the maximum iteration steps")
+    {
+        controller->SetIterationConfigs({{"tolerance", "0"}, {"max_iter_steps", "3"}});
+        controller->AddComponent(a);
+        controller->AddComponent(b);
+        controller->Initialize();
+        controller->Prepare();
+
+        controller->Update();
+        REQUIRE(controller->GetIterationCount() == 3);
+        REQUIRE_FALSE(controller->IsIterationConverged());
+        REQUIRE(a->evaluations == 3);
+        REQUIRE(a->restores == 2);
+        REQUIRE(a->Now() == Approx(1.));
+    }
+}
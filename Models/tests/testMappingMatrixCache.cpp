@@ -0,0 +1,111 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/DevSupports/ElementMapper.h"
+#include "Models/CommImp/DevSupports/MappingMatrixCache.h"
+#include "Models/CommImp/ElementSet.h"
+#include "Models/CommImp/Identifier.h"
+#include "Models/Utils/FilePathHelper.h"
+#include <filesystem>
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+shared_ptr<IElementSet> MakePoints(const vector<Coordinate> &coords)
+{
+    vector<Element> elements;
+    for (size_t i = 0; i < coords.size(); i++)
+    {
+        auto id = to_string(i);
+        elements.emplace_back(id, id, id, vector<Coordinate>{coords[i]});
+    }
+
+    return make_shared<ElementSet>("points", "", ElementType::Point, elements);
+}
+
+
+TEST_CASE("MappingMatrixCache tests")
+{
+    const auto dir =
+        (filesystem::temp_directory_path() / "testMappingMatrixCache").string();
+    filesystem::remove_all(dir);
+
+    auto from = MakePoints({{0, 0, 0}, {1, 0, 0}, {0, 1, 0}});
+    auto to   = MakePoints({{0.2, 0.2, 0}, {0.9, 0.1, 0}});
+
+    SECTION("keys")
+    {
+        auto keyOf = [](const string &method, const shared_ptr<IElementSet> &from,
+                        const shared_ptr<IElementSet> &to, const string &options) {
+            return MappingMatrixCache::ComputeKey(method, from, to, options);
+        };
+
+        auto key = keyOf("ElementMapper101", from, to, "");
+        REQUIRE(key == keyOf("ElementMapper101", from, to, ""));
+
+        // Any change of the method, the options or the element sets changes the key.
+        auto moved = MakePoints({{0.2, 0.2, 0}, {0.9, 0.1, 1.e-6}});
+        auto added = MakePoints({{0.2, 0.2, 0}, {0.9, 0.1, 0}, {1, 1, 0}});
+        REQUIRE(key != keyOf("ElementMapper100", from, to, ""));
+        REQUIRE(key != keyOf("ElementMapper101", from, to, "2"));
+        REQUIRE(key != keyOf("ElementMapper101", to, from, ""));
+        REQUIRE(key != keyOf("ElementMapper101", from, moved, ""));
+        REQUIRE(key != keyOf("ElementMapper101", from, added, ""));
+    }
+
+    SECTION("round trip")
+    {
+        DoubleSparseMatrix matrix(2, 3);
+        matrix.SetValue(0, 0, 0.25);
+        matrix.SetValue(0, 2, 0.75);
+        matrix.SetValue(1, 1, 1);
+        matrix.Compress();
+
+        REQUIRE(MappingMatrixCache::Save(dir, 42, matrix));
+        REQUIRE(FilePathHelper::FileExists(MappingMatrixCache::GetFilePath(dir, 42)));
+
+        DoubleSparseMatrix loaded(2, 3);
+        REQUIRE(MappingMatrixCache::Load(dir, 42, loaded));
+        REQUIRE(loaded.GetRowStarts() == matrix.GetRowStarts());
+        REQUIRE(loaded.GetColumns() == matrix.GetColumns());
+        REQUIRE(loaded.GetEntries() == matrix.GetEntries());
+
+        // Neither another key nor a matrix of another size is loaded.
+        DoubleSparseMatrix other(3, 3);
+        REQUIRE_FALSE(MappingMatrixCache::Load(dir, 43, loaded));
+        REQUIRE_FALSE(MappingMatrixCache::Load(dir, 42, other));
+    }
+
+    SECTION("element mapper")
+    {
+        ElementMapper::SetCacheDirectory(dir);
+
+        auto method = make_shared<Identifier>("ElementMapper101");
+
+        ElementMapper evaluated;
+        evaluated.Initialise(method, from, to);
+        auto key = MappingMatrixCache::ComputeKey(method->GetId(), from, to, "0,0,1");
+        REQUIRE(FilePathHelper::FileExists(MappingMatrixCache::GetFilePath(dir, key)));
+
+        ElementMapper cached;
+        cached.Initialise(method, from, to);
+        REQUIRE(
+            cached.GetMappingMatrix()->GetEntries()
+            == evaluated.GetMappingMatrix()->GetEntries());
+
+        // Moved elements are mapped again, rather than by the cached matrix.
+        auto moved = MakePoints({{0.2, 0.2, 0}, {0, 0.9, 0}});
+
+        ElementMapper remapped;
+        remapped.Initialise(method, from, moved);
+        REQUIRE(
+            remapped.GetMappingMatrix()->GetEntries()
+            != evaluated.GetMappingMatrix()->GetEntries());
+
+        ElementMapper::SetCacheDirectory("");
+    }
+
+    filesystem::remove_all(dir);
+}
@@ -11,4 +11,52 @@ TEST_CASE("Matrix template test")
     {
         Matrix<double> mat(3, 3);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Double sparse matrix test")
+{
+    DoubleSparseMatrix mat(3, 4);
+    mat.SetValue(0, 3, 2.0);
+    mat.SetValue(0, 1, 1.0);
+    mat.SetValue(1, 0, 0.0);
+    mat.SetValue(2, 2, 4.0);
+
+    vector<double> x = {1, 2, 3, 4};
+    vector<double> y = {5, 6, 7, 8};
+
+    SECTION("compressed product")
+    {
+        auto expected = mat.Product(x);
+
+        mat.Compress();
+        REQUIRE(mat.IsCompressed());
+        REQUIRE(mat.GetNonZerosCount() == 3);
+        REQUIRE(mat.Product(x) == expected);
+        REQUIRE(expected == vector<double>{10, 0, 12});
+
+        REQUIRE(mat(1, 0) == 0);
+        REQUIRE(mat(0, 3) == 2);
+        REQUIRE_THROWS(mat(3, 0));
+    }
+
+    SECTION("multiple vectors product")
+    {
+        mat.Compress();
+
+        vector<double> rx(3), ry(3);
+        mat.Product({rx.data(), ry.data()}, {x.data(), y.data()});
+        REQUIRE(rx == vector<double>{10, 0, 12});
+        REQUIRE(ry == vector<double>{22, 0, 28});
+    }
+
+    SECTION("assembling after compressed")
+    {
+        mat.Compress();
+        mat.SetValue(0, 1, 3.0);
+        REQUIRE(mat.IsCompressed());
+
+        mat.SetValue(1, 1, 1.0);
+        REQUIRE(!mat.IsCompressed());
+        REQUIRE(mat.Product(x) == vector<double>{14, 2, 12});
+    }
+}
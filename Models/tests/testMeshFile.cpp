@@ -0,0 +1,179 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/IO/MeshFile.h"
+#include "Models/CommImp/IO/MeshLoader.h"
+#include "Models/Utils/Exception.h"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace OpenOasis::CommImp::IO;
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+// Loader of a square cell, with the mesh data set directly.
+class StubMeshLoader : public MeshLoader
+{
+public:
+    unordered_map<string, vector<int>> patches = {{"p0", {0, 1}}};
+    unordered_map<string, vector<int>> zones   = {{"z0", {2, 3}}};
+
+    unordered_map<int, Coordinate> nodeCoords = {
+        {0, {0, 0, 0}}, {1, {1, 0, 0}}, {2, {1, 1, 0}}, {3, {0, 1, 0}}};
+    unordered_map<int, Coordinate> faceCoords = {
+        {0, {0.5, 0, 0}}, {1, {1, 0.5, 0}}, {2, {0.5, 1, 0}}, {3, {0, 0.5, 0}}};
+    unordered_map<int, Coordinate> cellCoords = {{0, {0.5, 0.5, 0}}};
+
+    CsvRows<int> faceNodes = {{}, {0, 2, 4, 6, 8}, {0, 1, 1, 2, 2, 3, 3, 0}};
+    CsvRows<int> cellFaces = {{}, {0, 4}, {0, 1, 2, 3}};
+
+    StubMeshLoader(const string &meshDir) : MeshLoader(meshDir)
+    {}
+
+    unordered_map<string, vector<int>> &GetPatches() override
+    {
+        return patches;
+    }
+    unordered_map<string, vector<int>> &GetZones() override
+    {
+        return zones;
+    }
+    unordered_map<int, Coordinate> &GetNodeCoordinates() override
+    {
+        return nodeCoords;
+    }
+    unordered_map<int, Coordinate> &GetFaceCoordinates() override
+    {
+        return faceCoords;
+    }
+    unordered_map<int, Coordinate> &GetCellCoordinates() override
+    {
+        return cellCoords;
+    }
+    CsvRows<int> &GetFaceNodes() override
+    {
+        return faceNodes;
+    }
+    CsvRows<int> &GetCellFaces() override
+    {
+        return cellFaces;
+    }
+};
+
+
+TEST_CASE("MeshFile tests")
+{
+    const auto dir  = filesystem::temp_directory_path();
+    const auto file = (dir / "testMeshFile.omsh").string();
+
+    StubMeshLoader loader(dir.string());
+
+    SECTION("round trip")
+    {
+        MeshFile::Write(file, loader);
+
+        auto mesh = MeshFile::Open(file);
+        REQUIRE(mesh->GetNodeCount() == 4);
+        REQUIRE(mesh->GetFaceCount() == 4);
+        REQUIRE(mesh->GetCellCount() == 1);
+        REQUIRE(mesh->GetFaceNodes(3)[0] == 3);
+        REQUIRE(mesh->GetFaceNodes(3)[1] == 0);
+        REQUIRE(mesh->GetCellFaces(0).size() == 4);
+        REQUIRE(mesh->GetPatchName(0) == "p0");
+        REQUIRE(mesh->GetZoneName(0) == "z0");
+        REQUIRE(mesh->GetZoneFaces(0)[1] == 3);
+    }
+
+    SECTION("indexes out of range")
+    {
+        loader.faceNodes.values[7] = 4;
+        MeshFile::Write(file, loader);
+        REQUIRE_THROWS_AS(MeshFile::Open(file), InvalidDataException);
+
+        loader.faceNodes.values[7] = 0;
+        loader.cellFaces.values[3] = 4;
+        MeshFile::Write(file, loader);
+        REQUIRE_THROWS_AS(MeshFile::Open(file), InvalidDataException);
+
+        loader.cellFaces.values[3] = 3;
+        loader.patches["p0"] = {0, 4};
+        MeshFile::Write(file, loader);
+        REQUIRE_THROWS_AS(MeshFile::Open(file), InvalidDataException);
+
+        loader.patches["p0"] = {0, 1};
+        loader.zones["z0"]   = {2, 4};
+        MeshFile::Write(file, loader);
+        REQUIRE_THROWS_AS(MeshFile::Open(file), InvalidDataException);
+    }
+
+    SECTION("concurrent writers")
+    {
+        // Each writer renames its own temporary file, the last one wins.
+        vector<thread> writers;
+        for (int i = 0; i < 8; i++)
+        {
+            writers.emplace_back([&]() { MeshFile::Write(file, loader); });
+        }
+        for (auto &writer : writers)
+        {
+            writer.join();
+        }
+
+        REQUIRE(MeshFile::Open(file)->GetFaceCount() == 4);
+        for (const auto &entry : filesystem::directory_iterator(dir))
+        {
+            REQUIRE(entry.path().string().rfind(file + ".", 0) == string::npos);
+        }
+    }
+
+    SECTION("rows missing")
+    {
+        loader.faceNodes = {{}, {0, 2, 4, 6}, {0, 1, 1, 2, 2, 3}};
+        REQUIRE_THROWS_AS(MeshFile::Write(file, loader), InvalidDataException);
+    }
+
+    SECTION("stale mesh file")
+    {
+        const auto meshDir = dir / "testMeshFile";
+        const auto binary  = (meshDir / MeshFile::DefaultFileName).string();
+        filesystem::create_directories(meshDir);
+
+        auto write = [&](const string &name, const string &content) {
+            ofstream stream(meshDir / name, ios::binary | ios::trunc);
+            stream << content;
+        };
+
+        write("nodes.csv", "id,x,y,z\n0,0,0,0\n1,1,0,0\n2,1,1,0\n3,0,1,0\n");
+        write("faces.csv", "id,n0,n1\n0,0,1\n1,1,2\n2,2,3\n3,3,0\n");
+        write("cells.csv", "id,f0,f1,f2,f3\n0,0,1,2,3\n");
+
+        MeshFile::ConvertFromCsv(meshDir.string(), binary);
+        REQUIRE(MeshFile::IsUpToDate(binary, meshDir.string()));
+
+        // The mesh is built from the binary file as the csv files are unchanged.
+        auto mesh = MeshLoader(meshDir.string()).LoadMesh();
+        REQUIRE(mesh.nodes.size() == 4);
+        REQUIRE(mesh.faces.at(3).nodeIndexes == vector<size_t>{3, 0});
+        REQUIRE(mesh.cells.at(0).faceIndexes == vector<size_t>{0, 1, 2, 3});
+        REQUIRE(mesh.cells.at(0).centroid.x == Approx(0.5));
+
+        // Once a csv file is changed, the csv files are loaded instead.
+        write("nodes.csv", "id,x,y,z\n0,0,0,0\n1,2.5,0,0\n2,2.5,1,0\n3,0,1,0\n");
+        REQUIRE_FALSE(MeshFile::IsUpToDate(binary, meshDir.string()));
+
+        mesh = MeshLoader(meshDir.string()).LoadMesh();
+        REQUIRE(mesh.nodes.at(1).coor.x == 2.5);
+        REQUIRE(mesh.faces.at(0).centroid.x == Approx(1.25));
+        REQUIRE(mesh.cells.at(0).centroid.x == Approx(1.25));
+
+        // So does a new csv file.
+        MeshFile::ConvertFromCsv(meshDir.string(), binary);
+        REQUIRE(MeshFile::IsUpToDate(binary, meshDir.string()));
+        write("patches.csv", "p0,0,1\n");
+        REQUIRE_FALSE(MeshFile::IsUpToDate(binary, meshDir.string()));
+
+        filesystem::remove_all(meshDir);
+    }
+
+    filesystem::remove(file);
+}
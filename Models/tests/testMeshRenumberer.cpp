@@ -0,0 +1,116 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/Spatial/MeshRenumberer.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp::Spatial;
+using namespace std;
+
+
+namespace
+{
+// Neighbors of the cells of a structured grid numbered by the given labels.
+Connectivity GridNeighbors(size_t nx, size_t ny, const vector<size_t> &labels)
+{
+    vector<vector<size_t>> neighbors(nx * ny);
+    for (size_t j = 0; j < ny; j++)
+    {
+        for (size_t i = 0; i < nx; i++)
+        {
+            size_t c = labels[j * nx + i];
+            if (i > 0)
+                neighbors[c].push_back(labels[j * nx + i - 1]);
+            if (i + 1 < nx)
+                neighbors[c].push_back(labels[j * nx + i + 1]);
+            if (j > 0)
+                neighbors[c].push_back(labels[(j - 1) * nx + i]);
+            if (j + 1 < ny)
+                neighbors[c].push_back(labels[(j + 1) * nx + i]);
+        }
+    }
+
+    Connectivity conn;
+    for (const auto &row : neighbors)
+    {
+        conn.indexes.insert(conn.indexes.end(), row.begin(), row.end());
+        conn.offsets.push_back(conn.indexes.size());
+    }
+
+    return conn;
+}
+
+bool IsPermutation(vector<size_t> order)
+{
+    sort(order.begin(), order.end());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        if (order[i] != i)
+            return false;
+    }
+
+    return true;
+}
+
+}  // namespace
+
+
+TEST_CASE("MeshRenumberer tests")
+{
+    SECTION("reverse Cuthill-McKee")
+    {
+        vector<size_t> labels(30 * 20);
+        iota(labels.begin(), labels.end(), 0);
+        shuffle(labels.begin(), labels.end(), mt19937(7));
+
+        auto neighbors = GridNeighbors(30, 20, labels);
+
+        vector<size_t> identity(labels.size());
+        iota(identity.begin(), identity.end(), 0);
+
+        auto order = MeshRenumberer::OrderByReverseCuthillMcKee(neighbors);
+        REQUIRE(order.size() == labels.size());
+        REQUIRE(IsPermutation(order));
+        REQUIRE(MeshRenumberer::CalculateBandwidth(neighbors, identity) > 100);
+        REQUIRE(MeshRenumberer::CalculateBandwidth(neighbors, order) <= 21);
+
+        // Deterministic, and isolated cells are kept.
+        REQUIRE(MeshRenumberer::OrderByReverseCuthillMcKee(neighbors) == order);
+
+        neighbors.offsets.push_back(neighbors.indexes.size());
+        order = MeshRenumberer::OrderByReverseCuthillMcKee(neighbors);
+        REQUIRE(IsPermutation(order));
+    }
+
+    SECTION("Hilbert curve")
+    {
+        vector<Coordinate> points = {{1, 0}, {0, 1}, {0, 0}, {1, 1}};
+
+        auto order = MeshRenumberer::OrderByHilbertCurve(points);
+        REQUIRE(order == vector<size_t>{2, 1, 3, 0});
+
+        auto ranks = MeshRenumberer::InvertOrder(order);
+        REQUIRE(ranks == vector<size_t>{3, 1, 0, 2});
+    }
+
+    SECTION("faces and nodes")
+    {
+        // Faces of two cells: face 2 is shared, the others are boundaries.
+        Connectivity faceCells;
+        faceCells.offsets = {0, 1, 2, 4, 5, 6};
+        faceCells.indexes = {1, 0, 1, 0, 0, 1};
+
+        vector<size_t> cellRanks = {1, 0};
+
+        auto faceOrder = MeshRenumberer::OrderFacesByCells(faceCells, cellRanks);
+        REQUIRE(faceOrder == vector<size_t>{0, 4, 2, 1, 3});
+
+        Connectivity faceNodes;
+        faceNodes.offsets = {0, 2, 4, 6, 8, 10};
+        faceNodes.indexes = {5, 4, 0, 1, 1, 4, 4, 3, 3, 2};
+
+        auto nodeOrder = MeshRenumberer::OrderNodesByFaces(faceNodes, faceOrder, 7);
+        REQUIRE(nodeOrder == vector<size_t>{5, 4, 3, 2, 1, 0, 6});
+    }
+}
@@ -0,0 +1,218 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/DevSupports/RemoteComponent.h"
+#include "Models/CommImp/ElementSet.h"
+#include "Models/CommImp/LinkableComponent.h"
+#include "Models/CommImp/Quantity.h"
+#include "Models/CommImp/Time.h"
+#include "Models/CommImp/TimeSet.h"
+#include "Models/CommImp/Unit.h"
+#include "Models/CommImp/ValueSetDense.h"
+#include "Models/Utils/Exception.h"
+#include <csignal>
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+// Component of one value `x = scale * y + now`, where `y` is the value of its input
+// at the current time, stepping one day per time step within four days. It kills
+// the process at the step `killAt` if set.
+class HostedComponent : public LinkableComponent
+{
+public:
+    shared_ptr<Output> output;
+    shared_ptr<Input>  input;
+
+    shared_ptr<IQuantity>   quantity;
+    shared_ptr<IElementSet> elementSet;
+
+    double scale  = 0;
+    double y      = 0;
+    int    killAt = 0;
+
+    HostedComponent(const string &id, double scale) :
+        LinkableComponent(id), scale(scale)
+    {}
+
+    double Now() const
+    {
+        return mCurrentTime->GetTimeStamp();
+    }
+
+protected:
+    void InitializeArguments() override
+    {}
+    void InitializeSpace() override
+    {}
+    void InitializeTime() override
+    {
+        mTimeExtent = make_shared<TimeSet>(
+            vector<shared_ptr<ITime>>{make_shared<Time>(0., 4.)});
+        mCurrentTime = make_shared<Time>(0.);
+    }
+    void InitializeInputs() override
+    {
+        input = make_shared<Input>("in", shared_from_this());
+        input->SetValues(make_shared<ValueSetDense<real>>(quantity));
+        input->SetTimeSet(
+            make_shared<TimeSet>(vector<shared_ptr<ITime>>{make_shared<Time>(0.)}));
+        input->SetElementSet(elementSet);
+        mInputs = {input};
+    }
+    void InitializeOutputs() override
+    {
+        // The initial values are available at the start time.
+        output = make_shared<Output>("out", shared_from_this());
+        output->SetValues(make_shared<ValueSetDense<real>>(quantity));
+        output->SetTimeSet(make_shared<TimeSet>());
+        output->SetElementSet(elementSet);
+        mOutputs = {output};
+        UpdateOutputs(mOutputs);
+    }
+    vector<string> OnValidate() override
+    {
+        return {};
+    }
+    void PrepareInputs() override
+    {}
+    void PrepareOutputs() override
+    {}
+
+    void ApplyInputData(const shared_ptr<IValueSet> &values) override
+    {
+        auto dense = dynamic_pointer_cast<ValueSetDense<real>>(values);
+        y          = dense->GetTimesCount() > 0 ? dense->Get(0, 0) : -1.;
+    }
+
+    void UpdateOutputs(const vector<shared_ptr<IOutput>> &) override
+    {
+        auto values = dynamic_pointer_cast<ValueSetDense<real>>(output->GetValues());
+        auto times  = dynamic_pointer_cast<TimeSet>(output->GetTimeSet());
+        values->AddElementValuesForTime(vector<real>{scale * y + Now()});
+        times->AddTime(make_shared<Time>(Now()));
+    }
+
+    void PerformTimestep(const vector<shared_ptr<IOutput>> &) override
+    {
+        if (Now() + 1 == killAt)
+        {
+            raise(SIGKILL);
+        }
+
+        mCurrentTime = make_shared<Time>(Now() + 1.);
+
+        // The input requests the values at the new time.
+        input->SetTimeSet(
+            make_shared<TimeSet>(vector<shared_ptr<ITime>>{make_shared<Time>(Now())}));
+    }
+};
+
+
+TEST_CASE("RemoteComponent tests")
+{
+    auto quantity = make_shared<Quantity>(
+        make_shared<Unit>(PredefinedUnits::Meter), "depth", "Water depth", (real)-9999);
+
+    vector<Element> elements;
+    elements.emplace_back("0", "0", "0", vector<Coordinate>{{0, 0, 0}});
+    auto elementSet =
+        make_shared<ElementSet>("points", "", ElementType::Point, elements);
+
+    auto create = [=](double scale, int killAt) {
+        return [=]() -> shared_ptr<ILinkableComponent> {
+            auto comp        = make_shared<HostedComponent>("hosted", scale);
+            comp->quantity   = quantity;
+            comp->elementSet = elementSet;
+            comp->killAt     = killAt;
+            return comp;
+        };
+    };
+
+    // The local source provides `x = now` to the input of the remote component.
+    auto source        = make_shared<HostedComponent>("source", 0.);
+    source->quantity   = quantity;
+    source->elementSet = elementSet;
+    source->Initialize();
+    source->Validate();
+    source->Prepare();
+
+    SECTION("exchange values through shared memory")
+    {
+        auto remote = make_shared<RemoteComponent>("hosted", create(2., 0));
+        REQUIRE(remote->GetProcessId() > 0);
+
+        remote->Initialize();
+        REQUIRE(remote->Validate().empty());
+
+        auto input  = remote->AddInput("in", quantity, elementSet);
+        auto output = remote->AddOutput("out", quantity, elementSet);
+        REQUIRE(remote->AddInput("in", quantity, elementSet) == input);
+        REQUIRE(remote->GetInputs().size() == 1);
+        source->GetOutputs()[0]->AddConsumer(input);
+
+        remote->Prepare();
+        REQUIRE(remote->GetOutputIds() == vector<string>{"out"});
+
+        // The initial values are published on preparing, before any input.
+        Span<const double> values;
+        REQUIRE(remote->GetOutputValues("out", values) == 0.);
+        REQUIRE(values.size() == 1);
+        REQUIRE(values[0] == 0.);
+
+        // The child pulls `y = now` of the source at its current time, and
+        // publishes `x = 2 * y + now` after stepping.
+        for (int step = 1; step <= 4; step++)
+        {
+            remote->Update();
+            REQUIRE(remote->GetNowTime() == step);
+            REQUIRE(remote->GetOutputValues("out", values) == step);
+            REQUIRE(values.size() == 1);
+            REQUIRE(values[0] == 2. * (step - 1) + step);
+
+            // The view refers to the segment, copied once into the output.
+            auto dense = dynamic_pointer_cast<ValueSetDense<real>>(
+                dynamic_pointer_cast<RemoteOutput>(output)->GetValues());
+            int times = dense->GetTimesCount();
+            REQUIRE(dense->Get(times - 1, 0) == values[0]);
+        }
+
+        REQUIRE(remote->GetStatus() == LinkableComponentStatus::Done);
+        remote->Finish();
+    }
+
+    SECTION("unknown items")
+    {
+        auto remote = make_shared<RemoteComponent>("hosted", create(2., 0));
+        remote->Initialize();
+        remote->AddInput("unknown", quantity, elementSet);
+
+        REQUIRE_THROWS_AS(remote->Prepare(), IllegalStateException);
+        REQUIRE(remote->GetStatus() == LinkableComponentStatus::Failed);
+    }
+
+    SECTION("child crash")
+    {
+        auto remote = make_shared<RemoteComponent>("hosted", create(2., 2));
+        remote->Initialize();
+        remote->AddOutput("out", quantity, elementSet);
+        remote->Prepare();
+
+        remote->Update();
+        REQUIRE(remote->GetStatus() == LinkableComponentStatus::Updated);
+
+        // The crash fails the component, whose segments are removed.
+        int pid = remote->GetProcessId();
+        remote->Update();
+        REQUIRE(remote->GetStatus() == LinkableComponentStatus::Failed);
+        REQUIRE(remote->GetProcessId() < 0);
+        REQUIRE_THROWS_AS(
+            SharedMemory::Open(ComponentHost::GetSegmentName(pid, "hosted", "out")),
+            IllegalStateException);
+
+        // The failed component isn't updated any more.
+        REQUIRE_NOTHROW(remote->Update());
+    }
+}
@@ -0,0 +1,68 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/tests/ProducingComponent.h"
+#include "Models/CommImp/ElementSet.h"
+#include "Models/CommImp/Input.h"
+#include "Models/CommImp/Quantity.h"
+#include "Models/CommImp/RemoteOutput.h"
+#include "Models/CommImp/Time.h"
+#include "Models/CommImp/TimeSet.h"
+#include "Models/CommImp/Unit.h"
+#include "Models/CommImp/ValueSetDense.h"
+#include "Models/Utils/Exception.h"
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+TEST_CASE("RemoteOutput tests")
+{
+    auto quantity = make_shared<Quantity>(
+        make_shared<Unit>(PredefinedUnits::Meter), "depth", "Water depth");
+
+    vector<Element> elements;
+    elements.emplace_back("0", "0", "0", vector<Coordinate>{{0, 0, 0}});
+    elements.emplace_back("1", "1", "1", vector<Coordinate>{{1, 0, 0}});
+    auto elementSet =
+        make_shared<ElementSet>("points", "", ElementType::Point, elements);
+
+    auto comp    = make_shared<ProducingComponent>(5, "stepping");
+    comp->output = make_shared<RemoteOutput>("out", comp, quantity, elementSet);
+
+    SECTION("append values")
+    {
+        comp->output->AppendValues(1, {1, 2});
+
+        // Values at a time not advancing are skipped.
+        comp->output->AppendValues(1, {3, 4});
+        REQUIRE(comp->output->GetTimeSet()->GetTimes().size() == 1);
+
+        REQUIRE_THROWS_AS(comp->output->AppendValues(2, {1}), InvalidDataException);
+        REQUIRE(comp->output->GetTimeSet()->GetTimes().size() == 1);
+    }
+
+    SECTION("update to the consumer time")
+    {
+        auto input = make_shared<Input>("in", comp);
+        input->SetValues(make_shared<ValueSetDense<real>>(quantity));
+        input->SetElementSet(elementSet);
+        input->SetTimeSet(
+            make_shared<TimeSet>(vector<shared_ptr<ITime>>{make_shared<Time>(3.)}));
+
+        comp->output->AddConsumer(input);
+        REQUIRE(comp->output->GetConsumers().size() == 1);
+
+        // The component is updated until the consumer time is covered.
+        auto values = comp->output->GetValues();
+        REQUIRE(comp->steps == 3);
+
+        int times = values->GetIndexCount({0});
+        REQUIRE(times >= 1);
+        auto row = dynamic_pointer_cast<ValueSetDense<real>>(values)
+                       ->GetElementValuesForTimeSpan(times - 1);
+        REQUIRE(row.size() == 2);
+        REQUIRE(row[0] == Approx(3.));
+        REQUIRE(row[1] == Approx(6.));
+    }
+}
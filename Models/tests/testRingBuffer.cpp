@@ -0,0 +1,66 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/Utils/RingBuffer.h"
+
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+TEST_CASE("Ring buffer tests")
+{
+    RingBuffer<int> ring(4);
+    REQUIRE(ring.IsEmpty());
+    REQUIRE(ring.GetCapacity() == 4);
+
+    SECTION("sliding window")
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            ring.PushBack(i);
+            if (ring.GetSize() > 3)
+            {
+                ring.PopFront();
+            }
+        }
+
+        REQUIRE(ring.GetCapacity() == 4);
+        REQUIRE(ring.ToVector() == vector<int>{97, 98, 99});
+        REQUIRE(ring.Front() == 97);
+        REQUIRE(ring.Back() == 99);
+        REQUIRE_THROWS(ring.At(3));
+    }
+
+    SECTION("growing")
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            ring.PushBack(i);
+        }
+
+        ring.PopFront(3);
+        REQUIRE(ring.GetCapacity() == 16);
+        REQUIRE(ring.GetSize() == 7);
+        REQUIRE(ring[0] == 3);
+
+        ring.PopFront(100);
+        REQUIRE(ring.IsEmpty());
+    }
+
+    SECTION("insert and erase")
+    {
+        ring.PushBack(1);
+        ring.PushBack(2);
+        ring.PopFront();
+        ring.PushBack(4);
+        ring.PushBack(5);
+
+        ring.Insert(1, 3);
+        ring.Insert(0, 1);
+        REQUIRE(ring.ToVector() == vector<int>{1, 2, 3, 4, 5});
+
+        ring.Erase(1, 2);
+        REQUIRE(ring.ToVector() == vector<int>{1, 4, 5});
+
+        ring.Erase(2, 10);
+        REQUIRE(ring.ToVector() == vector<int>{1, 4});
+    }
+}
@@ -0,0 +1,64 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/SpaceAdaptedOutputFactory.h"
+#include "Models/CommImp/Identifier.h"
+#include "Models/Utils/Exception.h"
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+TEST_CASE("SpaceAdaptedOutputFactory tests")
+{
+    auto findArgument = [](const vector<shared_ptr<IArgument>> &arguments,
+                           const string                        &id) {
+        for (const auto &argument : arguments)
+        {
+            if (argument->GetId() == id)
+            {
+                return argument;
+            }
+        }
+        return shared_ptr<IArgument>();
+    };
+
+    SECTION("inverse arguments")
+    {
+        // Point-to-point Nearest and Inverse.
+        auto nearest = SpaceAdaptedOutputFactory::GetAdaptedOutputArguments(
+            make_shared<Identifier>("ElementMapper100"));
+        auto inverse = SpaceAdaptedOutputFactory::GetAdaptedOutputArguments(
+            make_shared<Identifier>("ElementMapper101"));
+
+        REQUIRE_FALSE(findArgument(nearest, "InverseNeighbours"));
+        REQUIRE(findArgument(inverse, "InverseNeighbours"));
+        REQUIRE(findArgument(inverse, "InverseRadius"));
+        REQUIRE(findArgument(inverse, "InversePower"));
+    }
+
+    SECTION("set inverse arguments")
+    {
+        auto arguments = SpaceAdaptedOutputFactory::CreateInverseArguments();
+
+        ElementMapper mapper;
+        SpaceAdaptedOutputFactory::SetInverseArguments(mapper, arguments);
+        REQUIRE(mapper.GetInverseNeighbours() == 0);
+        REQUIRE(mapper.GetInverseRadius() == 0);
+        REQUIRE(mapper.GetInversePower() == 1);
+
+        findArgument(arguments, "InverseNeighbours")->SetValue(4);
+        findArgument(arguments, "InverseRadius")->SetValue(2.5);
+        findArgument(arguments, "InversePower")->SetValue(2.);
+        SpaceAdaptedOutputFactory::SetInverseArguments(mapper, arguments);
+        REQUIRE(mapper.GetInverseNeighbours() == 4);
+        REQUIRE(mapper.GetInverseRadius() == Approx(2.5));
+        REQUIRE(mapper.GetInversePower() == Approx(2.));
+
+        findArgument(arguments, "InverseRadius")->SetValue(-1.);
+        REQUIRE_THROWS_AS(
+            SpaceAdaptedOutputFactory::SetInverseArguments(mapper, arguments),
+            IllegalArgumentException);
+    }
+}
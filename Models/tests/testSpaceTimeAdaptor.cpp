@@ -0,0 +1,180 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/DevSupports/SpaceMapAdaptor.h"
+#include "Models/CommImp/DevSupports/SpaceTimeAdaptor.h"
+#include "Models/CommImp/DevSupports/TimeAdaptor.h"
+#include "Models/CommImp/ElementSet.h"
+#include "Models/CommImp/Identifier.h"
+#include "Models/CommImp/Input.h"
+#include "Models/CommImp/LinkableComponent.h"
+#include "Models/CommImp/Output.h"
+#include "Models/CommImp/Quantity.h"
+#include "Models/CommImp/Time.h"
+#include "Models/CommImp/TimeSet.h"
+#include "Models/CommImp/Unit.h"
+#include "Models/CommImp/ValueSetDense.h"
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace std;
+
+
+// Component of the values `x_i = (i + 1) * now^2` on its elements, stepping one day
+// per time step within four days.
+class MappedComponent : public LinkableComponent
+{
+public:
+    shared_ptr<Output> output;
+
+    shared_ptr<IQuantity>   quantity;
+    shared_ptr<IElementSet> elementSet;
+
+    MappedComponent(const string &id) : LinkableComponent(id)
+    {}
+
+    double Now() const
+    {
+        return mCurrentTime->GetTimeStamp();
+    }
+
+protected:
+    void InitializeArguments() override
+    {}
+    void InitializeSpace() override
+    {}
+    void InitializeTime() override
+    {
+        mTimeExtent = make_shared<TimeSet>(
+            vector<shared_ptr<ITime>>{make_shared<Time>(0., 4.)});
+        mCurrentTime = make_shared<Time>(0.);
+    }
+    void InitializeInputs() override
+    {}
+    void InitializeOutputs() override
+    {
+        output = make_shared<Output>("out", shared_from_this());
+        output->SetValues(make_shared<ValueSetDense<Utils::real>>(quantity));
+        output->SetTimeSet(make_shared<TimeSet>());
+        output->SetElementSet(elementSet);
+        mOutputs = {output};
+        UpdateOutputs(mOutputs);
+    }
+    vector<string> OnValidate() override
+    {
+        return {};
+    }
+    void PrepareInputs() override
+    {}
+    void PrepareOutputs() override
+    {}
+    void ApplyInputData(const shared_ptr<IValueSet> &) override
+    {}
+
+    void UpdateOutputs(const vector<shared_ptr<IOutput>> &) override
+    {
+        vector<Utils::real> row(elementSet->GetElementCount());
+        for (int i = 0; i < (int)row.size(); i++)
+        {
+            row[i] = (i + 1) * Now() * Now();
+        }
+
+        auto values =
+            dynamic_pointer_cast<ValueSetDense<Utils::real>>(output->GetValues());
+        auto times = dynamic_pointer_cast<TimeSet>(output->GetTimeSet());
+        values->AddElementValuesForTime(row);
+        times->AddTime(make_shared<Time>(Now()));
+    }
+
+    void PerformTimestep(const vector<shared_ptr<IOutput>> &) override
+    {
+        mCurrentTime = make_shared<Time>(Now() + 1.);
+    }
+};
+
+
+TEST_CASE("SpaceTimeAdaptor tests")
+{
+    auto quantity = make_shared<Quantity>(
+        make_shared<Unit>(PredefinedUnits::Meter), "depth", "Water depth");
+
+    auto createPoints = [](const string &id, const vector<double> &xs) {
+        vector<Element> elements;
+        for (int i = 0; i < (int)xs.size(); i++)
+        {
+            auto id = to_string(i);
+            elements.emplace_back(id, id, id, vector<Coordinate>{{xs[i], 0, 0}});
+        }
+        return make_shared<ElementSet>(id, "", ElementType::Point, elements);
+    };
+
+    auto source = createPoints("source", {0, 1, 2, 3});
+    auto target = createPoints("target", {0.2, 1.5, 2.9});
+
+    // Two identical components, one per adaptor, as the adaptors update them.
+    auto createComponent = [&](const string &id) {
+        auto comp        = make_shared<MappedComponent>(id);
+        comp->quantity   = quantity;
+        comp->elementSet = source;
+        comp->Initialize();
+        comp->Validate();
+        comp->Prepare();
+        return comp;
+    };
+
+    auto chained = createComponent("chained");
+    auto fused   = createComponent("fused");
+    auto owner   = make_shared<MappedComponent>("consumer");
+
+    auto input = make_shared<Input>("in", owner);
+    input->SetValues(make_shared<ValueSetDense<Utils::real>>(quantity));
+    input->SetElementSet(target);
+
+    // The chain interpolates in time, then maps the values to the target.
+    auto timeAdaptor  = make_shared<TimeAdaptor>("time", chained->output);
+    auto spaceAdaptor = make_shared<SpaceMapAdaptor>(
+        make_shared<Identifier>("ElementMapper101"), timeAdaptor, target);
+    timeAdaptor->AddConsumer(input);
+    spaceAdaptor->AddConsumer(input);
+
+    auto spaceTimeAdaptor = make_shared<SpaceTimeAdaptor>(
+        make_shared<Identifier>("SpaceTimeMapper101"), fused->output, target);
+    spaceTimeAdaptor->AddConsumer(input);
+
+    SECTION("match the chained adaptors")
+    {
+        shared_ptr<IValueSet> last;
+        for (double time : {0.5, 1.5, 2., 2.25, 3.5, 4.})
+        {
+            input->SetTimeSet(make_shared<TimeSet>(
+                vector<shared_ptr<ITime>>{make_shared<Time>(time)}));
+
+            auto expected = dynamic_pointer_cast<ValueSetDense<Utils::real>>(
+                spaceAdaptor->GetValues());
+            auto actual = dynamic_pointer_cast<ValueSetDense<Utils::real>>(
+                spaceTimeAdaptor->GetValues());
+
+            REQUIRE(actual->GetTimesCount() == 1);
+            REQUIRE(actual->GetElementsCount() == target->GetElementCount());
+
+            int  lastTime = expected->GetTimesCount() - 1;
+            auto row      = actual->GetElementValuesForTimeSpan(0);
+            for (int i = 0; i < target->GetElementCount(); i++)
+            {
+                REQUIRE(row[i] == Approx(expected->Get(lastTime, i)));
+            }
+
+            // The values grow along the target points, as on the source ones.
+            REQUIRE(row[0] < row[1]);
+            REQUIRE(row[1] < row[2]);
+
+            // The value set of the same shape is reused by the next query.
+            if (last)
+            {
+                REQUIRE(actual == last);
+            }
+            last = actual;
+        }
+
+        REQUIRE(fused->Now() == chained->Now());
+    }
+}
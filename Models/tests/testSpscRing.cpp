@@ -0,0 +1,74 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/Utils/SpscRing.h"
+#include <thread>
+
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+TEST_CASE("SpscRing tests")
+{
+    SECTION("bounded")
+    {
+        SpscRing<int> ring(2);
+        REQUIRE(ring.IsEmpty());
+        REQUIRE(ring.GetCapacity() == 2);
+
+        REQUIRE(ring.TryPush(1));
+        REQUIRE(ring.TryPush(2));
+        REQUIRE_FALSE(ring.TryPush(3));
+        REQUIRE(ring.GetSize() == 2);
+
+        int item = 0;
+        REQUIRE(ring.TryPop(item));
+        REQUIRE(item == 1);
+        REQUIRE(ring.TryPush(3));
+        REQUIRE(ring.TryPop(item));
+        REQUIRE(item == 2);
+        REQUIRE(ring.TryPop(item));
+        REQUIRE(item == 3);
+        REQUIRE_FALSE(ring.TryPop(item));
+        REQUIRE(ring.IsEmpty());
+    }
+
+    SECTION("producer and consumer pipeline")
+    {
+        // Frames of values at time steps, as exchanged by `AsyncOutput`.
+        const int steps = 20000, count = 16;
+
+        SpscRing<vector<double>> ring(2);
+
+        bool overflowed = false;
+        thread producer([&] {
+            for (int t = 0; t < steps; t++)
+            {
+                vector<double> frame(count, t);
+                while (!ring.TryPush(std::move(frame)))
+                {
+                    this_thread::yield();
+                }
+
+                overflowed = overflowed || ring.GetSize() > ring.GetCapacity();
+            }
+        });
+
+        bool           ordered = true;
+        vector<double> frame;
+        for (int t = 0; t < steps; t++)
+        {
+            while (!ring.TryPop(frame))
+            {
+                this_thread::yield();
+            }
+
+            ordered = ordered && (int)frame.size() == count && frame.front() == t
+                      && frame.back() == t;
+        }
+
+        producer.join();
+
+        REQUIRE(ordered);
+        REQUIRE_FALSE(overflowed);
+        REQUIRE(ring.IsEmpty());
+    }
+}
@@ -0,0 +1,304 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/Temporal/TimeBuffer.h"
+#include "Models/CommImp/Time.h"
+#include <cmath>
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::CommImp::Temporal;
+using namespace std;
+
+
+// Time buffer exposing its lookups.
+class InspectedTimeBuffer : public TimeBuffer
+{
+public:
+    using TimeBuffer::FindTimeIndex;
+    using TimeBuffer::mEndCursor;
+    using TimeBuffer::mIsUniformSpans;
+    using TimeBuffer::mStartCursor;
+    using TimeBuffer::mWeightPlans;
+};
+
+
+// Index of the first time not earlier than the time stamp, by linear search.
+int FindTimeIndexLinearly(const TimeBuffer &buffer, double timestamp, bool byEnd)
+{
+    int count = buffer.GetTimesCount();
+    for (int i = 0; i < count; i++)
+    {
+        auto   time = buffer.GetTimeAt(i);
+        double key  = time->GetTimeStamp() + (byEnd ? time->GetDurationInDays() : 0.);
+        if (key >= timestamp)
+        {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+
+// Buffer of the rows {t^2, ...} at the time stamps t = 0, 1, 2, 3, or over the spans
+// of one day starting from them, offset by 10 days. Extrapolated linearly.
+shared_ptr<TimeBuffer> CreateBuffer(bool hasSpans)
+{
+    vector<vector<real>> rows = {{0, 5}, {1, 4}, {4, 2}, {9, -1}};
+
+    auto buffer = make_shared<TimeBuffer>();
+    buffer->SetRelaxationFactor(0);
+    for (int i = 0; i < (int)rows.size(); i++)
+    {
+        buffer->AddValues(make_shared<Time>(10. + i, hasSpans ? 1. : 0.), rows[i]);
+    }
+
+    return buffer;
+}
+
+// Time at `t` days of the buffer.
+shared_ptr<ITime> At(double t, double duration = 0.)
+{
+    return make_shared<Time>(10. + t, duration);
+}
+
+void RequireValues(const vector<real> &values, const vector<real> &expected)
+{
+    REQUIRE(values.size() == expected.size());
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        REQUIRE(values[i] == Approx(expected[i]));
+    }
+}
+
+
+TEST_CASE("TimeBuffer tests")
+{
+    SECTION("map from time stamps to time stamp")
+    {
+        auto buffer = CreateBuffer(false);
+
+        RequireValues(buffer->GetValues(At(1.5)), {2.5, 3});
+        RequireValues(buffer->GetValues(At(2.)), {4, 2});
+
+        // Extrapolated linearly from the first or last two stamps.
+        RequireValues(buffer->GetValues(At(-1.)), {-1, 6});
+        RequireValues(buffer->GetValues(At(4.)), {14, -4});
+
+        // Relaxed towards the nearest stamp, fully by default.
+        buffer->SetRelaxationFactor(0.5);
+        RequireValues(buffer->GetValues(At(4.)), {11.5, -2.5});
+        buffer->SetRelaxationFactor(1);
+        RequireValues(buffer->GetValues(At(4.)), {9, -1});
+
+        buffer->SetDoExtrapolate(false);
+        REQUIRE_THROWS(buffer->GetValues(At(4.)));
+    }
+
+    SECTION("map from time stamps to time span")
+    {
+        auto buffer = CreateBuffer(false);
+
+        // Averages of the values interpolated linearly between the stamps.
+        RequireValues(buffer->GetValues(At(0.5, 1.)), {1.25, 3.875});
+        RequireValues(buffer->GetValues(At(1., 2.)), {4.5, 1.75});
+
+        // Extrapolated beyond the last stamp, partly or entirely.
+        RequireValues(buffer->GetValues(At(2.5, 1.)), {9, -1});
+        RequireValues(buffer->GetValues(At(4., 1.)), {16.5, -5.5});
+    }
+
+    SECTION("map from time spans to time stamp")
+    {
+        auto buffer = CreateBuffer(true);
+
+        RequireValues(buffer->GetValues(At(1.5)), {1, 4});
+        RequireValues(buffer->GetValues(At(2.5)), {4, 2});
+
+        // Extrapolated from the first or last two spans.
+        RequireValues(buffer->GetValues(At(-1.)), {-1, 6});
+        RequireValues(buffer->GetValues(At(5.)), {14, -4});
+    }
+
+    SECTION("map from time spans to time span")
+    {
+        auto buffer = CreateBuffer(true);
+
+        // Spans weighted by their overlaps with the request.
+        RequireValues(buffer->GetValues(At(1., 1.)), {1, 4});
+        RequireValues(buffer->GetValues(At(0.5, 2.)), {1.5, 3.75});
+
+        // Extrapolated linearly between the centers of the spans.
+        RequireValues(buffer->GetValues(At(-2., 1.)), {-2, 7});
+        RequireValues(buffer->GetValues(At(5., 1.)), {19, -7});
+        RequireValues(buffer->GetValues(At(3.5, 1.)), {10.875, -2.125});
+
+        buffer->SetRelaxationFactor(1);
+        RequireValues(buffer->GetValues(At(5., 1.)), {9, -1});
+
+        buffer->SetDoExtrapolate(false);
+        REQUIRE_THROWS(buffer->GetValues(At(3.5, 1.)));
+        RequireValues(buffer->GetValues(At(0.5, 2.)), {1.5, 3.75});
+    }
+
+    SECTION("reuse weight plans of repeated requests")
+    {
+        // Spans of one minute over four hours, requested by 15 minutes.
+        const double minute = 1. / 1440;
+        auto         fill   = [&](TimeBuffer &buffer, int from) {
+            for (int i = from; i < 240; i++)
+            {
+                buffer.AddValues(
+                    make_shared<Time>(10. + i * minute, minute),
+                    {(real)sin(0.1 * i), (real)i});
+            }
+        };
+
+        InspectedTimeBuffer cached;
+        cached.SetRelaxationFactor(0);
+        fill(cached, 0);
+
+        // Values of a buffer without any plan cached.
+        auto getFresh = [&](int from, const shared_ptr<ITime> &time) {
+            TimeBuffer fresh;
+            fresh.SetRelaxationFactor(0);
+            fill(fresh, from);
+            return fresh.GetValues(time);
+        };
+
+        for (int start = 0; start + 15 <= 240; start += 15)
+        {
+            auto time   = make_shared<Time>(10. + start * minute, 15 * minute);
+            auto values = cached.GetValues(time);
+            RequireValues(values, getFresh(0, time));
+            REQUIRE(values[1] == Approx(start + 7));
+        }
+
+        // The aligned requests share one plan.
+        REQUIRE(cached.mWeightPlans.size() == 1);
+
+        // Requests offset by half a minute overlap 16 spans, as another plan.
+        auto shifted = make_shared<Time>(10. + 30.5 * minute, 15 * minute);
+        RequireValues(cached.GetValues(shifted), getFresh(0, shifted));
+        REQUIRE(cached.mWeightPlans.size() == 2);
+
+        // Trimming shifts the first buffered span, the plans still apply relative
+        // to the first span overlapped.
+        cached.ClearBefore(make_shared<Time>(10. + 100 * minute));
+        REQUIRE(cached.GetTimesCount() == 140);
+        for (int start = 105; start + 15 <= 240; start += 15)
+        {
+            auto time = make_shared<Time>(10. + start * minute, 15 * minute);
+            RequireValues(cached.GetValues(time), getFresh(100, time));
+
+            auto offset = make_shared<Time>(10. + (start + 0.5) * minute, 15 * minute);
+            RequireValues(cached.GetValues(offset), getFresh(100, offset));
+        }
+
+        REQUIRE(cached.mWeightPlans.size() == 2);
+    }
+
+    SECTION("reuse weight plans after irregular spans cleared")
+    {
+        // Spans of one hour, the fourth of two hours, trimmed as a sliding window.
+        const double hour = 1. / 24;
+
+        InspectedTimeBuffer buffer;
+        buffer.SetRelaxationFactor(0);
+        double start = 0;
+        for (int i = 0; i < 10; i++)
+        {
+            double duration = (i == 3 ? 2 : 1) * hour;
+            buffer.AddValues(make_shared<Time>(start, duration), {(real)i});
+            start += duration;
+        }
+
+        auto request = [&](double from) {
+            return buffer.GetValues(make_shared<Time>(from * hour, 2 * hour));
+        };
+
+        REQUIRE_FALSE(buffer.mIsUniformSpans);
+        RequireValues(request(6), {5.5});
+        REQUIRE(buffer.mWeightPlans.empty());
+
+        // The irregular span is still buffered.
+        buffer.ClearBefore(make_shared<Time>(2 * hour));
+        REQUIRE_FALSE(buffer.mIsUniformSpans);
+
+        // Once it expires, the plans are cached again.
+        buffer.ClearBefore(make_shared<Time>(5 * hour));
+        REQUIRE(buffer.mIsUniformSpans);
+        RequireValues(request(6), {5.5});
+        RequireValues(request(8), {7.5});
+        REQUIRE(buffer.mWeightPlans.size() == 1);
+
+        // Clearing the later spans keeps the buffer uniform.
+        buffer.ClearAfter(make_shared<Time>(9 * hour));
+        REQUIRE(buffer.mIsUniformSpans);
+        REQUIRE(buffer.GetTimesCount() == 4);
+    }
+
+    SECTION("find time index with the cursor")
+    {
+        // Spans of one day from day 0 to day 10.
+        InspectedTimeBuffer buffer;
+        for (int i = 0; i < 10; i++)
+        {
+            buffer.AddValues(make_shared<Time>(i, 1.), {(real)i});
+        }
+
+        // Monotonic requests advance the cursor one time by one.
+        for (int i = 0; i < 10; i++)
+        {
+            REQUIRE(buffer.FindTimeIndex(i, false) == i);
+            REQUIRE(buffer.mStartCursor == i);
+            REQUIRE(buffer.FindTimeIndex(i + 0.5, true) == i);
+            REQUIRE(buffer.mEndCursor == i);
+        }
+
+        // Backward requests fall back to the binary search.
+        REQUIRE(buffer.FindTimeIndex(2.5, false) == 3);
+        REQUIRE(buffer.mStartCursor == 3);
+        REQUIRE(buffer.FindTimeIndex(2., false) == 2);
+        REQUIRE(buffer.FindTimeIndex(0., false) == 0);
+        REQUIRE(buffer.FindTimeIndex(3., true) == 2);
+        REQUIRE(buffer.mEndCursor == 2);
+
+        // Requests out of the buffer give the bounds.
+        REQUIRE(buffer.FindTimeIndex(-5., false) == 0);
+        REQUIRE(buffer.FindTimeIndex(100., false) == 10);
+        REQUIRE(buffer.mStartCursor == 10);
+        REQUIRE(buffer.FindTimeIndex(100., true) == 10);
+        REQUIRE(buffer.FindTimeIndex(-5., true) == 0);
+        REQUIRE(buffer.FindTimeIndex(9.5, false) == 10);
+        REQUIRE(buffer.FindTimeIndex(8.5, false) == 9);
+
+        // Mixed requests agree with the linear search, whatever the cursor is.
+        for (double t : {4.2, 4.2, 4.9, 5., 1.1, 7.7, 7.8, -1., 0., 10., 10.5, 6.})
+        {
+            for (bool byEnd : {false, true})
+            {
+                REQUIRE(
+                    buffer.FindTimeIndex(t, byEnd)
+                    == FindTimeIndexLinearly(buffer, t, byEnd));
+            }
+        }
+    }
+
+    SECTION("find time index after trimming")
+    {
+        InspectedTimeBuffer buffer;
+        for (int i = 0; i < 10; i++)
+        {
+            buffer.AddValues(make_shared<Time>(i), {(real)i});
+        }
+
+        REQUIRE(buffer.FindTimeIndex(8., false) == 8);
+
+        // The cursor beyond the trimmed buffer is checked, not trusted.
+        buffer.ClearBefore(make_shared<Time>(5.));
+        REQUIRE(buffer.GetTimesCount() == 5);
+        REQUIRE(buffer.FindTimeIndex(8., false) == 3);
+        REQUIRE(buffer.FindTimeIndex(5., false) == 0);
+        REQUIRE(buffer.FindTimeIndex(20., false) == 5);
+    }
+}
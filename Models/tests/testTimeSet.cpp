@@ -0,0 +1,55 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/Time.h"
+#include "Models/CommImp/TimeSet.h"
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+TEST_CASE("Time tests")
+{
+    SECTION("to datetime")
+    {
+        shared_ptr<ITime> time = make_shared<Time>(10.5, 2.);
+
+        auto date = Time::ToDatetime(time);
+        REQUIRE(date.GetTimeStampInDays() == Approx(10.5));
+        REQUIRE(Time(date).GetTimeStamp() == Approx(time->GetTimeStamp()));
+    }
+}
+
+
+TEST_CASE("TimeSet tests")
+{
+    SECTION("horizon of time stamps")
+    {
+        TimeSet times({make_shared<Time>(2.), make_shared<Time>(1.)});
+        REQUIRE_FALSE(times.HasDurations());
+
+        auto horizon = times.GetTimeHorizon();
+        REQUIRE(horizon->GetTimeStamp() == Approx(1.));
+        REQUIRE(horizon->GetDurationInDays() == Approx(1.));
+    }
+
+    SECTION("horizon of time spans")
+    {
+        TimeSet times({make_shared<Time>(1., 0.5), make_shared<Time>(0., 1.)});
+        REQUIRE(times.HasDurations());
+
+        // The horizon ends at the end of the last span.
+        auto horizon = times.GetTimeHorizon();
+        REQUIRE(horizon->GetTimeStamp() == Approx(0.));
+        REQUIRE(horizon->GetDurationInDays() == Approx(1.5));
+
+        times.AddTime(make_shared<Time>(1.5, 0.25));
+        horizon = times.GetTimeHorizon();
+        REQUIRE(horizon->GetDurationInDays() == Approx(1.75));
+
+        times.RemoveTime(0);
+        horizon = times.GetTimeHorizon();
+        REQUIRE(horizon->GetTimeStamp() == Approx(1.));
+        REQUIRE(horizon->GetDurationInDays() == Approx(0.75));
+    }
+}
@@ -0,0 +1,125 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/DevSupports/TimeWindowExecutor.h"
+#include "Models/CommImp/LinkableComponent.h"
+#include "Models/CommImp/Time.h"
+#include "Models/CommImp/TimeSet.h"
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace std;
+
+
+// Component stepping its time by a fixed interval from 0 to 1 day, and recording
+// the time of its provider when each step ends.
+class WindowedComponent : public LinkableComponent
+{
+public:
+    double                       step     = 0;
+    WindowedComponent           *provider = nullptr;
+    vector<pair<double, double>> records;
+
+    WindowedComponent(const string &id, double step) : LinkableComponent(id), step(step)
+    {}
+
+    double Now() const
+    {
+        return mCurrentTime->GetTimeStamp();
+    }
+
+protected:
+    void InitializeArguments() override
+    {}
+    void InitializeSpace() override
+    {}
+    void InitializeTime() override
+    {
+        mTimeExtent = make_shared<TimeSet>(
+            vector<shared_ptr<ITime>>{make_shared<Time>(0., 1.)});
+        mCurrentTime = make_shared<Time>(0.);
+    }
+    void InitializeInputs() override
+    {}
+    void InitializeOutputs() override
+    {}
+    vector<string> OnValidate() override
+    {
+        return {};
+    }
+    void PrepareInputs() override
+    {}
+    void PrepareOutputs() override
+    {}
+    void ApplyInputData(const shared_ptr<IValueSet> &) override
+    {}
+    void UpdateOutputs(const vector<shared_ptr<IOutput>> &) override
+    {}
+    void PerformTimestep(const vector<shared_ptr<IOutput>> &) override
+    {
+        mCurrentTime = make_shared<Time>(Now() + step);
+        records.emplace_back(Now(), provider ? provider->Now() : Now());
+    }
+};
+
+
+TEST_CASE("TimeWindowExecutor tests")
+{
+    // Window of 4.5 hours, the provider steps by 3 hours and the consumer by 45
+    // minutes.
+    const double window = 0.1875;
+
+    auto provider = make_shared<WindowedComponent>("provider", 0.125);
+    auto consumer = make_shared<WindowedComponent>("consumer", 0.03125);
+    consumer->provider = provider.get();
+
+    for (auto comp : {provider, consumer})
+    {
+        comp->Initialize();
+        comp->Validate();
+        comp->Prepare();
+    }
+
+    SECTION("invalid arguments")
+    {
+        REQUIRE_THROWS(TimeWindowExecutor(0.));
+        REQUIRE_THROWS(TimeWindowExecutor(window, 0));
+    }
+
+    SECTION("advance in windows")
+    {
+        TimeWindowExecutor executor(window, 1, 2);
+        executor.AddComponent("provider", provider.get());
+        executor.AddComponent("consumer", consumer.get());
+        executor.AddDependency("consumer", "provider");
+
+        auto steps = executor.Run();
+        REQUIRE(steps.at("provider") == 8);
+        REQUIRE(steps.at("consumer") == 32);
+        REQUIRE(provider->GetStatus() == LinkableComponentStatus::Done);
+        REQUIRE(consumer->GetStatus() == LinkableComponentStatus::Done);
+
+        // The provider has covered the window before the consumer steps into it.
+        for (const auto &record : consumer->records)
+        {
+            double windowEnd = ceil(record.first / window - 1e-9) * window;
+            REQUIRE(record.second >= min(windowEnd, 1.) - 1e-9);
+        }
+
+        // The provider stops at its first step reaching the first window end.
+        REQUIRE(consumer->records.front().second == Approx(0.25));
+    }
+
+    SECTION("bounded lookahead")
+    {
+        TimeWindowExecutor executor(window, 3, 2);
+        executor.AddComponent("provider", provider.get());
+        executor.AddComponent("consumer", consumer.get());
+        executor.AddDependency("consumer", "provider");
+
+        executor.Run();
+
+        // With a lookahead of 3, the provider runs on until 3 of its steps end past
+        // the first window end, i.e. to 12 hours, before the consumer starts.
+        REQUIRE(consumer->records.front().second == Approx(0.5));
+    }
+}
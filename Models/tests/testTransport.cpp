@@ -0,0 +1,326 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/DevSupports/Transport.h"
+#include "Models/CommImp/DevSupports/TransportPublisher.h"
+#include "Models/CommImp/ElementSet.h"
+#include "Models/CommImp/Input.h"
+#include "Models/CommImp/LinkableComponent.h"
+#include "Models/CommImp/Output.h"
+#include "Models/CommImp/Quantity.h"
+#include "Models/CommImp/Time.h"
+#include "Models/CommImp/TimeSet.h"
+#include "Models/CommImp/TransportOutput.h"
+#include "Models/CommImp/Unit.h"
+#include "Models/CommImp/ValueSetDense.h"
+#include <future>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::CommImp::DevSupports;
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+ValuePacket MakePacket(const string &channel, double time, int count)
+{
+    ValuePacket packet;
+    packet.channel  = channel;
+    packet.time     = time;
+    packet.duration = 0.5;
+    for (int i = 0; i < count; i++)
+    {
+        packet.values.push_back(time * 100 + i);
+    }
+
+    return packet;
+}
+
+
+TEST_CASE("Value packet tests")
+{
+    SECTION("pack and unpack")
+    {
+        auto packet = MakePacket("comp1/out1", 1.25, 1000);
+        auto buffer = packet.Pack();
+
+        auto result = ValuePacket::Unpack(buffer);
+        REQUIRE(result.channel == packet.channel);
+        REQUIRE(result.time == packet.time);
+        REQUIRE(result.duration == packet.duration);
+        REQUIRE(!result.ended);
+        REQUIRE(result.values == packet.values);
+    }
+
+    SECTION("truncated buffer")
+    {
+        auto buffer = MakePacket("comp1/out1", 1, 10).Pack();
+        buffer.resize(buffer.size() - 1);
+
+        REQUIRE_THROWS(ValuePacket::Unpack(buffer));
+        REQUIRE_THROWS(ValuePacket::Unpack(""));
+    }
+}
+
+
+TEST_CASE("Loopback transport tests")
+{
+    auto ranks = LoopbackTransport::CreateGroup(3);
+    REQUIRE(ranks.size() == 3);
+    REQUIRE(ranks[2]->GetRank() == 2);
+    REQUIRE(ranks[2]->GetSize() == 3);
+
+    SECTION("packets are queued by channel in order")
+    {
+        ranks[0]->Send(2, MakePacket("a", 1, 4));
+        ranks[1]->Send(2, MakePacket("b", 2, 4));
+        ranks[0]->Send(2, MakePacket("a", 3, 4));
+
+        ValuePacket packet;
+        REQUIRE(ranks[2]->Receive("a", packet));
+        REQUIRE(packet.time == 1);
+        REQUIRE(ranks[2]->Receive("a", packet));
+        REQUIRE(packet.time == 3);
+        REQUIRE(!ranks[2]->Receive("a", packet, false));
+
+        REQUIRE(ranks[2]->Receive("b", packet));
+        REQUIRE(packet.values == MakePacket("b", 2, 4).values);
+        REQUIRE(!ranks[1]->Receive("a", packet, false));
+    }
+
+    SECTION("waiting receiver")
+    {
+        auto received = async(launch::async, [&]() {
+            ValuePacket packet;
+            return ranks[1]->Receive("a", packet) ? packet.time : -1.;
+        });
+
+        ranks[0]->Send(1, MakePacket("a", 5, 2));
+        REQUIRE(received.get() == 5);
+    }
+
+    SECTION("closed transport")
+    {
+        ranks[1]->Close();
+
+        ValuePacket packet;
+        REQUIRE(!ranks[1]->Receive("a", packet));
+        REQUIRE_THROWS(ranks[0]->Send(3, packet));
+    }
+}
+
+
+TEST_CASE("Tcp transport tests")
+{
+    vector<string> endpoints = {"127.0.0.1:47311", "127.0.0.1:47312"};
+
+    // Both ranks connect to each other, thus started concurrently.
+    auto rank1 = async(launch::async, [&]() {
+        auto transport = make_shared<TcpTransport>(1, endpoints, 5000);
+        transport->Send(0, MakePacket("c1/o1", 1, 100000));
+
+        ValuePacket packet;
+        bool        received = transport->Receive("c0/o1", packet);
+        transport->Close();
+        return received ? packet.values.size() : 0;
+    });
+
+    TcpTransport rank0(0, endpoints, 5000);
+    rank0.Send(1, MakePacket("c0/o1", 2, 16));
+
+    ValuePacket packet;
+    REQUIRE(rank0.Receive("c1/o1", packet));
+    REQUIRE(packet.time == 1);
+    REQUIRE(packet.values == MakePacket("c1/o1", 1, 100000).values);
+    REQUIRE(rank1.get() == 16);
+
+    // The rank closed isn't lost.
+    REQUIRE(!rank0.Receive("c1/o1", packet, false));
+
+    rank0.Send(0, MakePacket("self", 3, 1));
+    REQUIRE(rank0.Receive("self", packet, false));
+    REQUIRE(packet.time == 3);
+}
+
+
+TEST_CASE("Tcp transport lost rank tests")
+{
+    vector<string> endpoints = {"127.0.0.1:47313", "127.0.0.1:47314"};
+
+    // The rank 1 process exits after sending a packet, without closing its transport.
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        try
+        {
+            TcpTransport rank1(1, endpoints, 5000);
+            rank1.Send(0, MakePacket("c1/o1", 1, 4));
+            _exit(0);
+        }
+        catch (...)
+        {
+            _exit(1);
+        }
+    }
+
+    TcpTransport rank0(0, endpoints, 5000);
+
+    // The packet sent before is still received, then the receiver fails.
+    ValuePacket packet;
+    REQUIRE(rank0.Receive("c1/o1", packet));
+    REQUIRE(packet.time == 1);
+    REQUIRE_THROWS_WITH(rank0.Receive("c1/o1", packet), Catch::Contains("Rank [1]"));
+    REQUIRE_THROWS_AS(rank0.Receive("c1/o2", packet, false), IllegalStateException);
+
+    int status = 0;
+    REQUIRE(waitpid(pid, &status, 0) == pid);
+    REQUIRE(WEXITSTATUS(status) == 0);
+}
+
+
+TEST_CASE("Transport publisher tests")
+{
+    auto ranks = LoopbackTransport::CreateGroup(2);
+
+    // Output of three elements, appended a time step at each update.
+    auto values = make_shared<ValueSetDense<real>>(
+        vector<vector<real>>{{1, 2, 3}}, shared_ptr<IValueDefinition>());
+    auto times = make_shared<TimeSet>(
+        vector<shared_ptr<ITime>>{make_shared<Time>(0., 0.5)});
+
+    auto output = make_shared<Output>("out", nullptr);
+    output->SetValues(values);
+    output->SetTimeSet(times);
+
+    TransportPublisher publisher(ranks[0]);
+    publisher.AddRoute(output, 1, "c0/out");
+
+    // Each time step is published once.
+    REQUIRE(publisher.Publish() == 1);
+    REQUIRE(publisher.Publish() == 0);
+
+    values->AddElementValuesForTime(vector<real>{4, 5, 6});
+    times->AddTime(make_shared<Time>(0.5, 0.5));
+    REQUIRE(publisher.Publish() == 1);
+
+    ValuePacket packet;
+    REQUIRE(ranks[1]->Receive("c0/out", packet, false));
+    REQUIRE(packet.time == 0.);
+    REQUIRE(packet.duration == 0.5);
+    REQUIRE(packet.values == vector<double>{1, 2, 3});
+    REQUIRE(ranks[1]->Receive("c0/out", packet, false));
+    REQUIRE(packet.time == 0.5);
+    REQUIRE(packet.values == vector<double>{4, 5, 6});
+
+    publisher.End();
+    REQUIRE(ranks[1]->Receive("c0/out", packet, false));
+    REQUIRE(packet.ended);
+    REQUIRE_FALSE(ranks[1]->Receive("c0/out", packet, false));
+}
+
+
+// Consumer component whose inputs are linked to other ranks.
+class ReceivingComponent : public LinkableComponent
+{
+public:
+    ReceivingComponent() : LinkableComponent("receiver")
+    {}
+
+protected:
+    void InitializeArguments() override
+    {}
+    void InitializeSpace() override
+    {}
+    void InitializeTime() override
+    {}
+    void InitializeInputs() override
+    {}
+    void InitializeOutputs() override
+    {}
+    vector<string> OnValidate() override
+    {
+        return {};
+    }
+    void PrepareInputs() override
+    {}
+    void PrepareOutputs() override
+    {}
+    void ApplyInputData(const shared_ptr<IValueSet> &) override
+    {}
+    void UpdateOutputs(const vector<shared_ptr<IOutput>> &) override
+    {}
+    void PerformTimestep(const vector<shared_ptr<IOutput>> &) override
+    {}
+};
+
+
+TEST_CASE("Transport output tests")
+{
+    auto ranks = LoopbackTransport::CreateGroup(2);
+
+    auto quantity = make_shared<Quantity>(
+        make_shared<Unit>(PredefinedUnits::Meter), "depth", "Water depth", (real)-9999);
+
+    vector<Element> elements;
+    for (int i = 0; i < 3; i++)
+    {
+        auto id = to_string(i);
+        elements.emplace_back(id, id, id, vector<Coordinate>{{(double)i, 0, 0}});
+    }
+    auto elementSet =
+        make_shared<ElementSet>("points", "", ElementType::Point, elements);
+
+    // Output of rank 0 appended a time step at each update, routed once per
+    // consumer as the launcher does.
+    auto values = make_shared<ValueSetDense<real>>(
+        vector<vector<real>>{{1, 2, 3}}, shared_ptr<IValueDefinition>());
+    auto times =
+        make_shared<TimeSet>(vector<shared_ptr<ITime>>{make_shared<Time>(0.)});
+
+    auto output = make_shared<Output>("out", nullptr);
+    output->SetValues(values);
+    output->SetTimeSet(times);
+
+    TransportPublisher publisher(ranks[0]);
+    publisher.AddRoute(output, 1, "c0/out");
+    publisher.AddRoute(output, 1, "c0/out");
+    REQUIRE(publisher.Publish() == 1);
+
+    values->AddElementValuesForTime(vector<real>{4, 5, 6});
+    times->AddTime(make_shared<Time>(0.5));
+    REQUIRE(publisher.Publish() == 1);
+
+    // Both consumers on rank 1 share the transport output of the channel.
+    auto comp   = make_shared<ReceivingComponent>();
+    auto shared = make_shared<TransportOutput>(
+        "c0/out", comp, quantity, elementSet, ranks[1], "c0/out");
+
+    vector<shared_ptr<Input>> inputs;
+    for (const auto &id : {"in1", "in2"})
+    {
+        auto input = make_shared<Input>(id, comp);
+        input->SetValues(make_shared<ValueSetDense<real>>(quantity));
+        input->SetElementSet(elementSet);
+        input->SetTimeSet(
+            make_shared<TimeSet>(vector<shared_ptr<ITime>>{make_shared<Time>(0.5)}));
+        shared->AddConsumer(input);
+        inputs.push_back(input);
+    }
+
+    for (const auto &input : inputs)
+    {
+        auto received = dynamic_pointer_cast<ValueSetDense<real>>(input->GetValues());
+        REQUIRE(received->GetTimesCount() == 1);
+        REQUIRE(received->Get(0, 0) == 4);
+        REQUIRE(received->Get(0, 2) == 6);
+    }
+
+    // Each time step was sent once, and received once for both consumers.
+    ValuePacket packet;
+    REQUIRE_FALSE(ranks[1]->Receive("c0/out", packet, false));
+
+    publisher.End();
+    REQUIRE(ranks[1]->Receive("c0/out", packet, false));
+    REQUIRE(packet.ended);
+    REQUIRE_FALSE(ranks[1]->Receive("c0/out", packet, false));
+}
@@ -0,0 +1,90 @@
+#include "ThirdPart/Catch2/catch.hpp"
+#include "Models/CommImp/ValueSetDense.h"
+
+using namespace OpenOasis;
+using namespace OpenOasis::CommImp;
+using namespace OpenOasis::Utils;
+using namespace std;
+
+
+TEST_CASE("Dense value set tests")
+{
+    auto values = make_shared<ValueSetDense<real>>(
+        vector<vector<real>>{{1, 2, 3}, {4, 5, 6}}, shared_ptr<IValueDefinition>());
+
+    SECTION("typed access")
+    {
+        REQUIRE(values->GetTimesCount() == 2);
+        REQUIRE(values->GetElementsCount() == 3);
+        REQUIRE(values->Get(1, 2) == 6);
+
+        auto span = values->GetElementValuesForTimeSpan(1);
+        REQUIRE(span.size() == 3);
+        REQUIRE(span[0] == 4);
+
+        span[0] = 7;
+        REQUIRE(values->Get(1, 0) == 7);
+        REQUIRE_THROWS(values->Get(2, 0));
+        REQUIRE_THROWS(values->Get(0, 3));
+    }
+
+    SECTION("rows")
+    {
+        vector<real> row = {7, 8, 9};
+        values->AddElementValuesForTime(row);
+        REQUIRE(values->GetTimesCount() == 3);
+        REQUIRE(values->GetElementValuesForTimeSpan(2).ToVector() == row);
+
+        values->SetElementValuesForTime(0, row);
+        REQUIRE(values->Get(0, 1) == 8);
+        REQUIRE_THROWS(values->AddElementValuesForTime(vector<real>{1, 2}));
+
+        values->RemoveTimesBefore(2);
+        REQUIRE(values->GetTimesCount() == 1);
+        REQUIRE(values->Get(0, 2) == 9);
+    }
+
+    SECTION("sliding times")
+    {
+        for (int t = 0; t < 50; t++)
+        {
+            values->AddElementValuesForTime(vector<real>{(real)t, 0, 0});
+            values->RemoveValue({0});
+        }
+
+        REQUIRE(values->GetTimesCount() == 2);
+        REQUIRE(values->Get(0, 0) == 48);
+        REQUIRE(values->Get(1, 0) == 49);
+
+        values->AddElementValuesForTime(vector<real>{50, 0, 0});
+        values->RemoveValue({1});
+        REQUIRE(values->Get(1, 0) == 50);
+
+        values->RemoveTimesFrom(1);
+        REQUIRE(values->GetTimesCount() == 1);
+        REQUIRE(values->Get(0, 0) == 48);
+    }
+
+    SECTION("compatible interface")
+    {
+        REQUIRE(values->GetIndexCount({0}) == 2);
+        REQUIRE(values->GetIndexCount({1, 0}) == 3);
+        REQUIRE(any_cast<real>(values->GetValue({1, 2})) == 6);
+
+        values->SetOrAddValue({2, 4}, (real)9);
+        REQUIRE(values->GetTimesCount() == 3);
+        REQUIRE(values->GetElementsCount() == 5);
+        REQUIRE(values->Get(1, 1) == 5);
+        REQUIRE(values->Get(0, 4) == 0);
+        REQUIRE(values->Get(2, 4) == 9);
+        REQUIRE_THROWS(values->SetOrAddValue({0, 0}, 1));
+
+        values->RemoveValue({0});
+        REQUIRE(values->Get(0, 0) == 4);
+        REQUIRE_THROWS(values->RemoveValue({0, 0}));
+
+        ValueSetDense<real> copy(static_pointer_cast<IValueSet>(values));
+        REQUIRE(copy.Get(1, 4) == 9);
+        REQUIRE(copy.GetTimeSeriesValuesForElement(0).size() == 2);
+    }
+}